@@ -9,9 +9,16 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <array>
+#include <cstdint>
+#include <vector>
 #include <benchmark/benchmark.h>
 #include <trial/protocol/buffer/array.hpp>
+#include <trial/protocol/buffer/vector.hpp>
 #include <trial/protocol/bintoken/reader.hpp>
+#include <trial/protocol/bintoken/writer.hpp>
+#include <trial/protocol/bintoken/indexed_reader.hpp>
+#include <trial/protocol/bintoken/indexed_writer.hpp>
+#include <trial/protocol/bintoken/partial/skip.hpp>
 
 namespace bintoken = trial::protocol::bintoken;
 
@@ -131,4 +138,172 @@ void parse_compact_array8(benchmark::State& state)
 BENCHMARK(parse_compact_array8);
 BENCHMARK(value_compact_array8);
 
+//-----------------------------------------------------------------------------
+
+// Compact arrays of numbers
+
+template <typename T>
+std::vector<T> make_numbers(std::size_t size)
+{
+    std::vector<T> result(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result[i] = T(i % 100);
+    }
+    return result;
+}
+
+template <typename T>
+void read_array(benchmark::State& state)
+{
+    const auto data = make_numbers<T>(state.range(0));
+    std::vector<std::uint8_t> input;
+    bintoken::writer writer(input);
+    writer.array(data.data(), data.size());
+    std::vector<T> output(data.size());
+    for (auto _ : state)
+    {
+        bintoken::reader reader(input);
+        benchmark::DoNotOptimize(reader.array<T>(output.data(), output.size()));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * data.size() * sizeof(T));
+}
+
+template <typename T>
+void view_array(benchmark::State& state)
+{
+    const auto data = make_numbers<T>(state.range(0));
+    std::vector<std::uint8_t> encoded;
+    bintoken::writer writer(encoded);
+    writer.array(data.data(), data.size());
+    // Pad in front of the array header so the array data is aligned
+    const auto header = encoded.size() - data.size() * sizeof(T);
+    const auto padding = (alignof(T) - header % alignof(T)) % alignof(T);
+    std::vector<std::uint8_t> input(padding);
+    input.insert(input.end(), encoded.begin(), encoded.end());
+    const bintoken::reader::view_type view(input.data() + padding, encoded.size());
+    for (auto _ : state)
+    {
+        bintoken::reader reader(view);
+        auto result = reader.array_view<T>();
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * data.size() * sizeof(T));
+}
+
+template <typename T>
+void write_array(benchmark::State& state)
+{
+    const auto data = make_numbers<T>(state.range(0));
+    std::vector<std::uint8_t> output;
+    output.reserve(data.size() * sizeof(T) + 16);
+    for (auto _ : state)
+    {
+        output.clear();
+        bintoken::writer writer(output);
+        benchmark::DoNotOptimize(writer.array(data.data(), data.size()));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * data.size() * sizeof(T));
+}
+
+BENCHMARK_TEMPLATE(read_array, std::int8_t)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(read_array, std::int16_t)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(read_array, std::int32_t)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(read_array, std::int64_t)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(read_array, float)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(read_array, double)->Arg(1000)->Arg(100000);
+
+BENCHMARK_TEMPLATE(view_array, std::int32_t)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(view_array, double)->Arg(1000)->Arg(100000);
+
+BENCHMARK_TEMPLATE(write_array, std::int8_t)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(write_array, std::int16_t)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(write_array, std::int32_t)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(write_array, std::int64_t)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(write_array, float)->Arg(1000)->Arg(100000);
+BENCHMARK_TEMPLATE(write_array, double)->Arg(1000)->Arg(100000);
+
+// Indexed containers
+
+std::vector<std::uint8_t> make_records(int count)
+{
+    std::vector<std::uint8_t> result;
+    bintoken::indexed_writer writer(result);
+    writer.value<bintoken::token::begin_array>();
+    for (int i = 0; i < count; ++i)
+    {
+        writer.value<bintoken::token::begin_record>();
+        writer.value(i);
+        writer.value("alpha bravo charlie");
+        writer.value<bintoken::token::end_record>();
+    }
+    writer.value<bintoken::token::end_array>();
+    return result;
+}
+
+void last_record_sequential(benchmark::State& state)
+{
+    const auto input = make_records(state.range(0));
+    for (auto _ : state)
+    {
+        bintoken::reader reader(input);
+        reader.next(); // Skip begin_array
+        for (int records = 0; records < state.range(0) - 1;)
+        {
+            reader.next();
+            if (reader.code() == bintoken::token::code::end_record)
+                ++records;
+        }
+        reader.next();
+        reader.next();
+        benchmark::DoNotOptimize(reader.value<int>());
+    }
+}
+BENCHMARK(last_record_sequential)->Arg(1000)->Arg(100000);
+
+void last_record_indexed(benchmark::State& state)
+{
+    const auto input = make_records(state.range(0));
+    bintoken::indexed_reader indexed(input);
+    for (auto _ : state)
+    {
+        auto reader = indexed.at(indexed.size() - 1);
+        reader.next();
+        benchmark::DoNotOptimize(reader.value<int>());
+    }
+}
+BENCHMARK(last_record_indexed)->Arg(1000)->Arg(100000);
+
+// Skipping
+
+void skip_group_next(benchmark::State& state)
+{
+    const auto input = make_records(state.range(0));
+    for (auto _ : state)
+    {
+        bintoken::reader reader(input);
+        const auto level = reader.level();
+        do
+        {
+            reader.next();
+        } while (reader.level() > level);
+        benchmark::DoNotOptimize(reader.code());
+    }
+}
+BENCHMARK(skip_group_next)->Arg(1000)->Arg(100000);
+
+void skip_group_partial(benchmark::State& state)
+{
+    const auto input = make_records(state.range(0));
+    for (auto _ : state)
+    {
+        bintoken::reader reader(input);
+        benchmark::DoNotOptimize(bintoken::partial::skip(reader));
+    }
+}
+BENCHMARK(skip_group_partial)->Arg(1000)->Arg(100000);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <trial/dynamic/variable.hpp>
+
+namespace dynamic = trial::dynamic;
+
+//-----------------------------------------------------------------------------
+
+namespace corpus
+{
+
+std::vector<std::string> keys(std::size_t size)
+{
+    std::vector<std::string> result;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result.push_back("key-" + std::to_string(i * 7919 % 100003));
+    }
+    return result;
+}
+
+template <typename MapPolicy>
+dynamic::basic_variable<std::allocator<char>, MapPolicy> make(const std::vector<std::string>& keys)
+{
+    auto result = dynamic::basic_map<std::allocator<char>, MapPolicy>::make();
+    std::int64_t value = 0;
+    for (const auto& key : keys)
+    {
+        result[key] = value++;
+    }
+    return result;
+}
+
+} // namespace corpus
+
+//-----------------------------------------------------------------------------
+
+template <typename MapPolicy>
+void map_build(benchmark::State& state)
+{
+    const auto keys = corpus::keys(state.range(0));
+    for (auto _ : state)
+    {
+        auto data = corpus::make<MapPolicy>(keys);
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename MapPolicy>
+void map_lookup(benchmark::State& state)
+{
+    auto keys = corpus::keys(state.range(0));
+    const auto data = corpus::make<MapPolicy>(keys);
+    using variable_type = dynamic::basic_variable<std::allocator<char>, MapPolicy>;
+    std::vector<variable_type> lookup(keys.begin(), keys.end());
+    std::shuffle(lookup.begin(), lookup.end(), std::mt19937_64(42));
+    for (auto _ : state)
+    {
+        std::int64_t sum = 0;
+        for (const auto& key : lookup)
+        {
+            sum += data[key].template assume_value<std::int64_t>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * lookup.size());
+}
+
+template <typename MapPolicy>
+void map_iterate(benchmark::State& state)
+{
+    const auto data = corpus::make<MapPolicy>(corpus::keys(state.range(0)));
+    for (auto _ : state)
+    {
+        std::int64_t sum = 0;
+        for (const auto& value : data)
+        {
+            sum += value.template assume_value<std::int64_t>();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK_TEMPLATE(map_build, dynamic::ordered_map_policy)->Arg(8)->Arg(1000);
+BENCHMARK_TEMPLATE(map_build, dynamic::flat_map_policy)->Arg(8)->Arg(1000);
+BENCHMARK_TEMPLATE(map_build, dynamic::hash_map_policy)->Arg(8)->Arg(1000);
+
+BENCHMARK_TEMPLATE(map_lookup, dynamic::ordered_map_policy)->Arg(8)->Arg(1000);
+BENCHMARK_TEMPLATE(map_lookup, dynamic::flat_map_policy)->Arg(8)->Arg(1000);
+BENCHMARK_TEMPLATE(map_lookup, dynamic::hash_map_policy)->Arg(8)->Arg(1000);
+
+BENCHMARK_TEMPLATE(map_iterate, dynamic::ordered_map_policy)->Arg(8)->Arg(1000);
+BENCHMARK_TEMPLATE(map_iterate, dynamic::flat_map_policy)->Arg(8)->Arg(1000);
+BENCHMARK_TEMPLATE(map_iterate, dynamic::hash_map_policy)->Arg(8)->Arg(1000);
+
+//-----------------------------------------------------------------------------
+
+BENCHMARK_MAIN();
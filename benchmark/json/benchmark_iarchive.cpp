@@ -0,0 +1,213 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <trial/protocol/json/serialization.hpp>
+
+namespace json = trial::protocol::json;
+
+//-----------------------------------------------------------------------------
+
+struct record
+{
+    std::int64_t identifier = 0;
+    std::int64_t timestamp = 0;
+    double latitude = 0.0;
+    double longitude = 0.0;
+    std::int64_t altitude = 0;
+    bool verified = false;
+    std::string category;
+};
+
+// Loads record via field table
+struct table_record : record {};
+
+// Loads record by decoding keys into strings
+struct string_record : record {};
+
+namespace trial
+{
+namespace protocol
+{
+namespace serialization
+{
+
+template <typename CharT>
+struct load_overloader<json::basic_iarchive<CharT>, table_record>
+{
+    static void load(json::basic_iarchive<CharT>& archive,
+                     table_record& data,
+                     const unsigned int version)
+    {
+        static const auto table = json::make_field_table(json::field("identifier", &record::identifier),
+                                                         json::field("timestamp", &record::timestamp),
+                                                         json::field("latitude", &record::latitude),
+                                                         json::field("longitude", &record::longitude),
+                                                         json::field("altitude", &record::altitude),
+                                                         json::field("verified", &record::verified),
+                                                         json::field("category", &record::category));
+        table.load(archive, data, version);
+    }
+};
+
+template <typename CharT>
+struct load_overloader<json::basic_iarchive<CharT>, string_record>
+{
+    static void load(json::basic_iarchive<CharT>& archive,
+                     string_record& data,
+                     const unsigned int version)
+    {
+        archive.template load<json::token::begin_object>();
+        while (!archive.template at<json::token::end_object>())
+        {
+            std::string key;
+            archive.load_override(key, version);
+            if (key == "identifier")
+                archive.load_override(data.identifier, version);
+            else if (key == "timestamp")
+                archive.load_override(data.timestamp, version);
+            else if (key == "latitude")
+                archive.load_override(data.latitude, version);
+            else if (key == "longitude")
+                archive.load_override(data.longitude, version);
+            else if (key == "altitude")
+                archive.load_override(data.altitude, version);
+            else if (key == "verified")
+                archive.load_override(data.verified, version);
+            else if (key == "category")
+                archive.load_override(data.category, version);
+            else
+                archive.skip();
+        }
+        archive.template load<json::token::end_object>();
+    }
+};
+
+} // namespace serialization
+} // namespace protocol
+} // namespace trial
+
+//-----------------------------------------------------------------------------
+
+namespace corpus
+{
+
+const std::size_t size = 10000;
+
+// Array of records with keys in reverse order
+std::string records()
+{
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 100000);
+    std::string result = "[";
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (i > 0)
+            result += ",";
+        result += "{\"category\":\"sensor\"";
+        result += ",\"verified\":true";
+        result += ",\"altitude\":" + std::to_string(distribution(generator));
+        result += ",\"longitude\":" + std::to_string(distribution(generator)) + ".25";
+        result += ",\"latitude\":" + std::to_string(distribution(generator)) + ".5";
+        result += ",\"timestamp\":" + std::to_string(distribution(generator));
+        result += ",\"identifier\":" + std::to_string(i) + "}";
+    }
+    result += "]";
+    return result;
+}
+
+// Array of random numbers with fractions if T is floating-point
+template <typename T>
+std::string numbers(std::size_t count)
+{
+    std::mt19937_64 generator(42);
+    std::uniform_real_distribution<double> distribution(-100000.0, 100000.0);
+    std::string result = "[";
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (i > 0)
+            result += ",";
+        const double value = distribution(generator);
+        if (std::is_floating_point<T>::value)
+            result += std::to_string(value);
+        else
+            result += std::to_string(std::int64_t(value));
+    }
+    result += "]";
+    return result;
+}
+
+} // namespace corpus
+
+//-----------------------------------------------------------------------------
+
+template <typename T>
+void load_records(benchmark::State& state)
+{
+    const auto input = corpus::records();
+    for (auto _ : state)
+    {
+        json::iarchive archive(input);
+        std::vector<T> result;
+        archive >> result;
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK_TEMPLATE(load_records, table_record);
+BENCHMARK_TEMPLATE(load_records, string_record);
+
+template <typename T>
+void load_numbers(benchmark::State& state)
+{
+    const auto input = corpus::numbers<T>(state.range(0));
+    for (auto _ : state)
+    {
+        json::iarchive archive(input);
+        std::vector<T> result;
+        archive >> result;
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+// Element by element for comparison
+template <typename T>
+void read_numbers(benchmark::State& state)
+{
+    const auto input = corpus::numbers<T>(state.range(0));
+    for (auto _ : state)
+    {
+        json::reader reader(input);
+        std::vector<T> result;
+        while (reader.next() && (reader.symbol() != json::token::symbol::end_array))
+        {
+            result.push_back(reader.value<T>());
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK_TEMPLATE(load_numbers, double)->Arg(100000)->Arg(1000000);
+BENCHMARK_TEMPLATE(load_numbers, float)->Arg(100000)->Arg(1000000);
+BENCHMARK_TEMPLATE(load_numbers, int)->Arg(100000)->Arg(1000000);
+BENCHMARK_TEMPLATE(read_numbers, double)->Arg(100000)->Arg(1000000);
+BENCHMARK_TEMPLATE(read_numbers, int)->Arg(100000)->Arg(1000000);
+
+//-----------------------------------------------------------------------------
+
+BENCHMARK_MAIN();
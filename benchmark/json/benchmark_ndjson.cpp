@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <benchmark/benchmark.h>
+#include <trial/protocol/json/ndjson.hpp>
+
+namespace json = trial::protocol::json;
+namespace dynamic = trial::dynamic;
+
+//-----------------------------------------------------------------------------
+
+namespace corpus
+{
+
+const std::size_t size = 100000;
+
+// Newline-delimited records
+const std::string& records()
+{
+    static const std::string result = []
+        {
+            std::mt19937_64 generator(42);
+            std::uniform_int_distribution<int> distribution(0, 100000);
+            std::string records;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                records += "{\"id\":" + std::to_string(i);
+                records += ",\"name\":\"record-name-" + std::to_string(distribution(generator)) + "\"";
+                records += ",\"tags\":[\"alpha\",\"bravo\"]";
+                records += ",\"position\":{\"x\":" + std::to_string(distribution(generator));
+                records += ",\"y\":" + std::to_string(distribution(generator)) + "}}\n";
+            }
+            return records;
+        }();
+    return result;
+}
+
+} // namespace corpus
+
+//-----------------------------------------------------------------------------
+
+// Scaling with the number of parser threads
+void visit_records(benchmark::State& state)
+{
+    const auto& input = corpus::records();
+    const auto concurrency = std::size_t(state.range(0));
+    for (auto _ : state)
+    {
+        std::size_t count = 0;
+        json::ndjson::visit(input,
+                            [&count] (dynamic::variable&& record)
+                            {
+                                benchmark::DoNotOptimize(record);
+                                ++count;
+                            },
+                            concurrency);
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.SetItemsProcessed(state.iterations() * corpus::size);
+}
+
+void scaling(benchmark::internal::Benchmark *benchmark)
+{
+    const int cores = std::max<int>(json::ndjson::default_concurrency(), 1);
+    for (int concurrency = 1; concurrency < cores; concurrency *= 2)
+    {
+        benchmark->Arg(concurrency);
+    }
+    benchmark->Arg(cores);
+}
+
+BENCHMARK(visit_records)->Apply(scaling)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+//-----------------------------------------------------------------------------
+
+BENCHMARK_MAIN();
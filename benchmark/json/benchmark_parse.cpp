@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <benchmark/benchmark.h>
+#include <trial/dynamic/arena.hpp>
+#include <trial/protocol/json/lazy.hpp>
+#include <trial/protocol/json/parse.hpp>
+#include <trial/protocol/json/parallel.hpp>
+#include <trial/protocol/json/query.hpp>
+
+namespace json = trial::protocol::json;
+namespace dynamic = trial::dynamic;
+
+//-----------------------------------------------------------------------------
+
+namespace corpus
+{
+
+const std::size_t size = 10000;
+
+// Array of many small records
+std::string records(std::size_t size = corpus::size)
+{
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 100000);
+    std::string result = "[";
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (i > 0)
+            result += ",";
+        result += "{\"id\":" + std::to_string(i);
+        result += ",\"name\":\"record-name-" + std::to_string(distribution(generator)) + "\"";
+        result += ",\"tags\":[\"alpha\",\"bravo\"]";
+        result += ",\"position\":{\"x\":" + std::to_string(distribution(generator));
+        result += ",\"y\":" + std::to_string(distribution(generator)) + "}}";
+    }
+    result += "]";
+    return result;
+}
+
+// Array of short arrays
+std::string tuples()
+{
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 100000);
+    std::string result = "[";
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (i > 0)
+            result += ",";
+        result += "[" + std::to_string(distribution(generator));
+        result += "," + std::to_string(distribution(generator)) + "]";
+    }
+    result += "]";
+    return result;
+}
+
+} // namespace corpus
+
+//-----------------------------------------------------------------------------
+
+void parse_heap(benchmark::State& state, const std::string& input)
+{
+    for (auto _ : state)
+    {
+        auto result = json::parse(input);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+void parse_arena(benchmark::State& state, const std::string& input)
+{
+    dynamic::arena region(64 * 1024);
+    for (auto _ : state)
+    {
+        {
+            auto result = json::parse(input, region);
+            benchmark::DoNotOptimize(result);
+        }
+        region.release();
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK_CAPTURE(parse_heap, records, corpus::records());
+BENCHMARK_CAPTURE(parse_heap, tuples, corpus::tuples());
+
+BENCHMARK_CAPTURE(parse_arena, records, corpus::records());
+BENCHMARK_CAPTURE(parse_arena, tuples, corpus::tuples());
+
+//-----------------------------------------------------------------------------
+
+// Read a few fields from the middle of the input
+
+void select_parse(benchmark::State& state, const std::string& input)
+{
+    for (auto _ : state)
+    {
+        auto document = json::parse(input);
+        const auto& record = document[corpus::size / 2];
+        auto name = record["name"].value<std::string>();
+        auto x = record["position"]["x"].value<int>();
+        benchmark::DoNotOptimize(name);
+        benchmark::DoNotOptimize(x);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+void select_lazy(benchmark::State& state, const std::string& input)
+{
+    for (auto _ : state)
+    {
+        json::lazy_value document(input);
+        const auto record = document[corpus::size / 2];
+        auto name = record["name"].string_view();
+        auto x = record["position"]["x"].value<int>();
+        benchmark::DoNotOptimize(name);
+        benchmark::DoNotOptimize(x);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK_CAPTURE(select_parse, records, corpus::records());
+BENCHMARK_CAPTURE(select_lazy, records, corpus::records());
+
+//-----------------------------------------------------------------------------
+
+// Read one field from every record
+
+void query_parse(benchmark::State& state, const std::string& input)
+{
+    for (auto _ : state)
+    {
+        auto document = json::parse(input);
+        long total = 0;
+        for (const auto& record : document)
+        {
+            total += record["position"]["x"].value<int>();
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+void query_visit(benchmark::State& state, const std::string& input)
+{
+    json::query query;
+    query.add("/*/position/x");
+    for (auto _ : state)
+    {
+        long total = 0;
+        query.visit(input,
+                    [&total] (std::size_t, const json::lazy_value& value)
+                    {
+                        total += value.value<int>();
+                    });
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK_CAPTURE(query_parse, records, corpus::records());
+BENCHMARK_CAPTURE(query_visit, records, corpus::records());
+
+//-----------------------------------------------------------------------------
+
+// Scaling with the number of parser threads
+void parse_parallel(benchmark::State& state)
+{
+    static const std::string input = corpus::records(10 * corpus::size);
+    const auto concurrency = std::size_t(state.range(0));
+    for (auto _ : state)
+    {
+        auto result = json::parallel::parse(input, concurrency);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+void scaling(benchmark::internal::Benchmark *benchmark)
+{
+    const int cores = std::max<int>(std::thread::hardware_concurrency(), 1);
+    for (int concurrency = 1; concurrency < cores; concurrency *= 2)
+    {
+        benchmark->Arg(concurrency);
+    }
+    benchmark->Arg(cores);
+}
+
+BENCHMARK(parse_parallel)->Apply(scaling)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+//-----------------------------------------------------------------------------
+
+BENCHMARK_MAIN();
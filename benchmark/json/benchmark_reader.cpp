@@ -8,12 +8,22 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
 #include <benchmark/benchmark.h>
 #include <trial/protocol/buffer/array.hpp>
 #include <trial/protocol/json/reader.hpp>
+#include <trial/protocol/json/chunk_reader.hpp>
+#include <trial/protocol/json/stream_reader.hpp>
+#include <trial/protocol/json/indexed_reader.hpp>
+#include <trial/protocol/json/partial/skip.hpp>
 
 namespace json = trial::protocol::json;
+namespace simd = trial::protocol::core::detail::simd;
 
 void parse_int16(benchmark::State& state)
 {
@@ -420,4 +430,340 @@ void parse_whitespaces(benchmark::State& state)
 
 BENCHMARK(parse_whitespaces);
 
+//-----------------------------------------------------------------------------
+// Scanner instruction sets
+//-----------------------------------------------------------------------------
+
+const std::string& long_string()
+{
+    static const std::string input(4096, 'A');
+    return input;
+}
+
+const std::string& long_digits()
+{
+    static const std::string input(4096, '7');
+    return input;
+}
+
+const std::string& long_whitespaces()
+{
+    // Deeply indented pretty-printed layout
+    static const std::string input = []
+    {
+        std::string result;
+        while (result.size() < 4096)
+        {
+            result += "\r\n";
+            result.append(32, ' ');
+            result += '\t';
+        }
+        return result;
+    }();
+    return input;
+}
+
+template <simd::isa I>
+bool skip_unsupported(benchmark::State& state)
+{
+    if (simd::supported() < I)
+    {
+        state.SkipWithError("instruction set not supported");
+        return true;
+    }
+    return false;
+}
+
+template <simd::isa I>
+void scan_narrow(benchmark::State& state)
+{
+    if (skip_unsupported<I>(state))
+        return;
+    const auto& input = long_string();
+    const char *head = input.data();
+    const char *tail = head + input.size();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(json::detail::scanner<I>::narrow(head, tail));
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK_TEMPLATE(scan_narrow, simd::isa::scalar);
+BENCHMARK_TEMPLATE(scan_narrow, simd::isa::sse2);
+BENCHMARK_TEMPLATE(scan_narrow, simd::isa::avx2);
+BENCHMARK_TEMPLATE(scan_narrow, simd::isa::avx512);
+
+template <simd::isa I>
+void scan_digit(benchmark::State& state)
+{
+    if (skip_unsupported<I>(state))
+        return;
+    const auto& input = long_digits();
+    const char *head = input.data();
+    const char *tail = head + input.size();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(json::detail::scanner<I>::digit(head, tail));
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK_TEMPLATE(scan_digit, simd::isa::scalar);
+BENCHMARK_TEMPLATE(scan_digit, simd::isa::sse2);
+BENCHMARK_TEMPLATE(scan_digit, simd::isa::avx2);
+BENCHMARK_TEMPLATE(scan_digit, simd::isa::avx512);
+
+template <simd::isa I>
+void scan_whitespace(benchmark::State& state)
+{
+    if (skip_unsupported<I>(state))
+        return;
+    const auto& input = long_whitespaces();
+    const char *head = input.data();
+    const char *tail = head + input.size();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(json::detail::scanner<I>::whitespace(head, tail));
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK_TEMPLATE(scan_whitespace, simd::isa::scalar);
+BENCHMARK_TEMPLATE(scan_whitespace, simd::isa::sse2);
+BENCHMARK_TEMPLATE(scan_whitespace, simd::isa::avx2);
+BENCHMARK_TEMPLATE(scan_whitespace, simd::isa::avx512);
+
+void parse_long_string(benchmark::State& state)
+{
+    const std::string input = "\"" + long_string() + "\"";
+    for (auto _ : state)
+    {
+        json::reader reader(input);
+        benchmark::DoNotOptimize(reader.literal());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK(parse_long_string);
+
+//-----------------------------------------------------------------------------
+// Structural index
+//-----------------------------------------------------------------------------
+
+const std::string& large_document()
+{
+    static const std::string input = []
+    {
+        std::string result = "{\"skip\": [";
+        for (int i = 0; i < 10000; ++i)
+        {
+            result += "\n    {\"name\": \"alpha\\\"beta\", \"values\": [1, 2.5, true, null]},";
+        }
+        result += "\n    {}\n], \"keep\": 42}";
+        return result;
+    }();
+    return input;
+}
+
+template <typename Reader>
+void parse_tokens(benchmark::State& state)
+{
+    const auto& input = large_document();
+    for (auto _ : state)
+    {
+        Reader reader(input);
+        while (reader.next())
+            continue;
+        benchmark::DoNotOptimize(reader.code());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK_TEMPLATE(parse_tokens, json::reader);
+BENCHMARK_TEMPLATE(parse_tokens, json::indexed_reader);
+BENCHMARK_TEMPLATE(parse_tokens, json::chunk_reader);
+
+// Input arrives in chunks of state.range(0) bytes
+void parse_chunks(benchmark::State& state)
+{
+    using view_type = json::chunk_reader::view_type;
+    const auto& input = large_document();
+    const std::size_t chunk_size = state.range(0);
+    std::vector<char> buffer(2 * chunk_size);
+    for (auto _ : state)
+    {
+        json::chunk_reader reader;
+        std::size_t length = 0;
+        for (std::size_t position = 0; position < input.size(); position += chunk_size)
+        {
+            const auto size = std::min(chunk_size, input.size() - position);
+            std::memcpy(&buffer[length], &input[position], size);
+            length += size;
+            if (reader.next(view_type(buffer.data(), length)))
+            {
+                while (reader.next())
+                    continue;
+                length = reader.tail().size();
+                std::memmove(buffer.data(), reader.tail().data(), length);
+                reader.shift({ buffer.data(), length });
+            }
+        }
+        benchmark::DoNotOptimize(reader.code());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK(parse_chunks)->Arg(256)->Arg(4096)->Arg(65536);
+
+// Input is pulled in chunks of state.range(0) bytes
+void parse_stream(benchmark::State& state)
+{
+    const auto& input = large_document();
+    const std::size_t chunk_size = state.range(0);
+    for (auto _ : state)
+    {
+        std::size_t position = 0;
+        json::stream_reader reader([&input, &position](char *data, std::size_t size)
+                                   {
+                                       const auto count = std::min(size, input.size() - position);
+                                       std::memcpy(data, &input[position], count);
+                                       position += count;
+                                       return count;
+                                   },
+                                   chunk_size);
+        while (reader.next())
+            continue;
+        benchmark::DoNotOptimize(reader.code());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK(parse_stream)->Arg(256)->Arg(4096)->Arg(65536);
+
+template <typename Reader>
+void parse_skip(benchmark::State& state)
+{
+    const auto& input = large_document();
+    for (auto _ : state)
+    {
+        Reader reader(input);
+        reader.next(); // key
+        reader.next(); // array
+        benchmark::DoNotOptimize(json::partial::skip(reader));
+        benchmark::DoNotOptimize(reader.template value<std::string>());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK_TEMPLATE(parse_skip, json::reader);
+BENCHMARK_TEMPLATE(parse_skip, json::indexed_reader);
+
+//-----------------------------------------------------------------------------
+// UTF-8 validation
+//-----------------------------------------------------------------------------
+
+// Array of strings built from repeated words
+const std::string& string_document(const char *word)
+{
+    static std::map<const char *, std::string> cache;
+    auto& result = cache[word];
+    if (result.empty())
+    {
+        result = "[";
+        for (int i = 0; i < 10000; ++i)
+        {
+            result += "\"";
+            for (int j = 0; j < 1 + i % 8; ++j)
+            {
+                result += word;
+            }
+            result += "\",";
+        }
+        result += "\"\"]";
+    }
+    return result;
+}
+
+const char ascii_word[] = "validate ";
+const char cjk_word[] = "\xE6\xA4\x9C\xE8\xA8\xBC\xE3\x81\x99\xE3\x82\x8B ";
+const char emoji_word[] = "\xF0\x9F\x98\x80\xF0\x9F\x91\x8D ";
+
+void parse_strings(benchmark::State& state,
+                   const char *word,
+                   json::validation validation)
+{
+    const auto& input = string_document(word);
+    for (auto _ : state)
+    {
+        json::reader reader(input, validation);
+        while (reader.next())
+            continue;
+        benchmark::DoNotOptimize(reader.code());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK_CAPTURE(parse_strings, ascii_lenient, ascii_word, json::validation::lenient);
+BENCHMARK_CAPTURE(parse_strings, ascii_strict, ascii_word, json::validation::strict);
+BENCHMARK_CAPTURE(parse_strings, cjk_lenient, cjk_word, json::validation::lenient);
+BENCHMARK_CAPTURE(parse_strings, cjk_strict, cjk_word, json::validation::strict);
+BENCHMARK_CAPTURE(parse_strings, emoji_lenient, emoji_word, json::validation::lenient);
+BENCHMARK_CAPTURE(parse_strings, emoji_strict, emoji_word, json::validation::strict);
+
+template <simd::isa I>
+void scan_strict_utf8(benchmark::State& state)
+{
+    if (skip_unsupported<I>(state))
+        return;
+    const auto& input = string_document(cjk_word);
+    const char *head = input.data();
+    const char *tail = head + input.size();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(json::detail::scanner<I>::strict_utf8(head, tail));
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK_TEMPLATE(scan_strict_utf8, simd::isa::scalar);
+BENCHMARK_TEMPLATE(scan_strict_utf8, simd::isa::sse2);
+BENCHMARK_TEMPLATE(scan_strict_utf8, simd::isa::avx2);
+BENCHMARK_TEMPLATE(scan_strict_utf8, simd::isa::avx512);
+
+//-----------------------------------------------------------------------------
+// Small documents
+//-----------------------------------------------------------------------------
+
+const char tiny_document[] = "{\"id\":42,\"method\":\"ping\",\"params\":[1,2]}";
+
+template <typename Reader>
+void construct_tiny(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        Reader reader(tiny_document);
+        benchmark::DoNotOptimize(reader.code());
+    }
+}
+
+BENCHMARK_TEMPLATE(construct_tiny, json::reader);
+BENCHMARK_TEMPLATE(construct_tiny, json::basic_reader<char, json::fixed_nesting<8>>);
+
+template <typename Reader>
+void parse_tiny(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        Reader reader(tiny_document);
+        while (reader.next())
+            continue;
+        benchmark::DoNotOptimize(reader.code());
+    }
+    state.SetBytesProcessed(state.iterations() * (sizeof(tiny_document) - 1));
+}
+
+BENCHMARK_TEMPLATE(parse_tiny, json::reader);
+BENCHMARK_TEMPLATE(parse_tiny, json::basic_reader<char, json::fixed_nesting<8>>);
+
 BENCHMARK_MAIN();
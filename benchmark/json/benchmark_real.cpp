@@ -8,6 +8,13 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
 #include <benchmark/benchmark.h>
 #include <trial/protocol/buffer/string.hpp>
 #include <trial/protocol/json/reader.hpp>
@@ -62,4 +69,111 @@ BENCHMARK_TEMPLATE(value_double, 30);
 BENCHMARK_TEMPLATE(value_double, 31);
 BENCHMARK_TEMPLATE(value_double, 32);
 
+//-----------------------------------------------------------------------------
+// Float corpora
+//-----------------------------------------------------------------------------
+
+namespace corpus
+{
+
+// Polygon coordinates with 17 significant digits in the style of canada.json
+std::string coordinates()
+{
+    std::mt19937_64 generator(2020);
+    std::uniform_real_distribution<double> longitude(-141.0, -52.0);
+    std::uniform_real_distribution<double> latitude(41.0, 83.0);
+    std::string result = "[";
+    char buffer[64];
+    for (int i = 0; i < 50000; ++i)
+    {
+        std::snprintf(buffer, sizeof(buffer), "[%.17g,%.17g],",
+                      longitude(generator), latitude(generator));
+        result += buffer;
+    }
+    result.back() = ']';
+    return result;
+}
+
+// Short decimal fractions in the style of mesh.json
+std::string mesh()
+{
+    std::mt19937_64 generator(2020);
+    std::uniform_int_distribution<int> value(-99999, 99999);
+    std::string result = "[";
+    char buffer[64];
+    for (int i = 0; i < 100000; ++i)
+    {
+        std::snprintf(buffer, sizeof(buffer), "%.3f,", value(generator) / 1000.0);
+        result += buffer;
+    }
+    result.back() = ']';
+    return result;
+}
+
+// Random bit patterns across the entire exponent range
+std::string random()
+{
+    std::mt19937_64 generator(2020);
+    std::string result = "[";
+    char buffer[64];
+    for (int i = 0; i < 50000; ++i)
+    {
+        double value;
+        do
+        {
+            const auto bits = generator();
+            std::memcpy(&value, &bits, sizeof(value));
+        } while (!std::isfinite(value));
+        std::snprintf(buffer, sizeof(buffer), "%.17g,", value);
+        result += buffer;
+    }
+    result.back() = ']';
+    return result;
+}
+
+} // namespace corpus
+
+// Skips the benchmark unless all numbers are the nearest double
+bool verify(benchmark::State& state, const std::string& input)
+{
+    json::reader reader(input);
+    while (reader.next())
+    {
+        if (reader.code() != json::token::code::real)
+            continue;
+        const auto literal = std::string(reader.literal().begin(), reader.literal().end());
+        if (reader.value<double>() != std::strtod(literal.c_str(), nullptr))
+        {
+            state.SkipWithError(("Incorrectly rounded " + literal).c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+void parse_corpus(benchmark::State& state, std::string input)
+{
+    if (!verify(state, input))
+        return;
+
+    for (auto _ : state)
+    {
+        json::reader reader(input);
+        double sum = 0.0;
+        while (reader.next())
+        {
+            if (reader.code() == json::token::code::real)
+            {
+                sum += reader.value<double>();
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+BENCHMARK_CAPTURE(parse_corpus, canada, corpus::coordinates());
+BENCHMARK_CAPTURE(parse_corpus, mesh, corpus::mesh());
+BENCHMARK_CAPTURE(parse_corpus, random, corpus::random());
+
 BENCHMARK_MAIN();
@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <trial/protocol/buffer/string.hpp>
+#include <trial/protocol/buffer/vector.hpp>
+#include <trial/protocol/json/writer.hpp>
+
+namespace buffer = trial::protocol::buffer;
+namespace json = trial::protocol::json;
+namespace token = json::token;
+
+using static_writer = json::static_writer<buffer::basic_string<char, buffer::static_base<char>>>;
+
+//-----------------------------------------------------------------------------
+
+namespace corpus
+{
+
+const std::size_t size = 10000;
+
+// Telemetry-like measurements
+template <typename T>
+std::vector<T> random()
+{
+    std::mt19937_64 generator(42);
+    std::uniform_real_distribution<T> distribution(T(-1000), T(1000));
+    std::vector<T> result;
+    result.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result.push_back(distribution(generator));
+    }
+    return result;
+}
+
+// Values with few significant digits
+std::vector<double> short_decimals()
+{
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<int> distribution(-100000, 100000);
+    std::vector<double> result;
+    result.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result.push_back(distribution(generator) / 100.0);
+    }
+    return result;
+}
+
+std::vector<double> integral()
+{
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<int> distribution(-1000000, 1000000);
+    std::vector<double> result;
+    result.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result.push_back(distribution(generator));
+    }
+    return result;
+}
+
+std::vector<std::int64_t> integers()
+{
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<std::int64_t> distribution(-1000000, 1000000);
+    std::vector<std::int64_t> result;
+    result.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result.push_back(distribution(generator));
+    }
+    return result;
+}
+
+std::vector<std::string> strings()
+{
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<int> length(4, 64);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::vector<std::string> result;
+    result.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        std::string entry(length(generator), ' ');
+        for (auto& character : entry)
+        {
+            character = char(letter(generator));
+        }
+        result.push_back(entry);
+    }
+    return result;
+}
+
+std::vector<std::string> messages()
+{
+    // Sentences with occasional escape and multi-byte characters
+    const char *words[] = { "alpha", "bravo", "charlie", "delta", "echo",
+                            "foxtrot", "caf\xC3\xA9", "\xE2\x82\xAC" "42",
+                            "\"quoted\"", "line\n" };
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<int> length(16, 256);
+    std::discrete_distribution<int> word({ 20, 20, 20, 20, 20, 20, 2, 2, 1, 1 });
+    std::vector<std::string> result;
+    result.reserve(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const std::size_t limit = length(generator);
+        std::string entry;
+        while (entry.size() < limit)
+        {
+            entry += words[word(generator)];
+            entry += ' ';
+        }
+        result.push_back(entry);
+    }
+    return result;
+}
+
+} // namespace corpus
+
+//-----------------------------------------------------------------------------
+
+template <typename Writer, typename Output, typename T>
+void write_array(benchmark::State& state, const std::vector<T>& input)
+{
+    Output buffer;
+    for (auto _ : state)
+    {
+        buffer = Output();
+        Writer writer(buffer);
+        writer.template value<token::begin_array>();
+        for (const auto& value : input)
+        {
+            writer.value(value);
+        }
+        writer.template value<token::end_array>();
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+template <typename T>
+void write_array(benchmark::State& state, const std::vector<T>& input)
+{
+    write_array<json::writer, std::string>(state, input);
+}
+
+template <typename T>
+void write_array_static(benchmark::State& state, const std::vector<T>& input)
+{
+    write_array<static_writer, std::string>(state, input);
+}
+
+template <typename T>
+void write_array_vector(benchmark::State& state, const std::vector<T>& input)
+{
+    write_array<json::writer, std::vector<char>>(state, input);
+}
+
+// Numbers written in one call
+template <typename Writer, typename Output, typename T>
+void write_numbers(benchmark::State& state, const std::vector<T>& input)
+{
+    Output buffer;
+    for (auto _ : state)
+    {
+        buffer = Output();
+        Writer writer(buffer);
+        writer.array(input.data(), input.size());
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+template <typename T>
+void write_numbers(benchmark::State& state, const std::vector<T>& input)
+{
+    write_numbers<json::writer, std::string>(state, input);
+}
+
+template <typename T>
+void write_numbers_static(benchmark::State& state, const std::vector<T>& input)
+{
+    write_numbers<static_writer, std::string>(state, input);
+}
+
+BENCHMARK_CAPTURE(write_array, float_random, corpus::random<float>());
+BENCHMARK_CAPTURE(write_array, double_random, corpus::random<double>());
+BENCHMARK_CAPTURE(write_array, double_short, corpus::short_decimals());
+BENCHMARK_CAPTURE(write_array, double_integral, corpus::integral());
+BENCHMARK_CAPTURE(write_array, integer, corpus::integers());
+BENCHMARK_CAPTURE(write_array, string, corpus::strings());
+BENCHMARK_CAPTURE(write_array, message, corpus::messages());
+
+BENCHMARK_CAPTURE(write_array_static, double_random, corpus::random<double>());
+BENCHMARK_CAPTURE(write_array_static, integer, corpus::integers());
+BENCHMARK_CAPTURE(write_array_static, string, corpus::strings());
+BENCHMARK_CAPTURE(write_array_static, message, corpus::messages());
+
+BENCHMARK_CAPTURE(write_array_vector, double_random, corpus::random<double>());
+BENCHMARK_CAPTURE(write_array_vector, integer, corpus::integers());
+BENCHMARK_CAPTURE(write_array_vector, string, corpus::strings());
+
+BENCHMARK_CAPTURE(write_numbers, float_random, corpus::random<float>());
+BENCHMARK_CAPTURE(write_numbers, double_random, corpus::random<double>());
+BENCHMARK_CAPTURE(write_numbers, double_short, corpus::short_decimals());
+BENCHMARK_CAPTURE(write_numbers, integer, corpus::integers());
+
+BENCHMARK_CAPTURE(write_numbers_static, double_random, corpus::random<double>());
+BENCHMARK_CAPTURE(write_numbers_static, integer, corpus::integers());
+
+//-----------------------------------------------------------------------------
+
+BENCHMARK_MAIN();
@@ -8,12 +8,12 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
-#include <string>
 #include <iostream>
-#include <boost/filesystem/fstream.hpp>
 #include <trial/protocol/buffer/ostream.hpp>
+#include <trial/protocol/core/mapped_file.hpp>
 #include "pretty_printer.hpp"
 
+namespace core = trial::protocol::core;
 namespace json = trial::protocol::json;
 
 int main(int argc, char *argv[])
@@ -26,19 +26,11 @@ int main(int argc, char *argv[])
             return 1;
         }
 
-        boost::filesystem::path input_name(argv[1]);
-        boost::filesystem::ifstream input(input_name);
-        if (input)
-        {
-            std::noskipws(input);
-            std::string buffer((std::istream_iterator<char>(input)),
-                               (std::istream_iterator<char>()));
-
-            json::reader reader(buffer);
-            json::writer writer(std::cout);
-            json::example::pretty_printer printer(reader, writer);
-            printer.print();
-        }
+        core::mapped_file input(argv[1]);
+        json::reader reader(input);
+        json::writer writer(std::cout);
+        json::example::pretty_printer printer(reader, writer);
+        printer.print();
     }
     catch (const std::exception& ex)
     {
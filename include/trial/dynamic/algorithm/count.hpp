@@ -21,9 +21,9 @@ namespace dynamic
 namespace key
 {
 
-template <typename Allocator, typename T>
-auto count(const basic_variable<Allocator>& self,
-           const T& other) -> typename basic_variable<Allocator>::size_type
+template <typename Allocator, typename MapPolicy, typename T>
+auto count(const basic_variable<Allocator, MapPolicy>& self,
+           const T& other) -> typename basic_variable<Allocator, MapPolicy>::size_type
 {
     switch (self.symbol())
     {
@@ -42,7 +42,7 @@ auto count(const basic_variable<Allocator>& self,
     case symbol::array:
     case symbol::map:
         {
-            typename basic_variable<Allocator>::size_type result = 0;
+            typename basic_variable<Allocator, MapPolicy>::size_type result = 0;
             for (auto it = self.key_begin(); it != self.key_end(); ++it)
             {
                 if (*it == other)
@@ -59,9 +59,9 @@ auto count(const basic_variable<Allocator>& self,
 namespace value
 {
 
-template <typename Allocator, typename T>
-auto count(const basic_variable<Allocator>& self,
-           const T& other) -> typename basic_variable<Allocator>::size_type
+template <typename Allocator, typename MapPolicy, typename T>
+auto count(const basic_variable<Allocator, MapPolicy>& self,
+           const T& other) -> typename basic_variable<Allocator, MapPolicy>::size_type
 {
     switch (self.symbol())
     {
@@ -80,7 +80,7 @@ auto count(const basic_variable<Allocator>& self,
     case symbol::array:
     case symbol::map:
         {
-            typename basic_variable<Allocator>::size_type result = 0;
+            typename basic_variable<Allocator, MapPolicy>::size_type result = 0;
             for (auto it = self.begin(); it != self.end(); ++it)
             {
                 if (*it == other)
@@ -22,9 +22,9 @@ namespace dynamic
 namespace key
 {
 
-template <typename Allocator, typename T>
-auto erase(basic_variable<Allocator>& self,
-           const T& other) -> typename basic_variable<Allocator>::key_iterator
+template <typename Allocator, typename MapPolicy, typename T>
+auto erase(basic_variable<Allocator, MapPolicy>& self,
+           const T& other) -> typename basic_variable<Allocator, MapPolicy>::key_iterator
 {
     switch (self.symbol())
     {
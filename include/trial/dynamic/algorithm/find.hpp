@@ -25,9 +25,9 @@ namespace dynamic
 namespace key
 {
 
-template <typename Allocator, typename T>
-auto find(const basic_variable<Allocator>& self,
-          const T& other) -> typename basic_variable<Allocator>::key_iterator
+template <typename Allocator, typename MapPolicy, typename T>
+auto find(const basic_variable<Allocator, MapPolicy>& self,
+          const T& other) -> typename basic_variable<Allocator, MapPolicy>::key_iterator
 {
     switch (self.symbol())
     {
@@ -64,9 +64,9 @@ auto find(const basic_variable<Allocator>& self,
 namespace value
 {
 
-template <typename Allocator, typename T>
-auto find(basic_variable<Allocator>& self,
-          const T& other) -> typename basic_variable<Allocator>::iterator
+template <typename Allocator, typename MapPolicy, typename T>
+auto find(basic_variable<Allocator, MapPolicy>& self,
+          const T& other) -> typename basic_variable<Allocator, MapPolicy>::iterator
 {
     switch (self.symbol())
     {
@@ -94,9 +94,9 @@ auto find(basic_variable<Allocator>& self,
     TRIAL_DYNAMIC_UNREACHABLE();
 }
 
-template <typename Allocator, typename T>
-auto find(const basic_variable<Allocator>& self,
-          const T& other) -> typename basic_variable<Allocator>::const_iterator
+template <typename Allocator, typename MapPolicy, typename T>
+auto find(const basic_variable<Allocator, MapPolicy>& self,
+          const T& other) -> typename basic_variable<Allocator, MapPolicy>::const_iterator
 {
     switch (self.symbol())
     {
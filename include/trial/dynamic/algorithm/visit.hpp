@@ -40,11 +40,11 @@ namespace dynamic
 //! @param[in] variable Non-const dynamic variable.
 //! @returns Return type of `Visitor::operator()(nullable)`.
 
-template <typename Visitor, typename Allocator>
-auto visit(Visitor&& visitor, basic_variable<Allocator>& variable)
+template <typename Visitor, typename Allocator, typename MapPolicy>
+auto visit(Visitor&& visitor, basic_variable<Allocator, MapPolicy>& variable)
     -> decltype(std::forward<Visitor>(visitor).operator()(variable.template assume_value<nullable>()))
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
     switch (variable.code())
     {
@@ -96,11 +96,11 @@ auto visit(Visitor&& visitor, basic_variable<Allocator>& variable)
 
 //! @brief Immutable visitation
 
-template <typename Visitor, typename Allocator>
-auto visit(Visitor&& visitor, const basic_variable<Allocator>& variable)
+template <typename Visitor, typename Allocator, typename MapPolicy>
+auto visit(Visitor&& visitor, const basic_variable<Allocator, MapPolicy>& variable)
     -> decltype(std::forward<Visitor>(visitor).operator()(variable.template assume_value<nullable>()))
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
     switch (variable.code())
     {
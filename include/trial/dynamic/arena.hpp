@@ -0,0 +1,148 @@
+#ifndef TRIAL_DYNAMIC_ARENA_HPP
+#define TRIAL_DYNAMIC_ARENA_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <type_traits>
+
+namespace trial
+{
+namespace dynamic
+{
+
+//! @brief Monotonic memory region.
+//!
+//! Memory is handed out sequentially from large blocks. Individual
+//! deallocations are ignored, and all memory is returned at once when the
+//! arena is released or destroyed.
+//!
+//! The arena must outlive all objects allocated from it.
+
+class arena
+{
+public:
+    //! @brief Construct an empty arena.
+    //!
+    //! No memory is allocated until the first allocation request.
+    //!
+    //! @param block_size Size of the first block. Subsequent blocks double in size.
+    explicit arena(std::size_t block_size = 4096) noexcept;
+    arena(const arena&) = delete;
+    arena(arena&&) = delete;
+    arena& operator=(const arena&) = delete;
+    arena& operator=(arena&&) = delete;
+    ~arena();
+
+    //! @brief Allocate memory.
+    //!
+    //! @param size Number of bytes.
+    //! @param alignment Alignment of the returned memory.
+    //! @returns Pointer to uninitialized memory.
+    //! @throws std::bad_alloc if memory is exhausted.
+    void *allocate(std::size_t size, std::size_t alignment);
+
+    //! @brief Return all memory.
+    //!
+    //! The arena can be reused afterwards, starting again from the initial
+    //! block size.
+    void release() noexcept;
+
+    //! @returns The total size of all blocks.
+    std::size_t capacity() const noexcept;
+
+    //! @brief Make arena the default for arena_allocator within a scope.
+    //!
+    //! Default-constructed arena allocators refer to the arena of the
+    //! innermost active scope on the current thread. Scopes are used where
+    //! allocators cannot be passed explicitly, such as when containers are
+    //! created inside dynamic::basic_variable.
+    class scope
+    {
+    public:
+        explicit scope(arena&) noexcept;
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+        ~scope();
+
+    private:
+        arena *previous;
+    };
+
+    //! @returns The arena of the innermost scope, or nullptr if no scope is active.
+    static arena *current() noexcept;
+
+#ifndef BOOST_DOXYGEN_INVOKED
+private:
+    static arena *& active() noexcept;
+    void *allocate_block(std::size_t size, std::size_t alignment);
+
+    struct block
+    {
+        block *next;
+        std::size_t size;
+    };
+
+    block *head;
+    char *cursor;
+    char *limit;
+    std::size_t first_size;
+    std::size_t next_size;
+    std::size_t total;
+#endif
+};
+
+//! @brief Allocator that allocates from an arena.
+//!
+//! A default-constructed allocator refers to the arena of the innermost
+//! active arena::scope, or to the heap if no scope is active.
+//!
+//! The allocator propagates with the container contents, so memory is always
+//! returned to where it came from.
+
+template <typename T>
+class arena_allocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    arena_allocator() noexcept;
+    explicit arena_allocator(arena&) noexcept;
+    template <typename U>
+    arena_allocator(const arena_allocator<U>&) noexcept;
+
+    T *allocate(std::size_t count);
+    void deallocate(T *, std::size_t) noexcept;
+
+    //! @returns The arena, or nullptr if the allocator uses the heap.
+    arena *resource() const noexcept;
+
+#ifndef BOOST_DOXYGEN_INVOKED
+private:
+    arena *region;
+#endif
+};
+
+template <typename T, typename U>
+bool operator==(const arena_allocator<T>&, const arena_allocator<U>&) noexcept;
+
+template <typename T, typename U>
+bool operator!=(const arena_allocator<T>&, const arena_allocator<U>&) noexcept;
+
+} // namespace dynamic
+} // namespace trial
+
+#include <trial/dynamic/detail/arena.ipp>
+
+#endif // TRIAL_DYNAMIC_ARENA_HPP
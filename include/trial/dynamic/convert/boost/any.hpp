@@ -23,10 +23,10 @@ namespace dynamic
 namespace convert
 {
 
-template <typename Allocator>
-struct overloader<basic_variable<Allocator>, boost::any>
+template <typename Allocator, typename MapPolicy>
+struct overloader<basic_variable<Allocator, MapPolicy>, boost::any>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
     static variable_type into(const boost::any& any,
                               std::error_code& error)
@@ -156,10 +156,10 @@ struct overloader<basic_variable<Allocator>, boost::any>
     }
 };
 
-template <typename Allocator>
-struct overloader<boost::any, basic_variable<Allocator>>
+template <typename Allocator, typename MapPolicy>
+struct overloader<boost::any, basic_variable<Allocator, MapPolicy>>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
     static boost::any into(const variable_type& data,
                            std::error_code& error)
@@ -230,10 +230,10 @@ struct overloader<boost::any, basic_variable<Allocator>>
     }
 };
 
-template <typename Allocator>
-struct overloader<std::vector<boost::any>, basic_variable<Allocator>>
+template <typename Allocator, typename MapPolicy>
+struct overloader<std::vector<boost::any>, basic_variable<Allocator, MapPolicy>>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
     static std::vector<boost::any> into(const variable_type& input,
                                         std::error_code& error)
@@ -22,11 +22,11 @@ namespace dynamic
 namespace convert
 {
 
-template <typename Allocator, typename T>
-struct overloader<basic_variable<Allocator>,
+template <typename Allocator, typename MapPolicy, typename T>
+struct overloader<basic_variable<Allocator, MapPolicy>,
                   boost::optional<T>>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
     static variable_type into(const boost::optional<T>& value,
                               std::error_code&)
@@ -38,13 +38,13 @@ struct overloader<basic_variable<Allocator>,
     }
 };
 
-template <typename Allocator, typename T>
+template <typename Allocator, typename MapPolicy, typename T>
 struct overloader<boost::optional<T>,
-                  basic_variable<Allocator>>
+                  basic_variable<Allocator, MapPolicy>>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
-    static boost::optional<T> into(const basic_variable<Allocator>& data,
+    static boost::optional<T> into(const basic_variable<Allocator, MapPolicy>& data,
                                    std::error_code& error)
     {
         error.clear();
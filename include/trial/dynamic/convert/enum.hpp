@@ -44,28 +44,28 @@ struct is_enum
 template <typename T>
 struct use_underlying_type : public std::false_type {};
 
-template <typename Allocator, typename T>
+template <typename Allocator, typename MapPolicy, typename T>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     T,
     typename std::enable_if<detail::is_enum<T>::value &&
                             use_underlying_type<T>::value>::type>
 {
-    static basic_variable<Allocator> into(const T& data,
+    static basic_variable<Allocator, MapPolicy> into(const T& data,
                                           std::error_code&)
     {
         return static_cast<typename std::underlying_type<T>::type>(data);
     }
 };
 
-template <typename Allocator, typename T>
+template <typename Allocator, typename MapPolicy, typename T>
 struct overloader<
     T,
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     typename std::enable_if<detail::is_enum<T>::value &&
                             use_underlying_type<T>::value>::type>
 {
-    static T into(const basic_variable<Allocator>& data,
+    static T into(const basic_variable<Allocator, MapPolicy>& data,
                   std::error_code& error)
     {
         return static_cast<T>(data.template value<typename std::underlying_type<T>::type>(error));
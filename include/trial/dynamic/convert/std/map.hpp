@@ -22,15 +22,15 @@ namespace dynamic
 namespace convert
 {
 
-template <typename Allocator, typename Key, typename Value>
+template <typename Allocator, typename MapPolicy, typename Key, typename Value>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     std::map<Key, Value>>
 {
-    static basic_variable<Allocator> into(const std::map<Key, Value>& map,
+    static basic_variable<Allocator, MapPolicy> into(const std::map<Key, Value>& map,
                                           std::error_code&)
     {
-        auto result = basic_map<Allocator>::make();
+        auto result = basic_map<Allocator, MapPolicy>::make();
         for (const auto& entry : map)
         {
             result += map::make(entry.first, entry.second);
@@ -39,12 +39,12 @@ struct overloader<
     }
 };
 
-template <typename Allocator, typename Key, typename Value>
+template <typename Allocator, typename MapPolicy, typename Key, typename Value>
 struct overloader<
     std::map<Key, Value>,
-    basic_variable<Allocator>>
+    basic_variable<Allocator, MapPolicy>>
 {
-    static std::map<Key, Value> into(const basic_variable<Allocator>& map,
+    static std::map<Key, Value> into(const basic_variable<Allocator, MapPolicy>& map,
                                      std::error_code& error)
     {
         std::map<Key, Value> result;
@@ -65,15 +65,15 @@ struct overloader<
 
 // Special case for std::map<T, variable>
 
-template <typename Allocator, typename Key>
+template <typename Allocator, typename MapPolicy, typename Key>
 struct overloader<
-    std::map<Key, basic_variable<Allocator>>,
-    basic_variable<Allocator>>
+    std::map<Key, basic_variable<Allocator, MapPolicy>>,
+    basic_variable<Allocator, MapPolicy>>
 {
-    static std::map<Key, basic_variable<Allocator>> into(const basic_variable<Allocator>& map,
+    static std::map<Key, basic_variable<Allocator, MapPolicy>> into(const basic_variable<Allocator, MapPolicy>& map,
                                                          std::error_code& error)
     {
-        std::map<Key, basic_variable<Allocator>> result;
+        std::map<Key, basic_variable<Allocator, MapPolicy>> result;
         for (auto it = map.begin(); it != map.end(); ++it)
         {
             result.emplace(it.key().template value<Key>(error), it.value());
@@ -22,15 +22,15 @@ namespace dynamic
 namespace convert
 {
 
-template <typename Allocator, typename T>
+template <typename Allocator, typename MapPolicy, typename T>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     std::set<T>>
 {
-    static basic_variable<Allocator> into(const std::set<T>& container,
+    static basic_variable<Allocator, MapPolicy> into(const std::set<T>& container,
                                           std::error_code&)
     {
-        auto result = basic_array<Allocator>::make();
+        auto result = basic_array<Allocator, MapPolicy>::make();
         for (const auto& entry : container)
         {
             result += entry;
@@ -39,12 +39,12 @@ struct overloader<
     }
 };
 
-template <typename Allocator, typename T>
+template <typename Allocator, typename MapPolicy, typename T>
 struct overloader<
     std::set<T>,
-    basic_variable<Allocator>>
+    basic_variable<Allocator, MapPolicy>>
 {
-    static std::set<T> into(const basic_variable<Allocator>& container,
+    static std::set<T> into(const basic_variable<Allocator, MapPolicy>& container,
                             std::error_code& error)
     {
         std::set<T> result;
@@ -64,15 +64,15 @@ struct overloader<
 
 // Special case for std::vector<variable>
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 struct overloader<
-    std::set<basic_variable<Allocator>>,
-    basic_variable<Allocator>>
+    std::set<basic_variable<Allocator, MapPolicy>>,
+    basic_variable<Allocator, MapPolicy>>
 {
-    static std::set<basic_variable<Allocator>> into(const basic_variable<Allocator>& container,
+    static std::set<basic_variable<Allocator, MapPolicy>> into(const basic_variable<Allocator, MapPolicy>& container,
                                                     std::error_code&)
     {
-        std::set<basic_variable<Allocator>> result;
+        std::set<basic_variable<Allocator, MapPolicy>> result;
         for (const auto& item : container)
         {
             result.insert(item);
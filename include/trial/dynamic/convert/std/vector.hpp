@@ -22,15 +22,15 @@ namespace dynamic
 namespace convert
 {
 
-template <typename Allocator, typename T>
+template <typename Allocator, typename MapPolicy, typename T>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     std::vector<T>>
 {
-    static basic_variable<Allocator> into(const std::vector<T>& array,
+    static basic_variable<Allocator, MapPolicy> into(const std::vector<T>& array,
                                           std::error_code&)
     {
-        auto result = basic_array<Allocator>::make();
+        auto result = basic_array<Allocator, MapPolicy>::make();
         for (const auto& entry : array)
         {
             result += entry;
@@ -39,12 +39,12 @@ struct overloader<
     }
 };
 
-template <typename Allocator, typename T>
+template <typename Allocator, typename MapPolicy, typename T>
 struct overloader<
     std::vector<T>,
-    basic_variable<Allocator>>
+    basic_variable<Allocator, MapPolicy>>
 {
-    static std::vector<T> into(const basic_variable<Allocator>& array,
+    static std::vector<T> into(const basic_variable<Allocator, MapPolicy>& array,
                                std::error_code& error)
     {
         std::vector<T> result;
@@ -65,15 +65,15 @@ struct overloader<
 
 // Special case for std::vector<variable>
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 struct overloader<
-    std::vector<basic_variable<Allocator>>,
-    basic_variable<Allocator>>
+    std::vector<basic_variable<Allocator, MapPolicy>>,
+    basic_variable<Allocator, MapPolicy>>
 {
-    static std::vector<basic_variable<Allocator>> into(const basic_variable<Allocator>& array,
+    static std::vector<basic_variable<Allocator, MapPolicy>> into(const basic_variable<Allocator, MapPolicy>& array,
                                                        std::error_code&)
     {
-        std::vector<basic_variable<Allocator>> result;
+        std::vector<basic_variable<Allocator, MapPolicy>> result;
         result.reserve(array.size());
         for (const auto& item : array)
         {
@@ -0,0 +1,196 @@
+#ifndef TRIAL_DYNAMIC_DETAIL_ARENA_IPP
+#define TRIAL_DYNAMIC_DETAIL_ARENA_IPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+namespace trial
+{
+namespace dynamic
+{
+
+//-----------------------------------------------------------------------------
+// arena
+//-----------------------------------------------------------------------------
+
+inline arena::arena(std::size_t block_size) noexcept
+    : head(nullptr),
+      cursor(nullptr),
+      limit(nullptr),
+      first_size(block_size > 0 ? block_size : 1),
+      next_size(first_size),
+      total(0)
+{
+}
+
+inline arena::~arena()
+{
+    release();
+}
+
+inline void *arena::allocate(std::size_t size, std::size_t alignment)
+{
+    assert((alignment & (alignment - 1)) == 0);
+
+    const auto address = reinterpret_cast<std::uintptr_t>(cursor);
+    const auto padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+    if ((cursor != nullptr) && (std::size_t(limit - cursor) >= padding) && (std::size_t(limit - cursor) - padding >= size))
+    {
+        void *result = cursor + padding;
+        cursor += padding + size;
+        return result;
+    }
+    return allocate_block(size, alignment);
+}
+
+inline void *arena::allocate_block(std::size_t size, std::size_t alignment)
+{
+    // Room for the block header, worst-case padding, and the requested size
+    if (size > std::numeric_limits<std::size_t>::max() - sizeof(block) - alignment)
+        throw std::bad_alloc();
+    const std::size_t required = sizeof(block) + alignment + size;
+    while (next_size < required)
+    {
+        if (next_size > std::numeric_limits<std::size_t>::max() / 2)
+        {
+            next_size = required;
+            break;
+        }
+        next_size *= 2;
+    }
+
+    auto entry = static_cast<block *>(::operator new(next_size));
+    entry->next = head;
+    entry->size = next_size;
+    head = entry;
+    total += next_size;
+    cursor = reinterpret_cast<char *>(entry) + sizeof(block);
+    limit = reinterpret_cast<char *>(entry) + next_size;
+    if (next_size <= std::numeric_limits<std::size_t>::max() / 2)
+    {
+        next_size *= 2;
+    }
+    return allocate(size, alignment);
+}
+
+inline void arena::release() noexcept
+{
+    while (head)
+    {
+        block *next = head->next;
+        ::operator delete(head);
+        head = next;
+    }
+    cursor = nullptr;
+    limit = nullptr;
+    next_size = first_size;
+    total = 0;
+}
+
+inline std::size_t arena::capacity() const noexcept
+{
+    return total;
+}
+
+inline arena *& arena::active() noexcept
+{
+    static thread_local arena *instance = nullptr;
+    return instance;
+}
+
+inline arena *arena::current() noexcept
+{
+    return active();
+}
+
+//-----------------------------------------------------------------------------
+// arena::scope
+//-----------------------------------------------------------------------------
+
+inline arena::scope::scope(arena& region) noexcept
+    : previous(arena::active())
+{
+    arena::active() = &region;
+}
+
+inline arena::scope::~scope()
+{
+    arena::active() = previous;
+}
+
+//-----------------------------------------------------------------------------
+// arena_allocator
+//-----------------------------------------------------------------------------
+
+template <typename T>
+arena_allocator<T>::arena_allocator() noexcept
+    : region(arena::current())
+{
+}
+
+template <typename T>
+arena_allocator<T>::arena_allocator(arena& other) noexcept
+    : region(&other)
+{
+}
+
+template <typename T>
+template <typename U>
+arena_allocator<T>::arena_allocator(const arena_allocator<U>& other) noexcept
+    : region(other.resource())
+{
+}
+
+template <typename T>
+T *arena_allocator<T>::allocate(std::size_t count)
+{
+    if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        throw std::bad_alloc();
+    if (region)
+        return static_cast<T *>(region->allocate(count * sizeof(T), alignof(T)));
+    return static_cast<T *>(::operator new(count * sizeof(T)));
+}
+
+template <typename T>
+void arena_allocator<T>::deallocate(T *pointer, std::size_t) noexcept
+{
+    if (!region)
+    {
+        ::operator delete(pointer);
+    }
+}
+
+template <typename T>
+arena *arena_allocator<T>::resource() const noexcept
+{
+    return region;
+}
+
+template <typename T, typename U>
+bool operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept
+{
+    return lhs.resource() == rhs.resource();
+}
+
+template <typename T, typename U>
+bool operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+} // namespace dynamic
+} // namespace trial
+
+#endif // TRIAL_DYNAMIC_DETAIL_ARENA_IPP
@@ -0,0 +1,155 @@
+#ifndef TRIAL_DYNAMIC_DETAIL_FLAT_MAP_HPP
+#define TRIAL_DYNAMIC_DETAIL_FLAT_MAP_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace trial
+{
+namespace dynamic
+{
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+// flat_map
+//-----------------------------------------------------------------------------
+
+// Associative container stored as a vector of pairs sorted by key.
+//
+// Lookup is a binary search over contiguous memory, and the whole container
+// is a single allocation. Insertion and erasure move subsequent elements,
+// and invalidate iterators.
+//
+// Unlike std::map, the key of value_type is not const. Keys must not be
+// modified through iterators.
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+class flat_map
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using key_compare = Compare;
+    using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+
+private:
+    using container_type = std::vector<value_type, allocator_type>;
+
+public:
+    using size_type = typename container_type::size_type;
+    using difference_type = typename container_type::difference_type;
+    using reference = typename container_type::reference;
+    using const_reference = typename container_type::const_reference;
+    using pointer = typename container_type::pointer;
+    using const_pointer = typename container_type::const_pointer;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+    using reverse_iterator = typename container_type::reverse_iterator;
+    using const_reverse_iterator = typename container_type::const_reverse_iterator;
+
+    flat_map() = default;
+    explicit flat_map(const allocator_type&);
+    template <typename InputIterator>
+    flat_map(InputIterator first, InputIterator last, const allocator_type& = allocator_type());
+    flat_map(std::initializer_list<value_type>, const allocator_type& = allocator_type());
+    flat_map(const flat_map&) = default;
+    flat_map(flat_map&&) = default;
+    flat_map& operator=(const flat_map&) = default;
+    flat_map& operator=(flat_map&&) = default;
+
+    allocator_type get_allocator() const noexcept { return data.get_allocator(); }
+    key_compare key_comp() const { return key_compare(); }
+
+    // Iterators
+
+    iterator begin() noexcept { return data.begin(); }
+    const_iterator begin() const noexcept { return data.begin(); }
+    const_iterator cbegin() const noexcept { return data.cbegin(); }
+    iterator end() noexcept { return data.end(); }
+    const_iterator end() const noexcept { return data.end(); }
+    const_iterator cend() const noexcept { return data.cend(); }
+    reverse_iterator rbegin() noexcept { return data.rbegin(); }
+    const_reverse_iterator rbegin() const noexcept { return data.rbegin(); }
+    reverse_iterator rend() noexcept { return data.rend(); }
+    const_reverse_iterator rend() const noexcept { return data.rend(); }
+
+    // Capacity
+
+    bool empty() const noexcept { return data.empty(); }
+    size_type size() const noexcept { return data.size(); }
+    size_type max_size() const noexcept { return data.max_size(); }
+    size_type capacity() const noexcept { return data.capacity(); }
+    void reserve(size_type size) { data.reserve(size); }
+
+    // Element access
+
+    mapped_type& operator[](const key_type&);
+    mapped_type& operator[](key_type&&);
+    mapped_type& at(const key_type&);
+    const mapped_type& at(const key_type&) const;
+
+    // Modifiers
+
+    void clear() noexcept { data.clear(); }
+    std::pair<iterator, bool> insert(const value_type&);
+    std::pair<iterator, bool> insert(value_type&&);
+    iterator insert(const_iterator hint, const value_type&);
+    iterator insert(const_iterator hint, value_type&&);
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last);
+    void insert(std::initializer_list<value_type>);
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&...);
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&...);
+    iterator erase(const_iterator);
+    iterator erase(const_iterator first, const_iterator last);
+    size_type erase(const key_type&);
+    void swap(flat_map&) noexcept;
+
+    // Lookup
+
+    size_type count(const key_type&) const;
+    iterator find(const key_type&);
+    const_iterator find(const key_type&) const;
+    iterator lower_bound(const key_type&);
+    const_iterator lower_bound(const key_type&) const;
+    iterator upper_bound(const key_type&);
+    const_iterator upper_bound(const key_type&) const;
+
+    friend bool operator==(const flat_map& lhs, const flat_map& rhs) { return lhs.data == rhs.data; }
+    friend bool operator!=(const flat_map& lhs, const flat_map& rhs) { return lhs.data != rhs.data; }
+    friend bool operator<(const flat_map& lhs, const flat_map& rhs) { return lhs.data < rhs.data; }
+
+private:
+    iterator mutable_iterator(const_iterator);
+    template <typename V>
+    std::pair<iterator, bool> insert_unique(V&&);
+    template <typename V>
+    iterator insert_hint(const_iterator, V&&);
+
+    container_type data;
+};
+
+} // namespace detail
+} // namespace dynamic
+} // namespace trial
+
+#include <trial/dynamic/detail/flat_map.ipp>
+
+#endif // TRIAL_DYNAMIC_DETAIL_FLAT_MAP_HPP
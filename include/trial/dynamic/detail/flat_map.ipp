@@ -0,0 +1,290 @@
+#ifndef TRIAL_DYNAMIC_DETAIL_FLAT_MAP_IPP
+#define TRIAL_DYNAMIC_DETAIL_FLAT_MAP_IPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+namespace trial
+{
+namespace dynamic
+{
+namespace detail
+{
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+flat_map<Key, T, Compare, Allocator>::flat_map(const allocator_type& allocator)
+    : data(allocator)
+{
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIterator>
+flat_map<Key, T, Compare, Allocator>::flat_map(InputIterator first,
+                                               InputIterator last,
+                                               const allocator_type& allocator)
+    : data(allocator)
+{
+    insert(first, last);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+flat_map<Key, T, Compare, Allocator>::flat_map(std::initializer_list<value_type> init,
+                                               const allocator_type& allocator)
+    : data(allocator)
+{
+    insert(init.begin(), init.end());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::operator[](const key_type& key) -> mapped_type&
+{
+    auto where = lower_bound(key);
+    if (where == end() || key_comp()(key, where->first))
+    {
+        where = data.emplace(where,
+                             std::piecewise_construct,
+                             std::forward_as_tuple(key),
+                             std::forward_as_tuple());
+    }
+    return where->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::operator[](key_type&& key) -> mapped_type&
+{
+    auto where = lower_bound(key);
+    if (where == end() || key_comp()(key, where->first))
+    {
+        where = data.emplace(where,
+                             std::piecewise_construct,
+                             std::forward_as_tuple(std::move(key)),
+                             std::forward_as_tuple());
+    }
+    return where->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::at(const key_type& key) -> mapped_type&
+{
+    auto where = find(key);
+    if (where == end())
+        throw std::out_of_range("flat_map::at");
+    return where->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::at(const key_type& key) const -> const mapped_type&
+{
+    auto where = find(key);
+    if (where == end())
+        throw std::out_of_range("flat_map::at");
+    return where->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::insert(const value_type& value) -> std::pair<iterator, bool>
+{
+    return insert_unique(value);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::insert(value_type&& value) -> std::pair<iterator, bool>
+{
+    return insert_unique(std::move(value));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::insert(const_iterator hint,
+                                                  const value_type& value) -> iterator
+{
+    return insert_hint(hint, value);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::insert(const_iterator hint,
+                                                  value_type&& value) -> iterator
+{
+    return insert_hint(hint, std::move(value));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIterator>
+void flat_map<Key, T, Compare, Allocator>::insert(InputIterator first,
+                                                  InputIterator last)
+{
+    // Append the new elements, sort them, and merge them into the existing
+    // elements. Both the sort and the merge are stable, so the first of
+    // several equivalent elements is kept, as with std::map.
+    const auto middle = size();
+    for (; first != last; ++first)
+    {
+        data.emplace_back(*first);
+    }
+    const auto less = [] (const value_type& lhs, const value_type& rhs) {
+        return key_compare()(lhs.first, rhs.first);
+    };
+    std::stable_sort(data.begin() + middle, data.end(), less);
+    std::inplace_merge(data.begin(), data.begin() + middle, data.end(), less);
+    const auto same = [] (const value_type& lhs, const value_type& rhs) {
+        return !key_compare()(lhs.first, rhs.first);
+    };
+    data.erase(std::unique(data.begin(), data.end(), same), data.end());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void flat_map<Key, T, Compare, Allocator>::insert(std::initializer_list<value_type> init)
+{
+    insert(init.begin(), init.end());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+auto flat_map<Key, T, Compare, Allocator>::emplace(Args&&... args) -> std::pair<iterator, bool>
+{
+    return insert_unique(value_type(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+auto flat_map<Key, T, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                                        Args&&... args) -> iterator
+{
+    return insert_hint(hint, value_type(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::erase(const_iterator where) -> iterator
+{
+    return data.erase(mutable_iterator(where));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::erase(const_iterator first,
+                                                 const_iterator last) -> iterator
+{
+    return data.erase(mutable_iterator(first), mutable_iterator(last));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::erase(const key_type& key) -> size_type
+{
+    auto where = find(key);
+    if (where == end())
+        return 0;
+    data.erase(where);
+    return 1;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void flat_map<Key, T, Compare, Allocator>::swap(flat_map& other) noexcept
+{
+    data.swap(other.data);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::count(const key_type& key) const -> size_type
+{
+    return (find(key) == end()) ? 0 : 1;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::find(const key_type& key) -> iterator
+{
+    auto where = lower_bound(key);
+    return (where != end() && !key_comp()(key, where->first)) ? where : end();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::find(const key_type& key) const -> const_iterator
+{
+    auto where = lower_bound(key);
+    return (where != end() && !key_comp()(key, where->first)) ? where : end();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::lower_bound(const key_type& key) -> iterator
+{
+    return std::lower_bound(data.begin(), data.end(), key,
+                            [] (const value_type& lhs, const key_type& rhs) {
+                                return key_compare()(lhs.first, rhs);
+                            });
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::lower_bound(const key_type& key) const -> const_iterator
+{
+    return std::lower_bound(data.begin(), data.end(), key,
+                            [] (const value_type& lhs, const key_type& rhs) {
+                                return key_compare()(lhs.first, rhs);
+                            });
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::upper_bound(const key_type& key) -> iterator
+{
+    return std::upper_bound(data.begin(), data.end(), key,
+                            [] (const key_type& lhs, const value_type& rhs) {
+                                return key_compare()(lhs, rhs.first);
+                            });
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::upper_bound(const key_type& key) const -> const_iterator
+{
+    return std::upper_bound(data.begin(), data.end(), key,
+                            [] (const key_type& lhs, const value_type& rhs) {
+                                return key_compare()(lhs, rhs.first);
+                            });
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+auto flat_map<Key, T, Compare, Allocator>::mutable_iterator(const_iterator where) -> iterator
+{
+    return data.begin() + (where - data.cbegin());
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename V>
+auto flat_map<Key, T, Compare, Allocator>::insert_unique(V&& value) -> std::pair<iterator, bool>
+{
+    // Keys often arrive in sorted order, so try the end first
+    if (empty() || key_comp()(data.back().first, value.first))
+    {
+        data.emplace_back(std::forward<V>(value));
+        return { --data.end(), true };
+    }
+    auto where = lower_bound(value.first);
+    if (where != end() && !key_comp()(value.first, where->first))
+        return { where, false };
+    return { data.insert(where, std::forward<V>(value)), true };
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename V>
+auto flat_map<Key, T, Compare, Allocator>::insert_hint(const_iterator hint, V&& value) -> iterator
+{
+    // Insert before hint if the key belongs there, otherwise ignore hint
+    if ((hint == cend() || key_comp()(value.first, hint->first)) &&
+        (hint == cbegin() || key_comp()((hint - 1)->first, value.first)))
+    {
+        return data.insert(mutable_iterator(hint), std::forward<V>(value));
+    }
+    return insert_unique(std::forward<V>(value)).first;
+}
+
+} // namespace detail
+} // namespace dynamic
+} // namespace trial
+
+#endif // TRIAL_DYNAMIC_DETAIL_FLAT_MAP_IPP
@@ -0,0 +1,171 @@
+#ifndef TRIAL_DYNAMIC_DETAIL_HASH_MAP_HPP
+#define TRIAL_DYNAMIC_DETAIL_HASH_MAP_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace trial
+{
+namespace dynamic
+{
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+// hash_map
+//-----------------------------------------------------------------------------
+
+// Associative container with open addressing.
+//
+// Elements are stored contiguously in insertion order, and are located via
+// a separate table of slots using linear probing. Each slot holds the
+// position of an element and part of its hash value, so probing rarely
+// compares keys and growing the table never rehashes keys.
+//
+// Insertion at the end is amortized constant time. Erasure moves subsequent
+// elements and renumbers their slots, so erasing the last element is constant
+// time. Both invalidate iterators.
+//
+// Unlike std::map, the key of value_type is not const. Keys must not be
+// modified through iterators.
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+class hash_map
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+
+private:
+    using container_type = std::vector<value_type, allocator_type>;
+
+    struct slot
+    {
+        // Position of element plus one, or zero if the slot is empty
+        std::uint32_t position;
+        std::uint32_t fragment;
+    };
+    using slot_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<slot>;
+    using table_type = std::vector<slot, slot_allocator_type>;
+
+public:
+    using size_type = typename container_type::size_type;
+    using difference_type = typename container_type::difference_type;
+    using reference = typename container_type::reference;
+    using const_reference = typename container_type::const_reference;
+    using pointer = typename container_type::pointer;
+    using const_pointer = typename container_type::const_pointer;
+    using iterator = typename container_type::iterator;
+    using const_iterator = typename container_type::const_iterator;
+
+    hash_map() = default;
+    explicit hash_map(const allocator_type&);
+    template <typename InputIterator>
+    hash_map(InputIterator first, InputIterator last, const allocator_type& = allocator_type());
+    hash_map(std::initializer_list<value_type>, const allocator_type& = allocator_type());
+    hash_map(const hash_map&) = default;
+    hash_map(hash_map&&) = default;
+    hash_map& operator=(const hash_map&) = default;
+    hash_map& operator=(hash_map&&) = default;
+
+    allocator_type get_allocator() const noexcept { return data.get_allocator(); }
+    hasher hash_function() const { return hasher(); }
+    key_equal key_eq() const { return key_equal(); }
+
+    // Iterators
+
+    iterator begin() noexcept { return data.begin(); }
+    const_iterator begin() const noexcept { return data.begin(); }
+    const_iterator cbegin() const noexcept { return data.cbegin(); }
+    iterator end() noexcept { return data.end(); }
+    const_iterator end() const noexcept { return data.end(); }
+    const_iterator cend() const noexcept { return data.cend(); }
+
+    // Capacity
+
+    bool empty() const noexcept { return data.empty(); }
+    size_type size() const noexcept { return data.size(); }
+    size_type max_size() const noexcept;
+    void reserve(size_type);
+
+    // Element access
+
+    mapped_type& operator[](const key_type&);
+    mapped_type& operator[](key_type&&);
+    mapped_type& at(const key_type&);
+    const mapped_type& at(const key_type&) const;
+
+    // Modifiers
+
+    void clear() noexcept;
+    std::pair<iterator, bool> insert(const value_type&);
+    std::pair<iterator, bool> insert(value_type&&);
+    iterator insert(const_iterator hint, const value_type&);
+    iterator insert(const_iterator hint, value_type&&);
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last);
+    void insert(std::initializer_list<value_type>);
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&...);
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&...);
+    iterator erase(const_iterator);
+    iterator erase(const_iterator first, const_iterator last);
+    size_type erase(const key_type&);
+    void swap(hash_map&) noexcept;
+
+    // Lookup
+
+    size_type count(const key_type&) const;
+    iterator find(const key_type&);
+    const_iterator find(const key_type&) const;
+
+    // Equal if both contain the same elements regardless of order
+    friend bool operator==(const hash_map& lhs, const hash_map& rhs) { return lhs.equal(rhs); }
+    friend bool operator!=(const hash_map& lhs, const hash_map& rhs) { return !lhs.equal(rhs); }
+    // Lexicographical order of elements sorted by key, which agrees with equality
+    friend bool operator<(const hash_map& lhs, const hash_map& rhs) { return lhs.less(rhs); }
+
+private:
+    static std::uint32_t fragment_of(const key_type&);
+    std::size_t locate(const key_type&, std::uint32_t) const;
+    std::size_t locate_position(std::size_t, std::uint32_t) const;
+    void grow();
+    void rehash(size_type);
+    template <typename K>
+    mapped_type& subscript(K&&);
+    template <typename V>
+    std::pair<iterator, bool> insert_value(V&&);
+    bool equal(const hash_map&) const;
+    bool less(const hash_map&) const;
+    std::vector<const value_type *> sorted() const;
+
+    container_type data;
+    table_type table;
+};
+
+} // namespace detail
+} // namespace dynamic
+} // namespace trial
+
+#include <trial/dynamic/detail/hash_map.ipp>
+
+#endif // TRIAL_DYNAMIC_DETAIL_HASH_MAP_HPP
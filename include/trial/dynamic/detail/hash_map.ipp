@@ -0,0 +1,434 @@
+#ifndef TRIAL_DYNAMIC_DETAIL_HASH_MAP_IPP
+#define TRIAL_DYNAMIC_DETAIL_HASH_MAP_IPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+namespace trial
+{
+namespace dynamic
+{
+namespace detail
+{
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+hash_map<Key, T, Hash, KeyEqual, Allocator>::hash_map(const allocator_type& allocator)
+    : data(allocator),
+      table(slot_allocator_type(allocator))
+{
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+template <typename InputIterator>
+hash_map<Key, T, Hash, KeyEqual, Allocator>::hash_map(InputIterator first,
+                                                      InputIterator last,
+                                                      const allocator_type& allocator)
+    : data(allocator),
+      table(slot_allocator_type(allocator))
+{
+    insert(first, last);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+hash_map<Key, T, Hash, KeyEqual, Allocator>::hash_map(std::initializer_list<value_type> init,
+                                                      const allocator_type& allocator)
+    : data(allocator),
+      table(slot_allocator_type(allocator))
+{
+    insert(init.begin(), init.end());
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::max_size() const noexcept -> size_type
+{
+    // Positions are stored with an offset of one in 32-bit slots
+    return std::min<size_type>(data.max_size(),
+                               std::numeric_limits<std::uint32_t>::max() / 2);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void hash_map<Key, T, Hash, KeyEqual, Allocator>::reserve(size_type size)
+{
+    data.reserve(size);
+    if (size * 2 > table.size())
+    {
+        rehash(size);
+    }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::operator[](const key_type& key) -> mapped_type&
+{
+    return subscript(key);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::operator[](key_type&& key) -> mapped_type&
+{
+    return subscript(std::move(key));
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::at(const key_type& key) -> mapped_type&
+{
+    auto where = find(key);
+    if (where == end())
+        throw std::out_of_range("hash_map::at");
+    return where->second;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::at(const key_type& key) const -> const mapped_type&
+{
+    auto where = find(key);
+    if (where == end())
+        throw std::out_of_range("hash_map::at");
+    return where->second;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void hash_map<Key, T, Hash, KeyEqual, Allocator>::clear() noexcept
+{
+    data.clear();
+    table.clear();
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::insert(const value_type& value) -> std::pair<iterator, bool>
+{
+    return insert_value(value);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::insert(value_type&& value) -> std::pair<iterator, bool>
+{
+    return insert_value(std::move(value));
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::insert(const_iterator,
+                                                         const value_type& value) -> iterator
+{
+    return insert_value(value).first;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::insert(const_iterator,
+                                                         value_type&& value) -> iterator
+{
+    return insert_value(std::move(value)).first;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+template <typename InputIterator>
+void hash_map<Key, T, Hash, KeyEqual, Allocator>::insert(InputIterator first,
+                                                         InputIterator last)
+{
+    for (; first != last; ++first)
+    {
+        insert_value(*first);
+    }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void hash_map<Key, T, Hash, KeyEqual, Allocator>::insert(std::initializer_list<value_type> init)
+{
+    insert(init.begin(), init.end());
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+template <typename... Args>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::emplace(Args&&... args) -> std::pair<iterator, bool>
+{
+    return insert_value(value_type(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+template <typename... Args>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::emplace_hint(const_iterator,
+                                                               Args&&... args) -> iterator
+{
+    return insert_value(value_type(std::forward<Args>(args)...)).first;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::erase(const_iterator where) -> iterator
+{
+    const auto position = std::uint32_t(where - data.cbegin()) + 1;
+    const std::size_t mask = table.size() - 1;
+
+    // Backward shift deletion keeps probe sequences unbroken
+    std::size_t hole = locate(where->first, fragment_of(where->first));
+    for (std::size_t current = (hole + 1) & mask;
+         table[current].position != 0;
+         current = (current + 1) & mask)
+    {
+        const std::size_t home = table[current].fragment & mask;
+        const bool movable = (hole <= current)
+            ? ((home <= hole) || (home > current))
+            : ((home <= hole) && (home > current));
+        if (movable)
+        {
+            table[hole] = table[current];
+            hole = current;
+        }
+    }
+    table[hole].position = 0;
+
+    // Only the subsequent elements move, so only their slots are renumbered
+    for (auto index = std::size_t(position); index < data.size(); ++index)
+    {
+        --table[locate_position(index + 1, fragment_of(data[index].first))].position;
+    }
+    return data.erase(data.begin() + (position - 1));
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::erase(const_iterator first,
+                                                        const_iterator last) -> iterator
+{
+    const auto offset = first - data.cbegin();
+    if (first == last)
+        return data.begin() + offset;
+    if ((first == data.cbegin()) && (last == data.cend()))
+    {
+        clear();
+        return data.begin();
+    }
+
+    // Renumber the table in a single pass and rebuild it once, instead of
+    // a backward shift deletion per element
+    const auto lower = std::uint32_t(offset) + 1;
+    const auto upper = std::uint32_t(last - data.cbegin()) + 1;
+    const auto count = upper - lower;
+    for (auto& entry : table)
+    {
+        if (entry.position >= upper)
+        {
+            entry.position -= count;
+        }
+        else if (entry.position >= lower)
+        {
+            entry.position = 0;
+        }
+    }
+    auto result = data.erase(first, last);
+    rehash(size());
+    return result;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::erase(const key_type& key) -> size_type
+{
+    auto where = find(key);
+    if (where == end())
+        return 0;
+    erase(where);
+    return 1;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void hash_map<Key, T, Hash, KeyEqual, Allocator>::swap(hash_map& other) noexcept
+{
+    data.swap(other.data);
+    table.swap(other.table);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::count(const key_type& key) const -> size_type
+{
+    return (find(key) == end()) ? 0 : 1;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::find(const key_type& key) -> iterator
+{
+    if (table.empty())
+        return end();
+    const auto position = table[locate(key, fragment_of(key))].position;
+    return (position == 0) ? end() : data.begin() + (position - 1);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::find(const key_type& key) const -> const_iterator
+{
+    if (table.empty())
+        return end();
+    const auto position = table[locate(key, fragment_of(key))].position;
+    return (position == 0) ? end() : data.begin() + (position - 1);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+std::uint32_t hash_map<Key, T, Hash, KeyEqual, Allocator>::fragment_of(const key_type& key)
+{
+    // Mix all bits into the lower half (MurmurHash3 finalizer)
+    std::uint64_t value = hasher()(key);
+    value ^= value >> 33;
+    value *= UINT64_C(0xFF51AFD7ED558CCD);
+    value ^= value >> 33;
+    value *= UINT64_C(0xC4CEB9FE1A85EC53);
+    value ^= value >> 33;
+    return std::uint32_t(value);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+std::size_t hash_map<Key, T, Hash, KeyEqual, Allocator>::locate(const key_type& key,
+                                                               std::uint32_t fragment) const
+{
+    // Returns slot containing key, or the empty slot where key belongs
+    const std::size_t mask = table.size() - 1;
+    std::size_t current = fragment & mask;
+    while (true)
+    {
+        const auto& entry = table[current];
+        if (entry.position == 0)
+            return current;
+        if ((entry.fragment == fragment) && key_equal()(data[entry.position - 1].first, key))
+            return current;
+        current = (current + 1) & mask;
+    }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+std::size_t hash_map<Key, T, Hash, KeyEqual, Allocator>::locate_position(std::size_t position,
+                                                                        std::uint32_t fragment) const
+{
+    // Returns slot containing position, which must be present
+    const std::size_t mask = table.size() - 1;
+    std::size_t current = fragment & mask;
+    while (table[current].position != position)
+    {
+        current = (current + 1) & mask;
+    }
+    return current;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void hash_map<Key, T, Hash, KeyEqual, Allocator>::grow()
+{
+    // Keep load factor at most one half
+    if ((size() + 1) * 2 > table.size())
+    {
+        if (size() >= max_size())
+            throw std::length_error("hash_map");
+        rehash(size() + 1);
+    }
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+void hash_map<Key, T, Hash, KeyEqual, Allocator>::rehash(size_type size)
+{
+    std::size_t capacity = 8;
+    while (capacity < size * 2)
+    {
+        capacity *= 2;
+    }
+    table_type other(capacity, slot{0, 0}, table.get_allocator());
+    const std::size_t mask = capacity - 1;
+    for (const auto& entry : table)
+    {
+        if (entry.position == 0)
+            continue;
+        std::size_t current = entry.fragment & mask;
+        while (other[current].position != 0)
+        {
+            current = (current + 1) & mask;
+        }
+        other[current] = entry;
+    }
+    table.swap(other);
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+template <typename K>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::subscript(K&& key) -> mapped_type&
+{
+    grow();
+    const auto fragment = fragment_of(key);
+    auto& entry = table[locate(key, fragment)];
+    if (entry.position == 0)
+    {
+        data.emplace_back(std::piecewise_construct,
+                          std::forward_as_tuple(std::forward<K>(key)),
+                          std::forward_as_tuple());
+        entry = slot{ std::uint32_t(data.size()), fragment };
+    }
+    return data[entry.position - 1].second;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+template <typename V>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::insert_value(V&& value) -> std::pair<iterator, bool>
+{
+    grow();
+    const auto fragment = fragment_of(value.first);
+    auto& entry = table[locate(value.first, fragment)];
+    if (entry.position != 0)
+        return { data.begin() + (entry.position - 1), false };
+    data.emplace_back(std::forward<V>(value));
+    entry = slot{ std::uint32_t(data.size()), fragment };
+    return { --data.end(), true };
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+bool hash_map<Key, T, Hash, KeyEqual, Allocator>::equal(const hash_map& other) const
+{
+    if (size() != other.size())
+        return false;
+    for (const auto& element : data)
+    {
+        auto where = other.find(element.first);
+        if ((where == other.end()) || !(where->second == element.second))
+            return false;
+    }
+    return true;
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+bool hash_map<Key, T, Hash, KeyEqual, Allocator>::less(const hash_map& other) const
+{
+    // Insertion order differs between equal maps, so compare in key order
+    const auto lhs = sorted();
+    const auto rhs = other.sorted();
+    return std::lexicographical_compare(lhs.begin(), lhs.end(),
+                                        rhs.begin(), rhs.end(),
+                                        [] (const value_type *a, const value_type *b)
+                                        {
+                                            return *a < *b;
+                                        });
+}
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+auto hash_map<Key, T, Hash, KeyEqual, Allocator>::sorted() const -> std::vector<const value_type *>
+{
+    std::vector<const value_type *> result;
+    result.reserve(size());
+    for (const auto& element : data)
+    {
+        result.push_back(&element);
+    }
+    std::sort(result.begin(), result.end(),
+              [] (const value_type *a, const value_type *b)
+              {
+                  return a->first < b->first;
+              });
+    return result;
+}
+
+} // namespace detail
+} // namespace dynamic
+} // namespace trial
+
+#endif // TRIAL_DYNAMIC_DETAIL_HASH_MAP_IPP
@@ -11,6 +11,8 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <cmath>
+#include <functional>
 #include <trial/dynamic/detail/type_traits.hpp>
 #include <trial/dynamic/error.hpp>
 
@@ -64,11 +66,11 @@ struct is_string<std::basic_string<CharT>>
 {
 };
 
-template <typename Allocator, typename T>
-using is_array = std::is_same<T, typename basic_variable<Allocator>::array_type>;
+template <typename Allocator, typename MapPolicy, typename T>
+using is_array = std::is_same<T, typename basic_variable<Allocator, MapPolicy>::array_type>;
 
-template <typename Allocator, typename T>
-using is_map = std::is_same<T, typename basic_variable<Allocator>::map_type>;
+template <typename Allocator, typename MapPolicy, typename T>
+using is_map = std::is_same<T, typename basic_variable<Allocator, MapPolicy>::map_type>;
 
 } // namespace detail
 
@@ -76,112 +78,112 @@ using is_map = std::is_same<T, typename basic_variable<Allocator>::map_type>;
 // variable::traits
 //-----------------------------------------------------------------------------
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-struct basic_variable<Allocator>::traits
+struct basic_variable<Allocator, MapPolicy>::traits
 {
-    static const std::size_t value = decltype(basic_variable<Allocator>::storage)::template to_index<T>::value;
+    static const std::size_t value = decltype(basic_variable<Allocator, MapPolicy>::storage)::template to_index<T>::value;
 };
 
 //-----------------------------------------------------------------------------
 // variable::tag_traits
 //-----------------------------------------------------------------------------
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T, typename>
-struct basic_variable<Allocator>::tag_traits
+struct basic_variable<Allocator, MapPolicy>::tag_traits
 {
     using type = T;
 };
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-struct basic_variable<Allocator>::tag_traits<
+struct basic_variable<Allocator, MapPolicy>::tag_traits<
     T,
     typename std::enable_if<std::is_same<T, nullable>::value>::type>
 {
     using type = nullable;
 };
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-struct basic_variable<Allocator>::tag_traits<
+struct basic_variable<Allocator, MapPolicy>::tag_traits<
     T,
     typename std::enable_if<std::is_same<T, typename dynamic::boolean>::value>::type>
 {
     using type = bool;
 };
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-struct basic_variable<Allocator>::tag_traits<
+struct basic_variable<Allocator, MapPolicy>::tag_traits<
     T,
     typename std::enable_if<std::is_same<T, typename dynamic::integer>::value>::type>
 {
     using type = int;
 };
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-struct basic_variable<Allocator>::tag_traits<
+struct basic_variable<Allocator, MapPolicy>::tag_traits<
     T,
     typename std::enable_if<std::is_same<T, typename dynamic::real>::value>::type>
 {
     using type = double;
 };
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-struct basic_variable<Allocator>::tag_traits<
+struct basic_variable<Allocator, MapPolicy>::tag_traits<
     T,
     typename std::enable_if<std::is_same<T, typename dynamic::string>::value>::type>
 {
-    using type = typename basic_variable<Allocator>::string_type;
+    using type = typename basic_variable<Allocator, MapPolicy>::string_type;
 };
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-struct basic_variable<Allocator>::tag_traits<
+struct basic_variable<Allocator, MapPolicy>::tag_traits<
     T,
     typename std::enable_if<std::is_same<T, typename dynamic::wstring>::value>::type>
 {
-    using type = typename basic_variable<Allocator>::wstring_type;
+    using type = typename basic_variable<Allocator, MapPolicy>::wstring_type;
 };
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-struct basic_variable<Allocator>::tag_traits<
+struct basic_variable<Allocator, MapPolicy>::tag_traits<
     T,
     typename std::enable_if<std::is_same<T, typename dynamic::u16string>::value>::type>
 {
-    using type = typename basic_variable<Allocator>::u16string_type;
+    using type = typename basic_variable<Allocator, MapPolicy>::u16string_type;
 };
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-struct basic_variable<Allocator>::tag_traits<
+struct basic_variable<Allocator, MapPolicy>::tag_traits<
     T,
     typename std::enable_if<std::is_same<T, typename dynamic::u32string>::value>::type>
 {
-    using type = typename basic_variable<Allocator>::u32string_type;
+    using type = typename basic_variable<Allocator, MapPolicy>::u32string_type;
 };
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-struct basic_variable<Allocator>::tag_traits<
+struct basic_variable<Allocator, MapPolicy>::tag_traits<
     T,
     typename std::enable_if<std::is_same<T, typename dynamic::array>::value>::type>
 {
-    using type = typename basic_variable<Allocator>::array_type;
+    using type = typename basic_variable<Allocator, MapPolicy>::array_type;
 };
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-struct basic_variable<Allocator>::tag_traits<
+struct basic_variable<Allocator, MapPolicy>::tag_traits<
     T,
     typename std::enable_if<std::is_same<T, typename dynamic::map>::value>::type>
 {
-    using type = typename basic_variable<Allocator>::map_type;
+    using type = typename basic_variable<Allocator, MapPolicy>::map_type;
 };
 
 //-----------------------------------------------------------------------------
@@ -199,13 +201,13 @@ struct overloader
 
 // Null
 
-template <typename Allocator, typename U>
+template <typename Allocator, typename MapPolicy, typename U>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     U,
     typename std::enable_if<detail::is_null<U>::value>::type>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
     using type = nullable;
     using category_type = type;
 
@@ -248,15 +250,15 @@ struct overloader<
 
 // Boolean
 
-template <typename Allocator, typename U>
+template <typename Allocator, typename MapPolicy, typename U>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     U,
     typename std::enable_if<detail::is_boolean<U>::value>::type>
 {
     using type = bool;
     using category_type = type;
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
     using array_type = typename variable_type::array_type;
 
@@ -493,16 +495,16 @@ struct overloader<
 
 // Signed integer
 
-template <typename Allocator, typename U>
+template <typename Allocator, typename MapPolicy, typename U>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     U,
     typename std::enable_if<detail::is_integer<U>::value &&
                             std::is_signed<U>::value>::type>
 {
     using type = U;
     using category_type = int;
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
     using array_type = typename variable_type::array_type;
 
@@ -729,16 +731,16 @@ struct overloader<
 
 // Unsigned integer
 
-template <typename Allocator, typename U>
+template <typename Allocator, typename MapPolicy, typename U>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     U,
     typename std::enable_if<detail::is_integer<U>::value &&
                             std::is_unsigned<U>::value>::type>
 {
     using type = U;
     using category_type = int;
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
     using array_type = typename variable_type::array_type;
 
@@ -965,15 +967,15 @@ struct overloader<
 
 // Floating-point
 
-template <typename Allocator, typename U>
+template <typename Allocator, typename MapPolicy, typename U>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     U,
     typename std::enable_if<detail::is_real<U>::value>::type>
 {
     using type = U;
     using category_type = float;
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
     using array_type = typename variable_type::array_type;
 
@@ -1255,13 +1257,13 @@ struct string_overloader<
 
 // string_type
 
-template <typename Allocator, typename U>
+template <typename Allocator, typename MapPolicy, typename U>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     U,
-    typename std::enable_if<std::is_same<U, typename basic_variable<Allocator>::string_type>::value>::type>
+    typename std::enable_if<std::is_same<U, typename basic_variable<Allocator, MapPolicy>::string_type>::value>::type>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
     using type = typename variable_type::string_type;
     using category_type = type;
 
@@ -1337,13 +1339,13 @@ struct overloader<
 
 // wstring_type
 
-template <typename Allocator, typename U>
+template <typename Allocator, typename MapPolicy, typename U>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     U,
-    typename std::enable_if<std::is_same<U, typename basic_variable<Allocator>::wstring_type>::value>::type>
+    typename std::enable_if<std::is_same<U, typename basic_variable<Allocator, MapPolicy>::wstring_type>::value>::type>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
     using type = typename variable_type::wstring_type;
     using category_type = type;
 
@@ -1418,13 +1420,13 @@ struct overloader<
 
 // u16string_type
 
-template <typename Allocator, typename U>
+template <typename Allocator, typename MapPolicy, typename U>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     U,
-    typename std::enable_if<std::is_same<U, typename basic_variable<Allocator>::u16string_type>::value>::type>
+    typename std::enable_if<std::is_same<U, typename basic_variable<Allocator, MapPolicy>::u16string_type>::value>::type>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
     using type = typename variable_type::u16string_type;
     using category_type = type;
 
@@ -1498,13 +1500,13 @@ struct overloader<
 
 // u32string_type
 
-template <typename Allocator, typename U>
+template <typename Allocator, typename MapPolicy, typename U>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     U,
-    typename std::enable_if<std::is_same<U, typename basic_variable<Allocator>::u32string_type>::value>::type>
+    typename std::enable_if<std::is_same<U, typename basic_variable<Allocator, MapPolicy>::u32string_type>::value>::type>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
     using type = typename variable_type::u32string_type;
     using category_type = type;
 
@@ -1577,13 +1579,13 @@ struct overloader<
 
 // Array
 
-template <typename Allocator, typename U>
+template <typename Allocator, typename MapPolicy, typename U>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     U,
-    typename std::enable_if<detail::is_array<Allocator, U>::value>::type>
+    typename std::enable_if<detail::is_array<Allocator, MapPolicy, U>::value>::type>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
     using type = typename variable_type::array_type;
     using category_type = type;
 
@@ -1672,13 +1674,13 @@ struct overloader<
 
 // Map
 
-template <typename Allocator, typename U>
+template <typename Allocator, typename MapPolicy, typename U>
 struct overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     U,
-    typename std::enable_if<detail::is_map<Allocator, U>::value>::type>
+    typename std::enable_if<detail::is_map<Allocator, MapPolicy, U>::value>::type>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
     using type = typename variable_type::map_type;
     using category_type = type;
 
@@ -1703,12 +1705,7 @@ struct overloader<
         {
         case code::map:
             {
-                const auto& map = self.template assume_value<map_type>();
-                if (map.size() == other.size())
-                {
-                    return std::equal(map.begin(), map.end(), other.begin());
-                }
-                return false;
+                return self.template assume_value<map_type>() == other;
             }
         default:
             return false;
@@ -1776,13 +1773,13 @@ struct operator_overloader
     static_assert_t<T, U> unsupported_type;
 };
 
-template <typename Allocator, typename U>
+template <typename Allocator, typename MapPolicy, typename U>
 struct operator_overloader<
-    basic_variable<Allocator>,
+    basic_variable<Allocator, MapPolicy>,
     U,
-    typename std::enable_if<!std::is_same<U, basic_variable<Allocator> >::value>::type>
+    typename std::enable_if<!std::is_same<U, basic_variable<Allocator, MapPolicy> >::value>::type>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
     using string_type = typename variable_type::string_type;
     using wstring_type = typename variable_type::wstring_type;
     using u16string_type = typename variable_type::u16string_type;
@@ -1843,13 +1840,13 @@ struct operator_overloader<
     }
 };
 
-template <typename T, typename Allocator>
+template <typename T, typename Allocator, typename MapPolicy>
 struct operator_overloader<
     T,
-    basic_variable<Allocator>,
-    typename std::enable_if<!std::is_same<T, basic_variable<Allocator> >::value>::type>
+    basic_variable<Allocator, MapPolicy>,
+    typename std::enable_if<!std::is_same<T, basic_variable<Allocator, MapPolicy> >::value>::type>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
     static bool equal(const T& lhs, const variable_type& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
     {
@@ -1862,12 +1859,12 @@ struct operator_overloader<
     }
 };
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 struct operator_overloader<
-    basic_variable<Allocator>,
-    basic_variable<Allocator>>
+    basic_variable<Allocator, MapPolicy>,
+    basic_variable<Allocator, MapPolicy>>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
     using string_type = typename variable_type::string_type;
     using wstring_type = typename variable_type::wstring_type;
     using u16string_type = typename variable_type::u16string_type;
@@ -2079,18 +2076,19 @@ namespace detail
 //   assert(data.same<float&>(), false);
 //   assert(data.same<const float>(), false);
 
-template <typename Allocator, typename T, typename = void>
+template <typename Allocator, typename MapPolicy, typename T, typename = void>
 struct same_overloader
 {
     static constexpr bool same(std::size_t which) noexcept
     {
-        return which == basic_variable<Allocator>::template traits<T>::value;
+        return which == basic_variable<Allocator, MapPolicy>::template traits<T>::value;
     }
 };
 
-template <typename Allocator, typename T>
+template <typename Allocator, typename MapPolicy, typename T>
 struct same_overloader<
     Allocator,
+    MapPolicy,
     T,
     typename std::enable_if<std::is_const<T>::value ||
                             std::is_volatile<T>::value ||
@@ -2111,10 +2109,10 @@ struct same_overloader<
 namespace detail
 {
 
-template <typename Allocator, typename Iterator, typename = void>
+template <typename Allocator, typename MapPolicy, typename Iterator, typename = void>
 struct iterator_overloader
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
     static void insert(variable_type& self,
                        Iterator begin,
@@ -2123,7 +2121,7 @@ struct iterator_overloader
         switch (self.symbol())
         {
         case symbol::null:
-            self = basic_array<Allocator>::make();
+            self = basic_array<Allocator, MapPolicy>::make();
             goto case_array;
         case symbol::array:
         case_array:
@@ -2159,14 +2157,15 @@ struct iterator_overloader
     }
 };
 
-template <typename Allocator, typename Iterator>
+template <typename Allocator, typename MapPolicy, typename Iterator>
 struct iterator_overloader<
     Allocator,
+    MapPolicy,
     Iterator,
     typename std::enable_if<detail::is_iterator<Iterator>::value &&
                             detail::is_pair<typename Iterator::value_type>::value>::type>
 {
-    using variable_type = basic_variable<Allocator>;
+    using variable_type = basic_variable<Allocator, MapPolicy>;
 
     static void insert(variable_type& self,
                        Iterator begin,
@@ -2210,33 +2209,33 @@ struct iterator_overloader<
 // variable::iterator_base
 //-----------------------------------------------------------------------------
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-basic_variable<Allocator>::iterator_base<Derived, T>::iterator_base()
+basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::iterator_base()
     : scope(nullptr),
       current(pointer(nullptr))
 {
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-basic_variable<Allocator>::iterator_base<Derived, T>::iterator_base(const iterator_base& other)
+basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::iterator_base(const iterator_base& other)
     : scope(other.scope),
       current(other.current)
 {
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-basic_variable<Allocator>::iterator_base<Derived, T>::iterator_base(iterator_base&& other)
+basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::iterator_base(iterator_base&& other)
     : scope(std::move(other.scope)),
       current(std::move(other.current))
 {
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-basic_variable<Allocator>::iterator_base<Derived, T>::iterator_base(pointer p,
+basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::iterator_base(pointer p,
                                                                     bool initialize)
     : scope(p),
       current(pointer(nullptr))
@@ -2274,45 +2273,45 @@ basic_variable<Allocator>::iterator_base<Derived, T>::iterator_base(pointer p,
     }
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-basic_variable<Allocator>::iterator_base<Derived, T>::iterator_base(pointer p,
+basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::iterator_base(pointer p,
                                                                     array_iterator where)
     : scope(p),
       current(where)
 {
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-basic_variable<Allocator>::iterator_base<Derived, T>::iterator_base(pointer p,
+basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::iterator_base(pointer p,
                                                                     map_iterator where)
     : scope(p),
       current(where)
 {
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-auto basic_variable<Allocator>::iterator_base<Derived, T>::operator= (const Derived& other) -> Derived&
+auto basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::operator= (const Derived& other) -> Derived&
 {
     scope = other.scope;
     current = other.current;
     return *static_cast<Derived*>(this);
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-auto basic_variable<Allocator>::iterator_base<Derived, T>::operator= (Derived&& other) -> Derived&
+auto basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::operator= (Derived&& other) -> Derived&
 {
     scope = std::move(other.scope);
     current = std::move(other.current);
     return *static_cast<Derived*>(this);
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-auto basic_variable<Allocator>::iterator_base<Derived, T>::operator++ () -> Derived&
+auto basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::operator++ () -> Derived&
 {
     assert(scope);
 
@@ -2340,9 +2339,9 @@ auto basic_variable<Allocator>::iterator_base<Derived, T>::operator++ () -> Deri
     return *static_cast<Derived*>(this);
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-auto basic_variable<Allocator>::iterator_base<Derived, T>::operator++ (int) -> Derived
+auto basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::operator++ (int) -> Derived
 {
     assert(scope);
 
@@ -2351,9 +2350,9 @@ auto basic_variable<Allocator>::iterator_base<Derived, T>::operator++ (int) -> D
     return result;
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-auto basic_variable<Allocator>::iterator_base<Derived, T>::operator-- () -> Derived&
+auto basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::operator-- () -> Derived&
 {
     assert(scope);
 
@@ -2387,9 +2386,9 @@ auto basic_variable<Allocator>::iterator_base<Derived, T>::operator-- () -> Deri
     return *static_cast<Derived*>(this);
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-auto basic_variable<Allocator>::iterator_base<Derived, T>::operator-- (int) -> Derived
+auto basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::operator-- (int) -> Derived
 {
     assert(scope);
 
@@ -2398,9 +2397,9 @@ auto basic_variable<Allocator>::iterator_base<Derived, T>::operator-- (int) -> D
     return result;
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-auto basic_variable<Allocator>::iterator_base<Derived, T>::key() const -> const_reference
+auto basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::key() const -> const_reference
 {
     assert(scope);
 
@@ -2414,9 +2413,9 @@ auto basic_variable<Allocator>::iterator_base<Derived, T>::key() const -> const_
     }
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-auto basic_variable<Allocator>::iterator_base<Derived, T>::value() -> reference
+auto basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::value() -> reference
 {
     assert(scope);
 
@@ -2441,9 +2440,9 @@ auto basic_variable<Allocator>::iterator_base<Derived, T>::value() -> reference
     TRIAL_DYNAMIC_UNREACHABLE();
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-auto basic_variable<Allocator>::iterator_base<Derived, T>::value() const -> const_reference
+auto basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::value() const -> const_reference
 {
     assert(scope);
 
@@ -2468,9 +2467,9 @@ auto basic_variable<Allocator>::iterator_base<Derived, T>::value() const -> cons
     TRIAL_DYNAMIC_UNREACHABLE();
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-auto basic_variable<Allocator>::iterator_base<Derived, T>::operator-> () const -> pointer
+auto basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::operator-> () const -> pointer
 {
     assert(scope);
 
@@ -2495,9 +2494,9 @@ auto basic_variable<Allocator>::iterator_base<Derived, T>::operator-> () const -
     TRIAL_DYNAMIC_UNREACHABLE();
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Derived, typename T>
-bool basic_variable<Allocator>::iterator_base<Derived, T>::equals(const Derived& other) const
+bool basic_variable<Allocator, MapPolicy>::iterator_base<Derived, T>::equals(const Derived& other) const
 {
     if (!scope)
         return !other.scope;
@@ -2531,46 +2530,46 @@ bool basic_variable<Allocator>::iterator_base<Derived, T>::equals(const Derived&
 // variable::iterator
 //-----------------------------------------------------------------------------
 
-template <typename Allocator>
-basic_variable<Allocator>::iterator::iterator()
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::iterator::iterator()
     : super()
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::iterator::iterator(const iterator& other)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::iterator::iterator(const iterator& other)
     : super(other)
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::iterator::iterator(iterator&& other)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::iterator::iterator(iterator&& other)
     : super(std::move(other))
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::iterator::iterator(pointer p, bool initialize)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::iterator::iterator(pointer p, bool initialize)
     : super(p, initialize)
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::iterator::iterator(pointer p,
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::iterator::iterator(pointer p,
                                               typename super::array_iterator where)
     : super(p, where)
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::iterator::iterator(pointer p,
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::iterator::iterator(pointer p,
                                               typename super::map_iterator where)
     : super(p, where)
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::iterator::iterator(const const_iterator& other)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::iterator::iterator(const const_iterator& other)
     : super(const_cast<pointer>(other.scope))
 {
     switch (other.current.index())
@@ -2587,14 +2586,14 @@ basic_variable<Allocator>::iterator::iterator(const const_iterator& other)
     }
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::iterator::operator= (const iterator& other) -> iterator&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::iterator::operator= (const iterator& other) -> iterator&
 {
     return super::operator=(other);
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::iterator::operator= (iterator&& other) -> iterator&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::iterator::operator= (iterator&& other) -> iterator&
 {
     return super::operator=(std::forward<iterator&&>(other));
 }
@@ -2603,32 +2602,32 @@ auto basic_variable<Allocator>::iterator::operator= (iterator&& other) -> iterat
 // variable::const_iterator
 //-----------------------------------------------------------------------------
 
-template <typename Allocator>
-basic_variable<Allocator>::const_iterator::const_iterator()
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::const_iterator::const_iterator()
     : super()
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::const_iterator::const_iterator(const const_iterator& other)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::const_iterator::const_iterator(const const_iterator& other)
     : super(other)
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::const_iterator::const_iterator(const_iterator&& other)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::const_iterator::const_iterator(const_iterator&& other)
     : super(std::move(other))
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::const_iterator::const_iterator(pointer p, bool initialize)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::const_iterator::const_iterator(pointer p, bool initialize)
     : super(p, initialize)
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::const_iterator::const_iterator(const iterator& other)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::const_iterator::const_iterator(const iterator& other)
     : super(other.scope)
 {
     switch (other.current.index())
@@ -2649,48 +2648,48 @@ basic_variable<Allocator>::const_iterator::const_iterator(const iterator& other)
 // variable::key_iterator
 //-----------------------------------------------------------------------------
 
-template <typename Allocator>
-basic_variable<Allocator>::key_iterator::key_iterator()
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::key_iterator::key_iterator()
     : super()
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::key_iterator::key_iterator(const key_iterator& other)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::key_iterator::key_iterator(const key_iterator& other)
     : super(other),
       index(other.index)
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::key_iterator::key_iterator(key_iterator&& other)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::key_iterator::key_iterator(key_iterator&& other)
 {
     super::scope = std::move(other.scope);
     super::current = std::move(other.current);
     index = std::move(other.index);
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::key_iterator::key_iterator(pointer p, bool initialize)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::key_iterator::key_iterator(pointer p, bool initialize)
     : super(p, initialize),
       index(0)
 {
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::key_iterator::operator= (const key_iterator& other) -> key_iterator&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::key_iterator::operator= (const key_iterator& other) -> key_iterator&
 {
     return super::operator=(other);
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::key_iterator::operator= (key_iterator&& other) -> key_iterator&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::key_iterator::operator= (key_iterator&& other) -> key_iterator&
 {
     return super::operator=(std::forward<key_iterator>(other));
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::key_iterator::key() const -> const_reference
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::key_iterator::key() const -> const_reference
 {
     assert(super::scope);
 
@@ -2713,8 +2712,8 @@ auto basic_variable<Allocator>::key_iterator::key() const -> const_reference
     TRIAL_DYNAMIC_UNREACHABLE();
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::key_iterator::operator++ () -> key_iterator&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::key_iterator::operator++ () -> key_iterator&
 {
     assert(super::scope);
 
@@ -2738,8 +2737,8 @@ auto basic_variable<Allocator>::key_iterator::operator++ () -> key_iterator&
     return super::operator++();
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::key_iterator::base() const -> const_iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::key_iterator::base() const -> const_iterator
 {
     assert(super::scope);
 
@@ -2753,14 +2752,14 @@ auto basic_variable<Allocator>::key_iterator::base() const -> const_iterator
 // storage visitors
 //-----------------------------------------------------------------------------
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-struct basic_variable<Allocator>::similar_visitor
+struct basic_variable<Allocator, MapPolicy>::similar_visitor
 {
     template <typename Which>
     static bool call(const storage_type&)
     {
-        using variable_type = basic_variable<Allocator>;
+        using variable_type = basic_variable<Allocator, MapPolicy>;
         using lhs_type = typename detail::overloader<variable_type, T>::category_type;
         using rhs_type = typename detail::overloader<variable_type, Which>::category_type;
         return std::is_same<lhs_type, rhs_type>::value;
@@ -2771,14 +2770,14 @@ struct basic_variable<Allocator>::similar_visitor
 // variable
 //-----------------------------------------------------------------------------
 
-template <typename Allocator>
-basic_variable<Allocator>::basic_variable()
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::basic_variable()
     : storage(null)
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::basic_variable(const basic_variable& other)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::basic_variable(const basic_variable& other)
     : storage(null)
 {
     switch (other.code())
@@ -2849,8 +2848,8 @@ basic_variable<Allocator>::basic_variable(const basic_variable& other)
     }
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::basic_variable(basic_variable&& other) noexcept
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::basic_variable(basic_variable&& other) noexcept
     : storage(null)
 {
     switch (other.code())
@@ -2922,15 +2921,15 @@ basic_variable<Allocator>::basic_variable(basic_variable&& other) noexcept
     }
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-basic_variable<Allocator>::basic_variable(T value)
+basic_variable<Allocator, MapPolicy>::basic_variable(T value)
     : storage(typename detail::overloader<value_type, typename std::decay<T>::type>::type(std::move(value)))
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::basic_variable(const std::initializer_list<value_type>& init)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::basic_variable(const std::initializer_list<value_type>& init)
     : storage(null)
 {
     if (init.size() == 0)
@@ -2957,62 +2956,62 @@ basic_variable<Allocator>::basic_variable(const std::initializer_list<value_type
     }
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::basic_variable(const nullable&)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::basic_variable(const nullable&)
     : storage(null)
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::basic_variable(const char *value)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::basic_variable(const char *value)
     : storage(string_type(value))
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::basic_variable(const wchar_t *value)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::basic_variable(const wchar_t *value)
     : storage(wstring_type(value))
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::basic_variable(const char16_t *value)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::basic_variable(const char16_t *value)
     : storage(u16string_type(value))
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::basic_variable(const char32_t *value)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::basic_variable(const char32_t *value)
     : storage(u32string_type(value))
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::basic_variable(const typename basic_variable::array_type& value)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::basic_variable(const typename basic_variable::array_type& value)
     : storage(value)
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::basic_variable(typename basic_variable::array_type&& value)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::basic_variable(typename basic_variable::array_type&& value)
     : storage(std::move(value))
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::basic_variable(const typename basic_variable::map_type& value)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::basic_variable(const typename basic_variable::map_type& value)
     : storage(value)
 {
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::basic_variable(typename basic_variable::map_type&& value)
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::basic_variable(typename basic_variable::map_type&& value)
     : storage(std::move(value))
 {
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator= (const basic_variable& other) -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator= (const basic_variable& other) -> basic_variable&
 {
     switch (other.code())
     {
@@ -3083,8 +3082,8 @@ auto basic_variable<Allocator>::operator= (const basic_variable& other) -> basic
     return *this;
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator= (basic_variable&& other) -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator= (basic_variable&& other) -> basic_variable&
 {
     switch (other.code())
     {
@@ -3155,59 +3154,59 @@ auto basic_variable<Allocator>::operator= (basic_variable&& other) -> basic_vari
     return *this;
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-auto basic_variable<Allocator>::operator= (T value) -> basic_variable&
+auto basic_variable<Allocator, MapPolicy>::operator= (T value) -> basic_variable&
 {
     storage = typename detail::overloader<value_type, T>::type{std::move(value)};
     return *this;
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator= (nullable) -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator= (nullable) -> basic_variable&
 {
     storage = null;
     return *this;
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator= (const char *value) -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator= (const char *value) -> basic_variable&
 {
     storage = string_type{value};
     return *this;
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator= (const wchar_t *value) -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator= (const wchar_t *value) -> basic_variable&
 {
     storage = wstring_type{value};
     return *this;
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator= (const char16_t *value) -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator= (const char16_t *value) -> basic_variable&
 {
     storage = u16string_type{value};
     return *this;
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator= (const char32_t *value) -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator= (const char32_t *value) -> basic_variable&
 {
     storage = u32string_type{value};
     return *this;
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-auto basic_variable<Allocator>::operator+= (const T& other) -> basic_variable&
+auto basic_variable<Allocator, MapPolicy>::operator+= (const T& other) -> basic_variable&
 {
     detail::overloader<value_type, T>::append(*this, other);
     return *this;
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator+= (const basic_variable& other) -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator+= (const basic_variable& other) -> basic_variable&
 {
     switch (other.code())
     {
@@ -3299,69 +3298,69 @@ auto basic_variable<Allocator>::operator+= (const basic_variable& other) -> basi
     return *this;
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator+= (const char *other) -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator+= (const char *other) -> basic_variable&
 {
     detail::overloader<value_type, string_type>::append(*this, other);
     return *this;
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator+= (const wchar_t *other) -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator+= (const wchar_t *other) -> basic_variable&
 {
     detail::overloader<value_type, wstring_type>::append(*this, other);
     return *this;
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator+= (const char16_t *other) -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator+= (const char16_t *other) -> basic_variable&
 {
     detail::overloader<value_type, u16string_type>::append(*this, other);
     return *this;
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator+= (const char32_t *other) -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator+= (const char32_t *other) -> basic_variable&
 {
     detail::overloader<value_type, u32string_type>::append(*this, other);
     return *this;
 }
 
-template <typename Allocator, typename U>
-auto operator+ (const basic_variable<Allocator>& lhs, const U& rhs) -> basic_variable<Allocator>
+template <typename Allocator, typename MapPolicy, typename U>
+auto operator+ (const basic_variable<Allocator, MapPolicy>& lhs, const U& rhs) -> basic_variable<Allocator, MapPolicy>
 {
-    basic_variable<Allocator> result(lhs);
+    basic_variable<Allocator, MapPolicy> result(lhs);
     result += rhs;
     return result;
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 auto operator+ (nullable,
-                const basic_variable<Allocator>& rhs) -> basic_variable<Allocator>
+                const basic_variable<Allocator, MapPolicy>& rhs) -> basic_variable<Allocator, MapPolicy>
 {
-    basic_variable<Allocator> result;
+    basic_variable<Allocator, MapPolicy> result;
     result += rhs;
     return result;
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename R>
-basic_variable<Allocator>::operator R() const
+basic_variable<Allocator, MapPolicy>::operator R() const
 {
     return value<R>();
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Tag>
-auto basic_variable<Allocator>::value(std::error_code& error) const noexcept -> typename tag_traits<typename std::decay<Tag>::type>::type
+auto basic_variable<Allocator, MapPolicy>::value(std::error_code& error) const noexcept -> typename tag_traits<typename std::decay<Tag>::type>::type
 {
     using return_type = typename tag_traits<typename std::decay<Tag>::type>::type;
     return detail::overloader<value_type, return_type>::convert(*this, error);
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Tag>
-auto basic_variable<Allocator>::value() const -> typename tag_traits<typename std::decay<Tag>::type>::type
+auto basic_variable<Allocator, MapPolicy>::value() const -> typename tag_traits<typename std::decay<Tag>::type>::type
 {
     std::error_code error;
     auto result = value<Tag>(error);
@@ -3370,24 +3369,24 @@ auto basic_variable<Allocator>::value() const -> typename tag_traits<typename st
     return result;
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename R>
-auto basic_variable<Allocator>::assume_value() & noexcept -> R&
+auto basic_variable<Allocator, MapPolicy>::assume_value() & noexcept -> R&
 {
     assert(same<R>());
     return storage.template get<typename std::decay<R>::type>();
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename R>
-auto basic_variable<Allocator>::assume_value() const & noexcept -> const R&
+auto basic_variable<Allocator, MapPolicy>::assume_value() const & noexcept -> const R&
 {
     assert(same<R>());
     return storage.template get<typename std::decay<R>::type>();
 }
 
-template <typename Allocator>
-basic_variable<Allocator>::operator bool() const
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy>::operator bool() const
 {
     switch (code())
     {
@@ -3436,8 +3435,8 @@ basic_variable<Allocator>::operator bool() const
     TRIAL_DYNAMIC_UNREACHABLE();
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator[] (size_type position) & -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator[] (size_type position) & -> basic_variable&
 {
     switch (symbol())
     {
@@ -3449,8 +3448,8 @@ auto basic_variable<Allocator>::operator[] (size_type position) & -> basic_varia
     }
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator[] (size_type position) const & -> const basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator[] (size_type position) const & -> const basic_variable&
 {
     switch (symbol())
     {
@@ -3462,13 +3461,13 @@ auto basic_variable<Allocator>::operator[] (size_type position) const & -> const
     }
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator[] (const typename map_type::key_type& key) & -> basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator[] (const typename map_type::key_type& key) & -> basic_variable&
 {
     switch (symbol())
     {
     case symbol::null:
-        *this = basic_map<Allocator>::make();
+        *this = basic_map<Allocator, MapPolicy>::make();
         goto case_map;
     case symbol::map:
     case_map:
@@ -3479,8 +3478,8 @@ auto basic_variable<Allocator>::operator[] (const typename map_type::key_type& k
     }
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::operator[] (const typename map_type::key_type& key) const & -> const basic_variable&
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::operator[] (const typename map_type::key_type& key) const & -> const basic_variable&
 {
     switch (symbol())
     {
@@ -3492,23 +3491,23 @@ auto basic_variable<Allocator>::operator[] (const typename map_type::key_type& k
     }
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename Tag>
-bool basic_variable<Allocator>::is() const noexcept
+bool basic_variable<Allocator, MapPolicy>::is() const noexcept
 {
     using tag_type = typename tag_traits<typename std::decay<Tag>::type>::type;
     return storage.template call<similar_visitor<tag_type>, bool>();
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename T>
-bool basic_variable<Allocator>::same() const noexcept
+bool basic_variable<Allocator, MapPolicy>::same() const noexcept
 {
-    return detail::same_overloader<Allocator, T>::same(storage.index());
+    return detail::same_overloader<Allocator, MapPolicy, T>::same(storage.index());
 }
 
-template <typename Allocator>
-dynamic::code::value basic_variable<Allocator>::code() const noexcept
+template <typename Allocator, typename MapPolicy>
+dynamic::code::value basic_variable<Allocator, MapPolicy>::code() const noexcept
 {
     switch (storage.index())
     {
@@ -3560,8 +3559,8 @@ dynamic::code::value basic_variable<Allocator>::code() const noexcept
     }
 }
 
-template <typename Allocator>
-dynamic::symbol::value basic_variable<Allocator>::symbol() const noexcept
+template <typename Allocator, typename MapPolicy>
+dynamic::symbol::value basic_variable<Allocator, MapPolicy>::symbol() const noexcept
 {
     switch (storage.index())
     {
@@ -3602,8 +3601,8 @@ dynamic::symbol::value basic_variable<Allocator>::symbol() const noexcept
     }
 }
 
-template <typename Allocator>
-bool basic_variable<Allocator>::empty() const noexcept
+template <typename Allocator, typename MapPolicy>
+bool basic_variable<Allocator, MapPolicy>::empty() const noexcept
 {
     switch (symbol())
     {
@@ -3625,8 +3624,8 @@ bool basic_variable<Allocator>::empty() const noexcept
     TRIAL_DYNAMIC_UNREACHABLE();
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::size() const noexcept -> size_type
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::size() const noexcept -> size_type
 {
     switch (symbol())
     {
@@ -3648,8 +3647,8 @@ auto basic_variable<Allocator>::size() const noexcept -> size_type
     TRIAL_DYNAMIC_UNREACHABLE();
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::max_size() const noexcept -> size_type
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::max_size() const noexcept -> size_type
 {
     switch (symbol())
     {
@@ -3671,8 +3670,8 @@ auto basic_variable<Allocator>::max_size() const noexcept -> size_type
     TRIAL_DYNAMIC_UNREACHABLE();
 }
 
-template <typename Allocator>
-void basic_variable<Allocator>::clear() noexcept
+template <typename Allocator, typename MapPolicy>
+void basic_variable<Allocator, MapPolicy>::clear() noexcept
 {
     switch (code())
     {
@@ -3754,13 +3753,13 @@ void basic_variable<Allocator>::clear() noexcept
     }
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::insert(basic_variable value) -> iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::insert(basic_variable value) -> iterator
 {
     switch (symbol())
     {
     case symbol::null:
-        *this = basic_array<Allocator>::make();
+        *this = basic_array<Allocator, MapPolicy>::make();
         goto case_array;
     case symbol::array:
     case_array:
@@ -3786,17 +3785,17 @@ auto basic_variable<Allocator>::insert(basic_variable value) -> iterator
     throw dynamic::error(incompatible_type);
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename InputIterator>
-void basic_variable<Allocator>::insert(InputIterator begin,
+void basic_variable<Allocator, MapPolicy>::insert(InputIterator begin,
                                        InputIterator end)
 {
-    return detail::iterator_overloader<Allocator, InputIterator>
+    return detail::iterator_overloader<Allocator, MapPolicy, InputIterator>
         ::insert(*this, std::move(begin), std::move(end));
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::insert(const_iterator where, const basic_variable& value) -> iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::insert(const_iterator where, const basic_variable& value) -> iterator
 {
     switch (symbol())
     {
@@ -3826,18 +3825,18 @@ auto basic_variable<Allocator>::insert(const_iterator where, const basic_variabl
     throw dynamic::error(incompatible_type);
 }
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 template <typename InputIterator>
-void basic_variable<Allocator>::insert(const_iterator where,
+void basic_variable<Allocator, MapPolicy>::insert(const_iterator where,
                                        InputIterator begin,
                                        InputIterator end)
 {
-    return detail::iterator_overloader<Allocator, InputIterator>
+    return detail::iterator_overloader<Allocator, MapPolicy, InputIterator>
         ::insert(*this, std::move(where), std::move(begin), std::move(end));
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::erase(iterator where) -> iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::erase(iterator where) -> iterator
 {
     // The iterator to iterator signature was introduced in C++17 as a
     // resolution to LWG defect 2059.
@@ -3867,8 +3866,8 @@ auto basic_variable<Allocator>::erase(iterator where) -> iterator
     return where;
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::erase(const_iterator where) -> iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::erase(const_iterator where) -> iterator
 {
     // The const_iterator to iterator signature was introduced in C++11 by
     // proposal N2350.
@@ -3900,8 +3899,8 @@ auto basic_variable<Allocator>::erase(const_iterator where) -> iterator
     return result;
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::erase(const_iterator first, const_iterator last) -> iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::erase(const_iterator first, const_iterator last) -> iterator
 {
     using array_iterator = typename basic_variable::const_iterator::array_iterator;
     using map_iterator = typename basic_variable::const_iterator::map_iterator;
@@ -3929,123 +3928,123 @@ auto basic_variable<Allocator>::erase(const_iterator first, const_iterator last)
     return result;
 }
 
-template <typename Allocator>
-void basic_variable<Allocator>::swap(basic_variable& other) noexcept
+template <typename Allocator, typename MapPolicy>
+void basic_variable<Allocator, MapPolicy>::swap(basic_variable& other) noexcept
 {
     using std::swap;
     swap(*this, other);
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::begin() & -> iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::begin() & -> iterator
 {
     return iterator(this);
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::begin() const & -> const_iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::begin() const & -> const_iterator
 {
     return const_iterator(this);
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::cbegin() const & -> const_iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::cbegin() const & -> const_iterator
 {
     return begin();
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::end() & -> iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::end() & -> iterator
 {
     return iterator(this, false);
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::end() const & -> const_iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::end() const & -> const_iterator
 {
     return const_iterator(this, false);
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::cend() const & -> const_iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::cend() const & -> const_iterator
 {
     return end();
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::rbegin() & -> reverse_iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::rbegin() & -> reverse_iterator
 {
     return reverse_iterator(end());
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::rbegin() const & -> const_reverse_iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::rbegin() const & -> const_reverse_iterator
 {
     return const_reverse_iterator(cend());
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::crbegin() const & -> const_reverse_iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::crbegin() const & -> const_reverse_iterator
 {
     return const_reverse_iterator(cend());
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::rend() & -> reverse_iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::rend() & -> reverse_iterator
 {
     return reverse_iterator(begin());
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::rend() const & -> const_reverse_iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::rend() const & -> const_reverse_iterator
 {
     return const_reverse_iterator(cbegin());
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::crend() const & -> const_reverse_iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::crend() const & -> const_reverse_iterator
 {
     return const_reverse_iterator(cbegin());
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::key_begin() const & -> key_iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::key_begin() const & -> key_iterator
 {
     return key_iterator(this);
 }
 
-template <typename Allocator>
-auto basic_variable<Allocator>::key_end() const & -> key_iterator
+template <typename Allocator, typename MapPolicy>
+auto basic_variable<Allocator, MapPolicy>::key_end() const & -> key_iterator
 {
     return key_iterator(this, false);
 }
 
-template <typename Allocator>
-bool basic_variable<Allocator>::is_pair() const
+template <typename Allocator, typename MapPolicy>
+bool basic_variable<Allocator, MapPolicy>::is_pair() const
 {
     return is<array>() && (size() == 2);
 }
 
 // Container comparison operators are noexcept from C++14
 
-template <typename Allocator, typename U>
-auto operator== (const basic_variable<Allocator>& lhs, const U& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
-    -> typename std::enable_if<!std::is_same<U, basic_variable<Allocator>>::value, bool>::type
+template <typename Allocator, typename MapPolicy, typename U>
+auto operator== (const basic_variable<Allocator, MapPolicy>& lhs, const U& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
+    -> typename std::enable_if<!std::is_same<U, basic_variable<Allocator, MapPolicy>>::value, bool>::type
 {
-    return detail::operator_overloader<basic_variable<Allocator>, U>::equal(lhs, rhs);
+    return detail::operator_overloader<basic_variable<Allocator, MapPolicy>, U>::equal(lhs, rhs);
 }
 
-template <typename T, typename Allocator>
-auto operator== (const T& lhs, const basic_variable<Allocator>& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
-    -> typename std::enable_if<!std::is_same<T, basic_variable<Allocator>>::value, bool>::type
+template <typename T, typename Allocator, typename MapPolicy>
+auto operator== (const T& lhs, const basic_variable<Allocator, MapPolicy>& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
+    -> typename std::enable_if<!std::is_same<T, basic_variable<Allocator, MapPolicy>>::value, bool>::type
 {
-    return detail::operator_overloader<T, basic_variable<Allocator>>::equal(lhs, rhs);
+    return detail::operator_overloader<T, basic_variable<Allocator, MapPolicy>>::equal(lhs, rhs);
 }
 
-template <typename Allocator>
-bool operator== (const basic_variable<Allocator>& lhs, const basic_variable<Allocator>& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
+template <typename Allocator, typename MapPolicy>
+bool operator== (const basic_variable<Allocator, MapPolicy>& lhs, const basic_variable<Allocator, MapPolicy>& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
 {
-    return detail::operator_overloader<basic_variable<Allocator>, basic_variable<Allocator>>::equal(lhs, rhs);
+    return detail::operator_overloader<basic_variable<Allocator, MapPolicy>, basic_variable<Allocator, MapPolicy>>::equal(lhs, rhs);
 }
 
 template <typename T, typename U>
@@ -4054,28 +4053,28 @@ bool operator!= (const T& lhs, const U& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
     return !(lhs == rhs);
 }
 
-template <typename Allocator, typename U>
-auto operator< (const basic_variable<Allocator>& lhs, const U& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
-    -> typename std::enable_if<!std::is_same<U, basic_variable<Allocator>>::value, bool>::type
+template <typename Allocator, typename MapPolicy, typename U>
+auto operator< (const basic_variable<Allocator, MapPolicy>& lhs, const U& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
+    -> typename std::enable_if<!std::is_same<U, basic_variable<Allocator, MapPolicy>>::value, bool>::type
 {
-    return detail::operator_overloader<basic_variable<Allocator>, U>::less(lhs, rhs);
+    return detail::operator_overloader<basic_variable<Allocator, MapPolicy>, U>::less(lhs, rhs);
 }
 
-template <typename T, typename Allocator>
-auto operator< (const T& lhs, const basic_variable<Allocator>& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
-    -> typename std::enable_if<!std::is_same<T, basic_variable<Allocator>>::value, bool>::type
+template <typename T, typename Allocator, typename MapPolicy>
+auto operator< (const T& lhs, const basic_variable<Allocator, MapPolicy>& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
+    -> typename std::enable_if<!std::is_same<T, basic_variable<Allocator, MapPolicy>>::value, bool>::type
 {
-    return detail::operator_overloader<T, basic_variable<Allocator>>::less(lhs, rhs);
+    return detail::operator_overloader<T, basic_variable<Allocator, MapPolicy>>::less(lhs, rhs);
 }
 
-template <typename Allocator>
-bool operator< (const basic_variable<Allocator>& lhs, const basic_variable<Allocator>& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
+template <typename Allocator, typename MapPolicy>
+bool operator< (const basic_variable<Allocator, MapPolicy>& lhs, const basic_variable<Allocator, MapPolicy>& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
 {
-    return detail::operator_overloader<basic_variable<Allocator>, basic_variable<Allocator>>::less(lhs, rhs);
+    return detail::operator_overloader<basic_variable<Allocator, MapPolicy>, basic_variable<Allocator, MapPolicy>>::less(lhs, rhs);
 }
 
-template <typename Allocator, typename U>
-bool operator<= (const basic_variable<Allocator>& lhs, const U& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
+template <typename Allocator, typename MapPolicy, typename U>
+bool operator<= (const basic_variable<Allocator, MapPolicy>& lhs, const U& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
 {
     if (lhs.template same<nullable>())
         return true;
@@ -4083,8 +4082,8 @@ bool operator<= (const basic_variable<Allocator>& lhs, const U& rhs) TRIAL_DYNAM
     return !(rhs < lhs);
 }
 
-template <typename Allocator, typename U>
-bool operator> (const basic_variable<Allocator>& lhs, const U& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
+template <typename Allocator, typename MapPolicy, typename U>
+bool operator> (const basic_variable<Allocator, MapPolicy>& lhs, const U& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
 {
     if (lhs.template same<nullable>())
         return false;
@@ -4098,72 +4097,192 @@ bool operator>= (const T& lhs, const U& rhs) TRIAL_DYNAMIC_CXX14(noexcept)
     return !(lhs < rhs);
 }
 
+//-----------------------------------------------------------------------------
+// hash
+//-----------------------------------------------------------------------------
+
+namespace detail
+{
+
+inline std::size_t hash_combine(std::size_t seed, std::size_t value) noexcept
+{
+    return seed ^ (value + 0x9E3779B9 + (seed << 6) + (seed >> 2));
+}
+
+template <typename T>
+std::size_t hash_integer(T value) noexcept
+{
+    // Two's complement representation of value
+    return (value < 0)
+        ? std::size_t(std::uint64_t(std::int64_t(value)))
+        : std::size_t(std::uint64_t(value));
+}
+
+template <typename T>
+std::size_t hash_real(T value) noexcept
+{
+    // Integral reals are hashed as integers to match equality
+    static const long double upper = std::ldexp(1.0L, 64);
+    static const long double lower = -std::ldexp(1.0L, 63);
+    const long double number = value;
+    if ((number == std::trunc(number)) && (number >= lower) && (number < upper))
+    {
+        return (number < 0)
+            ? hash_integer(std::int64_t(number))
+            : hash_integer(std::uint64_t(number));
+    }
+    return std::hash<double>()(double(number));
+}
+
+template <typename String>
+std::size_t hash_string(const String& value) noexcept
+{
+    // FNV-1a over code units
+    std::uint64_t result = UINT64_C(0xCBF29CE484222325);
+    for (auto unit : value)
+    {
+        result ^= std::uint64_t(unit);
+        result *= UINT64_C(0x100000001B3);
+    }
+    return std::size_t(result);
+}
+
+} // namespace detail
+
+template <typename Allocator, typename MapPolicy>
+std::size_t hash<basic_variable<Allocator, MapPolicy>>::operator()(const basic_variable<Allocator, MapPolicy>& self) const
+{
+    using variable_type = basic_variable<Allocator, MapPolicy>;
+
+    switch (self.code())
+    {
+    case code::null:
+        return 0x6E756C6C;
+    case code::boolean:
+        return detail::hash_integer(int(self.template assume_value<bool>()));
+    case code::signed_char:
+        return detail::hash_integer(self.template assume_value<signed char>());
+    case code::unsigned_char:
+        return detail::hash_integer(self.template assume_value<unsigned char>());
+    case code::signed_short_integer:
+        return detail::hash_integer(self.template assume_value<signed short int>());
+    case code::unsigned_short_integer:
+        return detail::hash_integer(self.template assume_value<unsigned short int>());
+    case code::signed_integer:
+        return detail::hash_integer(self.template assume_value<signed int>());
+    case code::unsigned_integer:
+        return detail::hash_integer(self.template assume_value<unsigned int>());
+    case code::signed_long_integer:
+        return detail::hash_integer(self.template assume_value<signed long int>());
+    case code::unsigned_long_integer:
+        return detail::hash_integer(self.template assume_value<unsigned long int>());
+    case code::signed_long_long_integer:
+        return detail::hash_integer(self.template assume_value<signed long long int>());
+    case code::unsigned_long_long_integer:
+        return detail::hash_integer(self.template assume_value<unsigned long long int>());
+    case code::real:
+        return detail::hash_real(self.template assume_value<float>());
+    case code::long_real:
+        return detail::hash_real(self.template assume_value<double>());
+    case code::long_long_real:
+        return detail::hash_real(self.template assume_value<long double>());
+    case code::string:
+        return detail::hash_string(self.template assume_value<typename variable_type::string_type>());
+    case code::wstring:
+        return detail::hash_string(self.template assume_value<typename variable_type::wstring_type>());
+    case code::u16string:
+        return detail::hash_string(self.template assume_value<typename variable_type::u16string_type>());
+    case code::u32string:
+        return detail::hash_string(self.template assume_value<typename variable_type::u32string_type>());
+    case code::array:
+    {
+        std::size_t result = self.size();
+        for (const auto& element : self.template assume_value<typename variable_type::array_type>())
+        {
+            result = detail::hash_combine(result, (*this)(element));
+        }
+        return result;
+    }
+    case code::map:
+    {
+        // Sum is independent of element order
+        std::size_t result = 0;
+        for (const auto& element : self.template assume_value<typename variable_type::map_type>())
+        {
+            result += detail::hash_combine((*this)(element.first), (*this)(element.second));
+        }
+        return detail::hash_combine(self.size(), result);
+    }
+    }
+    TRIAL_DYNAMIC_UNREACHABLE();
+}
+
 //-----------------------------------------------------------------------------
 // Factories
 //-----------------------------------------------------------------------------
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 struct basic_array
 {
-    static basic_variable<Allocator> make()
+    static basic_variable<Allocator, MapPolicy> make()
     {
-        basic_variable<Allocator> result;
-        result.storage = typename basic_variable<Allocator>::array_type{};
+        basic_variable<Allocator, MapPolicy> result;
+        result.storage = typename basic_variable<Allocator, MapPolicy>::array_type{};
         return result;
     }
 
     template <typename ForwardIterator>
-    static basic_variable<Allocator> make(ForwardIterator begin, ForwardIterator end)
+    static basic_variable<Allocator, MapPolicy> make(ForwardIterator begin, ForwardIterator end)
     {
-        basic_variable<Allocator> result;
-        result.storage = typename basic_variable<Allocator>::array_type(begin, end);
+        basic_variable<Allocator, MapPolicy> result;
+        result.storage = typename basic_variable<Allocator, MapPolicy>::array_type(begin, end);
         return result;
     }
 
-    static basic_variable<Allocator> make(std::initializer_list<typename basic_variable<Allocator>::value_type> init)
+    static basic_variable<Allocator, MapPolicy> make(std::initializer_list<typename basic_variable<Allocator, MapPolicy>::value_type> init)
     {
-        basic_variable<Allocator> result;
-        result.storage = typename basic_variable<Allocator>::array_type(init.begin(), init.end());
+        basic_variable<Allocator, MapPolicy> result;
+        result.storage = typename basic_variable<Allocator, MapPolicy>::array_type(init.begin(), init.end());
         return result;
     }
 
     template <typename T>
-    static basic_variable<Allocator> repeat(typename basic_variable<Allocator>::size_type size,
+    static basic_variable<Allocator, MapPolicy> repeat(typename basic_variable<Allocator, MapPolicy>::size_type size,
                                             const T& value)
     {
-        basic_variable<Allocator> result;
-        result.storage = typename basic_variable<Allocator>::array_type(size, basic_variable<Allocator>(value));
+        basic_variable<Allocator, MapPolicy> result;
+        result.storage = typename basic_variable<Allocator, MapPolicy>::array_type(size, basic_variable<Allocator, MapPolicy>(value));
         return result;
     }
 };
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 struct basic_map
 {
-    static basic_variable<Allocator> make()
+    static basic_variable<Allocator, MapPolicy> make()
     {
-        basic_variable<Allocator> result;
-        result.storage = typename basic_variable<Allocator>::map_type{};
+        basic_variable<Allocator, MapPolicy> result;
+        result.storage = typename basic_variable<Allocator, MapPolicy>::map_type{};
         return result;
     }
 
     template <typename T, typename U>
-    static basic_variable<Allocator> make(T key, U value)
+    static basic_variable<Allocator, MapPolicy> make(T key, U value)
     {
         return make({ std::move(key), std::move(value) });
     }
 
-    static basic_variable<Allocator> make(typename basic_variable<Allocator>::pair_type value)
+    static basic_variable<Allocator, MapPolicy> make(typename basic_variable<Allocator, MapPolicy>::pair_type value)
     {
-        basic_variable<Allocator> result;
-        result.storage = typename basic_variable<Allocator>::map_type{std::move(value)};
+        basic_variable<Allocator, MapPolicy> result;
+        result.storage = typename basic_variable<Allocator, MapPolicy>::map_type{std::move(value)};
         return result;
     }
 
-    static basic_variable<Allocator> make(std::initializer_list<typename basic_variable<Allocator>::pair_type> init)
+    static basic_variable<Allocator, MapPolicy> make(std::initializer_list<typename basic_variable<Allocator, MapPolicy>::pair_type> init)
     {
-        basic_variable<Allocator> result;
-        result.storage = typename basic_variable<Allocator>::map_type(init.begin(), init.end());
+        basic_variable<Allocator, MapPolicy> result;
+        result.storage = typename basic_variable<Allocator, MapPolicy>::map_type(init.begin(), init.end());
         return result;
     }
 };
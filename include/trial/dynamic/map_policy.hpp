@@ -0,0 +1,78 @@
+#ifndef TRIAL_DYNAMIC_MAP_POLICY_HPP
+#define TRIAL_DYNAMIC_MAP_POLICY_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <trial/dynamic/detail/flat_map.hpp>
+#include <trial/dynamic/detail/hash_map.hpp>
+
+namespace trial
+{
+namespace dynamic
+{
+
+//! @brief Hash function object for dynamic variables.
+//!
+//! Specialized for basic_variable.
+
+template <typename T> struct hash;
+
+//! @brief Associative arrays as balanced trees.
+//!
+//! Each element is a separate allocation. Iterators remain valid when other
+//! elements are inserted or erased.
+//!
+//! This is the default policy.
+
+struct ordered_map_policy
+{
+    template <typename Key, typename T, typename Allocator>
+    using map_type = std::map<Key,
+                              T,
+                              std::less<Key>,
+                              typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const Key, T>>>;
+};
+
+//! @brief Associative arrays as sorted vectors.
+//!
+//! Elements are stored contiguously in key order, which makes lookup and
+//! iteration cache-friendly and avoids an allocation per element. Insertion
+//! and erasure take linear time and invalidate iterators.
+//!
+//! Suited for the small, read-mostly objects typical of JSON documents.
+
+struct flat_map_policy
+{
+    template <typename Key, typename T, typename Allocator>
+    using map_type = detail::flat_map<Key, T, std::less<Key>, Allocator>;
+};
+
+//! @brief Associative arrays as open-addressing hash tables.
+//!
+//! Lookup takes constant time on average. Elements are iterated in
+//! insertion order, and equality does not depend on order. Insertion and
+//! erasure invalidate iterators, and erasure takes linear time.
+//!
+//! Suited for large, read-mostly objects.
+
+struct hash_map_policy
+{
+    template <typename Key, typename T, typename Allocator>
+    using map_type = detail::hash_map<Key, T, dynamic::hash<Key>, std::equal_to<Key>, Allocator>;
+};
+
+} // namespace dynamic
+} // namespace trial
+
+#endif // TRIAL_DYNAMIC_MAP_POLICY_HPP
@@ -21,6 +21,7 @@
 #include <trial/dynamic/detail/config.hpp>
 #include <trial/dynamic/detail/small_union.hpp>
 #include <trial/dynamic/error.hpp>
+#include <trial/dynamic/map_policy.hpp>
 #include <trial/dynamic/token.hpp>
 
 namespace trial
@@ -35,8 +36,8 @@ namespace detail
 
 template <typename T, typename U, typename> struct overloader;
 template <typename T, typename U, typename> struct operator_overloader;
-template <typename A, typename T, typename> struct same_overloader;
-template <typename A, typename U, typename> struct iterator_overloader;
+template <typename A, typename M, typename T, typename> struct same_overloader;
+template <typename A, typename M, typename U, typename> struct iterator_overloader;
 
 } // namespace detail
 
@@ -48,8 +49,8 @@ struct string {};
 struct wstring {};
 struct u16string {};
 struct u32string {};
-template <typename Allocator> struct basic_array;
-template <typename Allocator> struct basic_map;
+template <typename Allocator, typename MapPolicy = ordered_map_policy> struct basic_array;
+template <typename Allocator, typename MapPolicy = ordered_map_policy> struct basic_map;
 
 //! @brief Dynamic variable.
 //!
@@ -85,8 +86,9 @@ template <typename Allocator> struct basic_map;
 //! `dynamic::map_type`           | `dynamic::map`
 //!
 //! @tparam Allocator Allocator type (defaults to `std::allocator`)
+//! @tparam MapPolicy Associative array implementation (defaults to `dynamic::ordered_map_policy`)
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy = ordered_map_policy>
 class basic_variable
 {
     template <typename T> struct traits;
@@ -95,7 +97,7 @@ class basic_variable
 public:
 #if defined(BOOST_DOXYGEN_INVOKED)
 
-    using value_type = basic_variable<Allocator>;
+    using value_type = basic_variable<Allocator, MapPolicy>;
     using reference = value_type&;
     using const_reference = const value_type&;
     using difference_type = unspecified; //!< signed integer type
@@ -110,7 +112,7 @@ public:
 
 #else
 
-    using value_type = basic_variable<Allocator>;
+    using value_type = basic_variable<Allocator, MapPolicy>;
     using reference = typename std::add_lvalue_reference<value_type>::type;
     using const_reference = typename std::add_const<reference>::type;
     using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
@@ -121,7 +123,6 @@ private:
     using basic_string = std::basic_string<CharT,
                                            typename std::char_traits<CharT>,
                                            typename std::allocator_traits<allocator_type>::template rebind_alloc<CharT>>;
-    using map_value_type = typename std::map<value_type, value_type>::value_type;
 public:
     using string_type = basic_string<char>;
     using wstring_type = basic_string<wchar_t>;
@@ -129,18 +130,15 @@ public:
     using u32string_type = basic_string<char32_t>;
     using array_type = std::vector<value_type,
                                    allocator_type>;
-    using map_type = std::map<value_type,
-                              value_type,
-                              std::less<value_type>,
-                              typename std::allocator_traits<allocator_type>::template rebind_alloc<map_value_type>>;
+    using map_type = typename MapPolicy::template map_type<value_type, value_type, allocator_type>;
     using pair_type = typename map_type::value_type;
 
 #endif
 
 #if !defined(BOOST_DOXYGEN_INVOKED)
 private:
-    friend struct basic_array<Allocator>;
-    friend struct basic_map<Allocator>;
+    friend struct basic_array<Allocator, MapPolicy>;
+    friend struct basic_map<Allocator, MapPolicy>;
 
     template <typename Derived, typename T>
     class iterator_base
@@ -274,7 +272,7 @@ public:
 
     private:
         friend class basic_variable;
-        template <typename A, typename U, typename> friend struct detail::iterator_overloader;
+        template <typename A, typename M, typename U, typename> friend struct detail::iterator_overloader;
 
         explicit const_iterator(pointer p, bool initialize = true);
     };
@@ -978,9 +976,9 @@ private:
 
 private:
     template <typename T, typename U, typename> friend struct detail::overloader;
-    template <typename A, typename U, typename> friend struct detail::iterator_overloader;
+    template <typename A, typename M, typename U, typename> friend struct detail::iterator_overloader;
     template <typename T, typename U, typename> friend struct detail::operator_overloader;
-    template <typename A, typename T, typename> friend struct detail::same_overloader;
+    template <typename A, typename M, typename T, typename> friend struct detail::same_overloader;
     template <typename T> struct similar_visitor;
 
     using index_type = unsigned char;
@@ -1012,11 +1010,23 @@ private:
 #endif
 };
 
-template <typename Allocator, typename U>
-basic_variable<Allocator> operator+ (const basic_variable<Allocator>&, const U&);
+template <typename Allocator, typename MapPolicy, typename U>
+basic_variable<Allocator, MapPolicy> operator+ (const basic_variable<Allocator, MapPolicy>&, const U&);
 
-template <typename Allocator>
-basic_variable<Allocator> operator+ (nullable, const basic_variable<Allocator>&);
+template <typename Allocator, typename MapPolicy>
+basic_variable<Allocator, MapPolicy> operator+ (nullable, const basic_variable<Allocator, MapPolicy>&);
+
+//! @brief Hash function object for dynamic variables.
+//!
+//! Variables with equal values have equal hash values. Numbers are hashed by
+//! value regardless of type, so `1`, `1.0`, and `true` hash alike. Maps are
+//! hashed independently of element order.
+
+template <typename Allocator, typename MapPolicy>
+struct hash<basic_variable<Allocator, MapPolicy>>
+{
+    std::size_t operator()(const basic_variable<Allocator, MapPolicy>&) const;
+};
 
 // Comparison operators defined in variable.ipp
 
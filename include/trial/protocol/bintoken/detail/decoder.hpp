@@ -47,6 +47,7 @@ public:
 
     const view_type& literal() const BOOST_NOEXCEPT;
     const view_type& tail() const BOOST_NOEXCEPT;
+    view_type encoded() const BOOST_NOEXCEPT;
     template <typename Tag> typename Tag::type value() const;
 
     size_type array(token::int8::type *output, size_type output_length);
@@ -74,6 +75,7 @@ private:
     {
         mutable token::code::value code;
         view_type view;
+        const value_type *head;
     } current;
 };
 
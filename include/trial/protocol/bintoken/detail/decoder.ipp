@@ -15,6 +15,7 @@
 #include <cstring> // std::memcpy
 #include <string>
 #include <trial/protocol/buffer/base.hpp>
+#include <trial/protocol/bintoken/detail/endian.hpp>
 
 namespace trial
 {
@@ -136,10 +137,7 @@ struct decoder::overloader<token::int16>
             {
                 auto view = self.literal();
                 const auto size = std::min(view.size() / token::int16::size, output_length);
-                for (size_type i = 0; i < size; ++i)
-                {
-                    output[i] = endian(view_type(&view[i * token::int16::size], token::int16::size));
-                }
+                detail::endian::decode(view.data(), output, size);
                 return size;
             }
 
@@ -151,11 +149,7 @@ struct decoder::overloader<token::int16>
     static return_type endian(const view_type& view)
     {
         assert(view.size() == sizeof(return_type));
-        const std::uint16_t endian = UINT16_C(0x0100);
-        return_type result = 0;
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[0]] = static_cast<std::uint8_t>(view[0]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[1]] = static_cast<std::uint8_t>(view[1]);
-        return result;
+        return detail::endian::decode<return_type>(view.data());
     }
 };
 
@@ -189,10 +183,7 @@ struct decoder::overloader<token::int32>
             {
                 auto view = self.literal();
                 const auto size = std::min(view.size() / token::int32::size, output_length);
-                for (size_type i = 0; i < size; ++i)
-                {
-                    output[i] = endian(view_type(&view[i * token::int32::size], token::int32::size));
-                }
+                detail::endian::decode(view.data(), output, size);
                 return size;
             }
 
@@ -204,13 +195,7 @@ struct decoder::overloader<token::int32>
     static return_type endian(const view_type& view)
     {
         assert(view.size() == sizeof(return_type));
-        const std::uint32_t endian = UINT32_C(0x03020100);
-        return_type result = 0;
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[0]] = static_cast<std::uint8_t>(view[0]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[1]] = static_cast<std::uint8_t>(view[1]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[2]] = static_cast<std::uint8_t>(view[2]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[3]] = static_cast<std::uint8_t>(view[3]);
-        return result;
+        return detail::endian::decode<return_type>(view.data());
     }
 };
 
@@ -244,10 +229,7 @@ struct decoder::overloader<token::int64>
             {
                 auto view = self.literal();
                 const auto size = std::min(view.size() / token::int64::size, output_length);
-                for (size_type i = 0; i < size; ++i)
-                {
-                    output[i] = endian(view_type(&view[i * token::int64::size], token::int64::size));
-                }
+                detail::endian::decode(view.data(), output, size);
                 return size;
             }
 
@@ -259,17 +241,7 @@ struct decoder::overloader<token::int64>
     static return_type endian(const view_type& view)
     {
         assert(view.size() == sizeof(return_type));
-        const std::uint64_t endian = UINT64_C(0x0706050403020100);
-        return_type result = 0;
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[0]] = static_cast<std::uint8_t>(view[0]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[1]] = static_cast<std::uint8_t>(view[1]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[2]] = static_cast<std::uint8_t>(view[2]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[3]] = static_cast<std::uint8_t>(view[3]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[4]] = static_cast<std::uint8_t>(view[4]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[5]] = static_cast<std::uint8_t>(view[5]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[6]] = static_cast<std::uint8_t>(view[6]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[7]] = static_cast<std::uint8_t>(view[7]);
-        return result;
+        return detail::endian::decode<return_type>(view.data());
     }
 };
 
@@ -304,10 +276,7 @@ struct decoder::overloader<token::float32>
             {
                 auto view = self.literal();
                 const auto size = std::min(view.size() / token::float32::size, output_length);
-                for (size_type i = 0; i < size; ++i)
-                {
-                    output[i] = endian(view_type(&view[i * token::float32::size], token::float32::size));
-                }
+                detail::endian::decode(view.data(), output, size);
                 return size;
             }
 
@@ -319,13 +288,7 @@ struct decoder::overloader<token::float32>
     static return_type endian(const view_type& view)
     {
         assert(view.size() == sizeof(return_type));
-        const std::uint32_t endian = UINT32_C(0x03020100);
-        return_type result = 0;
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[0]] = static_cast<std::uint8_t>(view[0]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[1]] = static_cast<std::uint8_t>(view[1]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[2]] = static_cast<std::uint8_t>(view[2]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[3]] = static_cast<std::uint8_t>(view[3]);
-        return result;
+        return detail::endian::decode<return_type>(view.data());
     }
 };
 
@@ -359,10 +322,7 @@ struct decoder::overloader<token::float64>
             {
                 auto view = self.literal();
                 const auto size = std::min(view.size() / token::float64::size, output_length);
-                for (size_type i = 0; i < size; ++i)
-                {
-                    output[i] = endian(view_type(&view[i * token::float64::size], token::float64::size));
-                }
+                detail::endian::decode(view.data(), output, size);
                 return size;
             }
 
@@ -374,17 +334,7 @@ struct decoder::overloader<token::float64>
     static return_type endian(const view_type& view)
     {
         assert(view.size() == sizeof(return_type));
-        const std::uint64_t endian = UINT64_C(0x0706050403020100);
-        return_type result = 0;
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[0]] = static_cast<std::uint8_t>(view[0]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[1]] = static_cast<std::uint8_t>(view[1]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[2]] = static_cast<std::uint8_t>(view[2]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[3]] = static_cast<std::uint8_t>(view[3]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[4]] = static_cast<std::uint8_t>(view[4]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[5]] = static_cast<std::uint8_t>(view[5]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[6]] = static_cast<std::uint8_t>(view[6]);
-        ((volatile std::uint8_t *)&result)[((std::uint8_t *)&endian)[7]] = static_cast<std::uint8_t>(view[7]);
-        return result;
+        return detail::endian::decode<return_type>(view.data());
     }
 };
 
@@ -452,6 +402,11 @@ inline auto decoder::tail() const BOOST_NOEXCEPT -> const view_type&
     return input;
 }
 
+inline auto decoder::encoded() const BOOST_NOEXCEPT -> view_type
+{
+    return view_type(current.head, input.data() - current.head);
+}
+
 template <typename Tag>
 typename Tag::type decoder::value() const
 {
@@ -494,6 +449,7 @@ inline void decoder::next() BOOST_NOEXCEPT
 {
     // FIXME: return if error
 
+    current.head = input.data();
     if (input.empty())
     {
         current.code = token::code::end;
@@ -29,13 +29,18 @@ namespace bintoken
 namespace detail
 {
 
-template <std::size_t N>
+//! @brief Binary token encoder.
+//!
+//! The output buffer is type-erased if Buffer is buffer::base, in which case
+//! the buffer wrapper is stored in N bytes. Otherwise Buffer is the buffer
+//! wrapper itself and the output operations are dispatched statically.
+template <std::size_t N, typename Buffer = buffer::base<std::uint8_t>>
 class basic_encoder
 {
     using value_type = std::uint8_t;
 public:
     using size_type = std::size_t;
-    using buffer_type = buffer::base<value_type>;
+    using buffer_type = Buffer;
     using view_type = core::detail::basic_string_view<value_type, core::char_traits<value_type>>;
     using string_view_type = core::detail::basic_string_view<char, core::char_traits<char>>;
 
@@ -62,6 +67,8 @@ public:
     size_type array(const token::float32::type *, size_type);
     size_type array(const token::float64::type *, size_type);
 
+    bool reserve(size_type);
+
 private:
     template <typename T, typename = void>
     struct overloader;
@@ -73,15 +80,8 @@ private:
     size_type write(value_type);
     size_type write(const view_type&);
 
-    void endian_write(token::int16::type);
-    void endian_write(token::int32::type);
-    void endian_write(token::int64::type);
-    void endian_write(token::float32::type);
-    void endian_write(token::float64::type);
-
-    void endian_write(std::uint16_t);
-    void endian_write(std::uint32_t);
-    void endian_write(std::uint64_t);
+    template <typename T> void endian_write(T);
+    template <typename T> void endian_write(const T *, size_type);
 
     buffer_type& buffer();
     const buffer_type& buffer() const;
@@ -11,10 +11,12 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <limits>
 #include <trial/protocol/buffer/base.hpp>
 #include <trial/protocol/bintoken/token.hpp>
 #include <trial/protocol/bintoken/error.hpp>
+#include <trial/protocol/bintoken/detail/endian.hpp>
 
 namespace trial
 {
@@ -33,106 +35,106 @@ struct static_assert_t;
 // encoder::overloader
 //-----------------------------------------------------------------------------
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T, typename>
-struct basic_encoder<N>::overloader
+struct basic_encoder<N, Buffer>::overloader
 {
     static_assert_t<T> unsupported_type;
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<N>::overloader<
+struct basic_encoder<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::null>::value>::type>
 {
-    using size_type = typename basic_encoder<N>::size_type;
+    using size_type = typename basic_encoder<N, Buffer>::size_type;
 
-    static size_type write(basic_encoder<N>& self)
+    static size_type write(basic_encoder<N, Buffer>& self)
     {
         return self.write(token::null::code);
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<N>::overloader<
+struct basic_encoder<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::begin_record>::value>::type>
 {
-    using size_type = typename basic_encoder<N>::size_type;
+    using size_type = typename basic_encoder<N, Buffer>::size_type;
 
-    static size_type write(basic_encoder<N>& self)
+    static size_type write(basic_encoder<N, Buffer>& self)
     {
         return self.write(token::begin_record::code);
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<N>::overloader<
+struct basic_encoder<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::end_record>::value>::type>
 {
-    using size_type = typename basic_encoder<N>::size_type;
+    using size_type = typename basic_encoder<N, Buffer>::size_type;
 
-    static size_type write(basic_encoder<N>& self)
+    static size_type write(basic_encoder<N, Buffer>& self)
     {
         return self.write(token::end_record::code);
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<N>::overloader<
+struct basic_encoder<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::begin_array>::value>::type>
 {
-    using size_type = typename basic_encoder<N>::size_type;
+    using size_type = typename basic_encoder<N, Buffer>::size_type;
 
-    static size_type write(basic_encoder<N>& self)
+    static size_type write(basic_encoder<N, Buffer>& self)
     {
         return self.write(token::begin_array::code);
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<N>::overloader<
+struct basic_encoder<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::end_array>::value>::type>
 {
-    using size_type = typename basic_encoder<N>::size_type;
+    using size_type = typename basic_encoder<N, Buffer>::size_type;
 
-    static size_type write(basic_encoder<N>& self)
+    static size_type write(basic_encoder<N, Buffer>& self)
     {
         return self.write(token::end_array::code);
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<N>::overloader<
+struct basic_encoder<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::begin_assoc_array>::value>::type>
 {
-    using size_type = typename basic_encoder<N>::size_type;
+    using size_type = typename basic_encoder<N, Buffer>::size_type;
 
-    static size_type write(basic_encoder<N>& self)
+    static size_type write(basic_encoder<N, Buffer>& self)
     {
         return self.write(token::begin_assoc_array::code);
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<N>::overloader<
+struct basic_encoder<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::end_assoc_array>::value>::type>
 {
-    using size_type = typename basic_encoder<N>::size_type;
+    using size_type = typename basic_encoder<N, Buffer>::size_type;
 
-    static size_type write(basic_encoder<N>& self)
+    static size_type write(basic_encoder<N, Buffer>& self)
     {
         return self.write(token::end_assoc_array::code);
     }
@@ -142,37 +144,37 @@ struct basic_encoder<N>::overloader<
 // encoder
 //-----------------------------------------------------------------------------
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-basic_encoder<N>::basic_encoder(T& output)
+basic_encoder<N, Buffer>::basic_encoder(T& output)
 {
-    static_assert(N >= sizeof(typename buffer::traits<T>::buffer_type),
-                  "N is smaller than buffer_type");
+    using wrapper_type = typename buffer::detail::wrapper<buffer_type, T>::type;
+    static_assert(N >= sizeof(wrapper_type), "N is smaller than buffer_type");
 
-    ::new (std::addressof(storage)) typename buffer::traits<T>::buffer_type(output);
+    ::new (std::addressof(storage)) wrapper_type(output);
 }
 
-template <std::size_t N>
-basic_encoder<N>::~basic_encoder()
+template <std::size_t N, typename Buffer>
+basic_encoder<N, Buffer>::~basic_encoder()
 {
     buffer().~buffer_type();
 }
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename U>
-auto basic_encoder<N>::value() -> size_type
+auto basic_encoder<N, Buffer>::value() -> size_type
 {
     return overloader<U>::write(*this);
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::value(bool data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::value(bool data) -> size_type
 {
     return write(data ? token::code::true_value : token::code::false_value);
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::value(token::int8::type data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::value(token::int8::type data) -> size_type
 {
     if (data >= -32)
     {
@@ -192,8 +194,8 @@ auto basic_encoder<N>::value(token::int8::type data) -> size_type
     return 0;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::value(token::int16::type data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::value(token::int16::type data) -> size_type
 {
     const value_type token(token::int16::code);
     const size_type size = sizeof(token) + sizeof(std::int16_t);
@@ -206,8 +208,8 @@ auto basic_encoder<N>::value(token::int16::type data) -> size_type
     return 0;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::value(token::int32::type data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::value(token::int32::type data) -> size_type
 {
     const value_type token(token::int32::code);
     const size_type size = sizeof(token) + sizeof(std::int32_t);
@@ -220,8 +222,8 @@ auto basic_encoder<N>::value(token::int32::type data) -> size_type
     return 0;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::value(token::int64::type data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::value(token::int64::type data) -> size_type
 {
     const value_type token(token::int64::code);
     const size_type size = sizeof(token) + sizeof(std::int64_t);
@@ -234,8 +236,8 @@ auto basic_encoder<N>::value(token::int64::type data) -> size_type
     return 0;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::value(token::float32::type data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::value(token::float32::type data) -> size_type
 {
     // IEEE 754 single precision
     const value_type token(token::float32::code);
@@ -249,8 +251,8 @@ auto basic_encoder<N>::value(token::float32::type data) -> size_type
     return 0;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::value(token::float64::type data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::value(token::float64::type data) -> size_type
 {
     // IEEE 754 double precision
     const value_type token(token::float64::code);
@@ -264,8 +266,8 @@ auto basic_encoder<N>::value(token::float64::type data) -> size_type
     return 0;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::value(const string_view_type& data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::value(const string_view_type& data) -> size_type
 {
     const std::string::size_type length = data.size();
     size_type size = 0;
@@ -304,22 +306,22 @@ auto basic_encoder<N>::value(const string_view_type& data) -> size_type
     return sizeof(value_type) + size + length;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::value(const char *data,
-                             size_type size) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::value(const char *data,
+                                     size_type size) -> size_type
 {
     return value(string_view_type(data, size));
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::value(const char *data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::value(const char *data) -> size_type
 {
     return value(string_view_type(data));
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::array(const token::int8::type *data,
-                             size_type length) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::array(const token::int8::type *data,
+                                     size_type length) -> size_type
 {
     size_type size = 0;
 
@@ -358,9 +360,9 @@ auto basic_encoder<N>::array(const token::int8::type *data,
     return sizeof(value_type) + size + length;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::array(const token::int16::type *data,
-                             size_type length) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::array(const token::int16::type *data,
+                                     size_type length) -> size_type
 {
     size_type size = 0;
     size_type length_size = length * sizeof(*data);
@@ -396,16 +398,13 @@ auto basic_encoder<N>::array(const token::int16::type *data,
         size = write_length(static_cast<std::uint64_t>(length_size));
     }
 
-    for (size_type i = 0; i < length; ++i)
-    {
-        endian_write(data[i]);
-    }
+    endian_write(data, length);
     return sizeof(value_type) + size + length_size;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::array(const token::int32::type *data,
-                             size_type length) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::array(const token::int32::type *data,
+                                     size_type length) -> size_type
 {
     size_type size = 0;
     size_type length_size = length * sizeof(*data);
@@ -441,16 +440,13 @@ auto basic_encoder<N>::array(const token::int32::type *data,
         size = write_length(static_cast<std::uint64_t>(length_size));
     }
 
-    for (size_type i = 0; i < length; ++i)
-    {
-        endian_write(data[i]);
-    }
+    endian_write(data, length);
     return sizeof(value_type) + size + length_size;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::array(const token::int64::type *data,
-                             size_type length) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::array(const token::int64::type *data,
+                                     size_type length) -> size_type
 {
     size_type size = 0;
     size_type length_size = length * sizeof(*data);
@@ -486,16 +482,13 @@ auto basic_encoder<N>::array(const token::int64::type *data,
         size = write_length(static_cast<std::uint64_t>(length_size));
     }
 
-    for (size_type i = 0; i < length; ++i)
-    {
-        endian_write(data[i]);
-    }
+    endian_write(data, length);
     return sizeof(value_type) + size + length_size;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::array(const token::float32::type *data,
-                             size_type length) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::array(const token::float32::type *data,
+                                     size_type length) -> size_type
 {
     size_type size = 0;
     size_type length_size = length * sizeof(*data);
@@ -531,16 +524,13 @@ auto basic_encoder<N>::array(const token::float32::type *data,
         size = write_length(static_cast<std::uint64_t>(length_size));
     }
 
-    for (size_type i = 0; i < length; ++i)
-    {
-        endian_write(data[i]);
-    }
+    endian_write(data, length);
     return sizeof(value_type) + size + length_size;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::array(const token::float64::type *data,
-                             size_type length) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::array(const token::float64::type *data,
+                                     size_type length) -> size_type
 {
     size_type size = 0;
     size_type length_size = length * sizeof(*data);
@@ -576,21 +566,24 @@ auto basic_encoder<N>::array(const token::float64::type *data,
         size = write_length(static_cast<std::uint64_t>(length_size));
     }
 
-    for (size_type i = 0; i < length; ++i)
-    {
-        endian_write(data[i]);
-    }
+    endian_write(data, length);
     return sizeof(value_type) + size + length_size;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::write_length(std::uint8_t data) -> size_type
+template <std::size_t N, typename Buffer>
+bool basic_encoder<N, Buffer>::reserve(size_type size)
+{
+    return buffer().grow(size);
+}
+
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::write_length(std::uint8_t data) -> size_type
 {
     return write(data);
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::write_length(std::uint16_t data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::write_length(std::uint16_t data) -> size_type
 {
     const size_type size = sizeof(std::int16_t);
     if (buffer().grow(size))
@@ -601,8 +594,8 @@ auto basic_encoder<N>::write_length(std::uint16_t data) -> size_type
     return 0;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::write_length(std::uint32_t data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::write_length(std::uint32_t data) -> size_type
 {
     const size_type size = sizeof(std::int32_t);
     if (buffer().grow(size))
@@ -613,8 +606,8 @@ auto basic_encoder<N>::write_length(std::uint32_t data) -> size_type
     return 0;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::write_length(std::uint64_t data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::write_length(std::uint64_t data) -> size_type
 {
     const size_type size = sizeof(std::int64_t);
     if (buffer().grow(size))
@@ -625,8 +618,8 @@ auto basic_encoder<N>::write_length(std::uint64_t data) -> size_type
     return 0;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::write(value_type data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::write(value_type data) -> size_type
 {
     const size_type size = sizeof(data);
     if (buffer().grow(size))
@@ -637,8 +630,8 @@ auto basic_encoder<N>::write(value_type data) -> size_type
     return 0;
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::write(const view_type& data) -> size_type
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::write(const view_type& data) -> size_type
 {
     const size_type size = data.size();
     if (buffer().grow(size))
@@ -649,110 +642,45 @@ auto basic_encoder<N>::write(const view_type& data) -> size_type
     return 0;
 }
 
-template <std::size_t N>
-void basic_encoder<N>::endian_write(std::int16_t data)
-{
-    const std::uint16_t endian = UINT16_C(0x0100);
-    value_type *data_buffer = (value_type *)&data;
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[0]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[1]]));
-}
-
-template <std::size_t N>
-void basic_encoder<N>::endian_write(std::uint16_t data)
-{
-    const std::uint16_t endian = UINT16_C(0x0100);
-    value_type *data_buffer = (value_type *)&data;
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[0]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[1]]));
-}
-
-template <std::size_t N>
-void basic_encoder<N>::endian_write(std::int32_t data)
-{
-    const std::uint32_t endian = UINT32_C(0x03020100);
-    value_type *data_buffer = (value_type *)&data;
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[0]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[1]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[2]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[3]]));
-}
-
-template <std::size_t N>
-void basic_encoder<N>::endian_write(std::uint32_t data)
+template <std::size_t N, typename Buffer>
+template <typename T>
+void basic_encoder<N, Buffer>::endian_write(T data)
 {
-    const std::uint32_t endian = UINT32_C(0x03020100);
-    value_type *data_buffer = (value_type *)&data;
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[0]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[1]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[2]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[3]]));
-}
-
-template <std::size_t N>
-void basic_encoder<N>::endian_write(std::int64_t data)
-{
-    const std::uint64_t endian = UINT64_C(0x0706050403020100);
-    value_type *data_buffer = (value_type *)&data;
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[0]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[1]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[2]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[3]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[4]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[5]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[6]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[7]]));
+    value_type bytes[sizeof(T)];
+    detail::endian::encode(&data, bytes, 1);
+    buffer().write(view_type(bytes, sizeof(T)));
 }
 
-template <std::size_t N>
-void basic_encoder<N>::endian_write(std::uint64_t data)
-{
-    const std::uint64_t endian = UINT64_C(0x0706050403020100);
-    value_type *data_buffer = (value_type *)&data;
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[0]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[1]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[2]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[3]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[4]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[5]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[6]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[7]]));
-}
-
-template <std::size_t N>
-void basic_encoder<N>::endian_write(token::float32::type data)
+template <std::size_t N, typename Buffer>
+template <typename T>
+void basic_encoder<N, Buffer>::endian_write(const T *data, size_type length)
 {
-    const std::uint32_t endian = UINT32_C(0x03020100);
-    value_type *data_buffer = (value_type *)&data;
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[0]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[1]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[2]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[3]]));
-}
-
-template <std::size_t N>
-void basic_encoder<N>::endian_write(token::float64::type data)
-{
-    const std::uint64_t endian = UINT64_C(0x0706050403020100);
-    value_type *data_buffer = (value_type *)&data;
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[0]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[1]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[2]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[3]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[4]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[5]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[6]]));
-    buffer().write(static_cast<value_type>(data_buffer[((value_type *)&endian)[7]]));
+    if (detail::endian::is_little)
+    {
+        buffer().write(view_type(reinterpret_cast<const value_type *>(data), length * sizeof(T)));
+        return;
+    }
+    // Byte-swap in blocks
+    value_type block[256];
+    const size_type block_length = sizeof(block) / sizeof(T);
+    while (length > 0)
+    {
+        const size_type size = std::min(length, block_length);
+        detail::endian::encode(data, block, size);
+        buffer().write(view_type(block, size * sizeof(T)));
+        data += size;
+        length -= size;
+    }
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::buffer() -> buffer_type&
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::buffer() -> buffer_type&
 {
     return reinterpret_cast<buffer_type&>(storage);
 }
 
-template <std::size_t N>
-auto basic_encoder<N>::buffer() const -> const buffer_type&
+template <std::size_t N, typename Buffer>
+auto basic_encoder<N, Buffer>::buffer() const -> const buffer_type&
 {
     return reinterpret_cast<const buffer_type&>(storage);
 }
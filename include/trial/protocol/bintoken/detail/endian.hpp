@@ -0,0 +1,128 @@
+#ifndef TRIAL_PROTOCOL_BINTOKEN_DETAIL_ENDIAN_HPP
+#define TRIAL_PROTOCOL_BINTOKEN_DETAIL_ENDIAN_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <boost/predef/other/endian.h>
+
+namespace trial
+{
+namespace protocol
+{
+namespace bintoken
+{
+namespace detail
+{
+
+// Conversion between native numbers and the little-endian encoding.
+//
+// Contiguous numbers are copied in bulk on little-endian hosts. On other
+// hosts the numbers are byte-swapped in a simple loop that compilers
+// vectorize.
+
+namespace endian
+{
+
+#if BOOST_ENDIAN_LITTLE_BYTE
+constexpr bool is_little = true;
+#elif BOOST_ENDIAN_BIG_BYTE
+constexpr bool is_little = false;
+#else
+# error "Unsupported byte order"
+#endif
+
+template <std::size_t N> struct unsigned_of;
+template <> struct unsigned_of<2> { using type = std::uint16_t; };
+template <> struct unsigned_of<4> { using type = std::uint32_t; };
+template <> struct unsigned_of<8> { using type = std::uint64_t; };
+
+inline std::uint16_t byteswap(std::uint16_t value) noexcept
+{
+    return std::uint16_t((value << 8) | (value >> 8));
+}
+
+inline std::uint32_t byteswap(std::uint32_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap32(value);
+#else
+    return ((value & UINT32_C(0x000000FF)) << 24) |
+        ((value & UINT32_C(0x0000FF00)) << 8) |
+        ((value & UINT32_C(0x00FF0000)) >> 8) |
+        ((value & UINT32_C(0xFF000000)) >> 24);
+#endif
+}
+
+inline std::uint64_t byteswap(std::uint64_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(value);
+#else
+    return (std::uint64_t(byteswap(std::uint32_t(value))) << 32) |
+        byteswap(std::uint32_t(value >> 32));
+#endif
+}
+
+// Reverses the byte order of count numbers of type T in place
+template <typename T>
+void byteswap(void *data, std::size_t count) noexcept
+{
+    using unsigned_type = typename unsigned_of<sizeof(T)>::type;
+    auto bytes = static_cast<std::uint8_t *>(data);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        unsigned_type value;
+        std::memcpy(&value, bytes + i * sizeof(T), sizeof(T));
+        value = byteswap(value);
+        std::memcpy(bytes + i * sizeof(T), &value, sizeof(T));
+    }
+}
+
+// Converts count little-endian encoded numbers into native numbers
+template <typename T>
+void decode(const std::uint8_t *input, T *output, std::size_t count) noexcept
+{
+    std::memcpy(output, input, count * sizeof(T));
+    if (!is_little)
+    {
+        byteswap<T>(output, count);
+    }
+}
+
+template <typename T>
+T decode(const std::uint8_t *input) noexcept
+{
+    T result;
+    decode(input, &result, 1);
+    return result;
+}
+
+// Converts count native numbers into little-endian encoded numbers
+template <typename T>
+void encode(const T *input, std::uint8_t *output, std::size_t count) noexcept
+{
+    std::memcpy(output, input, count * sizeof(T));
+    if (!is_little)
+    {
+        byteswap<T>(output, count);
+    }
+}
+
+} // namespace endian
+} // namespace detail
+} // namespace bintoken
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_BINTOKEN_DETAIL_ENDIAN_HPP
@@ -23,10 +23,10 @@ namespace bintoken
 namespace detail
 {
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 struct basic_formatter
 {
-    using variable_type = trial::dynamic::basic_variable<Allocator>;
+    using variable_type = trial::dynamic::basic_variable<Allocator, MapPolicy>;
 
     basic_formatter(bintoken::writer& writer)
         : writer(writer)
@@ -0,0 +1,35 @@
+#ifndef TRIAL_PROTOCOL_BINTOKEN_DETAIL_INDEXED_HPP
+#define TRIAL_PROTOCOL_BINTOKEN_DETAIL_INDEXED_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef> // std::size_t
+#include <trial/protocol/bintoken/token.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace bintoken
+{
+namespace detail
+{
+
+// The footer of an indexed container is a compact int64 array with a single
+// element, so it consists of the token code, the length, and the element.
+constexpr std::size_t indexed_footer_size = 2 + sizeof(token::int64::type);
+
+} // namespace detail
+} // namespace bintoken
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_BINTOKEN_DETAIL_INDEXED_HPP
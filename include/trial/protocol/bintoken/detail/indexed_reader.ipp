@@ -0,0 +1,183 @@
+#ifndef TRIAL_PROTOCOL_BINTOKEN_DETAIL_INDEXED_READER_IPP
+#define TRIAL_PROTOCOL_BINTOKEN_DETAIL_INDEXED_READER_IPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <trial/protocol/buffer/base.hpp>
+#include <trial/protocol/bintoken/detail/indexed.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace bintoken
+{
+
+inline indexed_reader::indexed_reader(const view_type& data)
+    : input(data)
+{
+    const size_type footer_size = detail::indexed_footer_size;
+    if (input.size() < footer_size)
+        throw bintoken::error(invalid_value);
+    const size_type end = input.size() - footer_size;
+
+    // Footer
+    bintoken::reader footer(input.substr(end));
+    if ((footer.code() != token::code::array8_int64) || (footer.length() != 1))
+        throw bintoken::error(invalid_value);
+    std::int64_t index = 0;
+    footer.array(&index, 1);
+    if ((index <= 0) || (std::uint64_t(index) > end))
+        throw bintoken::error(invalid_value);
+
+    // Container
+    container = token::code::value(input.front());
+    token::code::value closing = token::code::end;
+    switch (container)
+    {
+    case token::code::begin_array:
+        closing = token::code::end_array;
+        break;
+    case token::code::begin_assoc_array:
+        closing = token::code::end_assoc_array;
+        break;
+    default:
+        throw bintoken::error(invalid_value);
+    }
+
+    // Index
+    bintoken::reader trailer(input.substr(size_type(index), end - size_type(index)));
+    if (trailer.symbol() != token::symbol::array)
+        throw bintoken::error(invalid_value);
+    offsets = trailer.array_view<std::int64_t>();
+    if (offsets.empty())
+        throw bintoken::error(invalid_value);
+    trailer.next();
+
+    // Keys
+    if (container == token::code::begin_assoc_array)
+    {
+        if (trailer.symbol() != token::symbol::array)
+            throw bintoken::error(invalid_value);
+        keys = trailer.array_view<std::int64_t>();
+        trailer.next();
+    }
+    if (trailer.code() != token::code::end)
+        throw bintoken::error(invalid_value);
+
+    // Offsets must be increasing and within the container
+    std::int64_t previous = 0;
+    for (auto current : offsets)
+    {
+        if ((current <= previous) || (current >= index))
+            throw bintoken::error(invalid_value);
+        previous = current;
+    }
+    if (input[size_type(previous)] != closing)
+        throw bintoken::error(invalid_value);
+
+    // Keys must refer to records
+    if (keys.size() > size())
+        throw bintoken::error(invalid_value);
+    for (auto current : keys)
+    {
+        if ((current < 0) || (std::uint64_t(current) >= size()))
+            throw bintoken::error(invalid_value);
+    }
+}
+
+template <typename T>
+indexed_reader::indexed_reader(const T& data)
+    : indexed_reader(buffer::traits<T>::view_cast(data))
+{
+}
+
+inline indexed_reader::indexed_reader(const core::mapped_file& file)
+    : indexed_reader(view_type(reinterpret_cast<const view_type::value_type *>(file.data()), file.size()))
+{
+}
+
+inline token::code::value indexed_reader::code() const noexcept
+{
+    return container;
+}
+
+inline auto indexed_reader::size() const noexcept -> size_type
+{
+    return offsets.size() - 1;
+}
+
+inline bool indexed_reader::empty() const noexcept
+{
+    return size() == 0;
+}
+
+inline auto indexed_reader::offset(size_type index) const noexcept -> size_type
+{
+    return size_type(offsets[index]);
+}
+
+inline auto indexed_reader::record(size_type index) const -> view_type
+{
+    if (index >= size())
+        throw bintoken::error(overflow);
+    return input.substr(offset(index), offset(index + 1) - offset(index));
+}
+
+inline bintoken::reader indexed_reader::at(size_type index) const
+{
+    return bintoken::reader(record(index));
+}
+
+inline bintoken::reader indexed_reader::range(size_type first, size_type last) const
+{
+    if ((first > last) || (last > size()))
+        throw bintoken::error(overflow);
+    return bintoken::reader(input.substr(offset(first), offset(last) - offset(first)));
+}
+
+inline auto indexed_reader::key(size_type index) const -> string_view_type
+{
+    bintoken::reader reader(record(index));
+    if (reader.symbol() != token::symbol::string)
+        throw bintoken::error(invalid_value);
+    const auto& literal = reader.literal();
+    return string_view_type(reinterpret_cast<const char *>(literal.data()), literal.size());
+}
+
+inline auto indexed_reader::find(const string_view_type& wanted) const -> size_type
+{
+    // Lower bound in keys table
+    size_type first = 0;
+    size_type count = keys.size();
+    while (count > 0)
+    {
+        const size_type half = count / 2;
+        if (key(size_type(keys[first + half])).compare(wanted) < 0)
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+    if ((first < keys.size()) && (key(size_type(keys[first])) == wanted))
+        return size_type(keys[first]);
+    return size();
+}
+
+} // namespace bintoken
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_BINTOKEN_DETAIL_INDEXED_READER_IPP
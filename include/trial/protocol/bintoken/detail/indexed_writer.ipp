@@ -0,0 +1,201 @@
+#ifndef TRIAL_PROTOCOL_BINTOKEN_DETAIL_INDEXED_WRITER_IPP
+#define TRIAL_PROTOCOL_BINTOKEN_DETAIL_INDEXED_WRITER_IPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+namespace trial
+{
+namespace protocol
+{
+namespace bintoken
+{
+
+template <typename T>
+indexed_writer::indexed_writer(T& output)
+    : writer(output)
+{
+}
+
+template <typename T>
+auto indexed_writer::value() -> size_type
+{
+    const token::code::value code = T::code;
+    if (!enter(code))
+        return 0;
+    return leave(code, writer.template value<T>());
+}
+
+template <typename T>
+auto indexed_writer::value(const T& data) -> size_type
+{
+    // Only the structure of the output matters, so all data values are
+    // treated alike
+    if (!enter(token::code::null))
+        return 0;
+    const bool is_key = (level == 1)
+        && (container == token::code::begin_assoc_array)
+        && (entries % 2 == 0);
+    const size_type result = leave(token::code::null, writer.value(data));
+    if (is_key && (result != 0))
+    {
+        remember(data);
+    }
+    return result;
+}
+
+template <typename T>
+auto indexed_writer::array(const T *data, size_type size) -> size_type
+{
+    if (!enter(token::code::null))
+        return 0;
+    return leave(token::code::null, writer.array(data, size));
+}
+
+inline auto indexed_writer::size() const noexcept -> size_type
+{
+    return records;
+}
+
+inline auto indexed_writer::tell() const noexcept -> size_type
+{
+    return position;
+}
+
+// Validates the token before it is written
+inline bool indexed_writer::enter(token::code::value code)
+{
+    if (closed)
+        throw bintoken::error(unexpected_token);
+
+    if (failed)
+        return false;
+
+    if (level == 0)
+    {
+        if ((code != token::code::begin_array) && (code != token::code::begin_assoc_array))
+            throw bintoken::error(unexpected_token);
+        container = code;
+    }
+    return true;
+}
+
+// Records the offset of tokens that start a record once they are written
+inline auto indexed_writer::leave(token::code::value code, size_type written) -> size_type
+{
+    if (written == 0)
+    {
+        // Offsets of subsequent tokens would be wrong, so the index cannot
+        // be completed
+        failed = true;
+        return 0;
+    }
+
+    switch (code)
+    {
+    case token::code::begin_record:
+    case token::code::begin_array:
+    case token::code::begin_assoc_array:
+        record();
+        ++level;
+        break;
+
+    case token::code::end_record:
+    case token::code::end_array:
+    case token::code::end_assoc_array:
+        --level;
+        if (level == 0)
+        {
+            // Offset of end token of container
+            offsets.push_back(std::int64_t(position));
+        }
+        break;
+
+    default:
+        record();
+        break;
+    }
+
+    position += written;
+
+    if (level == 0)
+    {
+        // Container is closed so write index and footer
+        closed = true;
+        const std::int64_t footer = std::int64_t(position);
+        size_type trailer = writer.array(offsets.data(), offsets.size());
+        if ((trailer != 0) && (container == token::code::begin_assoc_array))
+        {
+            std::stable_sort(keys.begin(), keys.end(),
+                             [] (const std::pair<std::string, std::int64_t>& lhs,
+                                 const std::pair<std::string, std::int64_t>& rhs)
+                             {
+                                 return lhs.first < rhs.first;
+                             });
+            std::vector<std::int64_t> table;
+            table.reserve(keys.size());
+            for (const auto& key : keys)
+            {
+                table.push_back(key.second);
+            }
+            const size_type written_keys = writer.array(table.data(), table.size());
+            trailer = (written_keys == 0) ? 0 : trailer + written_keys;
+        }
+        const size_type written_footer = (trailer == 0) ? 0 : writer.array(&footer, 1);
+        if (written_footer == 0)
+        {
+            failed = true;
+            return 0;
+        }
+        trailer += written_footer;
+        position += trailer;
+        written += trailer;
+    }
+    return written;
+}
+
+template <std::size_t M>
+void indexed_writer::remember(const char (&data)[M])
+{
+    // Drop terminating zero
+    keys.emplace_back(std::string(data, M - 1), std::int64_t(records - 1));
+}
+
+inline void indexed_writer::remember(const std::string& data)
+{
+    keys.emplace_back(data, std::int64_t(records - 1));
+}
+
+inline void indexed_writer::remember(const core::detail::string_view& data)
+{
+    keys.emplace_back(std::string(data.data(), data.size()), std::int64_t(records - 1));
+}
+
+inline void indexed_writer::record()
+{
+    if (level == 1)
+    {
+        // Associative arrays alternate between keys and values
+        if ((container == token::code::begin_array) || (entries % 2 == 0))
+        {
+            offsets.push_back(std::int64_t(position));
+            ++records;
+        }
+        ++entries;
+    }
+}
+
+} // namespace bintoken
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_BINTOKEN_DETAIL_INDEXED_WRITER_IPP
@@ -23,11 +23,11 @@ namespace bintoken
 namespace detail
 {
 
-template <typename Allocator>
+template <typename Allocator, typename MapPolicy>
 class basic_parser
 {
 public:
-    using variable_type = dynamic::basic_variable<Allocator>;
+    using variable_type = dynamic::basic_variable<Allocator, MapPolicy>;
 
     basic_parser(bintoken::reader& reader)
         : reader(reader)
@@ -93,7 +93,7 @@ private:
     {
         assert(reader.symbol() == token::symbol::begin_record);
 
-        auto scope = dynamic::basic_array<Allocator>::make();
+        auto scope = dynamic::basic_array<Allocator, MapPolicy>::make();
 
         while (reader.next())
         {
@@ -137,7 +137,7 @@ private:
     {
         assert(reader.symbol() == token::symbol::begin_array);
 
-        auto scope = dynamic::basic_array<Allocator>::make();
+        auto scope = dynamic::basic_array<Allocator, MapPolicy>::make();
 
         while (reader.next())
         {
@@ -181,7 +181,7 @@ private:
     {
         assert(reader.symbol() == token::symbol::begin_assoc_array);
 
-        auto scope = dynamic::basic_map<Allocator>::make();
+        auto scope = dynamic::basic_map<Allocator, MapPolicy>::make();
 
         while (reader.next())
         {
@@ -260,7 +260,7 @@ private:
                 std::vector<std::int8_t> input(reader.length());
                 reader.array<std::int8_t>(input.data(), input.size());
                 reader.next();
-                return dynamic::basic_array<Allocator>::make(input.begin(), input.end());
+                return dynamic::basic_array<Allocator, MapPolicy>::make(input.begin(), input.end());
             }
 
         case token::code::array8_int16:
@@ -271,7 +271,7 @@ private:
                 std::vector<std::int16_t> input(reader.length());
                 reader.array<std::int16_t>(input.data(), input.size());
                 reader.next();
-                return dynamic::basic_array<Allocator>::make(input.begin(), input.end());
+                return dynamic::basic_array<Allocator, MapPolicy>::make(input.begin(), input.end());
             }
 
         case token::code::array8_int32:
@@ -282,7 +282,7 @@ private:
                 std::vector<std::int32_t> input(reader.length());
                 reader.array<std::int32_t>(input.data(), input.size());
                 reader.next();
-                return dynamic::basic_array<Allocator>::make(input.begin(), input.end());
+                return dynamic::basic_array<Allocator, MapPolicy>::make(input.begin(), input.end());
             }
 
         case token::code::array8_int64:
@@ -293,7 +293,7 @@ private:
                 std::vector<std::int64_t> input(reader.length());
                 reader.array<std::int64_t>(input.data(), input.size());
                 reader.next();
-                return dynamic::basic_array<Allocator>::make(input.begin(), input.end());
+                return dynamic::basic_array<Allocator, MapPolicy>::make(input.begin(), input.end());
             }
 
         default:
@@ -13,10 +13,12 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <vector>
 #include <trial/protocol/core/detail/type_traits.hpp>
 #include <trial/protocol/bintoken/token.hpp>
+#include <trial/protocol/bintoken/detail/endian.hpp>
 
 namespace trial
 {
@@ -391,6 +393,11 @@ reader::reader(const T& input)
     stack.push(token::code::end);
 }
 
+inline reader::reader(const core::mapped_file& file)
+    : reader(view_type(reinterpret_cast<const value_type *>(file.data()), file.size()))
+{
+}
+
 inline token::code::value reader::code() const BOOST_NOEXCEPT
 {
     return decoder.code();
@@ -567,6 +574,75 @@ auto reader::array(T* output,
     return overloader<type>::convert(*this, output, output_length);
 }
 
+template <typename T>
+auto reader::array_view() const -> typed_view<T>
+{
+    static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                  "Cannot view type");
+
+    if (is_native_array<T>())
+    {
+        const auto& view = literal();
+        if (detail::endian::is_little &&
+            (reinterpret_cast<std::uintptr_t>(view.data()) % alignof(T) == 0))
+        {
+            return typed_view<T>(reinterpret_cast<const T *>(view.data()),
+                                 view.size() / sizeof(T));
+        }
+    }
+
+    std::vector<T> copy(length());
+    copy.resize(array(copy.data(), copy.size()));
+    return typed_view<T>(std::move(copy));
+}
+
+// Checks if the current token is a compact array with elements encoded as T
+template <typename T>
+bool reader::is_native_array() const BOOST_NOEXCEPT
+{
+    switch (code())
+    {
+    case token::code::array8_int8:
+    case token::code::array16_int8:
+    case token::code::array32_int8:
+    case token::code::array64_int8:
+        return std::is_integral<T>::value && (sizeof(T) == token::int8::size);
+
+    case token::code::array8_int16:
+    case token::code::array16_int16:
+    case token::code::array32_int16:
+    case token::code::array64_int16:
+        return std::is_integral<T>::value && (sizeof(T) == token::int16::size);
+
+    case token::code::array8_int32:
+    case token::code::array16_int32:
+    case token::code::array32_int32:
+    case token::code::array64_int32:
+        return std::is_integral<T>::value && (sizeof(T) == token::int32::size);
+
+    case token::code::array8_int64:
+    case token::code::array16_int64:
+    case token::code::array32_int64:
+    case token::code::array64_int64:
+        return std::is_integral<T>::value && (sizeof(T) == token::int64::size);
+
+    case token::code::array8_float32:
+    case token::code::array16_float32:
+    case token::code::array32_float32:
+    case token::code::array64_float32:
+        return std::is_same<T, token::float32::type>::value;
+
+    case token::code::array8_float64:
+    case token::code::array16_float64:
+    case token::code::array32_float64:
+    case token::code::array64_float64:
+        return std::is_same<T, token::float64::type>::value;
+
+    default:
+        return false;
+    }
+}
+
 inline const reader::view_type& reader::literal() const BOOST_NOEXCEPT
 {
     return decoder.literal();
@@ -577,6 +653,78 @@ inline auto reader::tail() const BOOST_NOEXCEPT -> const view_type&
     return decoder.tail();
 }
 
+inline auto reader::encoded() const BOOST_NOEXCEPT -> view_type
+{
+    return decoder.encoded();
+}
+
+inline bool reader::skip_to_end()
+{
+    token::code::value closing;
+    token::code::value failure;
+    switch (code())
+    {
+    case token::code::begin_record:
+        closing = token::code::end_record;
+        failure = token::code::error_expected_end_record;
+        break;
+
+    case token::code::begin_array:
+        closing = token::code::end_array;
+        failure = token::code::error_expected_end_array;
+        break;
+
+    case token::code::begin_assoc_array:
+        closing = token::code::end_assoc_array;
+        failure = token::code::error_expected_end_assoc_array;
+        break;
+
+    default:
+        return false;
+    }
+
+    // Enter the group as next() does, so the following next() leaves it
+    stack.push(closing);
+
+    size_type depth = 0;
+    for (;;)
+    {
+        decoder.next();
+        switch (decoder.code())
+        {
+        case token::code::begin_record:
+        case token::code::begin_array:
+        case token::code::begin_assoc_array:
+            ++depth;
+            break;
+
+        case token::code::end_record:
+        case token::code::end_array:
+        case token::code::end_assoc_array:
+            if (depth == 0)
+            {
+                if (decoder.code() != closing)
+                {
+                    decoder.code(failure);
+                    return false;
+                }
+                return true;
+            }
+            --depth;
+            break;
+
+        case token::code::end:
+            decoder.code(failure);
+            return false;
+
+        default:
+            if (category() == token::category::status)
+                return false;
+            break;
+        }
+    }
+}
+
 } // namespace bintoken
 } // namespace protocol
 } // namespace trial
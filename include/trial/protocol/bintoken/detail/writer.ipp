@@ -27,9 +27,9 @@ namespace bintoken
 // writer::overloader
 //-----------------------------------------------------------------------------
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T, typename Enable>
-struct basic_writer<N>::overloader
+struct basic_writer<N, Buffer>::overloader
 {
     static size_type value(basic_writer&, const T&)
     {
@@ -38,31 +38,31 @@ struct basic_writer<N>::overloader
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<N>::overloader<
+struct basic_writer<N, Buffer>::overloader<
     T,
     typename std::enable_if<core::detail::is_bool<T>::value>::type>
 {
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self, T data)
+    static size_type value(basic_writer<N, Buffer>& self, T data)
     {
         return self.encoder.value(data);
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<N>::overloader<
+struct basic_writer<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_integral<T>::value &&
                             std::is_signed<T>::value &&
                             !core::detail::is_bool<T>::value>::type>
 {
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self, T data)
+    static size_type value(basic_writer<N, Buffer>& self, T data)
     {
         if ((data <= std::numeric_limits<std::int8_t>::max()) &&
             (data >= std::numeric_limits<std::int8_t>::min()))
@@ -85,23 +85,23 @@ struct basic_writer<N>::overloader<
         }
     }
 
-    static size_type array(basic_writer<N>& self, const T *data, size_type size)
+    static size_type array(basic_writer<N, Buffer>& self, const T *data, size_type size)
     {
         return self.encoder.array(data, size);
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<N>::overloader<
+struct basic_writer<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_integral<T>::value &&
                             !std::is_signed<T>::value &&
                             !core::detail::is_bool<T>::value>::type>
 {
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self, T data)
+    static size_type value(basic_writer<N, Buffer>& self, T data)
     {
         if (data <= std::numeric_limits<std::uint8_t>::max())
         {
@@ -121,7 +121,7 @@ struct basic_writer<N>::overloader<
         }
     }
 
-    static size_type array(basic_writer<N>& self, const T *data, size_type size)
+    static size_type array(basic_writer<N, Buffer>& self, const T *data, size_type size)
     {
         using signed_type = typename std::make_signed<T>::type;
 
@@ -130,105 +130,105 @@ struct basic_writer<N>::overloader<
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<N>::overloader<
+struct basic_writer<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_floating_point<T>::value>::type>
 {
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self, T data)
+    static size_type value(basic_writer<N, Buffer>& self, T data)
     {
         return self.encoder.value(data);
     }
 
-    static size_type array(basic_writer<N>& self, const T *data, size_type size)
+    static size_type array(basic_writer<N, Buffer>& self, const T *data, size_type size)
     {
         return self.encoder.array(data, size);
     }
 };
 
 // String literals
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename CharT, std::size_t M>
-struct basic_writer<N>::overloader<CharT[M]>
+struct basic_writer<N, Buffer>::overloader<CharT[M]>
 {
     using type = CharT[M];
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self, const type& data)
+    static size_type value(basic_writer<N, Buffer>& self, const type& data)
     {
         return self.encoder.value(data, M - 1); // Drop terminating zero
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<N>::overloader<
+struct basic_writer<N, Buffer>::overloader<
     T,
-    typename std::enable_if<std::is_same<T, typename basic_writer<N>::string_view_type>::value>::type>
+    typename std::enable_if<std::is_same<T, typename basic_writer<N, Buffer>::string_view_type>::value>::type>
 {
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self, const T& data)
+    static size_type value(basic_writer<N, Buffer>& self, const T& data)
     {
         return self.encoder.value(data);
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<N>::overloader<
+struct basic_writer<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, std::string>::value>::type>
 {
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self, const T& data)
+    static size_type value(basic_writer<N, Buffer>& self, const T& data)
     {
         return self.encoder.value(data);
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<N>::overloader<
+struct basic_writer<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::null>::value>::type>
 {
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self)
+    static size_type value(basic_writer<N, Buffer>& self)
     {
         return self.encoder.template value<token::null>();
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<N>::overloader<
+struct basic_writer<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::begin_record>::value>::type>
 {
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self)
+    static size_type value(basic_writer<N, Buffer>& self)
     {
         self.stack.push(token::code::end_record);
         return self.encoder.template value<T>();
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<N>::overloader<
+struct basic_writer<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::end_record>::value>::type>
 {
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self)
+    static size_type value(basic_writer<N, Buffer>& self)
     {
         self.validate_scope(token::code::end_record, unexpected_token);
         size_type result = self.encoder.template value<T>();
@@ -237,30 +237,30 @@ struct basic_writer<N>::overloader<
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<N>::overloader<
+struct basic_writer<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::begin_array>::value>::type>
 {
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self)
+    static size_type value(basic_writer<N, Buffer>& self)
     {
         self.stack.push(token::code::end_array);
         return self.encoder.template value<T>();
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<N>::overloader<
+struct basic_writer<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::end_array>::value>::type>
 {
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self)
+    static size_type value(basic_writer<N, Buffer>& self)
     {
         self.validate_scope(token::code::end_array, unexpected_token);
         size_type result = self.encoder.template value<T>();
@@ -269,30 +269,30 @@ struct basic_writer<N>::overloader<
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<N>::overloader<
+struct basic_writer<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::begin_assoc_array>::value>::type>
 {
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self)
+    static size_type value(basic_writer<N, Buffer>& self)
     {
         self.stack.push(token::code::end_assoc_array);
         return self.encoder.template value<T>();
     }
 };
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<N>::overloader<
+struct basic_writer<N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::end_assoc_array>::value>::type>
 {
-    using size_type = typename basic_writer<N>::size_type;
+    using size_type = typename basic_writer<N, Buffer>::size_type;
 
-    static size_type value(basic_writer<N>& self)
+    static size_type value(basic_writer<N, Buffer>& self)
     {
         self.validate_scope(token::code::end_assoc_array, unexpected_token);
         size_type result = self.encoder.template value<T>();
@@ -305,38 +305,44 @@ struct basic_writer<N>::overloader<
 // writer
 //-----------------------------------------------------------------------------
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-basic_writer<N>::basic_writer(T& buffer)
+basic_writer<N, Buffer>::basic_writer(T& buffer)
     : encoder(buffer)
 {
     stack.push(token::code::end_array);
 }
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-auto basic_writer<N>::value(const T& data) -> size_type
+auto basic_writer<N, Buffer>::value(const T& data) -> size_type
 {
     return overloader<T>::value(*this, data);
 }
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-auto basic_writer<N>::value() -> size_type
+auto basic_writer<N, Buffer>::value() -> size_type
 {
     return overloader<T>::value(*this);
 }
 
-template <std::size_t N>
+template <std::size_t N, typename Buffer>
 template <typename T>
-auto basic_writer<N>::array(const T *data, size_type size) -> size_type
+auto basic_writer<N, Buffer>::array(const T *data, size_type size) -> size_type
 {
     return overloader<T>::array(*this, data, size);
 }
 
-template <std::size_t N>
-void basic_writer<N>::validate_scope(token::code::value code,
-                                     enum bintoken::errc e)
+template <std::size_t N, typename Buffer>
+bool basic_writer<N, Buffer>::reserve(size_type size)
+{
+    return encoder.reserve(size);
+}
+
+template <std::size_t N, typename Buffer>
+void basic_writer<N, Buffer>::validate_scope(token::code::value code,
+                                             enum bintoken::errc e)
 {
     if ((stack.size() < 2) || (stack.top() != code))
     {
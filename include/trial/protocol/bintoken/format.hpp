@@ -31,11 +31,11 @@ namespace partial
 //! @param[out] writer Writer pointing to arbitrary location within a buffer.
 //! @throw bintoken::error if input contains a long double, wstring, u16string,
 //!        or u32string.
-template <typename Allocator>
-void format(const trial::dynamic::basic_variable<Allocator>& data,
+template <typename Allocator, typename MapPolicy>
+void format(const trial::dynamic::basic_variable<Allocator, MapPolicy>& data,
             bintoken::writer& writer)
 {
-    detail::basic_formatter<Allocator> vis(writer);
+    detail::basic_formatter<Allocator, MapPolicy> vis(writer);
     trial::dynamic::visit(vis, data);
 }
 
@@ -48,8 +48,8 @@ void format(const trial::dynamic::basic_variable<Allocator>& data,
 //! @throw bintoken::error if input contains a long double, wstring, u16string,
 //!        or u32string.
 
-template <typename T, typename Allocator>
-auto format(const trial::dynamic::basic_variable<Allocator>& data) -> T
+template <typename T, typename Allocator, typename MapPolicy>
+auto format(const trial::dynamic::basic_variable<Allocator, MapPolicy>& data) -> T
 {
     T result;
     bintoken::writer writer(result);
@@ -64,8 +64,8 @@ auto format(const trial::dynamic::basic_variable<Allocator>& data) -> T
 //! @throw bintoken::error if input contains a long double, wstring, u16string,
 //!        or u32string.
 
-template <typename T, typename Allocator>
-void format(const trial::dynamic::basic_variable<Allocator>& data,
+template <typename T, typename Allocator, typename MapPolicy>
+void format(const trial::dynamic::basic_variable<Allocator, MapPolicy>& data,
             T& result)
 {
     bintoken::writer writer(result);
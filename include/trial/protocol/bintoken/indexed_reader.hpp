@@ -0,0 +1,118 @@
+#ifndef TRIAL_PROTOCOL_BINTOKEN_INDEXED_READER_HPP
+#define TRIAL_PROTOCOL_BINTOKEN_INDEXED_READER_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <trial/protocol/core/mapped_file.hpp>
+#include <trial/protocol/core/detail/string_view.hpp>
+#include <trial/protocol/bintoken/error.hpp>
+#include <trial/protocol/bintoken/reader.hpp>
+#include <trial/protocol/bintoken/token.hpp>
+#include <trial/protocol/bintoken/typed_view.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace bintoken
+{
+
+//! @brief Random access reader of an indexed container.
+//!
+//! Reads the output of bintoken::indexed_writer. The index is located
+//! through the footer at the end of the input, so records can be accessed
+//! without tokenizing the records before them.
+//!
+//! Records are returned as bintoken::reader instances limited to the
+//! requested records. These readers are independent of each other, so
+//! disjoint ranges of records can be scanned in parallel.
+//!
+//! The indexed reader does not assume ownership of the input.
+class indexed_reader
+{
+public:
+    using size_type = bintoken::reader::size_type;
+    using view_type = bintoken::reader::view_type;
+    using string_view_type = core::detail::string_view;
+
+    //! @brief Construct indexed reader.
+    //!
+    //! @param[in] input Buffer containing an indexed container.
+    //! @throws bintoken::error with bintoken::invalid_value if the input does
+    //!         not contain a valid index.
+    indexed_reader(const view_type& input);
+    template <typename T> indexed_reader(const T& input);
+    indexed_reader(const core::mapped_file& input);
+
+    //! @returns Code of the container, which is either token::code::begin_array
+    //!          or token::code::begin_assoc_array.
+    token::code::value code() const noexcept;
+
+    //! @returns Number of records.
+    size_type size() const noexcept;
+
+    //! @returns true if there are no records.
+    bool empty() const noexcept;
+
+    //! @brief Returns the encoded record.
+    //!
+    //! A record of an associative array contains both key and value.
+    //!
+    //! @throws bintoken::error with bintoken::overflow if index is out of range.
+    view_type record(size_type index) const;
+
+    //! @brief Returns reader positioned at the beginning of a record.
+    //!
+    //! @throws bintoken::error with bintoken::overflow if index is out of range.
+    bintoken::reader at(size_type index) const;
+
+    //! @brief Returns reader over a range of records.
+    //!
+    //! The reader reaches the end token after the last record.
+    //!
+    //! @param[in] first Index of first record.
+    //! @param[in] last Index one past the last record.
+    //! @throws bintoken::error with bintoken::overflow if range is invalid.
+    bintoken::reader range(size_type first, size_type last) const;
+
+    //! @brief Finds record by string key.
+    //!
+    //! The sorted keys table is searched with binary search, so the lookup
+    //! decodes a logarithmic number of keys.
+    //!
+    //! @returns Index of first record with the key, or size() if not found or
+    //!          if the container is not an associative array.
+    //! @throws bintoken::error with bintoken::invalid_value if the keys table
+    //!         refers to a record without a string key.
+    size_type find(const string_view_type& key) const;
+
+#ifndef BOOST_DOXYGEN_INVOKED
+private:
+    size_type offset(size_type index) const noexcept;
+    string_view_type key(size_type index) const;
+
+private:
+    view_type input;
+    token::code::value container;
+    typed_view<std::int64_t> offsets;
+    typed_view<std::int64_t> keys;
+#endif
+};
+
+} // namespace bintoken
+} // namespace protocol
+} // namespace trial
+
+#include <trial/protocol/bintoken/detail/indexed_reader.ipp>
+
+#endif // TRIAL_PROTOCOL_BINTOKEN_INDEXED_READER_HPP
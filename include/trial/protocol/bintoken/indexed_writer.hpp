@@ -0,0 +1,118 @@
+#ifndef TRIAL_PROTOCOL_BINTOKEN_INDEXED_WRITER_HPP
+#define TRIAL_PROTOCOL_BINTOKEN_INDEXED_WRITER_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <trial/protocol/core/detail/string_view.hpp>
+#include <trial/protocol/bintoken/error.hpp>
+#include <trial/protocol/bintoken/token.hpp>
+#include <trial/protocol/bintoken/writer.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace bintoken
+{
+
+//! @brief Binary token writer that produces an indexed container.
+//!
+//! The output must be a single array or associative array, whose elements
+//! are called records. Each element of an array is a record, and each
+//! key-value pair of an associative array is a record.
+//!
+//! When the container is closed, the byte offsets of all records are
+//! written after the container, followed by a fixed-size footer:
+//!
+//! @code
+//! container | index | keys | footer
+//! @endcode
+//!
+//! where index is a compact int64 array with the offset of each record
+//! relative to the start of the container, followed by the offset of the
+//! end token of the container, and footer is a compact int64 array with
+//! the offset of the index.
+//!
+//! The keys table is only written for associative arrays. It is a compact
+//! int64 array with the indices of the records with string keys, sorted by
+//! key. Records with equal keys retain their order.
+//!
+//! The container is a regular bintoken value, so the output can still be
+//! read sequentially with bintoken::reader, which will encounter the trailing
+//! tables and footer as values after the container. Use
+//! bintoken::indexed_reader for random access.
+//!
+//! The interface is the same as bintoken::writer. If a token cannot be
+//! written, then zero is returned and all subsequent tokens are discarded,
+//! because the index would no longer match the output.
+class indexed_writer
+{
+public:
+    using size_type = bintoken::writer::size_type;
+    using view_type = bintoken::writer::view_type;
+
+    template <typename T> indexed_writer(T&);
+
+    //! @throws bintoken::error with bintoken::unexpected_token if the first
+    //!         token is not the beginning of an array or associative array,
+    //!         or if tokens are written after the container is closed.
+    template <typename T>
+    size_type value();
+
+    template <typename T>
+    size_type value(const T&);
+
+    template <typename T>
+    size_type array(const T *, size_type);
+
+    //! @returns Number of records written so far.
+    size_type size() const noexcept;
+
+    //! @returns Number of bytes written so far.
+    size_type tell() const noexcept;
+
+#ifndef BOOST_DOXYGEN_INVOKED
+private:
+    bool enter(token::code::value);
+    size_type leave(token::code::value, size_type);
+    void record();
+
+    template <typename T> void remember(const T&) {}
+    template <std::size_t M> void remember(const char (&)[M]);
+    void remember(const std::string&);
+    void remember(const core::detail::string_view&);
+
+private:
+    bintoken::writer writer;
+    token::code::value container = token::code::end;
+    bool closed = false;
+    bool failed = false;
+    size_type level = 0;
+    size_type entries = 0;
+    size_type records = 0;
+    size_type position = 0;
+    std::vector<std::int64_t> offsets;
+    std::vector<std::pair<std::string, std::int64_t>> keys;
+#endif
+};
+
+} // namespace bintoken
+} // namespace protocol
+} // namespace trial
+
+#include <trial/protocol/bintoken/detail/indexed_writer.ipp>
+
+#endif // TRIAL_PROTOCOL_BINTOKEN_INDEXED_WRITER_HPP
@@ -34,10 +34,10 @@ namespace partial
 //! @param reader Reader pointing to an arbitrary position within a buffer.
 //! @returns Dynamic variable containing the decoded BinToken data.
 
-template <typename Allocator = std::allocator<char>>
-auto parse(bintoken::reader& reader) -> dynamic::basic_variable<Allocator>
+template <typename Allocator = std::allocator<char>, typename MapPolicy = dynamic::ordered_map_policy>
+auto parse(bintoken::reader& reader) -> dynamic::basic_variable<Allocator, MapPolicy>
 {
-    detail::basic_parser<Allocator> parser(reader);
+    detail::basic_parser<Allocator, MapPolicy> parser(reader);
     return parser.parse();
 }
 
@@ -48,8 +48,8 @@ auto parse(bintoken::reader& reader) -> dynamic::basic_variable<Allocator>
 //! @param input The BinToken formatted input buffer.
 //! @returns Dynamic variable containing the decoded BinToken data.
 
-template <typename U, typename Allocator = std::allocator<char>>
-auto parse(const U& input) -> dynamic::basic_variable<Allocator>
+template <typename U, typename Allocator = std::allocator<char>, typename MapPolicy = dynamic::ordered_map_policy>
+auto parse(const U& input) -> dynamic::basic_variable<Allocator, MapPolicy>
 {
     bintoken::reader reader(input);
     auto result = partial::parse(reader);
@@ -0,0 +1,98 @@
+#ifndef TRIAL_PROTOCOL_BINTOKEN_PARTIAL_SKIP_HPP
+#define TRIAL_PROTOCOL_BINTOKEN_PARTIAL_SKIP_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <system_error>
+#include <trial/protocol/bintoken/error.hpp>
+#include <trial/protocol/bintoken/reader.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace bintoken
+{
+namespace partial
+{
+
+//! @brief Skip over the current value.
+//!
+//! Strings and compact arrays are skipped in constant time using their
+//! length prefix. Groups are skipped with reader::skip_to_end().
+//!
+//! @param reader Reader pointing to a value. The reader will point to the
+//!        token after the value afterwards.
+//! @param[out] ec Error code if the value is malformed.
+//! @returns A view of the encoded value.
+inline reader::view_type skip(bintoken::reader& reader, std::error_code& ec)
+{
+    using view_type = bintoken::reader::view_type;
+
+    switch (reader.symbol())
+    {
+    case token::symbol::end:
+    case token::symbol::end_record:
+    case token::symbol::end_array:
+    case token::symbol::end_assoc_array:
+        ec = make_error_code(unexpected_token);
+        return {};
+
+    case token::symbol::error:
+        ec = reader.error();
+        return {};
+
+    case token::symbol::begin_record:
+    case token::symbol::begin_array:
+    case token::symbol::begin_assoc_array:
+        {
+            const auto head = reader.encoded().data();
+            if (!reader.skip_to_end())
+            {
+                ec = reader.error();
+                return view_type(head, reader.encoded().data() - head);
+            }
+            const auto tail = reader.tail().data();
+            if (!reader.next() && (reader.symbol() == token::symbol::error))
+                ec = reader.error();
+            return view_type(head, tail - head);
+        }
+
+    default:
+        {
+            const auto result = reader.encoded();
+            if (!reader.next() && (reader.symbol() == token::symbol::error))
+                ec = reader.error();
+            return result;
+        }
+    }
+}
+
+//! @brief Skip over the current value.
+//!
+//! @param reader Reader pointing to a value.
+//! @returns A view of the encoded value.
+//! @throws bintoken::error if the value is malformed.
+inline reader::view_type skip(bintoken::reader& reader)
+{
+    std::error_code ec;
+    auto result = skip(reader, ec);
+    if (ec)
+        throw bintoken::error(ec);
+    return result;
+}
+
+} // namespace partial
+} // namespace bintoken
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_BINTOKEN_PARTIAL_SKIP_HPP
@@ -13,7 +13,9 @@
 
 #include <cstddef> // std::size_t
 #include <stack>
+#include <trial/protocol/core/mapped_file.hpp>
 #include <trial/protocol/bintoken/error.hpp>
+#include <trial/protocol/bintoken/typed_view.hpp>
 #include <trial/protocol/bintoken/detail/decoder.hpp>
 
 namespace trial
@@ -33,6 +35,11 @@ public:
     reader(view_type);
     template <typename T> reader(const T&);
 
+    //! @brief Construct reader over a mapped file.
+    //!
+    //! The reader does not assume ownership of the mapped file.
+    reader(const core::mapped_file&);
+
     //! @brief Advance to the next token.
     bool next() BOOST_NOEXCEPT;
     bool next(token::code::value) BOOST_NOEXCEPT;
@@ -72,15 +79,47 @@ public:
     template <typename T>
     size_type array(T* output, size_type output_length) const;
 
+    //! @brief Return a view of the current value as contiguous numbers.
+    //!
+    //! Compact arrays whose element type matches T are viewed directly in the
+    //! input buffer without copying, provided that the host is little-endian
+    //! and the array data is suitably aligned for T. Otherwise the numbers are
+    //! copied as with array(). Use typed_view::is_copy() to tell the two apart.
+    //!
+    //! A view into the input buffer remains valid after the reader is advanced,
+    //! but not after the input buffer is destroyed.
+    //!
+    //! @throws system_error if requested type is incompatible with the current token.
+    template <typename T>
+    typed_view<T> array_view() const;
+
     //! @brief Return a view of the current value before it is converted into its type.
     const view_type& literal() const BOOST_NOEXCEPT;
 
     //! @returns A view of the remaining buffer.
     const view_type& tail() const BOOST_NOEXCEPT;
 
+    //! @brief Return a view of the current token as encoded in the input buffer.
+    //!
+    //! The view includes the token code and any length prefix.
+    view_type encoded() const BOOST_NOEXCEPT;
+
+    //! @brief Advance to the end token of the current group.
+    //!
+    //! Nested groups are passed by counting group tokens instead of tracking
+    //! them on the nesting stack. Mismatched end tokens within nested groups
+    //! are therefore not detected.
+    //!
+    //! @returns false if the current token does not begin a group, or if an
+    //!          error or end of input was encountered.
+    //! @throws std::bad_alloc if the group cannot be entered on the nesting stack.
+    bool skip_to_end();
+
 private:
     template <typename ReturnType, typename Enable = void> struct overloader;
 
+    template <typename T> bool is_native_array() const BOOST_NOEXCEPT;
+
     mutable detail::decoder decoder;
     std::stack<token::code::value> stack;
 };
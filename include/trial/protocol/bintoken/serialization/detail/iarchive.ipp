@@ -26,6 +26,11 @@ iarchive::iarchive(const T& input)
 {
 }
 
+inline iarchive::iarchive(const core::mapped_file& file)
+    : reader(file)
+{
+}
+
 template <typename T>
 void iarchive::load_override(T& data)
 {
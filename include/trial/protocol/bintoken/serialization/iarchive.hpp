@@ -36,6 +36,11 @@ public:
     template <typename T>
     iarchive(const T&);
 
+    //! @brief Construct archive over a mapped file.
+    //!
+    //! The archive does not assume ownership of the mapped file.
+    iarchive(const core::mapped_file&);
+
     template <typename T>
     void load_override(T& data);
 
@@ -0,0 +1,134 @@
+#ifndef TRIAL_PROTOCOL_BINTOKEN_TYPED_VIEW_HPP
+#define TRIAL_PROTOCOL_BINTOKEN_TYPED_VIEW_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef> // std::size_t
+#include <utility>
+#include <vector>
+
+namespace trial
+{
+namespace protocol
+{
+namespace bintoken
+{
+
+class reader;
+
+//! @brief Contiguous sequence of numbers from a compact array.
+//!
+//! The numbers are either viewed directly in the input buffer of the reader,
+//! or stored in a copy owned by the view. The input buffer must outlive the
+//! view in the former case.
+//!
+//! Created by bintoken::reader::array_view().
+
+template <typename T>
+class typed_view
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using const_pointer = const value_type *;
+    using const_iterator = const value_type *;
+
+    typed_view() noexcept = default;
+
+    typed_view(const typed_view& other)
+        : storage(other.storage),
+          head(storage.empty() ? other.head : storage.data()),
+          length(other.length)
+    {
+    }
+
+    typed_view(typed_view&& other) noexcept
+        : storage(std::move(other.storage)),
+          head(other.head),
+          length(other.length)
+    {
+        other.head = nullptr;
+        other.length = 0;
+    }
+
+    typed_view& operator=(typed_view other) noexcept
+    {
+        storage.swap(other.storage);
+        std::swap(head, other.head);
+        std::swap(length, other.length);
+        return *this;
+    }
+
+    //! @returns true if the numbers are copied rather than viewed in the input buffer.
+    bool is_copy() const noexcept
+    {
+        return !storage.empty();
+    }
+
+    const_pointer data() const noexcept
+    {
+        return head;
+    }
+
+    size_type size() const noexcept
+    {
+        return length;
+    }
+
+    bool empty() const noexcept
+    {
+        return length == 0;
+    }
+
+    const value_type& operator[](size_type index) const noexcept
+    {
+        return head[index];
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return head;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return head + length;
+    }
+
+#ifndef BOOST_DOXYGEN_INVOKED
+private:
+    friend class bintoken::reader;
+
+    typed_view(const_pointer data, size_type size) noexcept
+        : head(data),
+          length(size)
+    {
+    }
+
+    typed_view(std::vector<value_type>&& copy) noexcept
+        : storage(std::move(copy)),
+          head(storage.data()),
+          length(storage.size())
+    {
+    }
+
+private:
+    std::vector<value_type> storage;
+    const_pointer head = nullptr;
+    size_type length = 0;
+#endif
+};
+
+} // namespace bintoken
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_BINTOKEN_TYPED_VIEW_HPP
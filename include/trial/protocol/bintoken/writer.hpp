@@ -22,13 +22,20 @@ namespace protocol
 namespace bintoken
 {
 
-template <std::size_t N = 2 * sizeof(void *)>
+//! @brief Incremental binary token writer.
+//!
+//! By default the output buffer is accessed through the virtual buffer::base
+//! interface and the buffer wrapper is stored in N bytes. If Buffer is a
+//! buffer wrapper derived from buffer::static_base, then the output is
+//! written without virtual function calls. See static_writer.
+template <std::size_t N = 2 * sizeof(void *),
+          typename Buffer = buffer::base<std::uint8_t>>
 class basic_writer
 {
 public:
-    using size_type = typename detail::basic_encoder<N>::size_type;
-    using view_type = typename detail::basic_encoder<N>::view_type;
-    using string_view_type = typename detail::basic_encoder<N>::string_view_type;
+    using size_type = typename detail::basic_encoder<N, Buffer>::size_type;
+    using view_type = typename detail::basic_encoder<N, Buffer>::view_type;
+    using string_view_type = typename detail::basic_encoder<N, Buffer>::string_view_type;
 
     template <typename T> basic_writer(T&);
 
@@ -41,18 +48,29 @@ public:
     template <typename T>
     size_type array(const T *, size_type);
 
+    //! @brief Reserve capacity for an estimated amount of output.
+    //!
+    //! @returns false if the buffer cannot hold the estimated output.
+    bool reserve(size_type);
+
 private:
     void validate_scope(token::code::value, enum bintoken::errc);
 
 private:
     template <typename T, typename Enable = void> struct overloader;
 
-    detail::basic_encoder<N> encoder;
+    detail::basic_encoder<N, Buffer> encoder;
     std::stack<token::code::value> stack;
 };
 
 using writer = basic_writer<>;
 
+//! @brief Incremental binary token writer with statically dispatched buffer.
+//!
+//! Buffer must be a buffer wrapper derived from buffer::static_base.
+template <typename Buffer>
+using static_writer = basic_writer<sizeof(Buffer), Buffer>;
+
 } // namespace bintoken
 } // namespace protocol
 } // namespace trial
@@ -57,25 +57,32 @@ public:
         return size_type(current - begin());
     }
 
-private:
-    virtual bool grow(size_type delta)
+    bool grow(size_type delta)
     {
         return (N - size() >= delta);
     }
 
-    virtual void write(value_type value)
+    void write(value_type value)
     {
         assert(grow(sizeof(value_type)));
         *current = value;
         ++current;
     }
 
-    virtual void write(const view_type& view)
+    void write(const view_type& view)
     {
         assert(grow(view.size()));
         current = std::copy(view.begin(), view.end(), current);
     }
 
+    value_type *claim(size_type size)
+    {
+        assert(grow(size));
+        value_type *result = content.data() + this->size();
+        current += size;
+        return result;
+    }
+
 private:
     std::array<CharT, N>& content;
     iterator current;
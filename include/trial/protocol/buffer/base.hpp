@@ -35,6 +35,33 @@ public:
     virtual bool grow(size_type) = 0;
     virtual void write(value_type) = 0;
     virtual void write(const view_type&) = 0;
+
+    //! @brief Append elements to be filled in by the caller.
+    //!
+    //! Returns a pointer to size appended elements, all of which must be
+    //! assigned, or nullptr if the buffer does not support direct access in
+    //! which case write() must be used instead. The capacity must have been
+    //! obtained with grow().
+    virtual value_type *claim(size_type) { return nullptr; }
+};
+
+//! @brief Statically dispatched buffer interface.
+//!
+//! Buffer wrappers derived from static_base instead of base have no virtual
+//! functions. The encoder calls them directly, so the output operations can
+//! be inlined.
+template <typename CharT>
+class static_base
+{
+public:
+    using value_type = CharT;
+    using size_type = std::size_t;
+    using view_type = core::detail::basic_string_view<value_type, core::char_traits<value_type>>;
+
+    //! @brief Append elements to be filled in by the caller.
+    //!
+    //! Buffer wrappers with direct access hide this function.
+    value_type *claim(size_type) { return nullptr; }
 };
 
 template <typename T, typename Enable = void>
@@ -42,6 +69,25 @@ struct traits
 {
 };
 
+namespace detail
+{
+
+// Buffer wrapper for output type T. A type-erased base selects the wrapper
+// from the traits, otherwise the buffer wrapper is given.
+template <typename Buffer, typename T>
+struct wrapper
+{
+    using type = Buffer;
+};
+
+template <typename CharT, typename T>
+struct wrapper<base<CharT>, T>
+{
+    using type = typename traits<T>::buffer_type;
+};
+
+} // namespace detail
+
 } // namespace buffer
 } // namespace protocol
 } // namespace trial
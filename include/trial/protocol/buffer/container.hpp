@@ -12,6 +12,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <trial/protocol/buffer/base.hpp>
+#include <trial/protocol/buffer/growth.hpp>
 
 namespace trial
 {
@@ -20,21 +21,25 @@ namespace protocol
 namespace buffer
 {
 
-template <typename T>
+template <typename T,
+          typename Super = base<typename T::value_type>,
+          typename Growth = geometric_growth>
 class basic_container
 {
 };
 
 template <template <typename, typename> class ContainerType,
           typename CharT,
-          typename AllocatorType>
-class basic_container< ContainerType<CharT, AllocatorType> >
-    : public base<CharT>
+          typename AllocatorType,
+          typename Super,
+          typename Growth>
+class basic_container< ContainerType<CharT, AllocatorType>, Super, Growth >
+    : public Super
 {
 public:
-    using value_type = typename base<CharT>::value_type;
-    using size_type = typename base<CharT>::size_type;
-    using view_type = typename base<CharT>::view_type;
+    using value_type = typename Super::value_type;
+    using size_type = typename Super::size_type;
+    using view_type = typename Super::view_type;
     using container_type = ContainerType<CharT, AllocatorType>;
 
     basic_container(container_type& data)
@@ -42,25 +47,25 @@ public:
     {
     }
 
-protected:
-    virtual bool grow(size_type delta)
+    bool grow(size_type delta)
     {
         const size_type size = buffer.size() + delta;
         if (size > buffer.capacity())
         {
             if (size > buffer.max_size())
                 return false;
-            buffer.reserve(size);
+            const size_type capacity = Growth::capacity(buffer.capacity(), size);
+            buffer.reserve((capacity < buffer.max_size()) ? capacity : buffer.max_size());
         }
         return true;
     }
 
-    virtual void write(value_type value)
+    void write(value_type value)
     {
         buffer.push_back(value);
     }
 
-    virtual void write(const view_type& view)
+    void write(const view_type& view)
     {
         if (grow(view.size()))
         {
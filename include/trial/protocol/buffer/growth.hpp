@@ -0,0 +1,52 @@
+#ifndef TRIAL_PROTOCOL_BUFFER_GROWTH_HPP
+#define TRIAL_PROTOCOL_BUFFER_GROWTH_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef> // std::size_t
+
+namespace trial
+{
+namespace protocol
+{
+namespace buffer
+{
+
+//! @brief Growth policy with amortized constant time appends.
+//!
+//! The capacity is at least doubled whenever the buffer grows.
+struct geometric_growth
+{
+    using size_type = std::size_t;
+
+    static size_type capacity(size_type current, size_type required) noexcept
+    {
+        const size_type doubled = current + current;
+        return (doubled > required) ? doubled : required;
+    }
+};
+
+//! @brief Growth policy that only reserves the requested capacity.
+struct exact_growth
+{
+    using size_type = std::size_t;
+
+    static size_type capacity(size_type, size_type required) noexcept
+    {
+        return required;
+    }
+};
+
+} // namespace buffer
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_BUFFER_GROWTH_HPP
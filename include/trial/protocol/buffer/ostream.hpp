@@ -33,18 +33,17 @@ public:
 
     basic_ostream(std::basic_ostream<CharT, Traits>& stream) : content(stream) {}
 
-protected:
-    virtual bool grow(size_type)
+    bool grow(size_type)
     {
         return content.good();
     }
 
-    virtual void write(value_type value)
+    void write(value_type value)
     {
         content << value;
     }
 
-    virtual void write(const view_type& view)
+    void write(const view_type& view)
     {
         content << view;
     }
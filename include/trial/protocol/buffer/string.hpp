@@ -14,6 +14,7 @@
 #include <string>
 #include <type_traits>
 #include <trial/protocol/buffer/base.hpp>
+#include <trial/protocol/buffer/growth.hpp>
 
 namespace trial
 {
@@ -22,7 +23,9 @@ namespace protocol
 namespace buffer
 {
 
-template <typename CharT, typename Super = base<CharT> >
+template <typename CharT,
+          typename Super = base<CharT>,
+          typename Growth = geometric_growth>
 class basic_string : public Super
 {
 public:
@@ -35,29 +38,36 @@ public:
     {
     }
 
-protected:
-    virtual bool grow(size_type delta)
+    bool grow(size_type delta)
     {
         const size_type size = content.size() + delta + 1;
         if (size > content.capacity())
         {
             if (size > content.max_size())
                 return false;
-            content.reserve(size);
+            const size_type capacity = Growth::capacity(content.capacity(), size);
+            content.reserve((capacity < content.max_size()) ? capacity : content.max_size());
         }
         return true;
     }
 
-    virtual void write(value_type value)
+    void write(value_type value)
     {
         content.push_back(value);
     }
 
-    virtual void write(const view_type& view)
+    void write(const view_type& view)
     {
         content.append(view.data(), view.size());
     }
 
+    value_type *claim(size_type size)
+    {
+        const size_type offset = content.size();
+        content.resize(offset + size);
+        return &content[offset];
+    }
+
 private:
     std::basic_string<CharT>& content;
 };
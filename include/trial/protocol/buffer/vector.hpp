@@ -13,6 +13,7 @@
 
 #include <vector>
 #include <trial/protocol/buffer/base.hpp>
+#include <trial/protocol/buffer/growth.hpp>
 
 namespace trial
 {
@@ -22,38 +23,40 @@ namespace buffer
 {
 
 template <typename CharT,
-          typename Allocator = typename std::vector<CharT>::allocator_type>
-class vector : public base<CharT>
+          typename Allocator = typename std::vector<CharT>::allocator_type,
+          typename Super = base<CharT>,
+          typename Growth = geometric_growth>
+class vector : public Super
 {
 public:
-    using value_type = typename base<CharT>::value_type;
-    using size_type = typename base<CharT>::size_type;
-    using view_type = typename base<CharT>::view_type;
+    using value_type = typename Super::value_type;
+    using size_type = typename Super::size_type;
+    using view_type = typename Super::view_type;
 
     vector(std::vector<value_type>& data)
         : buffer(data)
     {
     }
 
-protected:
-    virtual bool grow(size_type delta)
+    bool grow(size_type delta)
     {
         const size_type size = buffer.size() + delta;
         if (size > buffer.capacity())
         {
             if (size > buffer.max_size())
                 return false;
-            buffer.reserve(size);
+            const size_type capacity = Growth::capacity(buffer.capacity(), size);
+            buffer.reserve((capacity < buffer.max_size()) ? capacity : buffer.max_size());
         }
         return true;
     }
 
-    virtual void write(value_type value)
+    void write(value_type value)
     {
         buffer.push_back(value);
     }
 
-    virtual void write(const view_type& view)
+    void write(const view_type& view)
     {
         if (grow(view.size()))
         {
@@ -61,6 +64,13 @@ protected:
         }
     }
 
+    value_type *claim(size_type size)
+    {
+        const size_type offset = buffer.size();
+        buffer.resize(offset + size);
+        return buffer.data() + offset;
+    }
+
 private:
     std::vector<value_type, Allocator>& buffer;
 };
@@ -35,6 +35,18 @@ constexpr int countr_zero(T x) noexcept
     return std::countr_zero(typename std::make_unsigned<T>::type(x));
 }
 
+template <typename T>
+constexpr int countl_zero(T x) noexcept
+{
+    return std::countl_zero(typename std::make_unsigned<T>::type(x));
+}
+
+template <typename T>
+constexpr int popcount(T x) noexcept
+{
+    return std::popcount(typename std::make_unsigned<T>::type(x));
+}
+
 #else
 
 namespace detail
@@ -67,6 +79,43 @@ inline constexpr int countr_zero(unsigned long long x) noexcept
         return __builtin_ctzll(x);
 }
 
+// Input must be non-zero
+
+inline constexpr int countl_zero(unsigned x) noexcept
+{
+    return __builtin_clz(x);
+}
+
+inline constexpr int countl_zero(unsigned long x) noexcept
+{
+    return __builtin_clzl(x);
+}
+
+inline constexpr int countl_zero(unsigned long long x) noexcept
+{
+    return __builtin_clzll(x);
+}
+
+#if defined(__POPCNT__)
+
+inline int popcount(unsigned long long x) noexcept
+{
+    return __builtin_popcountll(x);
+}
+
+#else
+
+// Avoid library call when popcnt instruction is unavailable
+inline int popcount(unsigned long long x) noexcept
+{
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return int((x * 0x0101010101010101ULL) >> 56);
+}
+
+#endif
+
 #endif
 
 } // namespace detail
@@ -85,6 +134,30 @@ constexpr int countr_zero(T x) noexcept
 #endif
 }
 
+template <typename T>
+int countl_zero(T x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return detail::countl_zero(typename std::make_unsigned<T>::type(x));
+#else
+    using unsigned_type = typename std::make_unsigned<T>::type;
+    int result = 0;
+    for (auto mask = unsigned_type(~(unsigned_type(-1) >> 1)); (mask != 0) && !(unsigned_type(x) & mask); mask >>= 1)
+        ++result;
+    return result;
+#endif
+}
+
+template <typename T>
+int popcount(T x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return detail::popcount(typename std::make_unsigned<T>::type(x));
+#else
+    return (x == 0) ? 0 : 1 + popcount(T(x & (x - 1)));
+#endif
+}
+
 #endif
 
 } // namespace detail
@@ -0,0 +1,189 @@
+#ifndef TRIAL_PROTOCOL_CORE_DETAIL_MAPPED_FILE_IPP
+#define TRIAL_PROTOCOL_CORE_DETAIL_MAPPED_FILE_IPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+#if TRIAL_PROTOCOL_MAPPED_FILE_POSIX
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#else
+# include <fstream>
+# include <iterator>
+#endif
+
+namespace trial
+{
+namespace protocol
+{
+namespace core
+{
+
+#if TRIAL_PROTOCOL_MAPPED_FILE_POSIX
+
+inline mapped_file::mapped_file(const std::string& path, access hint)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw std::system_error(errno, std::generic_category(), path);
+
+    struct ::stat status;
+    if (::fstat(fd, &status) == -1)
+    {
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), path);
+    }
+
+    length = size_type(status.st_size);
+    if (length > 0)
+    {
+        void *address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED)
+        {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), path);
+        }
+        head = static_cast<const value_type *>(address);
+    }
+    // The mapping remains valid after the file descriptor is closed
+    ::close(fd);
+
+    advise(hint);
+}
+
+inline void mapped_file::advise(access hint) noexcept
+{
+    if (length == 0)
+        return;
+
+    int advice = MADV_NORMAL;
+    switch (hint)
+    {
+    case access::normal:
+        break;
+    case access::sequential:
+        advice = MADV_SEQUENTIAL;
+        break;
+    case access::random:
+        advice = MADV_RANDOM;
+        break;
+    }
+    // Advice is only a hint, so failures are ignored
+    (void)::madvise(const_cast<value_type *>(head), length, advice);
+}
+
+inline void mapped_file::release() noexcept
+{
+    if (length > 0)
+    {
+        ::munmap(const_cast<value_type *>(head), length);
+    }
+    head = nullptr;
+    length = 0;
+}
+
+inline mapped_file::mapped_file(mapped_file&& other) noexcept
+    : head(other.head),
+      length(other.length)
+{
+    other.head = nullptr;
+    other.length = 0;
+}
+
+inline mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        std::swap(head, other.head);
+        std::swap(length, other.length);
+    }
+    return *this;
+}
+
+#else
+
+inline mapped_file::mapped_file(const std::string& path, access)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file)
+        throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory), path);
+    storage.assign(std::istreambuf_iterator<value_type>(file),
+                   std::istreambuf_iterator<value_type>());
+    head = storage.data();
+    length = storage.size();
+}
+
+inline void mapped_file::advise(access) noexcept
+{
+}
+
+inline void mapped_file::release() noexcept
+{
+    storage.clear();
+    head = nullptr;
+    length = 0;
+}
+
+inline mapped_file::mapped_file(mapped_file&& other) noexcept
+    : head(other.head),
+      length(other.length),
+      storage(std::move(other.storage))
+{
+    other.head = nullptr;
+    other.length = 0;
+}
+
+inline mapped_file& mapped_file::operator=(mapped_file&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        storage = std::move(other.storage);
+        std::swap(head, other.head);
+        std::swap(length, other.length);
+    }
+    return *this;
+}
+
+#endif
+
+inline mapped_file::~mapped_file()
+{
+    release();
+}
+
+inline auto mapped_file::data() const noexcept -> const value_type *
+{
+    return head;
+}
+
+inline auto mapped_file::size() const noexcept -> size_type
+{
+    return length;
+}
+
+inline bool mapped_file::empty() const noexcept
+{
+    return length == 0;
+}
+
+} // namespace core
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_CORE_DETAIL_MAPPED_FILE_IPP
@@ -15,8 +15,106 @@
 # define TRIAL_PROTOCOL_USE_SSE2 1
 #endif
 
+// Wider instruction sets are selected at runtime unless they are enabled at
+// compile-time or dispatching is disabled with TRIAL_PROTOCOL_NO_SIMD_DISPATCH
+
+#if __AVX2__
+# define TRIAL_PROTOCOL_USE_AVX2 1
+#endif
+
+#if __AVX512BW__
+# define TRIAL_PROTOCOL_USE_AVX512 1
+#endif
+
+#if defined(TRIAL_PROTOCOL_USE_SSE2) && !defined(TRIAL_PROTOCOL_NO_SIMD_DISPATCH)
+# if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#  define TRIAL_PROTOCOL_USE_SIMD_DISPATCH 1
+#  define TRIAL_PROTOCOL_TARGET_AVX2 __attribute__((target("avx2")))
+#  define TRIAL_PROTOCOL_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+# endif
+#endif
+
 #if defined(TRIAL_PROTOCOL_USE_SSE2)
 # include <emmintrin.h>
 #endif
 
+#if defined(TRIAL_PROTOCOL_USE_SIMD_DISPATCH) || defined(TRIAL_PROTOCOL_USE_AVX2) || defined(TRIAL_PROTOCOL_USE_AVX512)
+# include <immintrin.h>
+#endif
+
+#if defined(TRIAL_PROTOCOL_USE_AVX2) || defined(TRIAL_PROTOCOL_USE_SIMD_DISPATCH)
+# define TRIAL_PROTOCOL_HAS_AVX2 1
+#endif
+
+#if defined(TRIAL_PROTOCOL_USE_AVX512) || defined(TRIAL_PROTOCOL_USE_SIMD_DISPATCH)
+# define TRIAL_PROTOCOL_HAS_AVX512 1
+#endif
+
+#if !defined(TRIAL_PROTOCOL_TARGET_AVX2)
+# define TRIAL_PROTOCOL_TARGET_AVX2
+#endif
+
+#if !defined(TRIAL_PROTOCOL_TARGET_AVX512)
+# define TRIAL_PROTOCOL_TARGET_AVX512
+#endif
+
+namespace trial
+{
+namespace protocol
+{
+namespace core
+{
+namespace detail
+{
+namespace simd
+{
+
+// Instruction sets ordered by vector width
+
+enum class isa
+{
+    scalar,
+    sse2,
+    avx2,
+    avx512
+};
+
+//! @brief Widest instruction set supported by both compiler and processor.
+//!
+//! The processor is only queried once.
+
+inline isa supported() noexcept
+{
+#if defined(TRIAL_PROTOCOL_USE_AVX512)
+    return isa::avx512;
+#elif defined(TRIAL_PROTOCOL_USE_SIMD_DISPATCH)
+    struct query
+    {
+        static isa widest() noexcept
+        {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512bw"))
+                return isa::avx512;
+            if (__builtin_cpu_supports("avx2"))
+                return isa::avx2;
+            return isa::sse2;
+        }
+    };
+    static const isa result = query::widest();
+    return result;
+#elif defined(TRIAL_PROTOCOL_USE_AVX2)
+    return isa::avx2;
+#elif defined(TRIAL_PROTOCOL_USE_SSE2)
+    return isa::sse2;
+#else
+    return isa::scalar;
+#endif
+}
+
+} // namespace simd
+} // namespace detail
+} // namespace core
+} // namespace protocol
+} // namespace trial
+
 #endif // TRIAL_PROTOCOL_CORE_DETAIL_SIMD_HPP
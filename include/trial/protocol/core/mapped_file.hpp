@@ -0,0 +1,107 @@
+#ifndef TRIAL_PROTOCOL_CORE_MAPPED_FILE_HPP
+#define TRIAL_PROTOCOL_CORE_MAPPED_FILE_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef> // std::size_t
+#include <string>
+#include <vector>
+
+#if !defined(TRIAL_PROTOCOL_MAPPED_FILE_POSIX)
+# if defined(__unix__) || defined(__APPLE__)
+#  define TRIAL_PROTOCOL_MAPPED_FILE_POSIX 1
+# else
+#  define TRIAL_PROTOCOL_MAPPED_FILE_POSIX 0
+# endif
+#endif
+
+namespace trial
+{
+namespace protocol
+{
+namespace core
+{
+
+//! @brief Read-only file mapped into memory.
+//!
+//! The content of the file is available as a contiguous buffer that can be
+//! passed to readers and input archives without copying it into a string.
+//!
+//! Readers and archives constructed from a mapped file do not assume
+//! ownership, so the mapped file must outlive them.
+//!
+//! On platforms without mmap the file content is read into memory instead.
+//!
+//! @code
+//! core::mapped_file file("input.json");
+//! json::reader reader(file);
+//! @endcode
+
+class mapped_file
+{
+public:
+    using value_type = char;
+    using size_type = std::size_t;
+
+    //! @brief Expected access pattern passed to the operating system.
+    enum class access
+    {
+        normal,
+        sequential,
+        random
+    };
+
+    //! @brief Maps file into memory.
+    //!
+    //! @param[in] path Path to file.
+    //! @param[in] hint Expected access pattern of the file content.
+    //! @throws std::system_error if the file cannot be opened or mapped.
+    explicit mapped_file(const std::string& path, access hint = access::sequential);
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file(mapped_file&&) noexcept;
+    ~mapped_file();
+
+    mapped_file& operator=(const mapped_file&) = delete;
+    mapped_file& operator=(mapped_file&&) noexcept;
+
+    //! @returns Pointer to the file content.
+    const value_type *data() const noexcept;
+
+    //! @returns Size of file content in bytes.
+    size_type size() const noexcept;
+
+    //! @returns true if the file is empty.
+    bool empty() const noexcept;
+
+    //! @brief Changes the expected access pattern.
+    void advise(access hint) noexcept;
+
+#ifndef BOOST_DOXYGEN_INVOKED
+private:
+    void release() noexcept;
+
+private:
+    const value_type *head = nullptr;
+    size_type length = 0;
+#if !TRIAL_PROTOCOL_MAPPED_FILE_POSIX
+    std::vector<value_type> storage;
+#endif
+#endif
+};
+
+} // namespace core
+} // namespace protocol
+} // namespace trial
+
+#include <trial/protocol/core/detail/mapped_file.ipp>
+
+#endif // TRIAL_PROTOCOL_CORE_MAPPED_FILE_HPP
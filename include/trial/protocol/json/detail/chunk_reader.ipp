@@ -18,7 +18,9 @@ namespace json
 template <typename CharT>
 bool basic_chunk_reader<CharT>::next()
 {
-    auto before_decoder = super::decoder;
+    // Only the position of the current token is saved. The token is re-scanned
+    // in the rare case that the next token is incomplete.
+    const auto checkpoint = super::decoder.checkpoint();
     super::decoder.next();
     if (super::decoder.code() != token::code::end)
     {
@@ -26,7 +28,7 @@ bool basic_chunk_reader<CharT>::next()
             return true;
     }
     // Restore decoder
-    super::decoder = std::move(before_decoder);
+    super::decoder.rollback(checkpoint);
     return false;
 }
 
@@ -0,0 +1,77 @@
+#ifndef TRIAL_PROTOCOL_JSON_DETAIL_CONCURRENCY_HPP
+#define TRIAL_PROTOCOL_JSON_DETAIL_CONCURRENCY_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+namespace detail
+{
+
+inline std::size_t default_concurrency() noexcept
+{
+    const auto result = std::thread::hardware_concurrency();
+    return (result > 0) ? result : 1;
+}
+
+// Threads that are joined on all exits.
+//
+// The thread function must not throw.
+
+class thread_group
+{
+public:
+    thread_group() = default;
+    thread_group(const thread_group&) = delete;
+    thread_group& operator=(const thread_group&) = delete;
+
+    ~thread_group()
+    {
+        join();
+    }
+
+    template <typename Function>
+    void spawn(std::size_t count, Function function)
+    {
+        threads.reserve(threads.size() + count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            threads.emplace_back(function);
+        }
+    }
+
+    void join()
+    {
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        threads.clear();
+    }
+
+private:
+    std::vector<std::thread> threads;
+};
+
+} // namespace detail
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_DETAIL_CONCURRENCY_HPP
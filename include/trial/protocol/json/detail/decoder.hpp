@@ -18,6 +18,7 @@
 #include <trial/protocol/core/char_traits.hpp>
 #include <trial/protocol/json/token.hpp>
 #include <trial/protocol/json/error.hpp>
+#include <trial/protocol/json/validation.hpp>
 
 namespace trial
 {
@@ -39,9 +40,11 @@ public:
 
     basic_decoder();
     basic_decoder(const_pointer first, const_pointer last);
+    basic_decoder(const_pointer first, const_pointer last, json::validation);
     basic_decoder(const_pointer first, size_type length);
+    basic_decoder(const_pointer first, const_pointer last, const std::uint32_t *structural);
     template <std::size_t M>
-    basic_decoder(const value_type (&array)[M]);
+    explicit basic_decoder(const value_type (&array)[M]);
 
     basic_decoder(const basic_decoder&) = default;
     basic_decoder(basic_decoder&&) = default;
@@ -53,6 +56,23 @@ public:
 
     void shift(const_pointer first, size_type length);
 
+    // Rollback to the current token after subsequent tokens have been
+    // scanned. The token is re-scanned from the same input, so only its
+    // position is saved. Not for use with a structural index.
+    struct checkpoint_type
+    {
+        view_type literal;
+        const_pointer tail;
+        token::code::value code;
+    };
+    checkpoint_type checkpoint() const noexcept;
+    void rollback(const checkpoint_type&) noexcept;
+
+    // Structural index cursor
+    const std::uint32_t *structural() const noexcept;
+    void structural(const std::uint32_t *) noexcept;
+    void seek(const std::uint32_t *) noexcept;
+
     void code(token::code::value) noexcept;
     token::code::value code() const noexcept;
     std::error_code error() const noexcept;
@@ -110,6 +130,13 @@ private:
             } string;
         } scan;
     } current;
+    struct
+    {
+        // Token positions are relative to origin
+        const_pointer origin;
+        const std::uint32_t *position;
+    } indexed;
+    json::validation mode;
 };
 
 } // namespace detail
@@ -17,8 +17,8 @@
 #include <limits>
 #include <type_traits>
 #include <trial/protocol/core/detail/config.hpp>
-#include <trial/protocol/json/detail/string_converter.hpp>
 #include <trial/protocol/json/detail/decoder.hpp>
+#include <trial/protocol/json/detail/real.hpp>
 #include <trial/protocol/json/detail/traits.hpp>
 #include <trial/protocol/json/detail/scan.hpp>
 #include <trial/protocol/json/error.hpp>
@@ -39,15 +39,39 @@ namespace detail
 template <typename CharT>
 basic_decoder<CharT>::basic_decoder()
     : input(nullptr, nullptr),
-      current{ token::code::uninitialized, {}, {} }
+      current{ token::code::uninitialized, {}, {} },
+      indexed{ nullptr, nullptr },
+      mode(json::validation::lenient)
 {
 }
 
 template <typename CharT>
 basic_decoder<CharT>::basic_decoder(const_pointer first,
                                     const_pointer last)
+    : basic_decoder(first, last, json::validation::lenient)
+{
+}
+
+template <typename CharT>
+basic_decoder<CharT>::basic_decoder(const_pointer first,
+                                    const_pointer last,
+                                    json::validation validation)
+    : input(first, last),
+      current{token::code::uninitialized, {}, {}},
+      indexed{ nullptr, nullptr },
+      mode(validation)
+{
+    next();
+}
+
+template <typename CharT>
+basic_decoder<CharT>::basic_decoder(const_pointer first,
+                                    const_pointer last,
+                                    const std::uint32_t *structural)
     : input(first, last),
-      current{token::code::uninitialized, {}, {}}
+      current{token::code::uninitialized, {}, {}},
+      indexed{ first, structural },
+      mode(json::validation::lenient)
 {
     next();
 }
@@ -76,6 +100,55 @@ void basic_decoder<CharT>::shift(const_pointer first,
     current.code = token::code::shifted;
     current.view = view_type(input.data(), size_type(0));
     current.scan.string.length = 0;
+    indexed.position = nullptr;
+}
+
+template <typename CharT>
+auto basic_decoder<CharT>::checkpoint() const noexcept -> checkpoint_type
+{
+    return { current.view, input.begin(), current.code };
+}
+
+template <typename CharT>
+void basic_decoder<CharT>::rollback(const checkpoint_type& checkpoint) noexcept
+{
+    assert(indexed.position == nullptr);
+
+    if (checkpoint.literal.empty())
+    {
+        current.view = checkpoint.literal;
+        current.scan.string.length = 0;
+    }
+    else
+    {
+        // Re-scan token to restore auxiliary information
+        input = view_type(checkpoint.literal.begin(), input.end());
+        assume_next();
+        assert(current.view.end() == checkpoint.literal.end());
+    }
+    input = view_type(checkpoint.tail, input.end());
+    current.code = checkpoint.code;
+}
+
+template <typename CharT>
+auto basic_decoder<CharT>::structural() const noexcept -> const std::uint32_t *
+{
+    return indexed.position;
+}
+
+template <typename CharT>
+void basic_decoder<CharT>::structural(const std::uint32_t *position) noexcept
+{
+    indexed.position = position;
+}
+
+template <typename CharT>
+void basic_decoder<CharT>::seek(const std::uint32_t *position) noexcept
+{
+    // Continue from token at position
+    assert(indexed.origin + *position <= input.end());
+    input = view_type(indexed.origin + *position, input.end());
+    indexed.position = position;
 }
 
 template <typename CharT>
@@ -1056,261 +1129,77 @@ void basic_decoder<CharT>::real_value(T& output) const noexcept
 
     assert(current.code == token::code::real);
 
-    static constexpr T zero = T(0.0);
-    static constexpr T one = T(1.0);
-    static constexpr T base = T(10.0);
-
     const CharT *marker = current.view.begin();
     const bool is_negative = *marker == traits::alphabet<CharT>::minus;
     if (is_negative)
     {
         ++marker;
     }
-    T result = unsigned(*marker++ - traits::alphabet<CharT>::digit_0);
-    while (marker != current.scan.number.integer_tail)
+    const CharT *integer_head = marker;
+    marker = current.scan.number.integer_tail;
+    const CharT *fraction_head = marker;
+    if (*marker == traits::alphabet<CharT>::dot)
     {
-        result *= base;
-        result += unsigned(*marker - traits::alphabet<CharT>::digit_0);
-        ++marker;
+        fraction_head = marker + 1;
+        marker = current.scan.number.fraction_tail;
     }
-    if (*marker == traits::alphabet<CharT>::dot)
+    const CharT *fraction_tail = marker;
+
+    int exponent = 0;
+    if ((marker != current.view.end()) &&
+        ((*marker == traits::alphabet<CharT>::letter_e) || (*marker == traits::alphabet<CharT>::letter_E)))
     {
         ++marker;
-        T fraction = zero;
-
-        static constexpr T fractions[][10] = {
-            { 0e-1, 1e-1, 2e-1, 3e-1, 4e-1, 5e-1, 6e-1, 7e-1, 8e-1, 9e-1 },
-            { 0e-2, 1e-2, 2e-2, 3e-2, 4e-2, 5e-2, 6e-2, 7e-2, 8e-2, 9e-2 },
-            { 0e-3, 1e-3, 2e-3, 3e-3, 4e-3, 5e-3, 6e-3, 7e-3, 8e-3, 9e-3 },
-            { 0e-4, 1e-4, 2e-4, 3e-4, 4e-4, 5e-4, 6e-4, 7e-4, 8e-4, 9e-4 },
-            { 0e-5, 1e-5, 2e-5, 3e-5, 4e-5, 5e-5, 6e-5, 7e-5, 8e-5, 9e-5 },
-            { 0e-6, 1e-6, 2e-6, 3e-6, 4e-6, 5e-6, 6e-6, 7e-6, 8e-6, 9e-6 },
-            { 0e-7, 1e-7, 2e-7, 3e-7, 4e-7, 5e-7, 6e-7, 7e-7, 8e-7, 9e-7 },
-            { 0e-8, 1e-8, 2e-8, 3e-8, 4e-8, 5e-8, 6e-8, 7e-8, 8e-8, 9e-8 },
-            { 0e-9, 1e-9, 2e-9, 3e-9, 4e-9, 5e-9, 6e-9, 7e-9, 8e-9, 9e-9 },
-            { 0e-10, 1e-10, 2e-10, 3e-10, 4e-10, 5e-10, 6e-10, 7e-10, 8e-10, 9e-10 },
-            { 0e-11, 1e-11, 2e-11, 3e-11, 4e-11, 5e-11, 6e-11, 7e-11, 8e-11, 9e-11 },
-            { 0e-12, 1e-12, 2e-12, 3e-12, 4e-12, 5e-12, 6e-12, 7e-12, 8e-12, 9e-12 },
-            { 0e-13, 1e-13, 2e-13, 3e-13, 4e-13, 5e-13, 6e-13, 7e-13, 8e-13, 9e-13 },
-            { 0e-14, 1e-14, 2e-14, 3e-14, 4e-14, 5e-14, 6e-14, 7e-14, 8e-14, 9e-14 },
-            { 0e-15, 1e-15, 2e-15, 3e-15, 4e-15, 5e-15, 6e-15, 7e-15, 8e-15, 9e-15 },
-            { 0e-16, 1e-16, 2e-16, 3e-16, 4e-16, 5e-16, 6e-16, 7e-16, 8e-16, 9e-16 },
-            { 0e-17, 1e-17, 2e-17, 3e-17, 4e-17, 5e-17, 6e-17, 7e-17, 8e-17, 9e-17 },
-            { 0e-18, 1e-18, 2e-18, 3e-18, 4e-18, 5e-18, 6e-18, 7e-18, 8e-18, 9e-18 }
-        };
-
-        const auto fraction_size = current.scan.number.fraction_tail - marker;
-        switch (fraction_size)
+        const bool is_exponent_negative = *marker == traits::alphabet<CharT>::minus;
+        if (is_exponent_negative || *marker == traits::alphabet<CharT>::plus)
         {
-        default:
+            ++marker;
+        }
+        // Saturate far beyond the range of any floating-point type
+        const int max = 1000000;
+        for (; marker != current.view.end(); ++marker)
         {
-            static constexpr T superbase = T(1e4);
-            T scale = one;
-
-            while (current.scan.number.fraction_tail - marker > 4)
+            if (exponent < max)
             {
-                const auto delta1000 = unsigned(marker[0] - traits::alphabet<CharT>::digit_0);
-                const auto delta100 = unsigned(marker[1] - traits::alphabet<CharT>::digit_0);
-                const auto delta10 = unsigned(marker[2] - traits::alphabet<CharT>::digit_0);
-                const auto delta1 = unsigned(marker[3] - traits::alphabet<CharT>::digit_0);
-                const auto delta = delta1000 * 1000 + delta100 * 100 + delta10 * 10 + delta1;
-                fraction = fraction * superbase + delta;
-                scale *= superbase;
-                marker += 4;
+                exponent *= 10;
+                exponent += int(*marker - traits::alphabet<CharT>::digit_0);
             }
-
-            while (current.scan.number.fraction_tail > marker)
-            {
-                const unsigned delta = *marker - traits::alphabet<CharT>::digit_0;
-                scale *= base;
-                fraction *= base;
-                fraction += delta;
-                ++marker;
-            }
-            fraction /= scale;
-            break;
-        }
-        case 18:
-        {
-            const auto head = marker;
-            marker += 18;
-            std::uint64_t integer;
-            unsigned_value(head, marker, integer);
-            fraction += integer * T(1e-18);
-            break;
-        }
-        case 17:
-        {
-            const auto head = marker;
-            marker += 17;
-            std::uint64_t integer;
-            unsigned_value(head, marker, integer);
-            fraction += integer * T(1e-17);
-            break;
-        }
-        case 16:
-        {
-            const auto head = marker;
-            marker += 16;
-            std::uint64_t integer;
-            unsigned_value(head, marker, integer);
-            fraction += integer * T(1e-16);
-            break;
-        }
-        case 15:
-        {
-            const auto head = marker;
-            marker += 15;
-            std::uint64_t integer;
-            unsigned_value(head, marker, integer);
-            fraction += integer * T(1e-15);
-            break;
-        }
-        case 14:
-        {
-            const auto head = marker;
-            marker += 14;
-            std::uint64_t integer;
-            unsigned_value(head, marker, integer);
-            fraction += integer * T(1e-14);
-            break;
         }
-        case 13:
+        if (is_exponent_negative)
         {
-            const auto head = marker;
-            marker += 13;
-            std::uint64_t integer;
-            unsigned_value(head, marker, integer);
-            fraction += integer * T(1e-13);
-            break;
-        }
-        case 12:
-        {
-            const auto head = marker;
-            marker += 12;
-            std::uint64_t integer;
-            unsigned_value(head, marker, integer);
-            fraction += integer * T(1e-12);
-            break;
+            exponent = -exponent;
         }
-        case 11:
-            fraction += fractions[0][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[1][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[2][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[3][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[4][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[5][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[6][unsigned(*marker++- traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[7][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[8][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[9][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[10][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            break;
-        case 10:
-            fraction += fractions[0][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[1][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[2][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[3][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[4][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[5][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[6][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[7][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[8][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[9][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            break;
-        case 9:
-            fraction += fractions[0][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[1][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[2][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[3][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[4][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[5][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[6][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[7][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[8][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            break;
-        case 8:
-            fraction += fractions[0][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[1][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[2][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[3][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[4][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[5][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[6][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[7][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            break;
-        case 7:
-            fraction += fractions[0][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[1][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[2][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[3][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[4][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[5][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[6][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            break;
-        case 6:
-            fraction += fractions[0][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[1][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[2][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[3][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[4][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[5][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            break;
-        case 5:
-            fraction += fractions[0][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[1][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[2][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[3][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[4][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            break;
-        case 4:
-            fraction += fractions[0][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[1][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[2][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[3][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            break;
-        case 3:
-            fraction += fractions[0][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[1][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[2][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            break;
-        case 2:
-            fraction += fractions[0][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            fraction += fractions[1][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            break;
-        case 1:
-            fraction += fractions[0][unsigned(*marker++ - traits::alphabet<CharT>::digit_0)];
-            break;
-        case 0:
-            break;
-        }
-        result += fraction;
     }
-    if ((*marker == traits::alphabet<CharT>::letter_e) || (*marker == traits::alphabet<CharT>::letter_E))
+
+    const auto integer_size = current.scan.number.integer_tail - integer_head;
+    const auto fraction_size = fraction_tail - fraction_head;
+    T result;
+    if TRIAL_LIKELY(integer_size + fraction_size <= std::numeric_limits<std::uint64_t>::digits10)
     {
-        ++marker;
-        const bool is_exponent_negative = *marker == traits::alphabet<CharT>::minus;
-        if (is_exponent_negative || *marker == traits::alphabet<CharT>::plus)
-        {
-            ++marker;
-        }
-        int exponent = 0;
-        const int max = std::numeric_limits<int>::max();
-        while (true)
+        static constexpr std::uint64_t scale[] = {
+            UINT64_C(1), UINT64_C(10), UINT64_C(100), UINT64_C(1000), UINT64_C(10000),
+            UINT64_C(100000), UINT64_C(1000000), UINT64_C(10000000), UINT64_C(100000000),
+            UINT64_C(1000000000), UINT64_C(10000000000), UINT64_C(100000000000),
+            UINT64_C(1000000000000), UINT64_C(10000000000000), UINT64_C(100000000000000),
+            UINT64_C(1000000000000000), UINT64_C(10000000000000000), UINT64_C(100000000000000000),
+            UINT64_C(1000000000000000000)
+        };
+        // Significand fits into integer
+        std::uint64_t integer = 0;
+        unsigned_value(integer_head, current.scan.number.integer_tail, integer);
+        std::uint64_t fraction = 0;
+        if (fraction_size > 0)
         {
-            const unsigned delta = *marker - traits::alphabet<CharT>::digit_0;
-            if (delta > 9)
-                break;
-            if (max / 10 < exponent) // Overflow
-            {
-                output = std::numeric_limits<T>::infinity();
-                return;
-            }
-            exponent *= 10;
-            exponent += delta;
-            ++marker;
+            unsigned_value(fraction_head, fraction_tail, fraction);
         }
-        result *= detail::power10<T>(is_exponent_negative ? -exponent : exponent);
+        result = to_real<T>(integer * scale[fraction_size] + fraction,
+                            std::int64_t(exponent) - fraction_size);
+    }
+    else
+    {
+        result = to_real<T>(integer_head, current.scan.number.integer_tail,
+                            fraction_head, fraction_tail,
+                            exponent);
     }
     output = is_negative ? -result : result;
 }
@@ -1331,7 +1220,8 @@ template <typename CharT>
 template <typename Collector>
 void basic_decoder<CharT>::string_value(Collector& collector) const noexcept
 {
-    // FIXME: Validate string [ http://www.w3.org/International/questions/qa-forms-utf-8 ]
+    // The string has been validated by next_string() according to the
+    // validation mode.
     assert(current.code == token::code::string || current.code == token::code::key);
 
     // Skip initial and terminating quotes
@@ -1816,6 +1706,7 @@ void basic_decoder<CharT>::next_string() noexcept
     auto marker = input.begin();
     const auto end = input.end();
     bool in_segment = false;
+    bool has_multibyte = false;
     ++marker; // Skip initial '"'
     while (marker != end)
     {
@@ -1888,6 +1779,12 @@ void basic_decoder<CharT>::next_string() noexcept
 
         case traits::category::quote:
             // Handle end of string
+            if (has_multibyte)
+            {
+                const auto last = marker - 1;
+                if (scan_strict_utf8(input.begin() + 1, last) != last)
+                    goto invalid_encoding;
+            }
             current.view = view_type(input.begin(), marker); // Includes terminating '"'
             input.remove_front(std::distance(input.begin(), marker));
             current.code = token::code::string;
@@ -1910,6 +1807,8 @@ void basic_decoder<CharT>::next_string() noexcept
             break;
 
         case traits::category::extra_5:
+            if (mode == json::validation::strict)
+                goto case_multibyte;
             // Skip UTF-8 characters
             // Check for 10xxxxxx pattern of subsequent bytes
             if (marker == end)
@@ -1919,6 +1818,8 @@ void basic_decoder<CharT>::next_string() noexcept
             ++marker;
             goto case_extra_4;
         case traits::category::extra_4:
+            if (mode == json::validation::strict)
+                goto case_multibyte;
         case_extra_4:
             if (marker == end)
                 goto error;
@@ -1927,6 +1828,8 @@ void basic_decoder<CharT>::next_string() noexcept
             ++marker;
             goto case_extra_3;
         case traits::category::extra_3:
+            if (mode == json::validation::strict)
+                goto case_multibyte;
         case_extra_3:
             if (marker == end)
                 goto error;
@@ -1935,6 +1838,8 @@ void basic_decoder<CharT>::next_string() noexcept
             ++marker;
             goto case_extra_2;
         case traits::category::extra_2:
+            if (mode == json::validation::strict)
+                goto case_multibyte;
         case_extra_2:
             if (marker == end)
                 goto error;
@@ -1943,6 +1848,8 @@ void basic_decoder<CharT>::next_string() noexcept
             ++marker;
             goto case_extra_1;
         case traits::category::extra_1:
+            if (mode == json::validation::strict)
+                goto case_multibyte;
         case_extra_1:
             if (marker == end)
                 goto error;
@@ -1962,7 +1869,27 @@ void basic_decoder<CharT>::next_string() noexcept
             }
             break;
 
+        case_multibyte:
+            // Skip everything but escapes and the terminating quote in bulk,
+            // and validate UTF-8 once the entire string has been found.
+            has_multibyte = true;
+            marker = scan_unescaped(marker, end);
+            if (in_segment)
+            {
+                current.scan.string.segment_tail[current.scan.string.length - 1] = marker;
+            }
+            else if (current.scan.string.length < segment_max)
+            {
+                current.scan.string.segment_tail[current.scan.string.length] = marker;
+                ++current.scan.string.length;
+                in_segment = true;
+            }
+            break;
+
         case traits::category::illegal:
+            // Non-ASCII bytes are reported as invalid encoding
+            if ((mode == json::validation::strict) && (static_cast<unsigned char>(marker[-1]) >= 0x80))
+                goto case_multibyte;
             goto error;
         }
     }
@@ -1970,11 +1897,33 @@ void basic_decoder<CharT>::next_string() noexcept
  error:
     current.view = view_type(input.begin(), marker);
     current.code = token::code::error_unexpected_token;
+    return;
+
+ invalid_encoding:
+    current.view = view_type(input.begin(), marker);
+    current.code = token::code::error_invalid_encoding;
 }
 
 template <typename CharT>
 void basic_decoder<CharT>::skip_whitespaces() noexcept
 {
+    if (indexed.position)
+    {
+        // Jump directly to the next token. Only whitespaces may separate
+        // tokens, so the index is only used if the current token ended at
+        // the next token or at a whitespace.
+        const auto marker = indexed.origin + *indexed.position;
+        if TRIAL_LIKELY((marker == input.begin()) ||
+                        ((marker > input.begin()) && traits::is_space(input.front())))
+        {
+            input.remove_front(std::distance(input.begin(), marker));
+            if (!input.empty())
+                ++indexed.position; // Retain sentinel
+            return;
+        }
+        // Index is out of sync with input so continue without it
+        indexed.position = nullptr;
+    }
     const auto it = scan_whitespace(input.begin(), input.end());
     input.remove_front(std::distance(input.begin(), it));
 }
@@ -28,13 +28,18 @@ namespace json
 namespace detail
 {
 
-template <typename CharT, std::size_t N>
+//! @brief JSON encoder.
+//!
+//! The output buffer is type-erased if Buffer is buffer::base, in which case
+//! the buffer wrapper is stored in N bytes. Otherwise Buffer is the buffer
+//! wrapper itself and the output operations are dispatched statically.
+template <typename CharT, std::size_t N, typename Buffer = buffer::base<CharT>>
 class basic_encoder
 {
 public:
     using value_type = CharT;
     using size_type = std::size_t;
-    using buffer_type = buffer::base<value_type>;
+    using buffer_type = Buffer;
     using string_type = std::basic_string<value_type, core::char_traits<value_type>>;
     using view_type = core::detail::basic_string_view<value_type, core::char_traits<value_type>>;
 
@@ -55,6 +60,14 @@ public:
 
     size_type literal(const view_type&);
 
+    //! @brief Write array of numbers
+    //!
+    //! Type T can be an integral type (except bool) or a floating-point type.
+    template <typename T> size_type array(const T *, size_type);
+
+    //! @brief Reserve capacity in output buffer
+    bool reserve(size_type);
+
 private:
     template <typename T, typename Enable = void>
     struct overloader;
@@ -11,11 +11,14 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cmath>
 #include <iterator>
 #include <array>
 #include <type_traits>
 #include <trial/protocol/buffer/base.hpp>
+#include <trial/protocol/json/detail/integer_converter.hpp>
+#include <trial/protocol/json/detail/scan.hpp>
 #include <trial/protocol/json/detail/string_converter.hpp>
 #include <trial/protocol/json/detail/traits.hpp>
 #include <trial/protocol/json/token.hpp>
@@ -29,33 +32,36 @@ namespace json
 namespace detail
 {
 
-template <typename T, typename Enable = void>
-struct absolute
-{
-    static T value(T value)
-    {
-        return std::abs(value);
-    }
-};
+// Formatting of numbers in arrays
 
-template <typename T>
-struct absolute<T,
-                typename std::enable_if<std::is_unsigned<T>::value>::type>
+template <typename CharT, typename T, typename Enable = void>
+struct number_converter : public integer_converter<CharT, T>
 {
-    static T value(T value)
-    {
-        return value;
-    }
 };
 
-template <typename T>
-struct absolute<T,
-                typename std::enable_if<std::is_same<T, signed char>::value ||
-                                        std::is_same<T, signed short>::value>::type>
+template <typename CharT, typename T>
+struct number_converter<CharT, T,
+                        typename std::enable_if<std::is_floating_point<T>::value>::type>
 {
-    static T value(T value)
+    using converter = string_converter<CharT, T>;
+
+    static constexpr std::size_t max_size = converter::max_size;
+
+    static std::size_t encode(T value, CharT *output) noexcept
     {
-        return value < 0 ? -value : value;
+        switch (std::fpclassify(value))
+        {
+        case FP_INFINITE:
+        case FP_NAN:
+            // Infinity and NaN must be encoded as null
+            output[0] = traits::alphabet<CharT>::letter_n;
+            output[1] = traits::alphabet<CharT>::letter_u;
+            output[2] = traits::alphabet<CharT>::letter_l;
+            output[3] = traits::alphabet<CharT>::letter_l;
+            return 4;
+        default:
+            return converter::encode(value, output);
+        }
     }
 };
 
@@ -63,107 +69,107 @@ struct absolute<T,
 // encoder::overloader
 //-----------------------------------------------------------------------------
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T, typename Enable>
-struct basic_encoder<CharT, N>::overloader
+struct basic_encoder<CharT, N, Buffer>::overloader
 {
 };
 
 // Tags
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<CharT, N>::overloader<
+struct basic_encoder<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::null>::value>::type>
 {
-    using size_type = typename basic_encoder<CharT, N>::size_type;
+    using size_type = typename basic_encoder<CharT, N, Buffer>::size_type;
 
-    inline static size_type write(basic_encoder<CharT, N>& self)
+    inline static size_type write(basic_encoder<CharT, N, Buffer>& self)
     {
         return self.null_value();
     }
 };
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<CharT, N>::overloader<
+struct basic_encoder<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::begin_array>::value>::type>
 {
-    using size_type = typename basic_encoder<CharT, N>::size_type;
+    using size_type = typename basic_encoder<CharT, N, Buffer>::size_type;
 
-    inline static size_type write(basic_encoder<CharT, N>& self)
+    inline static size_type write(basic_encoder<CharT, N, Buffer>& self)
     {
         return self.begin_array_value();
     }
 };
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<CharT, N>::overloader<
+struct basic_encoder<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::end_array>::value>::type>
 {
-    using size_type = typename basic_encoder<CharT, N>::size_type;
+    using size_type = typename basic_encoder<CharT, N, Buffer>::size_type;
 
-    inline static size_type write(basic_encoder<CharT, N>& self)
+    inline static size_type write(basic_encoder<CharT, N, Buffer>& self)
     {
         return self.end_array_value();
     }
 };
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<CharT, N>::overloader<
+struct basic_encoder<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::begin_object>::value>::type>
 {
-    using size_type = typename basic_encoder<CharT, N>::size_type;
+    using size_type = typename basic_encoder<CharT, N, Buffer>::size_type;
 
-    inline static size_type write(basic_encoder<CharT, N>& self)
+    inline static size_type write(basic_encoder<CharT, N, Buffer>& self)
     {
         return self.begin_object_value();
     }
 };
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<CharT, N>::overloader<
+struct basic_encoder<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::end_object>::value>::type>
 {
-    using size_type = typename basic_encoder<CharT, N>::size_type;
+    using size_type = typename basic_encoder<CharT, N, Buffer>::size_type;
 
-    inline static size_type write(basic_encoder<CharT, N>& self)
+    inline static size_type write(basic_encoder<CharT, N, Buffer>& self)
     {
         return self.end_object_value();
     }
 };
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<CharT, N>::overloader<
+struct basic_encoder<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::detail::value_separator>::value>::type>
 {
-    using size_type = typename basic_encoder<CharT, N>::size_type;
+    using size_type = typename basic_encoder<CharT, N, Buffer>::size_type;
 
-    static size_type write(basic_encoder<CharT, N>& self)
+    static size_type write(basic_encoder<CharT, N, Buffer>& self)
     {
         return self.value_separator_value();
     }
 };
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<CharT, N>::overloader<
+struct basic_encoder<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::detail::name_separator>::value>::type>
 {
-    using size_type = typename basic_encoder<CharT, N>::size_type;
+    using size_type = typename basic_encoder<CharT, N, Buffer>::size_type;
 
-    static size_type write(basic_encoder<CharT, N>& self)
+    static size_type write(basic_encoder<CharT, N, Buffer>& self)
     {
         return self.name_separator_value();
     }
@@ -171,15 +177,15 @@ struct basic_encoder<CharT, N>::overloader<
 
 // Integers
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<CharT, N>::overloader<
+struct basic_encoder<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_integral<T>::value>::type>
 {
-    using size_type = typename basic_encoder<CharT, N>::size_type;
+    using size_type = typename basic_encoder<CharT, N, Buffer>::size_type;
 
-    inline static size_type write(basic_encoder<CharT, N>& self,
+    inline static size_type write(basic_encoder<CharT, N, Buffer>& self,
                                   const T& data)
     {
         return self.integral_value(data);
@@ -188,15 +194,15 @@ struct basic_encoder<CharT, N>::overloader<
 
 // Floating point numbers
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<CharT, N>::overloader<
+struct basic_encoder<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_floating_point<T>::value>::type>
 {
-    using size_type = typename basic_encoder<CharT, N>::size_type;
+    using size_type = typename basic_encoder<CharT, N, Buffer>::size_type;
 
-    inline static size_type write(basic_encoder<CharT, N>& self,
+    inline static size_type write(basic_encoder<CharT, N, Buffer>& self,
                                   const T& data)
     {
         return self.floating_value(data);
@@ -205,31 +211,31 @@ struct basic_encoder<CharT, N>::overloader<
 
 // Strings
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<CharT, N>::overloader<
+struct basic_encoder<CharT, N, Buffer>::overloader<
     T,
-    typename std::enable_if<std::is_same<T, typename basic_encoder<CharT, N>::view_type>::value>::type>
+    typename std::enable_if<std::is_same<T, typename basic_encoder<CharT, N, Buffer>::view_type>::value>::type>
 {
-    using size_type = typename basic_encoder<CharT, N>::size_type;
-    using view_type = typename basic_encoder<CharT, N>::view_type;
+    using size_type = typename basic_encoder<CharT, N, Buffer>::size_type;
+    using view_type = typename basic_encoder<CharT, N, Buffer>::view_type;
 
-    static size_type write(basic_encoder<CharT, N>& self,
+    static size_type write(basic_encoder<CharT, N, Buffer>& self,
                            const view_type& data)
     {
         return self.string_value(data);
     }
 };
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_encoder<CharT, N>::overloader<
+struct basic_encoder<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, std::basic_string<CharT> >::value>::type>
 {
-    using size_type = typename basic_encoder<CharT, N>::size_type;
+    using size_type = typename basic_encoder<CharT, N, Buffer>::size_type;
 
-    static size_type write(basic_encoder<CharT, N>& self,
+    static size_type write(basic_encoder<CharT, N, Buffer>& self,
                            const std::basic_string<CharT>& data)
     {
         return self.string_value(data);
@@ -237,34 +243,34 @@ struct basic_encoder<CharT, N>::overloader<
 };
 
 //-----------------------------------------------------------------------------
-// basic_encoder<CharT, N>
+// basic_encoder<CharT, N, Buffer>
 //-----------------------------------------------------------------------------
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-basic_encoder<CharT, N>::basic_encoder(T& output)
+basic_encoder<CharT, N, Buffer>::basic_encoder(T& output)
 {
-    static_assert(N >= sizeof(typename buffer::traits<T>::buffer_type),
-                  "N is smaller than buffer_type");
+    using wrapper_type = typename buffer::detail::wrapper<buffer_type, T>::type;
+    static_assert(N >= sizeof(wrapper_type), "N is smaller than buffer_type");
 
-    ::new (std::addressof(storage)) typename buffer::traits<T>::buffer_type(output);
+    ::new (std::addressof(storage)) wrapper_type(output);
 }
 
-template <typename CharT, std::size_t N>
-basic_encoder<CharT, N>::~basic_encoder()
+template <typename CharT, std::size_t N, typename Buffer>
+basic_encoder<CharT, N, Buffer>::~basic_encoder()
 {
     buffer().~buffer_type();
 }
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename U>
-auto basic_encoder<CharT, N>::value(const U& data) -> size_type
+auto basic_encoder<CharT, N, Buffer>::value(const U& data) -> size_type
 {
-    return basic_encoder<CharT, N>::overloader<U>::write(*this, data);
+    return basic_encoder<CharT, N, Buffer>::overloader<U>::write(*this, data);
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::value(bool data) -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::value(bool data) -> size_type
 {
     if (data)
     {
@@ -289,73 +295,107 @@ auto basic_encoder<CharT, N>::value(bool data) -> size_type
     }
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::value(const value_type *data) -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::value(const value_type *data) -> size_type
 {
-    return basic_encoder<CharT, N>::overloader<view_type>::write(*this, data);
+    return basic_encoder<CharT, N, Buffer>::overloader<view_type>::write(*this, data);
 }
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename U>
-auto basic_encoder<CharT, N>::value() -> size_type
+auto basic_encoder<CharT, N, Buffer>::value() -> size_type
 {
-    return basic_encoder<CharT, N>::overloader<U>::write(*this);
+    return basic_encoder<CharT, N, Buffer>::overloader<U>::write(*this);
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::literal(const view_type& data) -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::literal(const view_type& data) -> size_type
 {
     return write(data);
 }
 
-template <typename CharT, std::size_t N>
-template <typename T>
-auto basic_encoder<CharT, N>::integral_value(const T& data) -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+bool basic_encoder<CharT, N, Buffer>::reserve(size_type size)
 {
-    std::array<value_type, std::numeric_limits<T>::digits10 + 1> output;
+    return buffer().grow(size);
+}
 
-    // Build buffer backwards
-    typename decltype(output)::reverse_iterator where = output.rbegin();
-    const bool is_negative = data < 0;
-    using unsigned_type = typename std::make_unsigned<T>::type;
-    auto number = unsigned_type(detail::absolute<T>::value(data));
-    if (number == 0)
-    {
-        *where = traits::alphabet<CharT>::digit_0;
-        ++where;
-    }
-    else
+template <typename CharT, std::size_t N, typename Buffer>
+template <typename T>
+auto basic_encoder<CharT, N, Buffer>::array(const T *data, size_type size) -> size_type
+{
+    static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                  "T must be a number");
+
+    // Numbers are formatted into a block that is written whenever it cannot
+    // hold another number, so the buffer is only accessed once per block.
+    static constexpr size_type block_size = 512;
+    static constexpr size_type max_size = number_converter<CharT, T>::max_size + 1;
+    static_assert(block_size > max_size, "Block too small");
+    std::array<value_type, block_size> block;
+
+    size_type result = 0;
+    value_type *current = block.data();
+    *current++ = traits::alphabet<CharT>::bracket_open;
+    for (size_type i = 0; i < size; ++i)
     {
-        const T base = T(10);
-        while (number != 0)
+        if (size_type(block.data() + block_size - current) < max_size)
         {
-            *where = traits::alphabet<CharT>::digit_0 + (number % base);
-            ++where;
-            number /= base;
+            const auto written = write(view_type(block.data(), size_type(current - block.data())));
+            if (written == 0)
+                return 0;
+            result += written;
+            current = block.data();
         }
+        if (i > 0)
+        {
+            *current++ = traits::alphabet<CharT>::comma;
+        }
+        current += number_converter<CharT, T>::encode(data[i], current);
     }
-    typename decltype(output)::const_iterator begin = where.base();
-    const size_type size = size_type(std::distance(begin, output.cend()) + (is_negative ? 1 : 0));
+    if (current == block.data() + block_size)
+    {
+        // Last number filled the block so there is no room for the bracket
+        const auto written = write(view_type(block.data(), block_size));
+        if (written == 0)
+            return 0;
+        result += written;
+        current = block.data();
+    }
+    *current++ = traits::alphabet<CharT>::bracket_close;
+    const auto written = write(view_type(block.data(), size_type(current - block.data())));
+    if (written == 0)
+        return 0;
+    return result + written;
+}
+
+template <typename CharT, std::size_t N, typename Buffer>
+template <typename T>
+auto basic_encoder<CharT, N, Buffer>::integral_value(const T& data) -> size_type
+{
+    using converter = detail::integer_converter<CharT, T>;
+    std::array<value_type, converter::max_size> output;
+    const size_type size = converter::encode(data, output.data());
 
     if (!buffer().grow(size))
     {
         return 0;
     }
-    if (is_negative)
+    value_type *span = buffer().claim(size);
+    if (span)
     {
-        buffer().write(traits::alphabet<CharT>::minus);
+        std::copy(output.data(), output.data() + size, span);
     }
-    while (begin != output.end())
+    else
     {
-        buffer().write(*begin);
-        ++begin;
+        buffer().write(view_type(output.data(), size));
     }
     return size;
 }
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-auto basic_encoder<CharT, N>::floating_value(const T& data) -> size_type
+auto basic_encoder<CharT, N, Buffer>::floating_value(const T& data) -> size_type
 {
     switch (std::fpclassify(data))
     {
@@ -364,13 +404,18 @@ auto basic_encoder<CharT, N>::floating_value(const T& data) -> size_type
         // Infinity and NaN must be encoded as null
         return null_value();
     default:
-        return write(detail::string_converter<CharT, T>::encode(data));
+        {
+            using converter = detail::string_converter<CharT, T>;
+            std::array<value_type, converter::max_size> output;
+            const auto size = converter::encode(data, output.data());
+            return write(view_type(output.data(), size));
+        }
     }
 }
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-auto basic_encoder<CharT, N>::string_value(const T& data) -> size_type
+auto basic_encoder<CharT, N, Buffer>::string_value(const T& data) -> size_type
 {
     // This is an approximation of the size. Further characters may be
     // added by escaped characters, in which case we grow the buffer
@@ -382,10 +427,27 @@ auto basic_encoder<CharT, N>::string_value(const T& data) -> size_type
         return 0;
     }
 
+    const value_type *it = data.data();
+    const value_type * const last = it + data.size();
+    // Runs of valid characters are copied in bulk. Invalid UTF-8 sequences
+    // are sanitized character by character.
+    const bool is_valid = (detail::scan_utf8(it, last) == last);
+
     buffer().write(traits::alphabet<CharT>::quote);
-    typename T::const_iterator it = data.begin();
-    while (it != data.end())
+    while (it != last)
     {
+        if (is_valid)
+        {
+            const value_type *next = detail::scan_unescaped(it, last);
+            if (next != it)
+            {
+                buffer().write(view_type(it, std::size_t(next - it)));
+                it = next;
+                if (it == last)
+                    break;
+            }
+        }
+
         switch (*it)
         {
         case traits::alphabet<CharT>::quote:
@@ -446,8 +508,8 @@ auto basic_encoder<CharT, N>::string_value(const T& data) -> size_type
             else if ((*it & 0xE0) == 0xC0)
             {
                 // 110xxxxx
-                typename T::value_type first = *it;
-                if (++it == data.end())
+                const value_type first = *it;
+                if (++it == last)
                 {
                     if (write(traits::alphabet<CharT>::question_mark) == 0)
                         return 0;
@@ -464,8 +526,8 @@ auto basic_encoder<CharT, N>::string_value(const T& data) -> size_type
             else if ((*it & 0xF0) == 0xE0)
             {
                 // 1110xxxx
-                typename T::value_type first = *it;
-                if (++it == data.end())
+                const value_type first = *it;
+                if (++it == last)
                 {
                     if (write(traits::alphabet<CharT>::question_mark) == 0)
                         return 0;
@@ -474,8 +536,8 @@ auto basic_encoder<CharT, N>::string_value(const T& data) -> size_type
                 if ((*it & 0xC0) == 0x80)
                 {
                     // 1110xxxx 10xxxxxx
-                    typename T::value_type second = *it;
-                    if (++it == data.end())
+                    const value_type second = *it;
+                    if (++it == last)
                     {
                         if (write(traits::alphabet<CharT>::question_mark) == 0)
                             return 0;
@@ -502,8 +564,8 @@ auto basic_encoder<CharT, N>::string_value(const T& data) -> size_type
     return size;
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::null_value() -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::null_value() -> size_type
 {
     static constexpr CharT null_text[] = {
         traits::alphabet<CharT>::letter_n,
@@ -514,44 +576,44 @@ auto basic_encoder<CharT, N>::null_value() -> size_type
     return write(view_type(null_text, sizeof(null_text)));
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::begin_array_value() -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::begin_array_value() -> size_type
 {
     return write(traits::alphabet<CharT>::bracket_open);
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::end_array_value() -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::end_array_value() -> size_type
 {
     return write(traits::alphabet<CharT>::bracket_close);
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::begin_object_value() -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::begin_object_value() -> size_type
 {
     return write(traits::alphabet<CharT>::brace_open);
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::end_object_value() -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::end_object_value() -> size_type
 {
     return write(traits::alphabet<CharT>::brace_close);
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::value_separator_value() -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::value_separator_value() -> size_type
 {
     return write(traits::alphabet<CharT>::comma);
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::name_separator_value() -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::name_separator_value() -> size_type
 {
     return write(traits::alphabet<CharT>::colon);
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::write(value_type character) -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::write(value_type character) -> size_type
 {
     const size_type size = sizeof(character);
     if (buffer().grow(size))
@@ -562,8 +624,8 @@ auto basic_encoder<CharT, N>::write(value_type character) -> size_type
     return 0;
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::write(const view_type& data) -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::write(const view_type& data) -> size_type
 {
     const typename view_type::size_type size = data.size();
     if (buffer().grow(size))
@@ -574,8 +636,8 @@ auto basic_encoder<CharT, N>::write(const view_type& data) -> size_type
     return 0;
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::write(const string_type& data) -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::write(const string_type& data) -> size_type
 {
     const typename view_type::size_type size = data.size();
     if (buffer().grow(size))
@@ -586,14 +648,14 @@ auto basic_encoder<CharT, N>::write(const string_type& data) -> size_type
     return 0;
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::buffer() -> buffer_type&
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::buffer() -> buffer_type&
 {
     return reinterpret_cast<buffer_type&>(storage);
 }
 
-template <typename CharT, std::size_t N>
-auto basic_encoder<CharT, N>::buffer() const -> const buffer_type&
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_encoder<CharT, N, Buffer>::buffer() const -> const buffer_type&
 {
     return reinterpret_cast<const buffer_type&>(storage);
 }
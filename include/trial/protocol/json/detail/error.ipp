@@ -38,6 +38,9 @@ public:
         case unexpected_token:
             return "unexpected token";
 
+        case invalid_key:
+            return "invalid key";
+
         case invalid_value:
             return "invalid value";
 
@@ -58,6 +61,12 @@ public:
 
         case insufficient_tokens:
             return "algorithm used requires more tokens than available";
+
+        case invalid_encoding:
+            return "invalid UTF-8 encoding";
+
+        case max_depth:
+            return "maximum nesting depth exceeded";
         }
         return "trial.protocol.json error";
     }
@@ -101,6 +110,12 @@ inline enum errc to_errc(token::code::value value) noexcept
     case token::code::error_expected_end_object:
         return expected_end_object;
 
+    case token::code::error_invalid_encoding:
+        return invalid_encoding;
+
+    case token::code::error_max_depth:
+        return max_depth;
+
     default:
         return no_error;
     }
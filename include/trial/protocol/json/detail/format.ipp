@@ -23,10 +23,10 @@ namespace json
 namespace detail
 {
 
-template <typename CharT, typename Allocator>
+template <typename CharT, typename Allocator, typename MapPolicy>
 struct basic_formatter
 {
-    using variable_type = trial::dynamic::basic_variable<Allocator>;
+    using variable_type = trial::dynamic::basic_variable<Allocator, MapPolicy>;
 
     basic_formatter(basic_writer<CharT>& writer)
         : writer(writer)
@@ -0,0 +1,92 @@
+#ifndef TRIAL_PROTOCOL_JSON_DETAIL_INDEXED_READER_IPP
+#define TRIAL_PROTOCOL_JSON_DETAIL_INDEXED_READER_IPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+
+template <typename CharT>
+basic_indexed_reader<CharT>::basic_indexed_reader(const view_type& view)
+    : index_type(view.data(), view.data() + view.size()),
+      super(decoder_type(view.data(),
+                         view.data() + view.size(),
+                         (index_type::size() > 0) ? index_type::begin() : nullptr))
+{
+}
+
+template <typename CharT>
+basic_indexed_reader<CharT>::basic_indexed_reader(const basic_indexed_reader& other)
+    : index_type(other),
+      super(other)
+{
+    rebase(other);
+}
+
+template <typename CharT>
+auto basic_indexed_reader<CharT>::operator=(const basic_indexed_reader& other) -> basic_indexed_reader&
+{
+    index_type::operator=(other);
+    super::operator=(other);
+    rebase(other);
+    return *this;
+}
+
+template <typename CharT>
+auto basic_indexed_reader<CharT>::index() const noexcept -> const index_type&
+{
+    return *this;
+}
+
+template <typename CharT>
+void basic_indexed_reader<CharT>::rebase(const basic_indexed_reader& other) noexcept
+{
+    // Move index cursor from other index to own index
+    const auto cursor = other.decoder.structural();
+    if (cursor)
+    {
+        super::decoder.structural(index().begin() + std::distance(other.index().begin(), cursor));
+    }
+}
+
+template <typename CharT>
+bool basic_indexed_reader<CharT>::skip_to_end()
+{
+    switch (code())
+    {
+    case token::code::begin_array:
+    case token::code::begin_object:
+        break;
+    default:
+        return false;
+    }
+
+    // The index cursor points past the current token
+    const auto cursor = super::decoder.structural();
+    if (!cursor || (cursor == index().begin()))
+        return false;
+    const auto partner = index().partner(cursor - 1);
+    if (!partner)
+        return false;
+
+    super::decoder.seek(partner);
+    return next();
+}
+
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_DETAIL_INDEXED_READER_IPP
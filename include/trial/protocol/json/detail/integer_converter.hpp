@@ -0,0 +1,118 @@
+#ifndef TRIAL_PROTOCOL_JSON_DETAIL_INTEGER_CONVERTER_HPP
+#define TRIAL_PROTOCOL_JSON_DETAIL_INTEGER_CONVERTER_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <trial/protocol/core/detail/bit.hpp>
+#include <trial/protocol/json/detail/traits.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+namespace detail
+{
+
+//! @brief Number of decimal digits in value.
+inline int count_digits(std::uint64_t value) noexcept
+{
+    static const std::uint64_t power[] = {
+        UINT64_C(0), UINT64_C(10), UINT64_C(100), UINT64_C(1000), UINT64_C(10000),
+        UINT64_C(100000), UINT64_C(1000000), UINT64_C(10000000), UINT64_C(100000000),
+        UINT64_C(1000000000), UINT64_C(10000000000), UINT64_C(100000000000),
+        UINT64_C(1000000000000), UINT64_C(10000000000000), UINT64_C(100000000000000),
+        UINT64_C(1000000000000000), UINT64_C(10000000000000000), UINT64_C(100000000000000000),
+        UINT64_C(1000000000000000000), UINT64_C(10000000000000000000)
+    };
+    // Estimate from the number of bits times log10(2)
+    const int bits = std::numeric_limits<std::uint64_t>::digits - core::detail::countl_zero(value | 1);
+    const int estimate = (bits * 1233) >> 12;
+    return estimate + 1 - int(value < power[estimate]);
+}
+
+//! @brief Write the length decimal digits of value.
+//!
+//! Digits are written backwards in pairs to halve the number of divisions.
+//!
+//! @returns Position after the last digit.
+template <typename CharT, typename U>
+CharT *write_digits(U value, int length, CharT *output) noexcept
+{
+    static_assert(std::is_unsigned<U>::value, "U must be unsigned");
+
+    static const char pairs[] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+
+    CharT *current = output + length;
+    while (value >= 100)
+    {
+        const auto index = std::size_t(value % 100) * 2;
+        value /= 100;
+        *--current = CharT(traits::alphabet<CharT>::digit_0 + (pairs[index + 1] - '0'));
+        *--current = CharT(traits::alphabet<CharT>::digit_0 + (pairs[index] - '0'));
+    }
+    if (value >= 10)
+    {
+        const auto index = std::size_t(value) * 2;
+        *--current = CharT(traits::alphabet<CharT>::digit_0 + (pairs[index + 1] - '0'));
+        *--current = CharT(traits::alphabet<CharT>::digit_0 + (pairs[index] - '0'));
+    }
+    else
+    {
+        *--current = CharT(traits::alphabet<CharT>::digit_0 + value);
+    }
+    return output + length;
+}
+
+//! @brief Integer number formatting.
+template <typename CharT, typename T>
+struct integer_converter
+{
+    static_assert(std::is_integral<T>::value, "T must be integral");
+
+    // Sign and digits
+    static constexpr std::size_t max_size = std::numeric_limits<T>::digits10 + 2;
+
+    static std::size_t encode(T value, CharT *output) noexcept
+    {
+        // Avoid 64-bit divisions for narrower types
+        using unsigned_type = typename std::conditional<(sizeof(T) <= sizeof(std::uint32_t)),
+                                                        std::uint32_t,
+                                                        std::uint64_t>::type;
+        CharT *current = output;
+        unsigned_type number = unsigned_type(value);
+        if (value < 0)
+        {
+            *current++ = traits::alphabet<CharT>::minus;
+            // Negate in unsigned arithmetic to handle the minimum value
+            number = unsigned_type(0) - number;
+        }
+        current = write_digits(number, count_digits(number), current);
+        return std::size_t(current - output);
+    }
+};
+
+} // namespace detail
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_DETAIL_INTEGER_CONVERTER_HPP
@@ -0,0 +1,295 @@
+#ifndef TRIAL_PROTOCOL_JSON_DETAIL_LAZY_IPP
+#define TRIAL_PROTOCOL_JSON_DETAIL_LAZY_IPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <trial/protocol/json/parse.hpp>
+#include <trial/protocol/json/partial/skip.hpp>
+#include <trial/protocol/json/detail/traits.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+
+//-----------------------------------------------------------------------------
+// lazy_value::children
+//-----------------------------------------------------------------------------
+
+// Members and elements of a scanned container. Keys are only used for objects.
+struct lazy_value::children
+{
+    std::vector<lazy_value> keys;
+    std::vector<lazy_value> values;
+};
+
+//-----------------------------------------------------------------------------
+// lazy_value
+//-----------------------------------------------------------------------------
+
+inline lazy_value::lazy_value() noexcept
+    : current(token::code::end)
+{
+}
+
+inline lazy_value::lazy_value(token::code::value code, const view_type& view) noexcept
+    : current(code),
+      view(view)
+{
+}
+
+inline lazy_value::lazy_value(const view_type& input)
+{
+    json::reader reader(input);
+    current = reader.code();
+    view = partial::skip(reader);
+    if (reader.symbol() != token::symbol::end)
+        throw json::error(json::unexpected_token);
+}
+
+inline lazy_value::lazy_value(json::reader& reader)
+    : current(reader.code()),
+      view(partial::skip(reader))
+{
+}
+
+inline token::code::value lazy_value::code() const noexcept
+{
+    return current;
+}
+
+inline token::symbol::value lazy_value::symbol() const noexcept
+{
+    return token::symbol::convert(current);
+}
+
+inline auto lazy_value::literal() const noexcept -> view_type
+{
+    return view;
+}
+
+inline auto lazy_value::size() const -> size_type
+{
+    switch (symbol())
+    {
+    case token::symbol::null:
+        return 0;
+    case token::symbol::begin_array:
+    case token::symbol::begin_object:
+        return scan()->values.size();
+    default:
+        return 1;
+    }
+}
+
+inline bool lazy_value::empty() const
+{
+    switch (symbol())
+    {
+    case token::symbol::begin_array:
+    case token::symbol::begin_object:
+        return scan()->values.empty();
+    default:
+        return symbol() == token::symbol::null;
+    }
+}
+
+inline auto lazy_value::begin() const -> iterator
+{
+    switch (symbol())
+    {
+    case token::symbol::begin_array:
+    case token::symbol::begin_object:
+        return iterator(scan());
+    default:
+        return end();
+    }
+}
+
+inline auto lazy_value::end() const -> iterator
+{
+    return iterator();
+}
+
+inline auto lazy_value::find(const view_type& key) const -> iterator
+{
+    if (symbol() != token::symbol::begin_object)
+        throw json::error(json::incompatible_type);
+
+    const auto& container = scan();
+    for (size_type index = 0; index < container->keys.size(); ++index)
+    {
+        const auto& label = container->keys[index];
+        const bool found = label.has_escapes()
+            ? (label.value<std::string>() == key)
+            : (label.string_view() == key);
+        if (found)
+            return iterator(container, index);
+    }
+    return end();
+}
+
+inline auto lazy_value::operator[](size_type position) const -> lazy_value
+{
+    if (symbol() != token::symbol::begin_array)
+        throw json::error(json::incompatible_type);
+
+    const auto& container = scan();
+    if (position >= container->values.size())
+        throw json::error(json::invalid_key);
+    return container->values[position];
+}
+
+inline auto lazy_value::operator[](const view_type& key) const -> lazy_value
+{
+    auto where = find(key);
+    if (where == end())
+        throw json::error(json::invalid_key);
+    return *where;
+}
+
+template <typename ReturnType>
+ReturnType lazy_value::value() const
+{
+    json::reader reader(view);
+    return reader.template value<ReturnType>();
+}
+
+inline auto lazy_value::string_view() const -> view_type
+{
+    switch (current)
+    {
+    case token::code::string:
+    case token::code::key:
+        break;
+    default:
+        throw json::error(json::incompatible_type);
+    }
+    if (has_escapes())
+        throw json::error(json::invalid_value);
+    // Remove quotes
+    return view_type(view.data() + 1, view.size() - 2);
+}
+
+template <typename Allocator, typename MapPolicy>
+auto lazy_value::materialize() const -> dynamic::basic_variable<Allocator, MapPolicy>
+{
+    json::reader reader(view);
+    return partial::parse<Allocator, MapPolicy>(reader);
+}
+
+inline bool lazy_value::has_escapes() const noexcept
+{
+    return std::memchr(view.data(), detail::traits::alphabet<char>::reverse_solidus, view.size()) != nullptr;
+}
+
+inline auto lazy_value::scan() const -> const std::shared_ptr<const children>&
+{
+    if (!cache)
+    {
+        // The container has already been checked to be well-formed, so
+        // skipping over its members cannot fail.
+        auto result = std::make_shared<children>();
+        json::reader reader(view);
+        // Skip over begin_array or begin_object
+        reader.next();
+        while (true)
+        {
+            switch (reader.symbol())
+            {
+            case token::symbol::key:
+                result->keys.push_back(lazy_value(token::code::key, reader.literal()));
+                reader.next();
+                break;
+
+            case token::symbol::end_array:
+            case token::symbol::end_object:
+                cache = std::move(result);
+                return cache;
+
+            default:
+                break;
+            }
+            const auto code = reader.code();
+            result->values.push_back(lazy_value(code, partial::skip(reader)));
+        }
+    }
+    return cache;
+}
+
+//-----------------------------------------------------------------------------
+// lazy_value::iterator
+//-----------------------------------------------------------------------------
+
+inline lazy_value::iterator::iterator(const std::shared_ptr<const children>& container,
+                                      size_type index) noexcept
+    : container(container),
+      index(index)
+{
+}
+
+inline auto lazy_value::iterator::operator*() const noexcept -> reference
+{
+    return container->values[index];
+}
+
+inline auto lazy_value::iterator::operator->() const noexcept -> pointer
+{
+    return &container->values[index];
+}
+
+inline auto lazy_value::iterator::operator++() -> iterator&
+{
+    ++index;
+    return *this;
+}
+
+inline auto lazy_value::iterator::operator++(int) -> iterator
+{
+    iterator result = *this;
+    ++index;
+    return result;
+}
+
+inline bool lazy_value::iterator::operator==(const iterator& other) const noexcept
+{
+    if (at_end() || other.at_end())
+        return at_end() == other.at_end();
+    return (container == other.container) && (index == other.index);
+}
+
+inline bool lazy_value::iterator::operator!=(const iterator& other) const noexcept
+{
+    return !(*this == other);
+}
+
+inline auto lazy_value::iterator::key() const -> lazy_value
+{
+    if (at_end() || (index >= container->keys.size()))
+        throw json::error(json::incompatible_type);
+    return container->keys[index];
+}
+
+inline bool lazy_value::iterator::at_end() const noexcept
+{
+    return !container || (index >= container->values.size());
+}
+
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_DETAIL_LAZY_IPP
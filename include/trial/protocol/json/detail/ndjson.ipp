@@ -0,0 +1,232 @@
+#ifndef TRIAL_PROTOCOL_JSON_DETAIL_NDJSON_IPP
+#define TRIAL_PROTOCOL_JSON_DETAIL_NDJSON_IPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <trial/dynamic/variable.hpp>
+#include <trial/protocol/json/error.hpp>
+#include <trial/protocol/json/parse.hpp>
+#include <trial/protocol/json/reader.hpp>
+#include <trial/protocol/json/detail/concurrency.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+namespace detail
+{
+
+// Parses batches of records on worker threads and delivers the records in
+// input order on the calling thread.
+//
+// Workers only run a bounded number of batches ahead of the calling thread to
+// limit the amount of decoded records held in memory.
+
+template <typename Allocator, typename MapPolicy>
+class ndjson_parser
+{
+public:
+    using variable_type = dynamic::basic_variable<Allocator, MapPolicy>;
+    using view_type = json::reader::view_type;
+    using size_type = std::size_t;
+
+    ndjson_parser(const view_type& input, size_type batch_size)
+    {
+        split(input, std::max<size_type>(batch_size, 1));
+    }
+
+    template <typename Visitor>
+    void visit(Visitor& visitor, size_type concurrency)
+    {
+        if ((concurrency <= 1) || (batches.size() <= 1))
+        {
+            for (auto& batch : batches)
+            {
+                parse(batch);
+                deliver(batch, visitor);
+            }
+            return;
+        }
+
+        window = 2 * concurrency;
+        workers guard(*this, std::min(concurrency, batches.size()));
+
+        for (auto& batch : batches)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [&batch] { return batch.done; });
+            }
+            deliver(batch, visitor);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++delivered;
+            }
+            room.notify_all();
+        }
+    }
+
+private:
+    struct batch_type
+    {
+        batch_type(const view_type& input) : input(input) {}
+
+        view_type input;
+        std::vector<variable_type> records;
+        std::exception_ptr failure;
+        bool done = false;
+    };
+
+    // Stops and joins the worker threads on all exits
+    class workers
+    {
+    public:
+        workers(ndjson_parser& self, size_type count)
+            : self(self)
+        {
+            try
+            {
+                threads.spawn(count, [&self] { self.work(); });
+            }
+            catch (...)
+            {
+                stop();
+                throw;
+            }
+        }
+
+        ~workers()
+        {
+            stop();
+        }
+
+    private:
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(self.mutex);
+                self.stopped = true;
+            }
+            self.room.notify_all();
+            threads.join();
+        }
+
+        ndjson_parser& self;
+        detail::thread_group threads;
+    };
+
+    void split(const view_type& input, size_type batch_size)
+    {
+        const auto last = input.data() + input.size();
+        auto first = input.data();
+        while (first != last)
+        {
+            auto end = (size_type(last - first) > batch_size) ? first + batch_size : last;
+            end = std::find(end, last, '\n');
+            if (end != last)
+                ++end;
+            batches.emplace_back(view_type(first, end - first));
+            first = end;
+        }
+    }
+
+    void work()
+    {
+        for (;;)
+        {
+            batch_type *batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                room.wait(lock, [this]
+                          {
+                              return stopped || (next == batches.size()) || (next < delivered + window);
+                          });
+                if (stopped || (next == batches.size()))
+                    return;
+                batch = &batches[next++];
+            }
+            parse(*batch);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                batch->done = true;
+            }
+            ready.notify_one();
+        }
+    }
+
+    void parse(batch_type& batch)
+    {
+        try
+        {
+            const auto last = batch.input.data() + batch.input.size();
+            auto first = batch.input.data();
+            while (first != last)
+            {
+                const auto end = std::find(first, last, '\n');
+                json::reader reader(view_type(first, end - first));
+                if (reader.symbol() != token::symbol::end)
+                {
+                    batch.records.push_back(partial::parse<Allocator, MapPolicy>(reader));
+                    if (reader.symbol() != token::symbol::end)
+                        throw json::error(json::unexpected_token);
+                }
+                else if (reader.literal().size() > 0)
+                {
+                    throw json::error(json::unexpected_token);
+                }
+                first = (end == last) ? end : end + 1;
+            }
+        }
+        catch (...)
+        {
+            batch.failure = std::current_exception();
+        }
+    }
+
+    template <typename Visitor>
+    void deliver(batch_type& batch, Visitor& visitor)
+    {
+        for (auto& record : batch.records)
+        {
+            visitor(std::move(record));
+        }
+        if (batch.failure)
+            std::rethrow_exception(batch.failure);
+        std::vector<variable_type>().swap(batch.records);
+    }
+
+private:
+    std::vector<batch_type> batches;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::condition_variable room;
+    size_type next = 0;
+    size_type delivered = 0;
+    size_type window = 0;
+    bool stopped = false;
+};
+
+} // namespace detail
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_DETAIL_NDJSON_IPP
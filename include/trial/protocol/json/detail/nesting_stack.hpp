@@ -0,0 +1,110 @@
+#ifndef TRIAL_PROTOCOL_JSON_DETAIL_NESTING_STACK_HPP
+#define TRIAL_PROTOCOL_JSON_DETAIL_NESTING_STACK_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+namespace detail
+{
+
+// Stack with N elements stored inline.
+//
+// If Spill is true, elements beyond N are stored on the heap. Otherwise push()
+// fails when the stack is full.
+//
+// Copying and moving are element-wise, so no pointers into the inline storage
+// need to be fixed up.
+
+template <typename T, std::size_t N, bool Spill>
+class nesting_stack
+{
+    static_assert(N > 0, "nesting_stack must have inline capacity");
+
+    struct no_overflow {};
+    using overflow_type = typename std::conditional<Spill, std::vector<T>, no_overflow>::type;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    bool empty() const noexcept { return count == 0; }
+    size_type size() const noexcept { return count; }
+    static constexpr size_type capacity() noexcept { return N; }
+
+    T& top() noexcept
+    {
+        assert(count > 0);
+        return (count <= N) ? local[count - 1] : at_overflow(count - 1 - N);
+    }
+
+    const T& top() const noexcept
+    {
+        assert(count > 0);
+        return (count <= N) ? local[count - 1] : at_overflow(count - 1 - N);
+    }
+
+    // Returns false if the stack is full
+    bool push(const T& value)
+    {
+        if (count < N)
+        {
+            local[count++] = value;
+            return true;
+        }
+        return push_overflow(value, std::integral_constant<bool, Spill>{});
+    }
+
+    void pop() noexcept
+    {
+        assert(count > 0);
+        if (count > N)
+            pop_overflow(std::integral_constant<bool, Spill>{});
+        --count;
+    }
+
+private:
+    T& at_overflow(size_type index) noexcept { return at_overflow(index, std::integral_constant<bool, Spill>{}); }
+    const T& at_overflow(size_type index) const noexcept { return const_cast<nesting_stack *>(this)->at_overflow(index); }
+    T& at_overflow(size_type index, std::true_type) noexcept { return overflow[index]; }
+    T& at_overflow(size_type, std::false_type) noexcept { return local[N - 1]; }
+
+    bool push_overflow(const T& value, std::true_type)
+    {
+        overflow.push_back(value);
+        ++count;
+        return true;
+    }
+    bool push_overflow(const T&, std::false_type) noexcept { return false; }
+
+    void pop_overflow(std::true_type) noexcept { overflow.pop_back(); }
+    void pop_overflow(std::false_type) noexcept {}
+
+    size_type count = 0;
+    T local[N];
+    overflow_type overflow;
+};
+
+} // namespace detail
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_DETAIL_NESTING_STACK_HPP
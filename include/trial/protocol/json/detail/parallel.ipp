@@ -0,0 +1,244 @@
+#ifndef TRIAL_PROTOCOL_JSON_DETAIL_PARALLEL_IPP
+#define TRIAL_PROTOCOL_JSON_DETAIL_PARALLEL_IPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <trial/dynamic/variable.hpp>
+#include <trial/protocol/json/error.hpp>
+#include <trial/protocol/json/parse.hpp>
+#include <trial/protocol/json/reader.hpp>
+#include <trial/protocol/json/detail/concurrency.hpp>
+#include <trial/protocol/json/detail/traits.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+namespace detail
+{
+
+// Parses the elements of a top-level array in parallel.
+//
+// A pre-scan splits the array into fragments at value separators in the
+// outermost array. The pre-scan only tracks strings, escapes, and the nesting
+// depth, so it is much faster than decoding. The fragments are decoded by
+// worker threads into separate arrays, which are spliced together in input
+// order.
+//
+// Malformed input is not diagnosed by the pre-scan or the workers. Instead
+// the input is decoded sequentially to report the same error as json::parse.
+
+template <typename Allocator, typename MapPolicy>
+class parallel_parser
+{
+public:
+    using variable_type = dynamic::basic_variable<Allocator, MapPolicy>;
+    using array_type = typename variable_type::array_type;
+    using view_type = json::reader::view_type;
+    using size_type = std::size_t;
+
+    parallel_parser(const view_type& input, size_type fragment_size)
+        : input(input)
+    {
+        scanned = split(std::max<size_type>(fragment_size, 1));
+    }
+
+    variable_type parse(size_type concurrency)
+    {
+        if (!scanned || (concurrency <= 1) || (fragments.size() <= 1))
+            return json::parse<view_type, Allocator, MapPolicy>(input);
+
+        std::atomic<size_type> next(0);
+        {
+            detail::thread_group threads;
+            threads.spawn(std::min(concurrency, fragments.size()),
+                          [this, &next]
+                          {
+                              for (;;)
+                              {
+                                  const size_type index = next++;
+                                  if (index >= fragments.size())
+                                      return;
+                                  parse(fragments[index]);
+                              }
+                          });
+        }
+
+        size_type total = 0;
+        for (const auto& fragment : fragments)
+        {
+            if (fragment.failure)
+                return json::parse<view_type, Allocator, MapPolicy>(input);
+            total += fragment.elements.size();
+        }
+
+        // Splice fragments
+        auto result = dynamic::basic_array<Allocator, MapPolicy>::make();
+        auto& elements = result.template assume_value<array_type>();
+        elements.reserve(total);
+        for (auto& fragment : fragments)
+        {
+            elements.insert(elements.end(),
+                            std::make_move_iterator(fragment.elements.begin()),
+                            std::make_move_iterator(fragment.elements.end()));
+            array_type().swap(fragment.elements);
+        }
+        return result;
+    }
+
+private:
+    using const_pointer = const char *;
+
+    struct fragment_type
+    {
+        fragment_type(const_pointer first, const_pointer last)
+            : input(first, last - first)
+        {}
+
+        view_type input;
+        array_type elements;
+        std::exception_ptr failure;
+    };
+
+    // Returns false if the input is not a well-formed top-level array
+    bool split(size_type fragment_size)
+    {
+        const_pointer first = input.data();
+        const const_pointer last = first + input.size();
+
+        while ((first != last) && traits::is_space(*first))
+            ++first;
+        if ((first == last) || (*first != traits::alphabet<char>::bracket_open))
+            return false;
+        ++first;
+
+        const_pointer start = first;
+        size_type depth = 0;
+        for (const_pointer current = first; current != last; ++current)
+        {
+            switch (*current)
+            {
+            case traits::alphabet<char>::quote:
+                current = skip_string(current + 1, last);
+                if (current == last)
+                    return false;
+                break;
+
+            case traits::alphabet<char>::bracket_open:
+            case traits::alphabet<char>::brace_open:
+                ++depth;
+                break;
+
+            case traits::alphabet<char>::bracket_close:
+                if (depth == 0)
+                {
+                    fragments.emplace_back(start, current);
+                    return std::all_of(current + 1, last, traits::is_space<char>);
+                }
+                --depth;
+                break;
+
+            case traits::alphabet<char>::brace_close:
+                if (depth == 0)
+                    return false;
+                --depth;
+                break;
+
+            case traits::alphabet<char>::comma:
+                if ((depth == 0) && (size_type(current - start) >= fragment_size))
+                {
+                    fragments.emplace_back(start, current);
+                    start = current + 1;
+                }
+                break;
+
+            default:
+                break;
+            }
+        }
+        return false;
+    }
+
+    // Returns the position of the closing quote, or last if unterminated
+    static const_pointer skip_string(const_pointer first, const_pointer last) noexcept
+    {
+        const_pointer current = first;
+        for (;;)
+        {
+            current = static_cast<const_pointer>(std::memchr(current, traits::alphabet<char>::quote, last - current));
+            if (current == nullptr)
+                return last;
+            // Quote is escaped if preceded by an odd number of backslashes
+            const_pointer escape = current;
+            while ((escape != first) && (escape[-1] == traits::alphabet<char>::reverse_solidus))
+                --escape;
+            if ((current - escape) % 2 == 0)
+                return current;
+            ++current;
+        }
+    }
+
+    // Decodes the comma-separated values of a fragment
+    void parse(fragment_type& fragment)
+    {
+        try
+        {
+            view_type tail = fragment.input;
+            for (;;)
+            {
+                // Fragments are split at value separators so empty values
+                // are never valid
+                json::reader reader(tail);
+                if (reader.symbol() == token::symbol::end)
+                    throw json::error(json::unexpected_token);
+                fragment.elements.push_back(partial::parse<Allocator, MapPolicy>(reader));
+                switch (reader.code())
+                {
+                case token::code::error_value_separator:
+                    tail = reader.tail();
+                    break;
+
+                case token::code::end:
+                    return;
+
+                default:
+                    throw json::error(json::unexpected_token);
+                }
+            }
+        }
+        catch (...)
+        {
+            fragment.failure = std::current_exception();
+        }
+    }
+
+private:
+    view_type input;
+    std::vector<fragment_type> fragments;
+    bool scanned;
+};
+
+} // namespace detail
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_DETAIL_PARALLEL_IPP
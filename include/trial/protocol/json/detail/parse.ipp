@@ -26,12 +26,13 @@ namespace json
 namespace detail
 {
 
-template <typename CharT, typename Allocator>
+template <typename CharT, typename Allocator, typename MapPolicy>
 class basic_parser
 {
 public:
-    using variable_type = dynamic::basic_variable<Allocator>;
+    using variable_type = dynamic::basic_variable<Allocator, MapPolicy>;
     using string_type = typename variable_type::string_type;
+    using map_type = typename variable_type::map_type;
 
     basic_parser(basic_reader<CharT>& reader)
         : reader(reader)
@@ -84,7 +85,7 @@ private:
     {
         assert(reader.symbol() == token::symbol::begin_array);
 
-        auto scope = dynamic::basic_array<Allocator>::make();
+        auto scope = dynamic::basic_array<Allocator, MapPolicy>::make();
 
         while (reader.next())
         {
@@ -117,7 +118,10 @@ private:
     {
         assert(reader.symbol() == token::symbol::begin_object);
 
-        auto scope = dynamic::basic_map<Allocator>::make();
+        auto scope = dynamic::basic_map<Allocator, MapPolicy>::make();
+        // Members are emplaced directly because inserting key-value pairs
+        // via an initializer list copies the value.
+        auto& members = scope.template assume_value<map_type>();
 
         while (reader.next())
         {
@@ -146,11 +150,11 @@ private:
             switch (reader.symbol())
             {
             case token::symbol::begin_array:
-                scope.insert({ std::move(key), std::move(parse_array()) });
+                members.emplace(std::move(key), parse_array());
                 break;
 
             case token::symbol::begin_object:
-                scope.insert({ std::move(key), std::move(parse_object()) });
+                members.emplace(std::move(key), parse_object());
                 break;
 
             case token::symbol::end_array:
@@ -164,7 +168,7 @@ private:
                 break;
 
             default:
-                scope.insert({ std::move(key), std::move(parse_value()) });
+                members.emplace(std::move(key), parse_value());
                 break;
             }
         }
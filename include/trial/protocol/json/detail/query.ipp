@@ -0,0 +1,308 @@
+#ifndef TRIAL_PROTOCOL_JSON_DETAIL_QUERY_IPP
+#define TRIAL_PROTOCOL_JSON_DETAIL_QUERY_IPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <trial/protocol/json/partial/skip.hpp>
+#include <trial/protocol/json/detail/traits.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+
+//-----------------------------------------------------------------------------
+// query::evaluator
+//-----------------------------------------------------------------------------
+
+// Walks the input while keeping a list of active paths for each nesting
+// level. A path is active at a level if all its preceding segments have
+// matched. Values without active paths are skipped.
+
+template <typename Visitor>
+class query::evaluator
+{
+public:
+    evaluator(const std::vector<path_type>& paths, Visitor& visitor)
+        : paths(paths),
+          visitor(visitor),
+          active(1)
+    {
+        for (size_type path = 0; path < paths.size(); ++path)
+        {
+            active[0].push_back(path);
+        }
+    }
+
+    void evaluate(json::reader& reader)
+    {
+        evaluate(reader, 0);
+    }
+
+private:
+    void evaluate(json::reader& reader, size_type depth)
+    {
+        if (reader.symbol() == token::symbol::error)
+            throw json::error(reader.error());
+
+        bool matched = false;
+        bool descend = false;
+        for (auto path : active[depth])
+        {
+            if (paths[path].size() == depth)
+                matched = true;
+            else
+                descend = true;
+        }
+
+        const bool container = (reader.symbol() == token::symbol::begin_array) ||
+            (reader.symbol() == token::symbol::begin_object);
+        if (matched)
+        {
+            if (!(descend && container))
+            {
+                emit(lazy_value(reader), depth);
+                return;
+            }
+            // Skip over matched value with a copy of the reader, so the
+            // original reader can descend into it
+            json::reader copy(reader);
+            emit(lazy_value(copy), depth);
+        }
+
+        switch (reader.symbol())
+        {
+        case token::symbol::begin_array:
+            evaluate_array(reader, depth);
+            break;
+
+        case token::symbol::begin_object:
+            evaluate_object(reader, depth);
+            break;
+
+        default:
+            partial::skip(reader);
+            break;
+        }
+    }
+
+    void evaluate_array(json::reader& reader, size_type depth)
+    {
+        reader.next(); // Skip over begin_array
+        for (size_type position = 0;; ++position)
+        {
+            switch (reader.symbol())
+            {
+            case token::symbol::end_array:
+                reader.next();
+                return;
+
+            case token::symbol::error:
+                throw json::error(reader.error());
+
+            default:
+                break;
+            }
+
+            auto& next = level(depth + 1);
+            for (auto path : active[depth])
+            {
+                if (paths[path].size() <= depth)
+                    continue;
+                const auto& current = paths[path][depth];
+                if (current.wildcard || (current.index == position))
+                    next.push_back(path);
+            }
+
+            if (next.empty())
+                partial::skip(reader);
+            else
+                evaluate(reader, depth + 1);
+        }
+    }
+
+    void evaluate_object(json::reader& reader, size_type depth)
+    {
+        reader.next(); // Skip over begin_object
+        std::string unescaped;
+        for (;;)
+        {
+            switch (reader.symbol())
+            {
+            case token::symbol::end_object:
+                reader.next();
+                return;
+
+            case token::symbol::key:
+                break;
+
+            default:
+                throw json::error(reader.error());
+            }
+
+            // Match key without the surrounding quotes
+            const auto literal = reader.literal();
+            view_type key(literal.data() + 1, literal.size() - 2);
+            if (std::memchr(key.data(), detail::traits::alphabet<char>::reverse_solidus, key.size()) != nullptr)
+            {
+                unescaped = reader.value<std::string>();
+                key = view_type(unescaped.data(), unescaped.size());
+            }
+
+            auto& next = level(depth + 1);
+            for (auto path : active[depth])
+            {
+                if (paths[path].size() <= depth)
+                    continue;
+                const auto& current = paths[path][depth];
+                if (current.wildcard || (key == view_type(current.key.data(), current.key.size())))
+                    next.push_back(path);
+            }
+
+            if (!reader.next())
+                throw json::error(reader.error());
+            if (next.empty())
+                partial::skip(reader);
+            else
+                evaluate(reader, depth + 1);
+        }
+    }
+
+    // Returns the cleared list of active paths at depth
+    std::vector<size_type>& level(size_type depth)
+    {
+        if (active.size() <= depth)
+            active.resize(depth + 1);
+        active[depth].clear();
+        return active[depth];
+    }
+
+    void emit(const lazy_value& value, size_type depth)
+    {
+        for (auto path : active[depth])
+        {
+            if (paths[path].size() == depth)
+                visitor(path, value);
+        }
+    }
+
+private:
+    const std::vector<path_type>& paths;
+    Visitor& visitor;
+    std::vector<std::vector<size_type>> active;
+};
+
+//-----------------------------------------------------------------------------
+// query
+//-----------------------------------------------------------------------------
+
+inline auto query::add(const view_type& path) -> size_type
+{
+    path_type result;
+    if (!path.empty())
+    {
+        if (path.front() != '/')
+            throw json::error(json::invalid_key);
+
+        for (auto it = path.begin() + 1;; ++it)
+        {
+            // Unescape segment
+            segment current;
+            for (; (it != path.end()) && (*it != '/'); ++it)
+            {
+                if (*it == '~')
+                {
+                    ++it;
+                    if (it == path.end())
+                        throw json::error(json::invalid_key);
+                    switch (*it)
+                    {
+                    case '0':
+                        current.key += '~';
+                        break;
+                    case '1':
+                        current.key += '/';
+                        break;
+                    default:
+                        throw json::error(json::invalid_key);
+                    }
+                }
+                else
+                {
+                    current.key += *it;
+                }
+            }
+
+            if (current.key == "*")
+            {
+                current.wildcard = true;
+            }
+            else if (!current.key.empty() &&
+                     (current.key.size() < 19) &&
+                     ((current.key[0] != '0') || (current.key.size() == 1)) &&
+                     (current.key.find_first_not_of("0123456789") == std::string::npos))
+            {
+                // Array index without leading zeroes
+                current.index = std::stoull(current.key);
+            }
+            result.push_back(std::move(current));
+
+            if (it == path.end())
+                break;
+        }
+    }
+    paths.push_back(std::move(result));
+    return paths.size() - 1;
+}
+
+inline auto query::size() const noexcept -> size_type
+{
+    return paths.size();
+}
+
+template <typename Visitor>
+void query::visit(const view_type& input, Visitor&& visitor) const
+{
+    json::reader reader(input);
+    visit(reader, std::forward<Visitor>(visitor));
+    if (reader.symbol() != token::symbol::end)
+        throw json::error(json::unexpected_token);
+}
+
+template <typename Visitor>
+void query::visit(json::reader& reader, Visitor&& visitor) const
+{
+    evaluator<typename std::remove_reference<Visitor>::type> engine(paths, visitor);
+    engine.evaluate(reader);
+}
+
+template <typename Allocator, typename MapPolicy>
+auto query::select(const view_type& input) const -> std::vector<std::vector<dynamic::basic_variable<Allocator, MapPolicy>>>
+{
+    std::vector<std::vector<dynamic::basic_variable<Allocator, MapPolicy>>> result(paths.size());
+    visit(input,
+          [&result] (size_type path, const lazy_value& value)
+          {
+              result[path].push_back(value.template materialize<Allocator, MapPolicy>());
+          });
+    return result;
+}
+
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_DETAIL_QUERY_IPP
@@ -11,10 +11,13 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <cassert>
 #include <cmath>
 #include <type_traits>
+#include <utility>
 #include <trial/protocol/core/detail/config.hpp>
 #include <trial/protocol/core/detail/type_traits.hpp>
+#include <trial/protocol/json/detail/traits.hpp>
 
 namespace trial
 {
@@ -27,28 +30,28 @@ namespace json
 // reader::overloader
 //-----------------------------------------------------------------------------
 
-template <typename CharT>
+template <typename CharT, typename Nesting>
 template <typename ReturnType, typename Enable>
-struct basic_reader<CharT>::overloader
+struct basic_reader<CharT, Nesting>::overloader
 {
 };
 
 // Booleans
 
-template <typename CharT>
+template <typename CharT, typename Nesting>
 template <typename ReturnType>
-struct basic_reader<CharT>::overloader<
+struct basic_reader<CharT, Nesting>::overloader<
     ReturnType,
     typename std::enable_if<core::detail::is_bool<ReturnType>::value>::type>
 {
-    inline static ReturnType value(const basic_reader<CharT>& self)
+    inline static ReturnType value(const basic_reader<CharT, Nesting>& self)
     {
         ReturnType result;
         throw_on_error(value(self, result));
         return result;
     }
 
-    inline static json::errc value(const basic_reader<CharT>& self,
+    inline static json::errc value(const basic_reader<CharT, Nesting>& self,
                                    ReturnType& output) noexcept
     {
         switch (self.decoder.code())
@@ -69,22 +72,22 @@ struct basic_reader<CharT>::overloader<
 
 // Signed integers
 
-template <typename CharT>
+template <typename CharT, typename Nesting>
 template <typename ReturnType>
-struct basic_reader<CharT>::overloader<
+struct basic_reader<CharT, Nesting>::overloader<
     ReturnType,
     typename std::enable_if<std::is_integral<ReturnType>::value &&
                             std::is_signed<ReturnType>::value &&
                             !core::detail::is_bool<ReturnType>::value>::type>
 {
-    inline static ReturnType value(const basic_reader<CharT>& self)
+    inline static ReturnType value(const basic_reader<CharT, Nesting>& self)
     {
         ReturnType result;
         throw_on_error(value(self, result));
         return result;
     }
 
-    inline static json::errc value(const basic_reader<CharT>& self,
+    inline static json::errc value(const basic_reader<CharT, Nesting>& self,
                                    ReturnType& output) noexcept
     {
         switch (self.decoder.code())
@@ -109,22 +112,22 @@ struct basic_reader<CharT>::overloader<
 
 // Unsigned integers
 
-template <typename CharT>
+template <typename CharT, typename Nesting>
 template <typename ReturnType>
-struct basic_reader<CharT>::overloader<
+struct basic_reader<CharT, Nesting>::overloader<
     ReturnType,
     typename std::enable_if<std::is_integral<ReturnType>::value &&
                             std::is_unsigned<ReturnType>::value &&
                             !core::detail::is_bool<ReturnType>::value>::type>
 {
-    inline static ReturnType value(const basic_reader<CharT>& self)
+    inline static ReturnType value(const basic_reader<CharT, Nesting>& self)
     {
         ReturnType result;
         throw_on_error(value(self, result));
         return result;
     }
 
-    inline static json::errc value(const basic_reader<CharT>& self,
+    inline static json::errc value(const basic_reader<CharT, Nesting>& self,
                                    ReturnType& output) noexcept
     {
         switch (self.decoder.code())
@@ -149,20 +152,20 @@ struct basic_reader<CharT>::overloader<
 
 // Floating-point numbers
 
-template <typename CharT>
+template <typename CharT, typename Nesting>
 template <typename ReturnType>
-struct basic_reader<CharT>::overloader<
+struct basic_reader<CharT, Nesting>::overloader<
     ReturnType,
     typename std::enable_if<std::is_floating_point<ReturnType>::value>::type>
 {
-    inline static ReturnType value(const basic_reader<CharT>& self)
+    inline static ReturnType value(const basic_reader<CharT, Nesting>& self)
     {
         ReturnType result;
         throw_on_error(value(self, result));
         return result;
     }
 
-    inline static json::errc value(const basic_reader<CharT>& self,
+    inline static json::errc value(const basic_reader<CharT, Nesting>& self,
                                    ReturnType& output) noexcept
     {
         switch (self.decoder.code())
@@ -190,21 +193,21 @@ struct basic_reader<CharT>::overloader<
 
 // Strings
 
-template <typename CharT>
+template <typename CharT, typename Nesting>
 template <typename CharTraits, typename Allocator>
-struct basic_reader<CharT>::overloader<
+struct basic_reader<CharT, Nesting>::overloader<
     std::basic_string<CharT, CharTraits, Allocator>>
 {
     using return_type = std::basic_string<CharT, CharTraits, Allocator>;
 
-    inline static return_type value(const basic_reader<CharT>& self)
+    inline static return_type value(const basic_reader<CharT, Nesting>& self)
     {
         return_type result;
         throw_on_error(value(self, result));
         return result;
     }
 
-    inline static json::errc value(const basic_reader<CharT>& self,
+    inline static json::errc value(const basic_reader<CharT, Nesting>& self,
                                    return_type& output) noexcept
     {
         switch (self.decoder.code())
@@ -223,21 +226,42 @@ struct basic_reader<CharT>::overloader<
 // basic_reader
 //-----------------------------------------------------------------------------
 
-template <typename CharT>
-basic_reader<CharT>::basic_reader()
+template <typename CharT, typename Nesting>
+basic_reader<CharT, Nesting>::basic_reader()
 {
     stack.push(token::null{});
 }
 
-template <typename CharT>
-basic_reader<CharT>::basic_reader(const view_type& input)
-    : decoder(input.data(), input.data() + input.size())
+template <typename CharT, typename Nesting>
+basic_reader<CharT, Nesting>::basic_reader(const view_type& input)
+    : basic_reader(decoder_type(input.data(), input.data() + input.size()))
+{
+}
+
+template <typename CharT, typename Nesting>
+basic_reader<CharT, Nesting>::basic_reader(const view_type& input,
+                                           json::validation validation)
+    : basic_reader(decoder_type(input.data(), input.data() + input.size(), validation))
+{
+}
+
+template <typename CharT, typename Nesting>
+basic_reader<CharT, Nesting>::basic_reader(const core::mapped_file& file)
+    : basic_reader(view_type(reinterpret_cast<const CharT *>(file.data()),
+                             file.size() / sizeof(CharT)))
+{
+}
+
+template <typename CharT, typename Nesting>
+basic_reader<CharT, Nesting>::basic_reader(decoder_type&& input)
+    : decoder(std::move(input))
 {
     stack.push(token::null{});
     switch (decoder.code())
     {
     case token::code::begin_array:
-        stack.push(token::begin_array{});
+        if (!stack.push(token::begin_array{}))
+            decoder.code(token::code::error_max_depth);
         break;
 
     case token::code::end_array:
@@ -245,7 +269,8 @@ basic_reader<CharT>::basic_reader(const view_type& input)
         break;
 
     case token::code::begin_object:
-        stack.push(token::begin_object{});
+        if (!stack.push(token::begin_object{}))
+            decoder.code(token::code::error_max_depth);
         break;
 
     case token::code::end_object:
@@ -257,59 +282,56 @@ basic_reader<CharT>::basic_reader(const view_type& input)
     }
 }
 
-template <typename CharT>
-auto basic_reader<CharT>::level() const noexcept -> size_type
+template <typename CharT, typename Nesting>
+auto basic_reader<CharT, Nesting>::level() const noexcept -> size_type
 {
     assert(stack.size() > 0);
     return stack.size() - 1;
 }
 
-template <typename CharT>
-token::code::value basic_reader<CharT>::code() const noexcept
+template <typename CharT, typename Nesting>
+token::code::value basic_reader<CharT, Nesting>::code() const noexcept
 {
     return decoder.code();
 }
 
-template <typename CharT>
-token::symbol::value basic_reader<CharT>::symbol() const noexcept
+template <typename CharT, typename Nesting>
+token::symbol::value basic_reader<CharT, Nesting>::symbol() const noexcept
 {
     return token::symbol::convert(code());
 }
 
-template <typename CharT>
-token::category::value basic_reader<CharT>::category() const noexcept
+template <typename CharT, typename Nesting>
+token::category::value basic_reader<CharT, Nesting>::category() const noexcept
 {
     return token::category::convert(code());
 }
 
-template <typename CharT>
-std::error_code basic_reader<CharT>::error() const noexcept
+template <typename CharT, typename Nesting>
+std::error_code basic_reader<CharT, Nesting>::error() const noexcept
 {
     return decoder.error();
 }
 
-template <typename CharT>
-bool basic_reader<CharT>::next()
+template <typename CharT, typename Nesting>
+bool basic_reader<CharT, Nesting>::next()
 {
     decoder.next();
     return next_frame();
 }
 
-template <typename CharT>
-bool basic_reader<CharT>::next_frame()
+template <typename CharT, typename Nesting>
+bool basic_reader<CharT, Nesting>::next_frame()
 {
-    auto& frame = stack.top();
-    const auto ret = (frame.*frame.next)(decoder);
+    const auto ret = stack.top().next(decoder);
     switch (ret)
     {
     case token::code::begin_array:
-        stack.push(token::begin_array{});
-        decoder.code(ret);
+        decoder.code(stack.push(token::begin_array{}) ? ret : token::code::error_max_depth);
         break;
 
     case token::code::begin_object:
-        stack.push(token::begin_object{});
-        decoder.code(ret);
+        decoder.code(stack.push(token::begin_object{}) ? ret : token::code::error_max_depth);
         break;
 
     case token::code::end_array:
@@ -325,8 +347,8 @@ bool basic_reader<CharT>::next_frame()
     return code() >= token::code::null;
 }
 
-template <typename CharT>
-bool basic_reader<CharT>::next(token::code::value expect)
+template <typename CharT, typename Nesting>
+bool basic_reader<CharT, Nesting>::next(token::code::value expect)
 {
     const token::code::value current = code();
     if (current != expect)
@@ -337,25 +359,25 @@ bool basic_reader<CharT>::next(token::code::value expect)
     return next();
 }
 
-template <typename CharT>
+template <typename CharT, typename Nesting>
 template <typename T>
-T basic_reader<CharT>::value() const
+T basic_reader<CharT, Nesting>::value() const
 {
     using return_type = typename std::remove_cv<typename std::decay<T>::type>::type;
-    return basic_reader<CharT>::overloader<return_type>::value(*this);
+    return basic_reader<CharT, Nesting>::overloader<return_type>::value(*this);
 }
 
-template <typename CharT>
+template <typename CharT, typename Nesting>
 template <typename T>
-auto basic_reader<CharT>::value(T& output) const noexcept -> json::errc
+auto basic_reader<CharT, Nesting>::value(T& output) const noexcept -> json::errc
 {
     using return_type = typename std::remove_cv<typename std::decay<T>::type>::type;
-    return basic_reader<CharT>::overloader<return_type>::value(*this, output);
+    return basic_reader<CharT, Nesting>::overloader<return_type>::value(*this, output);
 }
 
-template <typename CharT>
+template <typename CharT, typename Nesting>
 template <typename Collector>
-auto basic_reader<CharT>::string(Collector& collector) const noexcept -> json::errc
+auto basic_reader<CharT, Nesting>::string(Collector& collector) const noexcept -> json::errc
 {
     switch (decoder.code())
     {
@@ -368,14 +390,42 @@ auto basic_reader<CharT>::string(Collector& collector) const noexcept -> json::e
     }
 }
 
-template <typename CharT>
-auto basic_reader<CharT>::literal() const noexcept -> view_type
+template <typename CharT, typename Nesting>
+template <typename T>
+auto basic_reader<CharT, Nesting>::array(T *output, size_type output_length) -> size_type
+{
+    static_assert(std::is_arithmetic<T>::value && !core::detail::is_bool<T>::value,
+                  "T must be a number");
+
+    size_type size = 0;
+    while (size < output_length)
+    {
+        switch (decoder.code())
+        {
+        case token::code::integer:
+        case token::code::real:
+            break;
+        default:
+            return size;
+        }
+        if (overloader<T>::value(*this, output[size]) != json::no_error)
+            break;
+        ++size;
+        decoder.next();
+        if (!stack.top().next_number(decoder))
+            next_frame();
+    }
+    return size;
+}
+
+template <typename CharT, typename Nesting>
+auto basic_reader<CharT, Nesting>::literal() const noexcept -> view_type
 {
     return view_type(decoder.literal().data(), decoder.literal().size());
 }
 
-template <typename CharT>
-auto basic_reader<CharT>::tail() const noexcept -> view_type
+template <typename CharT, typename Nesting>
+auto basic_reader<CharT, Nesting>::tail() const noexcept -> view_type
 {
     return view_type(decoder.tail().data(), decoder.tail().size());
 }
@@ -384,26 +434,80 @@ auto basic_reader<CharT>::tail() const noexcept -> view_type
 // reader::frame
 //-----------------------------------------------------------------------------
 
-template <typename CharT>
-basic_reader<CharT>::frame::frame(token::null) noexcept
-    : next(&frame::next_outer)
+template <typename CharT, typename Nesting>
+basic_reader<CharT, Nesting>::frame::frame(token::null) noexcept
+    : state(outer)
+{
+}
+
+template <typename CharT, typename Nesting>
+basic_reader<CharT, Nesting>::frame::frame(token::begin_array) noexcept
+    : state(array)
 {
 }
 
-template <typename CharT>
-basic_reader<CharT>::frame::frame(token::begin_array) noexcept
-    : next(&frame::next_array)
+template <typename CharT, typename Nesting>
+basic_reader<CharT, Nesting>::frame::frame(token::begin_object) noexcept
+    : state(object)
 {
 }
 
-template <typename CharT>
-basic_reader<CharT>::frame::frame(token::begin_object) noexcept
-    : next(&frame::next_object)
+template <typename CharT, typename Nesting>
+token::code::value basic_reader<CharT, Nesting>::frame::next(decoder_type& decoder) noexcept
 {
+    switch (state)
+    {
+    case outer:
+        return next_outer(decoder);
+    case array:
+        return next_array(decoder);
+    case array_value:
+        return next_array_value(decoder);
+    case object:
+        return next_object(decoder);
+    case object_key:
+        return next_object_key(decoder);
+    case object_value:
+        return next_object_value(decoder);
+    }
+    assert(false);
+    return token::code::error_unexpected_token;
+}
+
+// Shortcut for numbers in arrays. Scans the next array value if it directly
+// follows the value separator and is a number.
+template <typename CharT, typename Nesting>
+bool basic_reader<CharT, Nesting>::frame::next_number(decoder_type& decoder) noexcept
+{
+    if ((state != array_value) || (decoder.code() != token::code::error_value_separator))
+        return false;
+
+    const auto& tail = decoder.tail();
+    if (tail.empty())
+        return false;
+    switch (tail.front())
+    {
+    case detail::traits::alphabet<CharT>::minus:
+    case detail::traits::alphabet<CharT>::digit_0:
+    case detail::traits::alphabet<CharT>::digit_1:
+    case detail::traits::alphabet<CharT>::digit_2:
+    case detail::traits::alphabet<CharT>::digit_3:
+    case detail::traits::alphabet<CharT>::digit_4:
+    case detail::traits::alphabet<CharT>::digit_5:
+    case detail::traits::alphabet<CharT>::digit_6:
+    case detail::traits::alphabet<CharT>::digit_7:
+    case detail::traits::alphabet<CharT>::digit_8:
+    case detail::traits::alphabet<CharT>::digit_9:
+        decoder.assume_next();
+        return true;
+
+    default:
+        return false;
+    }
 }
 
-template <typename CharT>
-token::code::value basic_reader<CharT>::frame::next_outer(decoder_type& decoder) noexcept
+template <typename CharT, typename Nesting>
+token::code::value basic_reader<CharT, Nesting>::frame::next_outer(decoder_type& decoder) noexcept
 {
     // RFC 8259, section 2
     //
@@ -428,8 +532,8 @@ token::code::value basic_reader<CharT>::frame::next_outer(decoder_type& decoder)
     }
 }
 
-template <typename CharT>
-token::code::value basic_reader<CharT>::frame::next_array(decoder_type& decoder) noexcept
+template <typename CharT, typename Nesting>
+token::code::value basic_reader<CharT, Nesting>::frame::next_array(decoder_type& decoder) noexcept
 {
     // RFC 8259, section 5
     //
@@ -446,13 +550,13 @@ token::code::value basic_reader<CharT>::frame::next_array(decoder_type& decoder)
         return token::code::error_expected_end_array;
 
     default:
-        next = &frame::next_array_value;
+        state = array_value;
         return current;
     }
 }
 
-template <typename CharT>
-token::code::value basic_reader<CharT>::frame::next_array_value(decoder_type& decoder) noexcept
+template <typename CharT, typename Nesting>
+token::code::value basic_reader<CharT, Nesting>::frame::next_array_value(decoder_type& decoder) noexcept
 {
     const token::code::value current = decoder.code();
     if TRIAL_LIKELY(current == token::code::error_value_separator)
@@ -471,8 +575,8 @@ token::code::value basic_reader<CharT>::frame::next_array_value(decoder_type& de
     return token::code::error_expected_end_array;
 }
 
-template <typename CharT>
-token::code::value basic_reader<CharT>::frame::next_object(decoder_type& decoder) noexcept
+template <typename CharT, typename Nesting>
+token::code::value basic_reader<CharT, Nesting>::frame::next_object(decoder_type& decoder) noexcept
 {
     // RFC 8259, section 4
     //
@@ -499,13 +603,13 @@ token::code::value basic_reader<CharT>::frame::next_object(decoder_type& decoder
         // Key must be string type
         if (current != token::code::string)
             return token::code::error_invalid_key;
-        next = &frame::next_object_key;
+        state = object_key;
         return token::code::key;
     }
 }
 
-template <typename CharT>
-token::code::value basic_reader<CharT>::frame::next_object_key(decoder_type& decoder) noexcept
+template <typename CharT, typename Nesting>
+token::code::value basic_reader<CharT, Nesting>::frame::next_object_key(decoder_type& decoder) noexcept
 {
     if (decoder.code() == token::code::error_name_separator)
     {
@@ -517,15 +621,15 @@ token::code::value basic_reader<CharT>::frame::next_object_key(decoder_type& dec
             return token::code::error_unexpected_token;
 
         default:
-            next = &frame::next_object_value;
+            state = object_value;
             return decoder.code();
         }
     }
     return token::code::error_unexpected_token;
 }
 
-template <typename CharT>
-token::code::value basic_reader<CharT>::frame::next_object_value(decoder_type& decoder) noexcept
+template <typename CharT, typename Nesting>
+token::code::value basic_reader<CharT, Nesting>::frame::next_object_value(decoder_type& decoder) noexcept
 {
     const auto current = decoder.code();
     if TRIAL_LIKELY(current == token::code::error_value_separator)
@@ -537,7 +641,7 @@ token::code::value basic_reader<CharT>::frame::next_object_value(decoder_type& d
             // Prohibit trailing separator
             return token::code::error_unexpected_token;
         case token::code::string:
-            next = &frame::next_object_key;
+            state = object_key;
             return token::code::key;
         default:
             return decoder.code();
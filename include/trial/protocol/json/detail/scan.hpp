@@ -11,6 +11,8 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef>
+#include <cstdint>
 #include <trial/protocol/core/detail/config.hpp>
 #include <trial/protocol/core/detail/bit.hpp>
 #include <trial/protocol/core/detail/simd.hpp>
@@ -25,87 +27,1019 @@ namespace json
 namespace detail
 {
 
+// Scanners return the first position that does not belong to the category.
+//
+// Each instruction set processes as many full vectors as possible and passes
+// the remainder on to the next narrower instruction set.
+
+// Moves a position that was reached by validating blocks of UTF-8 bytes back
+// to the beginning of the sequence that straddles the block boundary.
 template <typename CharT>
-auto scan_narrow(const CharT *marker,
-                 const CharT * const tail) noexcept -> const CharT *
+auto utf8_boundary(const CharT *marker,
+                   std::uint64_t carry) noexcept -> const CharT *
 {
+    if (carry != 0)
+    {
+        while ((static_cast<unsigned char>(marker[-1]) & 0xC0) == 0x80)
+            --marker;
+        --marker;
+    }
+    return marker;
+}
+
 #if defined(TRIAL_PROTOCOL_USE_SSE2)
-    // Swaps space and quote characters
-    const auto permuter = _mm_set1_epi8(0x02);
-    // Covers permuted quote and control characters + extra characters
-    const auto lower = _mm_set1_epi8(0x21);
-    const auto escape = _mm_set1_epi8(0x5e);
-    while (tail - marker > 16)
-    {
-        const auto data = _mm_xor_si128(_mm_loadu_si128((const __m128i *)marker),
-                                        permuter);
-        const auto avoid = _mm_or_si128(_mm_cmpeq_epi8(data, escape),
-                                        _mm_cmplt_epi8(data, lower));
-        const auto mask = _mm_movemask_epi8(avoid);
-        if (mask != 0)
-            return marker + core::detail::countr_zero(mask);
-        marker += 16;
+
+// Lookup tables for strict UTF-8 validation
+//
+// J. Keiser, D. Lemire, "Validating UTF-8 In Less Than One Instruction Per
+// Byte", Software: Practice and Experience, 2021.
+//
+// Each byte is classified by the high and low nibbles of the preceding byte
+// and by the high nibble of the byte itself. The three classifications are
+// combined to detect errors in two-byte windows. The only combination that is
+// not an error, a continuation that follows a continuation, is marked with the
+// high bit, which must match the expected third and fourth bytes.
+
+struct utf8_lookup
+{
+    enum : unsigned char
+    {
+        too_short = 1 << 0,         // 11______ 0_______ or 11______ 11______
+        too_long = 1 << 1,          // 0_______ 10______
+        overlong_3 = 1 << 2,        // 11100000 100_____
+        too_large = 1 << 3,         // 11110100 1001____ or 11110100 101_____ or 11110101+
+        surrogate = 1 << 4,         // 11101101 101_____
+        overlong_2 = 1 << 5,        // 1100000_ 10______
+        too_large_1000 = 1 << 6,    // 11110101+ 1000____
+        overlong_4 = 1 << 6,        // 11110000 1000____
+        two_continuations = 1 << 7, // 10______ 10______
+        carry = too_short | too_long | two_continuations
+    };
+
+    static __m128i first_high() noexcept
+    {
+        return _mm_setr_epi8(
+            // 0_______
+            too_long, too_long, too_long, too_long,
+            too_long, too_long, too_long, too_long,
+            // 10______
+            char(two_continuations), char(two_continuations),
+            char(two_continuations), char(two_continuations),
+            // 1100____
+            too_short | overlong_2,
+            // 1101____
+            too_short,
+            // 1110____
+            too_short | overlong_3 | surrogate,
+            // 1111____
+            too_short | too_large | too_large_1000 | overlong_4);
+    }
+
+    static __m128i first_low() noexcept
+    {
+        return _mm_setr_epi8(
+            // ____0000
+            char(carry | overlong_3 | overlong_2 | overlong_4),
+            // ____0001
+            char(carry | overlong_2),
+            // ____001_
+            char(carry),
+            char(carry),
+            // ____0100
+            char(carry | too_large),
+            // ____0101
+            char(carry | too_large | too_large_1000),
+            // ____011_
+            char(carry | too_large | too_large_1000),
+            char(carry | too_large | too_large_1000),
+            // ____1___
+            char(carry | too_large | too_large_1000),
+            char(carry | too_large | too_large_1000),
+            char(carry | too_large | too_large_1000),
+            char(carry | too_large | too_large_1000),
+            char(carry | too_large | too_large_1000),
+            // ____1101
+            char(carry | too_large | too_large_1000 | surrogate),
+            char(carry | too_large | too_large_1000),
+            char(carry | too_large | too_large_1000));
+    }
+
+    static __m128i second_high() noexcept
+    {
+        return _mm_setr_epi8(
+            // 0_______
+            too_short, too_short, too_short, too_short,
+            too_short, too_short, too_short, too_short,
+            // 1000____
+            char(too_long | overlong_2 | two_continuations | overlong_3 | too_large_1000 | overlong_4),
+            // 1001____
+            char(too_long | overlong_2 | two_continuations | overlong_3 | too_large),
+            // 101_____
+            char(too_long | overlong_2 | two_continuations | surrogate | too_large),
+            char(too_long | overlong_2 | two_continuations | surrogate | too_large),
+            // 11______
+            too_short, too_short, too_short, too_short);
     }
+};
+
 #endif
 
-    while (marker != tail)
+// Checks if a sequence starts among the last three bytes before a block
+// boundary and continues after it.
+template <typename CharT>
+auto utf8_incomplete(const CharT *marker) noexcept -> std::uint64_t
+{
+    return (static_cast<unsigned char>(marker[-1]) >= 0xC0)
+        || (static_cast<unsigned char>(marker[-2]) >= 0xE0)
+        || (static_cast<unsigned char>(marker[-3]) >= 0xF0);
+}
+
+template <core::detail::simd::isa>
+struct scanner;
+
+template <>
+struct scanner<core::detail::simd::isa::scalar>
+{
+    template <typename CharT>
+    static auto narrow(const CharT *marker,
+                       const CharT * const tail) noexcept -> const CharT *
+    {
+        while (marker != tail)
+        {
+            if (traits::to_category(*marker) == traits::category::narrow)
+            {
+                ++marker;
+            }
+            else
+                break;
+        }
+        return marker;
+    }
+
+    template <typename CharT>
+    static auto digit(const CharT *marker,
+                      const CharT * const tail) noexcept -> const CharT *
+    {
+        while (marker != tail)
+        {
+            if (traits::is_digit(*marker))
+            {
+                ++marker;
+            }
+            else
+                break;
+        }
+        return marker;
+    }
+
+    template <typename CharT>
+    static auto whitespace(const CharT *marker,
+                           const CharT * const tail) noexcept -> const CharT *
+    {
+        while (marker != tail)
+        {
+            if (traits::is_space(*marker))
+            {
+                ++marker;
+            }
+            else
+                break;
+        }
+        return marker;
+    }
+
+    template <typename CharT>
+    static auto unescaped(const CharT *marker,
+                          const CharT * const tail) noexcept -> const CharT *
     {
-        if (traits::to_category(*marker) == traits::category::narrow)
+        while (marker != tail)
         {
+            if (needs_escape(*marker))
+                break;
             ++marker;
         }
-        else
-            break;
+        return marker;
     }
-    return marker;
-}
 
-template <typename CharT>
-auto scan_digit(const CharT *marker,
-                const CharT * const tail) noexcept -> const CharT *
-{
+    // Sequences are validated by their bit distribution, which means that
+    // overlong sequences are accepted, and four byte sequences are rejected.
+    template <typename CharT>
+    static auto utf8(const CharT *marker,
+                     const CharT * const tail) noexcept -> const CharT *
+    {
+        while (marker != tail)
+        {
+            const auto lead = static_cast<unsigned char>(*marker);
+            std::ptrdiff_t length;
+            if ((lead & 0x80) == 0x00)
+            {
+                // 0xxxxxxx
+                ++marker;
+                continue;
+            }
+            else if ((lead & 0xE0) == 0xC0)
+            {
+                // 110xxxxx 10xxxxxx
+                length = 2;
+            }
+            else if ((lead & 0xF0) == 0xE0)
+            {
+                // 1110xxxx 10xxxxxx 10xxxxxx
+                length = 3;
+            }
+            else
+                break;
+
+            if (tail - marker < length)
+                break;
+            for (std::ptrdiff_t i = 1; i < length; ++i)
+            {
+                if ((static_cast<unsigned char>(marker[i]) & 0xC0) != 0x80)
+                    return marker;
+            }
+            marker += length;
+        }
+        return marker;
+    }
+
+    // Well-formed sequences according to The Unicode Standard, Version 13.0 -
+    // Core Specification, Table 3-7.
+    template <typename CharT>
+    static auto strict_utf8(const CharT *marker,
+                            const CharT * const tail) noexcept -> const CharT *
+    {
+        while (marker != tail)
+        {
+            const auto lead = static_cast<unsigned char>(*marker);
+            if (lead < 0x80)
+            {
+                ++marker;
+                continue;
+            }
+            // Range of the second byte
+            unsigned char lower = 0x80;
+            unsigned char upper = 0xBF;
+            std::ptrdiff_t length;
+            if (lead < 0xC2)
+                break;
+            else if (lead < 0xE0)
+            {
+                length = 2;
+            }
+            else if (lead < 0xF0)
+            {
+                length = 3;
+                if (lead == 0xE0)
+                    lower = 0xA0; // Overlong
+                else if (lead == 0xED)
+                    upper = 0x9F; // Surrogates
+            }
+            else if (lead < 0xF5)
+            {
+                length = 4;
+                if (lead == 0xF0)
+                    lower = 0x90; // Overlong
+                else if (lead == 0xF4)
+                    upper = 0x8F; // Beyond U+10FFFF
+            }
+            else
+                break;
+
+            if (tail - marker < length)
+                break;
+            const auto second = static_cast<unsigned char>(marker[1]);
+            if ((second < lower) || (second > upper))
+                break;
+            for (std::ptrdiff_t i = 2; i < length; ++i)
+            {
+                if ((static_cast<unsigned char>(marker[i]) & 0xC0) != 0x80)
+                    return marker;
+            }
+            marker += length;
+        }
+        return marker;
+    }
+
+private:
+    template <typename CharT>
+    static bool needs_escape(CharT value) noexcept
+    {
+        switch (value)
+        {
+        case traits::alphabet<CharT>::quote:
+        case traits::alphabet<CharT>::reverse_solidus:
+        case traits::alphabet<CharT>::solidus:
+            return true;
+        default:
+            return static_cast<unsigned char>(value) < 0x20;
+        }
+    }
+};
+
 #if defined(TRIAL_PROTOCOL_USE_SSE2)
-    // Shift digits to range [0x75, 0x7F] to make single range comparison
-    const auto offset = _mm_set1_epi8(0x7F - 0x39);
-    const auto legal = _mm_set1_epi8(0x7F - 10);
-    while (tail - marker > 16)
-    {
-        auto data = _mm_loadu_si128((const __m128i *)marker);
-        data = _mm_add_epi8(data, offset);
-        data = _mm_cmplt_epi8(data, legal);
-        const auto mask = _mm_movemask_epi8(data);
-        if (mask != 0)
-            return marker + core::detail::countr_zero(mask);
-        marker += 16;
+
+template <>
+struct scanner<core::detail::simd::isa::sse2>
+{
+    using next = scanner<core::detail::simd::isa::scalar>;
+
+    template <typename CharT>
+    static auto narrow(const CharT *marker,
+                       const CharT * const tail) noexcept -> const CharT *
+    {
+        // Swaps space and quote characters
+        const auto permuter = _mm_set1_epi8(0x02);
+        // Covers permuted quote and control characters + extra characters
+        const auto lower = _mm_set1_epi8(0x21);
+        const auto escape = _mm_set1_epi8(0x5e);
+        while (tail - marker >= 16)
+        {
+            const auto data = _mm_xor_si128(_mm_loadu_si128((const __m128i *)marker),
+                                            permuter);
+            const auto avoid = _mm_or_si128(_mm_cmpeq_epi8(data, escape),
+                                            _mm_cmplt_epi8(data, lower));
+            const auto mask = _mm_movemask_epi8(avoid);
+            if (mask != 0)
+                return marker + core::detail::countr_zero(mask);
+            marker += 16;
+        }
+        return next::narrow(marker, tail);
+    }
+
+    template <typename CharT>
+    static auto digit(const CharT *marker,
+                      const CharT * const tail) noexcept -> const CharT *
+    {
+        // Shift digits to range [0x76, 0x7F] to make single range comparison
+        const auto offset = _mm_set1_epi8(0x7F - 0x39);
+        const auto legal = _mm_set1_epi8(0x7F - 9);
+        while (tail - marker >= 16)
+        {
+            auto data = _mm_loadu_si128((const __m128i *)marker);
+            data = _mm_add_epi8(data, offset);
+            data = _mm_cmplt_epi8(data, legal);
+            const auto mask = _mm_movemask_epi8(data);
+            if (mask != 0)
+                return marker + core::detail::countr_zero(mask);
+            marker += 16;
+        }
+        return next::digit(marker, tail);
+    }
+
+    template <typename CharT>
+    static auto whitespace(const CharT *marker,
+                           const CharT * const tail) noexcept -> const CharT *
+    {
+        const auto space = _mm_set1_epi8(0x20);
+        const auto tabulator = _mm_set1_epi8(0x09);
+        const auto newline = _mm_set1_epi8(0x0A);
+        const auto carriage_return = _mm_set1_epi8(0x0D);
+        while (tail - marker >= 16)
+        {
+            const auto data = _mm_loadu_si128((const __m128i *)marker);
+            const auto keep = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, space),
+                                                         _mm_cmpeq_epi8(data, tabulator)),
+                                           _mm_or_si128(_mm_cmpeq_epi8(data, newline),
+                                                        _mm_cmpeq_epi8(data, carriage_return)));
+            const auto mask = ~_mm_movemask_epi8(keep) & 0xFFFF;
+            if (mask != 0)
+                return marker + core::detail::countr_zero(mask);
+            marker += 16;
+        }
+        return next::whitespace(marker, tail);
+    }
+
+    template <typename CharT>
+    static auto unescaped(const CharT *marker,
+                          const CharT * const tail) noexcept -> const CharT *
+    {
+        const auto quote = _mm_set1_epi8(0x22);
+        const auto solidus = _mm_set1_epi8(0x2F);
+        const auto reverse_solidus = _mm_set1_epi8(0x5C);
+        const auto control = _mm_set1_epi8(0x1F);
+        while (tail - marker >= 16)
+        {
+            const auto data = _mm_loadu_si128((const __m128i *)marker);
+            const auto avoid = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, quote),
+                                                         _mm_cmpeq_epi8(data, solidus)),
+                                            _mm_or_si128(_mm_cmpeq_epi8(data, reverse_solidus),
+                                                         _mm_cmpeq_epi8(_mm_min_epu8(data, control), data)));
+            const auto mask = _mm_movemask_epi8(avoid);
+            if (mask != 0)
+                return marker + core::detail::countr_zero(mask);
+            marker += 16;
+        }
+        return next::unescaped(marker, tail);
     }
+
+    // Each byte is classified as ASCII, continuation, lead, or illegal. A
+    // continuation must follow a lead byte and vice versa.
+    template <typename CharT>
+    static auto utf8(const CharT *marker,
+                     const CharT * const tail) noexcept -> const CharT *
+    {
+        // Signed comparisons on 0x80-0xBF, 0xC0-0xFF, 0xE0-0xFF, 0xF0-0xFF
+        const auto continuation = _mm_set1_epi8(char(0xC0));
+        const auto lead3 = _mm_set1_epi8(char(0xDF));
+        const auto illegal = _mm_set1_epi8(char(0xEF));
+        std::uint64_t carry = 0;
+        while (tail - marker >= 16)
+        {
+            const auto data = _mm_loadu_si128((const __m128i *)marker);
+            const std::uint64_t high = _mm_movemask_epi8(data);
+            if ((high | carry) != 0)
+            {
+                const std::uint64_t tails = _mm_movemask_epi8(_mm_cmplt_epi8(data, continuation));
+                const std::uint64_t threes = high & _mm_movemask_epi8(_mm_cmpgt_epi8(data, lead3));
+                const std::uint64_t fours = high & _mm_movemask_epi8(_mm_cmpgt_epi8(data, illegal));
+                const std::uint64_t leads = high & ~tails;
+                const std::uint64_t expected = (carry | (leads << 1) | (threes << 2)) & 0xFFFF;
+                if (((expected ^ tails) | fours) != 0)
+                    break;
+                carry = (leads >> 15) | (threes >> 14);
+            }
+            marker += 16;
+        }
+        return next::utf8(utf8_boundary(marker, carry), tail);
+    }
+
+    // The byte shuffles needed for strict validation are unavailable, so only
+    // leading ASCII characters are skipped in bulk.
+    template <typename CharT>
+    static auto strict_utf8(const CharT *marker,
+                            const CharT * const tail) noexcept -> const CharT *
+    {
+        while (tail - marker >= 16)
+        {
+            const auto data = _mm_loadu_si128((const __m128i *)marker);
+            if (_mm_movemask_epi8(data) != 0)
+                break;
+            marker += 16;
+        }
+        return next::strict_utf8(marker, tail);
+    }
+};
+
 #endif
 
-    while (marker != tail)
+#if defined(TRIAL_PROTOCOL_HAS_AVX2)
+
+template <>
+struct scanner<core::detail::simd::isa::avx2>
+{
+    using next = scanner<core::detail::simd::isa::sse2>;
+
+    template <typename CharT>
+    TRIAL_PROTOCOL_TARGET_AVX2
+    static auto narrow(const CharT *marker,
+                       const CharT * const tail) noexcept -> const CharT *
     {
-        if (traits::is_digit(*marker))
+        const auto permuter = _mm256_set1_epi8(0x02);
+        const auto lower = _mm256_set1_epi8(0x21);
+        const auto escape = _mm256_set1_epi8(0x5e);
+        while (tail - marker >= 32)
         {
-            ++marker;
+            const auto data = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)marker),
+                                               permuter);
+            const auto avoid = _mm256_or_si256(_mm256_cmpeq_epi8(data, escape),
+                                               _mm256_cmpgt_epi8(lower, data));
+            const auto mask = _mm256_movemask_epi8(avoid);
+            if (mask != 0)
+                return marker + core::detail::countr_zero(mask);
+            marker += 32;
         }
-        else
-            break;
+        return next::narrow(marker, tail);
     }
-    return marker;
+
+    template <typename CharT>
+    TRIAL_PROTOCOL_TARGET_AVX2
+    static auto digit(const CharT *marker,
+                      const CharT * const tail) noexcept -> const CharT *
+    {
+        const auto offset = _mm256_set1_epi8(0x7F - 0x39);
+        const auto legal = _mm256_set1_epi8(0x7F - 9);
+        while (tail - marker >= 32)
+        {
+            auto data = _mm256_loadu_si256((const __m256i *)marker);
+            data = _mm256_add_epi8(data, offset);
+            data = _mm256_cmpgt_epi8(legal, data);
+            const auto mask = _mm256_movemask_epi8(data);
+            if (mask != 0)
+                return marker + core::detail::countr_zero(mask);
+            marker += 32;
+        }
+        return next::digit(marker, tail);
+    }
+
+    template <typename CharT>
+    TRIAL_PROTOCOL_TARGET_AVX2
+    static auto whitespace(const CharT *marker,
+                           const CharT * const tail) noexcept -> const CharT *
+    {
+        const auto space = _mm256_set1_epi8(0x20);
+        const auto tabulator = _mm256_set1_epi8(0x09);
+        const auto newline = _mm256_set1_epi8(0x0A);
+        const auto carriage_return = _mm256_set1_epi8(0x0D);
+        while (tail - marker >= 32)
+        {
+            const auto data = _mm256_loadu_si256((const __m256i *)marker);
+            const auto keep = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(data, space),
+                                                               _mm256_cmpeq_epi8(data, tabulator)),
+                                              _mm256_or_si256(_mm256_cmpeq_epi8(data, newline),
+                                                              _mm256_cmpeq_epi8(data, carriage_return)));
+            const auto mask = ~unsigned(_mm256_movemask_epi8(keep));
+            if (mask != 0)
+                return marker + core::detail::countr_zero(mask);
+            marker += 32;
+        }
+        return next::whitespace(marker, tail);
+    }
+
+    template <typename CharT>
+    TRIAL_PROTOCOL_TARGET_AVX2
+    static auto unescaped(const CharT *marker,
+                          const CharT * const tail) noexcept -> const CharT *
+    {
+        const auto quote = _mm256_set1_epi8(0x22);
+        const auto solidus = _mm256_set1_epi8(0x2F);
+        const auto reverse_solidus = _mm256_set1_epi8(0x5C);
+        const auto control = _mm256_set1_epi8(0x1F);
+        while (tail - marker >= 32)
+        {
+            const auto data = _mm256_loadu_si256((const __m256i *)marker);
+            const auto avoid = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(data, quote),
+                                                               _mm256_cmpeq_epi8(data, solidus)),
+                                               _mm256_or_si256(_mm256_cmpeq_epi8(data, reverse_solidus),
+                                                               _mm256_cmpeq_epi8(_mm256_min_epu8(data, control), data)));
+            const auto mask = _mm256_movemask_epi8(avoid);
+            if (mask != 0)
+                return marker + core::detail::countr_zero(mask);
+            marker += 32;
+        }
+        return next::unescaped(marker, tail);
+    }
+
+    template <typename CharT>
+    TRIAL_PROTOCOL_TARGET_AVX2
+    static auto utf8(const CharT *marker,
+                     const CharT * const tail) noexcept -> const CharT *
+    {
+        const auto continuation = _mm256_set1_epi8(char(0xC0));
+        const auto lead3 = _mm256_set1_epi8(char(0xDF));
+        const auto illegal = _mm256_set1_epi8(char(0xEF));
+        std::uint64_t carry = 0;
+        while (tail - marker >= 32)
+        {
+            const auto data = _mm256_loadu_si256((const __m256i *)marker);
+            const std::uint64_t high = std::uint32_t(_mm256_movemask_epi8(data));
+            if ((high | carry) != 0)
+            {
+                const std::uint64_t tails = std::uint32_t(_mm256_movemask_epi8(_mm256_cmpgt_epi8(continuation, data)));
+                const std::uint64_t threes = high & std::uint32_t(_mm256_movemask_epi8(_mm256_cmpgt_epi8(data, lead3)));
+                const std::uint64_t fours = high & std::uint32_t(_mm256_movemask_epi8(_mm256_cmpgt_epi8(data, illegal)));
+                const std::uint64_t leads = high & ~tails;
+                const std::uint64_t expected = (carry | (leads << 1) | (threes << 2)) & 0xFFFFFFFF;
+                if (((expected ^ tails) | fours) != 0)
+                    break;
+                carry = (leads >> 31) | (threes >> 30);
+            }
+            marker += 32;
+        }
+        return next::utf8(utf8_boundary(marker, carry), tail);
+    }
+
+    template <typename CharT>
+    TRIAL_PROTOCOL_TARGET_AVX2
+    static auto strict_utf8(const CharT *marker,
+                            const CharT * const tail) noexcept -> const CharT *
+    {
+        const auto nibble = _mm256_set1_epi8(0x0F);
+        const auto first_high = _mm256_broadcastsi128_si256(utf8_lookup::first_high());
+        const auto first_low = _mm256_broadcastsi128_si256(utf8_lookup::first_low());
+        const auto second_high = _mm256_broadcastsi128_si256(utf8_lookup::second_high());
+        const auto third = _mm256_set1_epi8(char(0xE0 - 0x80));
+        const auto fourth = _mm256_set1_epi8(char(0xF0 - 0x80));
+        const auto high = _mm256_set1_epi8(char(0x80));
+        auto previous = _mm256_setzero_si256();
+        std::uint64_t carry = 0;
+        while (tail - marker >= 32)
+        {
+            const auto data = _mm256_loadu_si256((const __m256i *)marker);
+            if ((_mm256_movemask_epi8(data) | carry) != 0)
+            {
+                // Previous bytes shifted in from the previous block
+                const auto shifted = _mm256_permute2x128_si256(previous, data, 0x21);
+                const auto prev1 = _mm256_alignr_epi8(data, shifted, 16 - 1);
+                const auto prev2 = _mm256_alignr_epi8(data, shifted, 16 - 2);
+                const auto prev3 = _mm256_alignr_epi8(data, shifted, 16 - 3);
+                const auto special = _mm256_and_si256(
+                    _mm256_and_si256(
+                        _mm256_shuffle_epi8(first_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+                        _mm256_shuffle_epi8(first_low, _mm256_and_si256(prev1, nibble))),
+                    _mm256_shuffle_epi8(second_high, _mm256_and_si256(_mm256_srli_epi16(data, 4), nibble)));
+                const auto continuation = _mm256_and_si256(
+                    _mm256_or_si256(_mm256_subs_epu8(prev2, third),
+                                    _mm256_subs_epu8(prev3, fourth)),
+                    high);
+                const auto error = _mm256_xor_si256(continuation, special);
+                if (!_mm256_testz_si256(error, error))
+                    break;
+            }
+            previous = data;
+            marker += 32;
+            carry = utf8_incomplete(marker);
+        }
+        return next::strict_utf8(utf8_boundary(marker, carry), tail);
+    }
+};
+
+#endif
+
+#if defined(TRIAL_PROTOCOL_HAS_AVX512)
+
+template <>
+struct scanner<core::detail::simd::isa::avx512>
+{
+    using next = scanner<core::detail::simd::isa::avx2>;
+
+    template <typename CharT>
+    TRIAL_PROTOCOL_TARGET_AVX512
+    static auto narrow(const CharT *marker,
+                       const CharT * const tail) noexcept -> const CharT *
+    {
+        const auto permuter = _mm512_set1_epi8(0x02);
+        const auto lower = _mm512_set1_epi8(0x21);
+        const auto escape = _mm512_set1_epi8(0x5e);
+        while (tail - marker >= 64)
+        {
+            const auto data = _mm512_xor_si512(_mm512_loadu_si512((const void *)marker),
+                                               permuter);
+            const auto mask = _mm512_cmpeq_epi8_mask(data, escape)
+                | _mm512_cmplt_epi8_mask(data, lower);
+            if (mask != 0)
+                return marker + core::detail::countr_zero(mask);
+            marker += 64;
+        }
+        return next::narrow(marker, tail);
+    }
+
+    template <typename CharT>
+    TRIAL_PROTOCOL_TARGET_AVX512
+    static auto digit(const CharT *marker,
+                      const CharT * const tail) noexcept -> const CharT *
+    {
+        const auto offset = _mm512_set1_epi8(0x7F - 0x39);
+        const auto legal = _mm512_set1_epi8(0x7F - 9);
+        while (tail - marker >= 64)
+        {
+            const auto data = _mm512_add_epi8(_mm512_loadu_si512((const void *)marker),
+                                              offset);
+            const auto mask = _mm512_cmplt_epi8_mask(data, legal);
+            if (mask != 0)
+                return marker + core::detail::countr_zero(mask);
+            marker += 64;
+        }
+        return next::digit(marker, tail);
+    }
+
+    template <typename CharT>
+    TRIAL_PROTOCOL_TARGET_AVX512
+    static auto whitespace(const CharT *marker,
+                           const CharT * const tail) noexcept -> const CharT *
+    {
+        const auto space = _mm512_set1_epi8(0x20);
+        const auto tabulator = _mm512_set1_epi8(0x09);
+        const auto newline = _mm512_set1_epi8(0x0A);
+        const auto carriage_return = _mm512_set1_epi8(0x0D);
+        while (tail - marker >= 64)
+        {
+            const auto data = _mm512_loadu_si512((const void *)marker);
+            const auto keep = _mm512_cmpeq_epi8_mask(data, space)
+                | _mm512_cmpeq_epi8_mask(data, tabulator)
+                | _mm512_cmpeq_epi8_mask(data, newline)
+                | _mm512_cmpeq_epi8_mask(data, carriage_return);
+            const auto mask = ~keep;
+            if (mask != 0)
+                return marker + core::detail::countr_zero(mask);
+            marker += 64;
+        }
+        return next::whitespace(marker, tail);
+    }
+
+    template <typename CharT>
+    TRIAL_PROTOCOL_TARGET_AVX512
+    static auto unescaped(const CharT *marker,
+                          const CharT * const tail) noexcept -> const CharT *
+    {
+        const auto quote = _mm512_set1_epi8(0x22);
+        const auto solidus = _mm512_set1_epi8(0x2F);
+        const auto reverse_solidus = _mm512_set1_epi8(0x5C);
+        const auto control = _mm512_set1_epi8(0x1F);
+        while (tail - marker >= 64)
+        {
+            const auto data = _mm512_loadu_si512((const void *)marker);
+            const auto mask = _mm512_cmpeq_epi8_mask(data, quote)
+                | _mm512_cmpeq_epi8_mask(data, solidus)
+                | _mm512_cmpeq_epi8_mask(data, reverse_solidus)
+                | _mm512_cmple_epu8_mask(data, control);
+            if (mask != 0)
+                return marker + core::detail::countr_zero(mask);
+            marker += 64;
+        }
+        return next::unescaped(marker, tail);
+    }
+
+    template <typename CharT>
+    TRIAL_PROTOCOL_TARGET_AVX512
+    static auto utf8(const CharT *marker,
+                     const CharT * const tail) noexcept -> const CharT *
+    {
+        const auto continuation = _mm512_set1_epi8(char(0xC0));
+        const auto lead3 = _mm512_set1_epi8(char(0xDF));
+        const auto illegal = _mm512_set1_epi8(char(0xEF));
+        std::uint64_t carry = 0;
+        while (tail - marker >= 64)
+        {
+            const auto data = _mm512_loadu_si512((const void *)marker);
+            const std::uint64_t high = _mm512_movepi8_mask(data);
+            if ((high | carry) != 0)
+            {
+                const std::uint64_t tails = _mm512_cmplt_epi8_mask(data, continuation);
+                const std::uint64_t threes = high & _mm512_cmpgt_epi8_mask(data, lead3);
+                const std::uint64_t fours = high & _mm512_cmpgt_epi8_mask(data, illegal);
+                const std::uint64_t leads = high & ~tails;
+                const std::uint64_t expected = carry | (leads << 1) | (threes << 2);
+                if (((expected ^ tails) | fours) != 0)
+                    break;
+                carry = (leads >> 63) | (threes >> 62);
+            }
+            marker += 64;
+        }
+        return next::utf8(utf8_boundary(marker, carry), tail);
+    }
+
+    template <typename CharT>
+    TRIAL_PROTOCOL_TARGET_AVX512
+    static auto strict_utf8(const CharT *marker,
+                            const CharT * const tail) noexcept -> const CharT *
+    {
+        const auto nibble = _mm512_set1_epi8(0x0F);
+        const auto first_high = _mm512_maskz_broadcast_i32x4(0xFFFF, utf8_lookup::first_high());
+        const auto first_low = _mm512_maskz_broadcast_i32x4(0xFFFF, utf8_lookup::first_low());
+        const auto second_high = _mm512_maskz_broadcast_i32x4(0xFFFF, utf8_lookup::second_high());
+        const auto third = _mm512_set1_epi8(char(0xE0 - 0x80));
+        const auto fourth = _mm512_set1_epi8(char(0xF0 - 0x80));
+        const auto high = _mm512_set1_epi8(char(0x80));
+        // Last 128-bit lane of previous block followed by first three lanes
+        const auto lanes = _mm512_set_epi64(13, 12, 11, 10, 9, 8, 7, 6);
+        auto previous = _mm512_setzero_si512();
+        std::uint64_t carry = 0;
+        while (tail - marker >= 64)
+        {
+            const auto data = _mm512_loadu_si512((const void *)marker);
+            if ((_mm512_movepi8_mask(data) | carry) != 0)
+            {
+                const auto shifted = _mm512_permutex2var_epi64(previous, lanes, data);
+                const auto prev1 = _mm512_alignr_epi8(data, shifted, 16 - 1);
+                const auto prev2 = _mm512_alignr_epi8(data, shifted, 16 - 2);
+                const auto prev3 = _mm512_alignr_epi8(data, shifted, 16 - 3);
+                const auto special = _mm512_and_si512(
+                    _mm512_and_si512(
+                        _mm512_shuffle_epi8(first_high, _mm512_and_si512(_mm512_srli_epi16(prev1, 4), nibble)),
+                        _mm512_shuffle_epi8(first_low, _mm512_and_si512(prev1, nibble))),
+                    _mm512_shuffle_epi8(second_high, _mm512_and_si512(_mm512_srli_epi16(data, 4), nibble)));
+                const auto continuation = _mm512_and_si512(
+                    _mm512_or_si512(_mm512_subs_epu8(prev2, third),
+                                    _mm512_subs_epu8(prev3, fourth)),
+                    high);
+                const auto error = _mm512_xor_si512(continuation, special);
+                if (_mm512_test_epi8_mask(error, error) != 0)
+                    break;
+            }
+            previous = data;
+            marker += 64;
+            carry = utf8_incomplete(marker);
+        }
+        return next::strict_utf8(utf8_boundary(marker, carry), tail);
+    }
+};
+
+#endif
+
+// Widest instruction set enabled at compile-time
+
+#if defined(TRIAL_PROTOCOL_USE_AVX512)
+using native_scanner = scanner<core::detail::simd::isa::avx512>;
+#elif defined(TRIAL_PROTOCOL_USE_AVX2)
+using native_scanner = scanner<core::detail::simd::isa::avx2>;
+#elif defined(TRIAL_PROTOCOL_USE_SSE2)
+using native_scanner = scanner<core::detail::simd::isa::sse2>;
+#else
+using native_scanner = scanner<core::detail::simd::isa::scalar>;
+#endif
+
+#if defined(TRIAL_PROTOCOL_USE_SIMD_DISPATCH)
+
+// Widest instruction set supported by the processor
+//
+// Only used for runs that are longer than one native vector, because short
+// runs are faster with the inlined native scanner than with an indirect call.
+// The first native vector is therefore probed inline, and the remainder is
+// dispatched only if the run continues beyond the probe.
+
+template <typename CharT>
+struct dispatch_scanner
+{
+#if defined(TRIAL_PROTOCOL_USE_AVX512)
+    static constexpr std::ptrdiff_t probe = 64;
+#elif defined(TRIAL_PROTOCOL_USE_AVX2)
+    static constexpr std::ptrdiff_t probe = 32;
+#else
+    static constexpr std::ptrdiff_t probe = 16;
+#endif
+
+    using function_type = const CharT *(*)(const CharT *, const CharT *);
+
+    struct table
+    {
+        function_type narrow;
+        function_type digit;
+        function_type whitespace;
+        function_type unescaped;
+        function_type utf8;
+        function_type strict_utf8;
+    };
+
+    static const table& get() noexcept
+    {
+        static const table instance = make(core::detail::simd::supported());
+        return instance;
+    }
+
+    // End of the inline probe
+    static auto probe_end(const CharT *marker,
+                          const CharT * const tail) noexcept -> const CharT *
+    {
+        return (tail - marker > probe) ? marker + probe : tail;
+    }
+
+private:
+    template <core::detail::simd::isa I>
+    static table make() noexcept
+    {
+        return { &scanner<I>::template narrow<CharT>,
+                 &scanner<I>::template digit<CharT>,
+                 &scanner<I>::template whitespace<CharT>,
+                 &scanner<I>::template unescaped<CharT>,
+                 &scanner<I>::template utf8<CharT>,
+                 &scanner<I>::template strict_utf8<CharT> };
+    }
+
+    static table make(core::detail::simd::isa supported) noexcept
+    {
+        switch (supported)
+        {
+        case core::detail::simd::isa::avx512:
+            return make<core::detail::simd::isa::avx512>();
+        case core::detail::simd::isa::avx2:
+            return make<core::detail::simd::isa::avx2>();
+        default:
+            return make<core::detail::simd::isa::sse2>();
+        }
+    }
+};
+
+#endif
+
+template <typename CharT>
+auto scan_narrow(const CharT *marker,
+                 const CharT * const tail) noexcept -> const CharT *
+{
+#if defined(TRIAL_PROTOCOL_USE_SIMD_DISPATCH)
+    const auto probe = dispatch_scanner<CharT>::probe_end(marker, tail);
+    marker = native_scanner::narrow(marker, probe);
+    if ((marker != probe) || (marker == tail))
+        return marker;
+    return dispatch_scanner<CharT>::get().narrow(marker, tail);
+#else
+    return native_scanner::narrow(marker, tail);
+#endif
+}
+
+template <typename CharT>
+auto scan_digit(const CharT *marker,
+                const CharT * const tail) noexcept -> const CharT *
+{
+#if defined(TRIAL_PROTOCOL_USE_SIMD_DISPATCH)
+    const auto probe = dispatch_scanner<CharT>::probe_end(marker, tail);
+    marker = native_scanner::digit(marker, probe);
+    if ((marker != probe) || (marker == tail))
+        return marker;
+    return dispatch_scanner<CharT>::get().digit(marker, tail);
+#else
+    return native_scanner::digit(marker, tail);
+#endif
 }
 
 template <typename CharT>
 auto scan_whitespace(const CharT *marker,
                      const CharT * const tail) noexcept -> const CharT *
 {
-    while (marker != tail)
+    // Most tokens are not preceded by whitespaces
+    if ((marker == tail) || !traits::is_space(*marker))
+        return marker;
+#if defined(TRIAL_PROTOCOL_USE_SIMD_DISPATCH)
+    const auto probe = dispatch_scanner<CharT>::probe_end(marker, tail);
+    marker = native_scanner::whitespace(marker, probe);
+    if ((marker != probe) || (marker == tail))
+        return marker;
+    return dispatch_scanner<CharT>::get().whitespace(marker, tail);
+#else
+    return native_scanner::whitespace(marker, tail);
+#endif
+}
+
+template <typename CharT>
+auto scan_unescaped(const CharT *marker,
+                    const CharT * const tail) noexcept -> const CharT *
+{
+#if defined(TRIAL_PROTOCOL_USE_SIMD_DISPATCH)
+    const auto probe = dispatch_scanner<CharT>::probe_end(marker, tail);
+    marker = native_scanner::unescaped(marker, probe);
+    if ((marker != probe) || (marker == tail))
+        return marker;
+    return dispatch_scanner<CharT>::get().unescaped(marker, tail);
+#else
+    return native_scanner::unescaped(marker, tail);
+#endif
+}
+
+// UTF-8 scanners stop before a sequence that is cut off by the probe, so the
+// scan continues if it stopped within the length of a sequence from the probe.
+
+template <typename CharT>
+auto scan_utf8(const CharT *marker,
+               const CharT * const tail) noexcept -> const CharT *
+{
+#if defined(TRIAL_PROTOCOL_USE_SIMD_DISPATCH)
+    const auto probe = dispatch_scanner<CharT>::probe_end(marker, tail);
+    marker = native_scanner::utf8(marker, probe);
+    if ((probe - marker >= 4) || (probe == tail))
+        return marker;
+    return dispatch_scanner<CharT>::get().utf8(marker, tail);
+#else
+    return native_scanner::utf8(marker, tail);
+#endif
+}
+
+template <typename CharT>
+auto scan_strict_utf8(const CharT *marker,
+                      const CharT * const tail) noexcept -> const CharT *
+{
+#if defined(TRIAL_PROTOCOL_USE_SIMD_DISPATCH)
+    const auto probe = dispatch_scanner<CharT>::probe_end(marker, tail);
+    marker = native_scanner::strict_utf8(marker, probe);
+    if ((probe - marker >= 4) || (probe == tail))
+        return marker;
+    return dispatch_scanner<CharT>::get().strict_utf8(marker, tail);
+#else
+    return native_scanner::strict_utf8(marker, tail);
+#endif
+}
+
+// Counts value separators before the first end array bracket. The input is
+// not validated, so the count is only exact for well-formed arrays without
+// containers and strings.
+template <typename CharT>
+auto count_separators(const CharT *marker,
+                      const CharT * const tail) noexcept -> std::size_t
+{
+    std::size_t result = 0;
+#if defined(TRIAL_PROTOCOL_USE_SSE2)
+    const auto separator = _mm_set1_epi8(traits::alphabet<CharT>::comma);
+    const auto bracket = _mm_set1_epi8(traits::alphabet<CharT>::bracket_close);
+    while (tail - marker >= 16)
     {
-        if (traits::is_space(*marker))
+        const auto data = _mm_loadu_si128((const __m128i *)marker);
+        const unsigned separators = _mm_movemask_epi8(_mm_cmpeq_epi8(data, separator));
+        const unsigned brackets = _mm_movemask_epi8(_mm_cmpeq_epi8(data, bracket));
+        if (brackets != 0)
         {
-            ++marker;
+            const unsigned before = (1U << core::detail::countr_zero(brackets)) - 1;
+            return result + core::detail::popcount(separators & before);
         }
-        else
+        result += core::detail::popcount(separators);
+        marker += 16;
+    }
+#endif
+    for (; marker != tail; ++marker)
+    {
+        if (*marker == traits::alphabet<CharT>::comma)
+            ++result;
+        else if (*marker == traits::alphabet<CharT>::bracket_close)
             break;
     }
-    return marker;
+    return result;
 }
 
 } // namespace detail
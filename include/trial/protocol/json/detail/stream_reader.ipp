@@ -0,0 +1,226 @@
+#ifndef TRIAL_PROTOCOL_JSON_DETAIL_STREAM_READER_IPP
+#define TRIAL_PROTOCOL_JSON_DETAIL_STREAM_READER_IPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+
+template <typename CharT>
+basic_stream_reader<CharT>::basic_stream_reader(source_type source,
+                                                size_type capacity,
+                                                json::validation validation)
+    : source(std::move(source)),
+      buffer(std::max<size_type>(capacity, 1)),
+      length(0),
+      exhausted(false),
+      mode(validation)
+{
+    initialize();
+}
+
+template <typename CharT>
+basic_stream_reader<CharT>::basic_stream_reader(std::basic_istream<value_type>& input,
+                                                size_type capacity,
+                                                json::validation validation)
+    : basic_stream_reader([&input](value_type *data, size_type size) -> size_type
+                          {
+                              // Only block for the first character
+                              if (!input.get(*data))
+                                  return 0;
+                              return 1 + size_type(input.readsome(data + 1, size - 1));
+                          },
+                          capacity,
+                          validation)
+{
+}
+
+template <typename CharT>
+bool basic_stream_reader<CharT>::next()
+{
+    for (;;)
+    {
+        const auto checkpoint = super::decoder.checkpoint();
+        const auto frame = super::stack.top();
+        const auto before_level = level();
+        if ((before_level == 0) && (code() >= token::code::null))
+        {
+            // Start of subsequent value in sequence
+            next_root();
+        }
+        else
+        {
+            super::next();
+        }
+        if TRIAL_LIKELY(!tentative())
+            return code() >= token::code::null;
+
+        // Token may continue beyond buffer, so restore state and retry with
+        // more input
+        assert(level() == before_level);
+        super::stack.top() = frame;
+        refill(checkpoint);
+    }
+}
+
+template <typename CharT>
+bool basic_stream_reader<CharT>::next(token::code::value expect)
+{
+    if (code() != expect)
+    {
+        super::decoder.code(token::code::error_unexpected_token);
+        return false;
+    }
+    return next();
+}
+
+template <typename CharT>
+auto basic_stream_reader<CharT>::capacity() const noexcept -> size_type
+{
+    return buffer.size();
+}
+
+template <typename CharT>
+void basic_stream_reader<CharT>::initialize()
+{
+    do
+    {
+        fill(0);
+        static_cast<super&>(*this) = super(view_type(buffer.data(), length), mode);
+    } while (tentative());
+}
+
+template <typename CharT>
+void basic_stream_reader<CharT>::next_root()
+{
+    super::decoder.next();
+    switch (super::decoder.code())
+    {
+    case token::code::begin_array:
+        if (!super::stack.push(token::begin_array{}))
+            super::decoder.code(token::code::error_max_depth);
+        break;
+
+    case token::code::end_array:
+        super::decoder.code(token::code::error_unbalanced_end_array);
+        break;
+
+    case token::code::begin_object:
+        if (!super::stack.push(token::begin_object{}))
+            super::decoder.code(token::code::error_max_depth);
+        break;
+
+    case token::code::end_object:
+        super::decoder.code(token::code::error_unbalanced_end_object);
+        break;
+
+    case token::code::error_value_separator:
+    case token::code::error_name_separator:
+        super::decoder.code(token::code::error_unexpected_token);
+        break;
+
+    default:
+        break;
+    }
+}
+
+template <typename CharT>
+bool basic_stream_reader<CharT>::tentative() const noexcept
+{
+    // Keywords are at most this long
+    constexpr size_type lookahead = 5;
+
+    if (exhausted)
+        return false;
+
+    switch (code())
+    {
+    case token::code::end:
+        return true;
+
+    case token::code::null:
+    case token::code::true_value:
+    case token::code::false_value:
+    case token::code::integer:
+    case token::code::real:
+        // Could continue in the next chunk
+        return super::tail().empty();
+
+    case token::code::string:
+    case token::code::key:
+    case token::code::begin_array:
+    case token::code::end_array:
+    case token::code::begin_object:
+    case token::code::end_object:
+        return false;
+
+    default:
+        // Errors caused by the end of the buffer
+        return (literal().end() == buffer.data() + length) || (super::tail().size() < lookahead);
+    }
+}
+
+template <typename CharT>
+void basic_stream_reader<CharT>::refill(const checkpoint_type& checkpoint)
+{
+    using literal_type = typename decoder_type::view_type;
+
+    // Retain the current token and anything after it
+    const_pointer keep = checkpoint.literal.empty() ? checkpoint.tail : checkpoint.literal.data();
+    const size_type literal_offset = checkpoint.literal.empty() ? 0 : checkpoint.literal.data() - keep;
+    const size_type tail_offset = checkpoint.tail - keep;
+
+    fill(keep - buffer.data());
+
+    // Continue from the current token in the refilled buffer
+    const_pointer first = buffer.data();
+    super::decoder.shift(first + tail_offset, length - tail_offset);
+    super::decoder.rollback({ literal_type(first + literal_offset, checkpoint.literal.size()),
+                              first + tail_offset,
+                              checkpoint.code });
+}
+
+template <typename CharT>
+void basic_stream_reader<CharT>::fill(size_type offset)
+{
+    assert(offset <= length);
+
+    // Move retained input to the beginning
+    if (offset > 0)
+    {
+        std::copy(buffer.begin() + offset, buffer.begin() + length, buffer.begin());
+        length -= offset;
+    }
+    if (length == buffer.size())
+    {
+        buffer.resize(2 * buffer.size());
+    }
+    const auto size = source(buffer.data() + length, buffer.size() - length);
+    if (size == 0)
+    {
+        exhausted = true;
+    }
+    length += size;
+}
+
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_DETAIL_STREAM_READER_IPP
@@ -12,14 +12,14 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
 #include <limits>
-#include <algorithm>
-#include <string>
-#include <sstream>
-#include <iomanip>
-#include <locale>
-#include <trial/protocol/core/detail/string_view.hpp>
+#include <type_traits>
 #include <trial/protocol/json/detail/traits.hpp>
+#include <trial/protocol/json/detail/integer_converter.hpp>
+#include <trial/protocol/json/detail/real.hpp>
 
 namespace trial
 {
@@ -30,81 +30,194 @@ namespace json
 namespace detail
 {
 
-template <typename RealT>
-RealT power10(int exponent)
-{
-    switch (exponent)
-    {
-    case 0: return RealT(1.0);
-    case 1: return RealT(1E1);
-    case 2: return RealT(1E2);
-    case 3: return RealT(1E3);
-    case 4: return RealT(1E4);
-    case 5: return RealT(1E5);
-    case 6: return RealT(1E6);
-    case 7: return RealT(1E7);
-    case 8: return RealT(1E8);
-    case 9: return RealT(1E9);
-    case 10: return RealT(1E10);
-    default: return std::pow(RealT(10), exponent);
-    }
-}
-
-template <typename CharT, typename ReturnType>
+//! @brief Floating-point number formatting.
+//!
+//! The number is formatted with the fewest digits needed to convert it back
+//! to the same floating-point number. A decimal point or an exponent is
+//! always included so the output is read back as a real number.
+//!
+//! Fixed notation is used for decimal exponents in [-4, max_digits10),
+//! otherwise scientific notation is used.
+//!
+//! The number must be finite.
+template <typename CharT, typename T, typename Enable = void>
 struct string_converter
 {
-};
+    // Sign, digits, decimal point, and exponent
+    static constexpr std::size_t max_size = 64;
 
-template <typename CharT>
-struct string_converter<CharT, float>
-{
-    using string = std::basic_string<CharT, core::char_traits<CharT>>;
-    using string_view = core::detail::basic_string_view<CharT, core::char_traits<CharT>>;
+    static std::size_t encode(T value, CharT *output) noexcept;
 
-    static string encode(float value)
+private:
+    static std::size_t widen(const char *work, int length, CharT *output) noexcept
     {
-        // Workaround for CharT = unsigned char, which std::locale does not support
-        std::ostringstream stream;
-        stream.imbue(std::locale::classic());
-        stream << std::showpoint << std::setprecision(std::numeric_limits<float>::digits10) << value;
-        std::string work = stream.str();
-        return {work.begin(), work.end()};
+        bool is_real = false;
+        for (int i = 0; i < length; ++i)
+        {
+            switch (work[i])
+            {
+            case '-':
+                output[i] = traits::alphabet<CharT>::minus;
+                break;
+            case '+':
+                output[i] = traits::alphabet<CharT>::plus;
+                break;
+            case 'e':
+                output[i] = traits::alphabet<CharT>::letter_e;
+                is_real = true;
+                break;
+            default:
+                if ((work[i] >= '0') && (work[i] <= '9'))
+                {
+                    output[i] = traits::alphabet<CharT>::digit_0 + (work[i] - '0');
+                }
+                else
+                {
+                    // Locale-dependent decimal point
+                    output[i] = traits::alphabet<CharT>::dot;
+                    is_real = true;
+                }
+                break;
+            }
+        }
+        std::size_t size = std::size_t(length);
+        if (!is_real)
+        {
+            output[size++] = traits::alphabet<CharT>::dot;
+            output[size++] = traits::alphabet<CharT>::digit_0;
+        }
+        return size;
     }
 };
 
-template <typename CharT>
-struct string_converter<CharT, double>
+template <typename CharT, typename T>
+struct string_converter<CharT, T, typename std::enable_if<real::binary_format<T>::is_specialized>::type>
 {
-    using string = std::basic_string<CharT, core::char_traits<CharT>>;
-    using string_view = core::detail::basic_string_view<CharT, core::char_traits<CharT>>;
+    // Sign, max_digits10 digits, four leading zeros, decimal point, and exponent
+    static constexpr std::size_t max_size = 32;
 
-    static string encode(double value)
+    static std::size_t encode(T value, CharT *output) noexcept
     {
-        // Workaround for CharT = unsigned char, which std::locale does not support
-        std::ostringstream stream;
-        stream.imbue(std::locale::classic());
-        stream << std::showpoint << std::setprecision(std::numeric_limits<double>::digits10) << value;
-        std::string work = stream.str();
-        return {work.begin(), work.end()};
+        CharT *current = output;
+        if (std::signbit(value))
+        {
+            *current++ = traits::alphabet<CharT>::minus;
+        }
+        if (value == T(0))
+        {
+            *current++ = traits::alphabet<CharT>::digit_0;
+            *current++ = traits::alphabet<CharT>::dot;
+            *current++ = traits::alphabet<CharT>::digit_0;
+            return std::size_t(current - output);
+        }
+
+        auto decimal = real::shortest(value);
+        while (decimal.significand % 10 == 0)
+        {
+            decimal.significand /= 10;
+            ++decimal.exponent;
+        }
+        const int length = count_digits(decimal.significand);
+        // Position of decimal point relative to the first digit
+        const int point = length + decimal.exponent;
+
+        if ((point > -4) && (point <= std::numeric_limits<T>::max_digits10))
+        {
+            if (point <= 0)
+            {
+                // 0.00ddd
+                *current++ = traits::alphabet<CharT>::digit_0;
+                *current++ = traits::alphabet<CharT>::dot;
+                for (int i = point; i < 0; ++i)
+                {
+                    *current++ = traits::alphabet<CharT>::digit_0;
+                }
+                current = write_digits(decimal.significand, length, current);
+            }
+            else if (point >= length)
+            {
+                // ddd00.0
+                current = write_digits(decimal.significand, length, current);
+                for (int i = length; i < point; ++i)
+                {
+                    *current++ = traits::alphabet<CharT>::digit_0;
+                }
+                *current++ = traits::alphabet<CharT>::dot;
+                *current++ = traits::alphabet<CharT>::digit_0;
+            }
+            else
+            {
+                // dd.ddd
+                write_digits(decimal.significand, length, current + 1);
+                for (int i = 0; i < point; ++i)
+                {
+                    current[i] = current[i + 1];
+                }
+                current[point] = traits::alphabet<CharT>::dot;
+                current += length + 1;
+            }
+        }
+        else
+        {
+            // d.ddde+dd
+            write_digits(decimal.significand, length, current + 1);
+            current[0] = current[1];
+            if (length > 1)
+            {
+                current[1] = traits::alphabet<CharT>::dot;
+                current += length + 1;
+            }
+            else
+            {
+                current += 1;
+            }
+            *current++ = traits::alphabet<CharT>::letter_e;
+            int exponent = point - 1;
+            if (exponent < 0)
+            {
+                *current++ = traits::alphabet<CharT>::minus;
+                exponent = -exponent;
+            }
+            else
+            {
+                *current++ = traits::alphabet<CharT>::plus;
+            }
+            const int exponent_length = count_digits(std::uint64_t(exponent));
+            current = write_digits(std::uint64_t(exponent), exponent_length, current);
+        }
+        return std::size_t(current - output);
     }
 };
 
-template <typename CharT>
-struct string_converter<CharT, long double>
+template <typename CharT, typename T, typename Enable>
+std::size_t string_converter<CharT, T, Enable>::encode(T value, CharT *output) noexcept
 {
-    using string = std::basic_string<CharT, core::char_traits<CharT>>;
-    using string_view = core::detail::basic_string_view<CharT, core::char_traits<CharT>>;
+    char work[max_size];
+    if (value == T(static_cast<double>(value)))
+    {
+        // The shortest digits of the double only identify the value if
+        // they also convert back to the same extended precision value
+        const auto length = string_converter<char, double>::encode(static_cast<double>(value), work);
+        work[length] = 0;
+        if (std::strtold(work, nullptr) == static_cast<long double>(value))
+            return widen(work, int(length), output);
+    }
 
-    static string encode(long double value)
+    // Fallback for extended precision
+    int length = 0;
+    for (int precision = std::numeric_limits<T>::digits10;
+         precision <= std::numeric_limits<T>::max_digits10;
+         ++precision)
     {
-        // Workaround for CharT = unsigned char, which std::locale does not support
-        std::ostringstream stream;
-        stream.imbue(std::locale::classic());
-        stream << std::showpoint << std::setprecision(std::numeric_limits<long double>::digits10) << value;
-        std::string work = stream.str();
-        return {work.begin(), work.end()};
+        length = std::snprintf(work, sizeof(work),
+                               "%.*Lg",
+                               precision,
+                               static_cast<long double>(value));
+        if (std::strtold(work, nullptr) == static_cast<long double>(value))
+            break;
     }
-};
+    return widen(work, length, output);
+}
 
 } // namespace detail
 } // namespace json
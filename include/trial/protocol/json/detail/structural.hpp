@@ -0,0 +1,402 @@
+#ifndef TRIAL_PROTOCOL_JSON_DETAIL_STRUCTURAL_HPP
+#define TRIAL_PROTOCOL_JSON_DETAIL_STRUCTURAL_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <trial/protocol/core/detail/config.hpp>
+#include <trial/protocol/core/detail/bit.hpp>
+#include <trial/protocol/core/detail/simd.hpp>
+#include <trial/protocol/json/detail/traits.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+namespace detail
+{
+
+// Structural index
+//
+// The index contains the position of the first character of every token in
+// the input, that is structural characters outside strings, opening quotes,
+// and the first character of literals and numbers. The positions are followed
+// by a sentinel at the end of the input.
+//
+// The input is classified in blocks of 64 characters into bitmasks.
+// Characters inside strings are masked away by calculating the prefix-xor of
+// unescaped quotes, where escaped characters are found by locating the ends of
+// odd-length sequences of backslashes.
+//
+// The matching closing bracket for each opening bracket is also recorded.
+
+template <typename CharT>
+class structural_index
+{
+public:
+    using value_type = CharT;
+    using const_pointer = const value_type *;
+    using position_type = std::uint32_t;
+    using size_type = std::size_t;
+
+    static constexpr position_type npos = std::numeric_limits<position_type>::max();
+
+    structural_index() = default;
+    structural_index(const_pointer first, const_pointer last);
+
+    //! @returns true if the input is too large to be indexed.
+    static bool overflow(size_type length) noexcept;
+
+    const position_type *begin() const noexcept;
+    const position_type *end() const noexcept;
+    size_type size() const noexcept;
+
+    //! @returns Index entry of matching bracket, or nullptr if unmatched.
+    const position_type *partner(const position_type *entry) const noexcept;
+
+private:
+    struct block
+    {
+        std::uint64_t quote;
+        std::uint64_t backslash;
+        std::uint64_t op;
+        std::uint64_t bracket;
+        std::uint64_t space;
+    };
+
+    static void classify(const_pointer, block&) noexcept;
+#if defined(TRIAL_PROTOCOL_HAS_AVX2)
+    static void classify_avx2(const_pointer, block&) noexcept;
+#endif
+    static bool is_open(value_type) noexcept;
+    static bool is_partner(value_type open, value_type close) noexcept;
+
+    void build(const_pointer first, const_pointer last);
+
+private:
+    std::vector<position_type> positions;
+    // Pairs of opening and closing entries ordered by opening entry
+    std::vector<std::pair<position_type, position_type>> partners;
+};
+
+//-----------------------------------------------------------------------------
+
+template <typename CharT>
+constexpr typename structural_index<CharT>::position_type structural_index<CharT>::npos;
+
+template <typename CharT>
+structural_index<CharT>::structural_index(const_pointer first,
+                                          const_pointer last)
+{
+    build(first, last);
+}
+
+template <typename CharT>
+bool structural_index<CharT>::overflow(size_type length) noexcept
+{
+    return length >= size_type(npos);
+}
+
+template <typename CharT>
+auto structural_index<CharT>::begin() const noexcept -> const position_type *
+{
+    return positions.data();
+}
+
+template <typename CharT>
+auto structural_index<CharT>::end() const noexcept -> const position_type *
+{
+    return positions.data() + positions.size();
+}
+
+template <typename CharT>
+auto structural_index<CharT>::size() const noexcept -> size_type
+{
+    return positions.size();
+}
+
+template <typename CharT>
+auto structural_index<CharT>::partner(const position_type *entry) const noexcept -> const position_type *
+{
+    const auto offset = position_type(std::distance(begin(), entry));
+    const auto where = std::lower_bound(
+        partners.begin(),
+        partners.end(),
+        offset,
+        [] (const std::pair<position_type, position_type>& lhs, position_type rhs)
+        {
+            return lhs.first < rhs;
+        });
+    if ((where == partners.end()) || (where->first != offset) || (where->second == npos))
+        return nullptr;
+    return begin() + where->second;
+}
+
+template <typename CharT>
+void structural_index<CharT>::classify(const_pointer input,
+                                       block& result) noexcept
+{
+#if defined(TRIAL_PROTOCOL_USE_SSE2)
+    const auto quote = _mm_set1_epi8('"');
+    const auto backslash = _mm_set1_epi8('\\');
+    // Lowercase brackets are braces
+    const auto lowercase = _mm_set1_epi8(0x20);
+    const auto brace_open = _mm_set1_epi8('{');
+    const auto brace_close = _mm_set1_epi8('}');
+    const auto comma = _mm_set1_epi8(',');
+    const auto colon = _mm_set1_epi8(':');
+    const auto space = _mm_set1_epi8(' ');
+    const auto tab = _mm_set1_epi8('\t');
+    const auto newline = _mm_set1_epi8('\n');
+    const auto carriage_return = _mm_set1_epi8('\r');
+
+    result = {};
+    for (int i = 0; i < 64; i += 16)
+    {
+        const auto data = _mm_loadu_si128((const __m128i *)(input + i));
+        const auto lower = _mm_or_si128(data, lowercase);
+        const auto bracket = _mm_or_si128(_mm_cmpeq_epi8(lower, brace_open),
+                                          _mm_cmpeq_epi8(lower, brace_close));
+        const auto op = _mm_or_si128(bracket,
+                                     _mm_or_si128(_mm_cmpeq_epi8(data, comma),
+                                                  _mm_cmpeq_epi8(data, colon)));
+        const auto whitespace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, space),
+                                                          _mm_cmpeq_epi8(data, tab)),
+                                             _mm_or_si128(_mm_cmpeq_epi8(data, newline),
+                                                          _mm_cmpeq_epi8(data, carriage_return)));
+        using mask_type = std::uint64_t;
+        result.quote |= mask_type(std::uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(data, quote)))) << i;
+        result.backslash |= mask_type(std::uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(data, backslash)))) << i;
+        result.op |= mask_type(std::uint16_t(_mm_movemask_epi8(op))) << i;
+        result.bracket |= mask_type(std::uint16_t(_mm_movemask_epi8(bracket))) << i;
+        result.space |= mask_type(std::uint16_t(_mm_movemask_epi8(whitespace))) << i;
+    }
+#else
+    result = {};
+    for (int i = 0; i < 64; ++i)
+    {
+        const std::uint64_t bit = std::uint64_t(1) << i;
+        switch (input[i])
+        {
+        case '"':
+            result.quote |= bit;
+            break;
+        case '\\':
+            result.backslash |= bit;
+            break;
+        case '{': case '}': case '[': case ']':
+            result.bracket |= bit;
+            result.op |= bit;
+            break;
+        case ',': case ':':
+            result.op |= bit;
+            break;
+        case ' ': case '\t': case '\n': case '\r':
+            result.space |= bit;
+            break;
+        default:
+            break;
+        }
+    }
+#endif
+}
+
+#if defined(TRIAL_PROTOCOL_HAS_AVX2)
+
+template <typename CharT>
+TRIAL_PROTOCOL_TARGET_AVX2
+void structural_index<CharT>::classify_avx2(const_pointer input,
+                                            block& result) noexcept
+{
+    const auto quote = _mm256_set1_epi8('"');
+    const auto backslash = _mm256_set1_epi8('\\');
+    const auto lowercase = _mm256_set1_epi8(0x20);
+    const auto brace_open = _mm256_set1_epi8('{');
+    const auto brace_close = _mm256_set1_epi8('}');
+    const auto comma = _mm256_set1_epi8(',');
+    const auto colon = _mm256_set1_epi8(':');
+    const auto space = _mm256_set1_epi8(' ');
+    const auto tab = _mm256_set1_epi8('\t');
+    const auto newline = _mm256_set1_epi8('\n');
+    const auto carriage_return = _mm256_set1_epi8('\r');
+
+    result = {};
+    for (int i = 0; i < 64; i += 32)
+    {
+        const auto data = _mm256_loadu_si256((const __m256i *)(input + i));
+        const auto lower = _mm256_or_si256(data, lowercase);
+        const auto bracket = _mm256_or_si256(_mm256_cmpeq_epi8(lower, brace_open),
+                                             _mm256_cmpeq_epi8(lower, brace_close));
+        const auto op = _mm256_or_si256(bracket,
+                                        _mm256_or_si256(_mm256_cmpeq_epi8(data, comma),
+                                                        _mm256_cmpeq_epi8(data, colon)));
+        const auto whitespace = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(data, space),
+                                                                _mm256_cmpeq_epi8(data, tab)),
+                                                _mm256_or_si256(_mm256_cmpeq_epi8(data, newline),
+                                                                _mm256_cmpeq_epi8(data, carriage_return)));
+        using mask_type = std::uint64_t;
+        result.quote |= mask_type(std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, quote)))) << i;
+        result.backslash |= mask_type(std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(data, backslash)))) << i;
+        result.op |= mask_type(std::uint32_t(_mm256_movemask_epi8(op))) << i;
+        result.bracket |= mask_type(std::uint32_t(_mm256_movemask_epi8(bracket))) << i;
+        result.space |= mask_type(std::uint32_t(_mm256_movemask_epi8(whitespace))) << i;
+    }
+}
+
+#endif
+
+template <typename CharT>
+bool structural_index<CharT>::is_open(value_type symbol) noexcept
+{
+    return (symbol == traits::alphabet<CharT>::bracket_open) ||
+        (symbol == traits::alphabet<CharT>::brace_open);
+}
+
+template <typename CharT>
+bool structural_index<CharT>::is_partner(value_type open, value_type close) noexcept
+{
+    return (close == traits::alphabet<CharT>::bracket_close)
+        ? (open == traits::alphabet<CharT>::bracket_open)
+        : (open == traits::alphabet<CharT>::brace_open);
+}
+
+template <typename CharT>
+void structural_index<CharT>::build(const_pointer first,
+                                    const_pointer last)
+{
+    const size_type length = std::distance(first, last);
+    if (overflow(length))
+        return;
+
+    constexpr std::uint64_t odd_bits = 0xAAAAAAAAAAAAAAAAULL;
+
+    // State carried between blocks
+    std::uint64_t next_is_escaped = 0;
+    std::uint64_t prev_in_string = 0;
+    std::uint64_t prev_boundary = 1; // Start of input acts as boundary
+
+    // Reserve space for dense input to avoid reallocations
+    positions.reserve(length / 2 + 1);
+
+    // Unmatched opening brackets as partners slot and symbol
+    std::vector<std::pair<size_type, value_type>> opened;
+
+    auto classifier = &structural_index::classify;
+#if defined(TRIAL_PROTOCOL_HAS_AVX2)
+    if (core::detail::simd::supported() >= core::detail::simd::isa::avx2)
+        classifier = &structural_index::classify_avx2;
+#endif
+
+    block masks;
+    value_type padding[64];
+    for (size_type offset = 0; offset < length; offset += 64)
+    {
+        const_pointer input = first + offset;
+        if (length - offset < 64)
+        {
+            // Pad last block with whitespaces
+            const size_type remaining = length - offset;
+            for (size_type i = 0; i < 64; ++i)
+                padding[i] = (i < remaining) ? input[i] : value_type(' ');
+            input = padding;
+        }
+        classifier(input, masks);
+
+        // Escaped characters are those following an odd-length sequence of
+        // backslashes.
+        std::uint64_t escaped = next_is_escaped;
+        if (masks.backslash)
+        {
+            const std::uint64_t potential = masks.backslash & ~next_is_escaped;
+            const std::uint64_t maybe_escaped = potential << 1;
+            const std::uint64_t codes = ((maybe_escaped | odd_bits) - potential) ^ odd_bits;
+            escaped = codes ^ (masks.backslash | next_is_escaped);
+            next_is_escaped = (codes & masks.backslash) >> 63;
+        }
+        else
+        {
+            next_is_escaped = 0;
+        }
+
+        // Prefix-xor of unescaped quotes marks opening quote and string content
+        const std::uint64_t quote = masks.quote & ~escaped;
+        std::uint64_t in_string = quote;
+        in_string ^= in_string << 1;
+        in_string ^= in_string << 2;
+        in_string ^= in_string << 4;
+        in_string ^= in_string << 8;
+        in_string ^= in_string << 16;
+        in_string ^= in_string << 32;
+        in_string ^= prev_in_string;
+        prev_in_string = std::uint64_t(std::int64_t(in_string) >> 63);
+
+        const std::uint64_t boundary = masks.op | masks.space | quote;
+        const std::uint64_t scalar = ~(boundary | in_string);
+        const std::uint64_t follows_boundary = (boundary << 1) | prev_boundary;
+        prev_boundary = boundary >> 63;
+
+        std::uint64_t tokens = (masks.op & ~in_string)
+            | (quote & in_string)
+            | (scalar & follows_boundary);
+        if (length - offset < 64)
+        {
+            // Remove padding
+            tokens &= (std::uint64_t(1) << (length - offset)) - 1;
+        }
+
+        // Pair brackets
+        std::uint64_t brackets = masks.bracket & ~in_string;
+        while (brackets != 0)
+        {
+            const int where = core::detail::countr_zero(brackets);
+            const auto entry = position_type(positions.size() + core::detail::popcount(tokens & ((std::uint64_t(1) << where) - 1)));
+            const auto symbol = input[where];
+            brackets &= brackets - 1;
+            if (is_open(symbol))
+            {
+                opened.emplace_back(partners.size(), symbol);
+                partners.emplace_back(entry, npos);
+            }
+            else if (!opened.empty() && is_partner(opened.back().second, symbol))
+            {
+                partners[opened.back().first].second = entry;
+                opened.pop_back();
+            }
+            else
+            {
+                // Unbalanced brackets
+                opened.clear();
+            }
+        }
+
+        while (tokens != 0)
+        {
+            positions.push_back(position_type(offset + core::detail::countr_zero(tokens)));
+            tokens &= tokens - 1;
+        }
+    }
+    // Sentinel
+    positions.push_back(position_type(length));
+}
+
+} // namespace detail
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_DETAIL_STRUCTURAL_HPP
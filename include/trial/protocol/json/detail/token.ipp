@@ -43,6 +43,8 @@ inline symbol::value symbol::convert(code::value value)
     case code::error_unbalanced_end_object:
     case code::error_expected_end_array:
     case code::error_expected_end_object:
+    case code::error_invalid_encoding:
+    case code::error_max_depth:
         return symbol::error;
 
     case code::null:
@@ -25,77 +25,77 @@ namespace json
 // writer::overloader
 //-----------------------------------------------------------------------------
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T, typename Enable>
-struct basic_writer<CharT, N>::overloader
+struct basic_writer<CharT, N, Buffer>::overloader
 {
 };
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<CharT, N>::overloader<
+struct basic_writer<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::null>::value>::type>
 {
-    using size_type = typename basic_writer<CharT, N>::size_type;
+    using size_type = typename basic_writer<CharT, N, Buffer>::size_type;
 
-    inline static size_type value(basic_writer<CharT, N>& self)
+    inline static size_type value(basic_writer<CharT, N, Buffer>& self)
     {
         return self.null_value();
     }
 };
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<CharT, N>::overloader<
+struct basic_writer<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::begin_array>::value>::type>
 {
-    using size_type = typename basic_writer<CharT, N>::size_type;
+    using size_type = typename basic_writer<CharT, N, Buffer>::size_type;
 
-    inline static size_type value(basic_writer<CharT, N>& self)
+    inline static size_type value(basic_writer<CharT, N, Buffer>& self)
     {
         return self.begin_array_value();
     }
 };
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<CharT, N>::overloader<
+struct basic_writer<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::end_array>::value>::type>
 {
-    using size_type = typename basic_writer<CharT, N>::size_type;
+    using size_type = typename basic_writer<CharT, N, Buffer>::size_type;
 
-    inline static size_type value(basic_writer<CharT, N>& self)
+    inline static size_type value(basic_writer<CharT, N, Buffer>& self)
     {
         return self.end_array_value();
     }
 };
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<CharT, N>::overloader<
+struct basic_writer<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::begin_object>::value>::type>
 {
-    using size_type = typename basic_writer<CharT, N>::size_type;
+    using size_type = typename basic_writer<CharT, N, Buffer>::size_type;
 
-    inline static size_type value(basic_writer<CharT, N>& self)
+    inline static size_type value(basic_writer<CharT, N, Buffer>& self)
     {
         return self.begin_object_value();
     }
 };
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-struct basic_writer<CharT, N>::overloader<
+struct basic_writer<CharT, N, Buffer>::overloader<
     T,
     typename std::enable_if<std::is_same<T, token::end_object>::value>::type>
 {
-    using size_type = typename basic_writer<CharT, N>::size_type;
+    using size_type = typename basic_writer<CharT, N, Buffer>::size_type;
 
-    inline static size_type value(basic_writer<CharT, N>& self)
+    inline static size_type value(basic_writer<CharT, N, Buffer>& self)
     {
         return self.end_object_value();
     }
@@ -105,37 +105,37 @@ struct basic_writer<CharT, N>::overloader<
 // writer
 //-----------------------------------------------------------------------------
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-basic_writer<CharT, N>::basic_writer(T& buffer)
+basic_writer<CharT, N, Buffer>::basic_writer(T& buffer)
     : encoder(buffer)
 {
     // Push outermost scope
     stack.push(frame(encoder, token::code::end_array));
 }
 
-template <typename CharT, std::size_t N>
-std::error_code basic_writer<CharT, N>::error() const BOOST_NOEXCEPT
+template <typename CharT, std::size_t N, typename Buffer>
+std::error_code basic_writer<CharT, N, Buffer>::error() const BOOST_NOEXCEPT
 {
     return make_error_code(last_error);
 }
 
-template <typename CharT, std::size_t N>
-auto basic_writer<CharT, N>::level() const BOOST_NOEXCEPT -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_writer<CharT, N, Buffer>::level() const BOOST_NOEXCEPT -> size_type
 {
     return stack.size() - 1;
 }
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-auto basic_writer<CharT, N>::value() -> size_type
+auto basic_writer<CharT, N, Buffer>::value() -> size_type
 {
-    return basic_writer<CharT, N>::overloader<T>::value(*this);
+    return basic_writer<CharT, N, Buffer>::overloader<T>::value(*this);
 }
 
-template <typename CharT, std::size_t N>
+template <typename CharT, std::size_t N, typename Buffer>
 template <typename T>
-auto basic_writer<CharT, N>::value(T&& data) -> size_type
+auto basic_writer<CharT, N, Buffer>::value(T&& data) -> size_type
 {
     validate_scope();
 
@@ -143,14 +143,30 @@ auto basic_writer<CharT, N>::value(T&& data) -> size_type
     return encoder.value(std::forward<T>(data));
 }
 
-template <typename CharT, std::size_t N>
-auto basic_writer<CharT, N>::literal(const view_type& data) BOOST_NOEXCEPT -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+template <typename T>
+auto basic_writer<CharT, N, Buffer>::array(const T *data, size_type size) -> size_type
+{
+    validate_scope();
+
+    stack.top().write_separator();
+    return encoder.array(data, size);
+}
+
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_writer<CharT, N, Buffer>::literal(const view_type& data) BOOST_NOEXCEPT -> size_type
 {
     return encoder.literal(data);
 }
 
-template <typename CharT, std::size_t N>
-void basic_writer<CharT, N>::validate_scope()
+template <typename CharT, std::size_t N, typename Buffer>
+bool basic_writer<CharT, N, Buffer>::reserve(size_type size)
+{
+    return encoder.reserve(size);
+}
+
+template <typename CharT, std::size_t N, typename Buffer>
+void basic_writer<CharT, N, Buffer>::validate_scope()
 {
     if (stack.empty())
     {
@@ -159,9 +175,9 @@ void basic_writer<CharT, N>::validate_scope()
     }
 }
 
-template <typename CharT, std::size_t N>
-void basic_writer<CharT, N>::validate_scope(token::code::value code,
-                                            enum json::errc e)
+template <typename CharT, std::size_t N, typename Buffer>
+void basic_writer<CharT, N, Buffer>::validate_scope(token::code::value code,
+                                                    enum json::errc e)
 {
     if ((stack.size() < 2) || (stack.top().code != code))
     {
@@ -170,8 +186,8 @@ void basic_writer<CharT, N>::validate_scope(token::code::value code,
     }
 }
 
-template <typename CharT, std::size_t N>
-auto basic_writer<CharT, N>::null_value() -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_writer<CharT, N, Buffer>::null_value() -> size_type
 {
     validate_scope();
 
@@ -179,8 +195,8 @@ auto basic_writer<CharT, N>::null_value() -> size_type
     return encoder.template value<token::null>();
 }
 
-template <typename CharT, std::size_t N>
-auto basic_writer<CharT, N>::begin_array_value() -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_writer<CharT, N, Buffer>::begin_array_value() -> size_type
 {
     validate_scope();
 
@@ -189,8 +205,8 @@ auto basic_writer<CharT, N>::begin_array_value() -> size_type
     return encoder.template value<token::begin_array>();
 }
 
-template <typename CharT, std::size_t N>
-auto basic_writer<CharT, N>::end_array_value() -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_writer<CharT, N, Buffer>::end_array_value() -> size_type
 {
     validate_scope(token::code::end_array, json::unexpected_token);
 
@@ -199,8 +215,8 @@ auto basic_writer<CharT, N>::end_array_value() -> size_type
     return result;
 }
 
-template <typename CharT, std::size_t N>
-auto basic_writer<CharT, N>::begin_object_value() -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_writer<CharT, N, Buffer>::begin_object_value() -> size_type
 {
     validate_scope();
 
@@ -209,8 +225,8 @@ auto basic_writer<CharT, N>::begin_object_value() -> size_type
     return encoder.template value<token::begin_object>();
 }
 
-template <typename CharT, std::size_t N>
-auto basic_writer<CharT, N>::end_object_value() -> size_type
+template <typename CharT, std::size_t N, typename Buffer>
+auto basic_writer<CharT, N, Buffer>::end_object_value() -> size_type
 {
     validate_scope(token::code::end_object, json::unexpected_token);
 
@@ -223,17 +239,17 @@ auto basic_writer<CharT, N>::end_object_value() -> size_type
 // frame
 //-----------------------------------------------------------------------------
 
-template <typename CharT, std::size_t N>
-basic_writer<CharT, N>::frame::frame(encoder_type& encoder,
-                                     token::code::value code)
+template <typename CharT, std::size_t N, typename Buffer>
+basic_writer<CharT, N, Buffer>::frame::frame(encoder_type& encoder,
+                                             token::code::value code)
     : encoder(encoder),
       code(code),
       counter(0)
 {
 }
 
-template <typename CharT, std::size_t N>
-void basic_writer<CharT, N>::frame::write_separator()
+template <typename CharT, std::size_t N, typename Buffer>
+void basic_writer<CharT, N, Buffer>::frame::write_separator()
 {
     if (counter != 0)
     {
@@ -30,11 +30,11 @@ namespace partial
 //! @param[out] writer Writer pointing to an arbitrary location within a buffer.
 //! @throws json::error if input contains a wstring, u16string, or u32string.
 
-template <typename Allocator>
-void format(const trial::dynamic::basic_variable<Allocator>& data,
+template <typename Allocator, typename MapPolicy>
+void format(const trial::dynamic::basic_variable<Allocator, MapPolicy>& data,
             json::writer& writer)
 {
-    detail::basic_formatter<char, Allocator> vis(writer);
+    detail::basic_formatter<char, Allocator, MapPolicy> vis(writer);
     trial::dynamic::visit(vis, data);
 }
 
@@ -46,8 +46,8 @@ void format(const trial::dynamic::basic_variable<Allocator>& data,
 //! @returns Buffer containing the formatted JSON output.
 //! @throws json::error if input contains a wstring, u16string, or u32string.
 
-template <typename T, typename Allocator>
-auto format(const trial::dynamic::basic_variable<Allocator>& data) -> T
+template <typename T, typename Allocator, typename MapPolicy>
+auto format(const trial::dynamic::basic_variable<Allocator, MapPolicy>& data) -> T
 {
     T result;
     json::writer writer(result);
@@ -61,8 +61,8 @@ auto format(const trial::dynamic::basic_variable<Allocator>& data) -> T
 //! @param[out] result Buffer containing the formatted JSON output.
 //! @throws json::error if input contains a wstring, u16string, or u32string.
 
-template <typename T, typename Allocator>
-void format(const trial::dynamic::basic_variable<Allocator>& data,
+template <typename T, typename Allocator, typename MapPolicy>
+void format(const trial::dynamic::basic_variable<Allocator, MapPolicy>& data,
             T& result)
 {
     json::writer writer(result);
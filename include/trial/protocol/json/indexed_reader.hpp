@@ -0,0 +1,102 @@
+#ifndef TRIAL_PROTOCOL_JSON_INDEXED_READER_HPP
+#define TRIAL_PROTOCOL_JSON_INDEXED_READER_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <trial/protocol/json/reader.hpp>
+#include <trial/protocol/json/detail/structural.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+
+//! @brief Incremental JSON reader for skipping containers.
+//!
+//! The entire input buffer is first indexed in a single vectorized pass that
+//! locates all tokens and records matching brackets. Containers can then be
+//! skipped with skip_to_end() or partial::skip() without tokenizing their
+//! content.
+//!
+//! Token by token reading is not faster than json::reader, because building
+//! the index costs about as much as tokenizing the input. Use this reader
+//! when large parts of the input are skipped.
+//!
+//! Inputs larger than 4 GB are parsed without the index.
+template <typename CharT>
+class basic_indexed_reader
+    // Index must be constructed before the reader
+    : private detail::structural_index<CharT>,
+      protected basic_reader<CharT>
+{
+    using super = basic_reader<CharT>;
+    using typename super::decoder_type;
+    using index_type = detail::structural_index<CharT>;
+
+public:
+    using typename super::value_type;
+    using typename super::size_type;
+    using typename super::view_type;
+
+    //! @brief Construct an indexed JSON reader.
+    //!
+    //! The entire input is indexed and the first token is parsed.
+    //!
+    //! The reader does not assume ownership of the view.
+    //!
+    //! @param[in] view A string view of a JSON formatted buffer.
+    basic_indexed_reader(const view_type& view);
+
+    basic_indexed_reader(const basic_indexed_reader&);
+    basic_indexed_reader(basic_indexed_reader&&) = default;
+
+    basic_indexed_reader& operator=(const basic_indexed_reader&);
+    basic_indexed_reader& operator=(basic_indexed_reader&&) = default;
+
+    //! @brief Move to the end of the current container.
+    //!
+    //! If the current token is begin_array or begin_object, then the reader
+    //! moves directly to the matching end_array or end_object token. The
+    //! content of the container is not validated.
+    //!
+    //! @returns false if the current token is not the beginning of a container
+    //!          or the matching end token is unknown, true otherwise.
+    bool skip_to_end();
+
+    using super::next;
+    using super::level;
+    using super::code;
+    using super::symbol;
+    using super::category;
+    using super::error;
+    using super::value;
+    using super::string;
+    using super::literal;
+    using super::tail;
+
+#ifndef BOOST_DOXYGEN_INVOKED
+private:
+    const index_type& index() const noexcept;
+    void rebase(const basic_indexed_reader&) noexcept;
+#endif
+};
+
+using indexed_reader = basic_indexed_reader<char>;
+
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#include <trial/protocol/json/detail/indexed_reader.ipp>
+
+#endif // TRIAL_PROTOCOL_JSON_INDEXED_READER_HPP
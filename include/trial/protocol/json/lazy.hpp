@@ -0,0 +1,219 @@
+#ifndef TRIAL_PROTOCOL_JSON_LAZY_HPP
+#define TRIAL_PROTOCOL_JSON_LAZY_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <trial/dynamic/variable.hpp>
+#include <trial/protocol/json/error.hpp>
+#include <trial/protocol/json/reader.hpp>
+#include <trial/protocol/json/token.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+
+//! @brief Lazily decoded JSON value.
+//!
+//! A view of a JSON value within the original input buffer. Nothing is
+//! decoded or allocated until the value is accessed, and only the accessed
+//! parts are decoded. Members and elements of containers are located by
+//! skipping over them with partial::skip, and are returned as lazy values
+//! themselves.
+//!
+//! A container is scanned on first access, and the location of its members
+//! and elements is cached, so indexing and lookup do not scan it again. The
+//! cache is shared by copies of the lazy value. The same lazy value must not
+//! be accessed concurrently before its cache has been built.
+//!
+//! Strings without escaped characters can be accessed as views into the input
+//! buffer. Any value can be materialized into a dynamic variable.
+//!
+//! The input buffer must outlive the lazy value and all values obtained
+//! from it.
+//!
+//! @code
+//! json::lazy_value document(input);
+//! auto name = document["items"][0]["name"].string_view();
+//! auto price = document["items"][0]["price"].value<double>();
+//! @endcode
+
+class lazy_value
+{
+public:
+    using value_type = json::reader::value_type;
+    using size_type = json::reader::size_type;
+    using view_type = json::reader::view_type;
+
+    class iterator;
+    using const_iterator = iterator;
+
+    //! @brief Construct lazy value from JSON formatted buffer.
+    //!
+    //! The input is checked to be well-formed JSON, but is not decoded.
+    //!
+    //! @param[in] input A string view of a JSON formatted buffer.
+    //! @throws json::error if the input is malformed.
+    lazy_value(const view_type& input);
+
+    //! @brief Construct lazy value from current value of reader.
+    //!
+    //! The reader is advanced past the value, as by partial::skip.
+    //!
+    //! @param[in] reader Reader pointing to a value.
+    //! @throws json::error if the value is malformed.
+    lazy_value(json::reader& reader);
+
+    lazy_value(const lazy_value&) = default;
+    lazy_value(lazy_value&&) = default;
+    lazy_value& operator=(const lazy_value&) = default;
+    lazy_value& operator=(lazy_value&&) = default;
+
+    //! @returns The code of the first token of the value.
+    token::code::value code() const noexcept;
+
+    //! @returns The symbol of the first token of the value.
+    token::symbol::value symbol() const noexcept;
+
+    //! @returns A view of the value in the input buffer, including the
+    //!          surrounding quotes of strings and brackets of containers.
+    view_type literal() const noexcept;
+
+    //! @brief Returns the number of elements.
+    //!
+    //! Containers are scanned once to count their elements. Null has no
+    //! elements, and other values have one element, as with dynamic::variable.
+    size_type size() const;
+
+    //! @returns true if size() is zero.
+    bool empty() const;
+
+    //! @returns Iterator to the first element of an array or member of an
+    //!          object, or end() for other values.
+    iterator begin() const;
+
+    //! @returns Iterator to the end of the elements.
+    iterator end() const;
+
+    //! @brief Finds member of object.
+    //!
+    //! @param[in] key Unescaped key.
+    //! @returns Iterator to the first member with @c key, or end() if not found.
+    //! @throws json::error with json::incompatible_type if value is not an object.
+    iterator find(const view_type& key) const;
+
+    //! @brief Returns element at position in array.
+    //!
+    //! @throws json::error with json::incompatible_type if value is not an array.
+    //! @throws json::error with json::invalid_key if @c position is out of range.
+    lazy_value operator[](size_type position) const;
+
+    //! @brief Returns member of object.
+    //!
+    //! @throws json::error with json::incompatible_type if value is not an object.
+    //! @throws json::error with json::invalid_key if @c key does not exist.
+    lazy_value operator[](const view_type& key) const;
+
+    //! @brief Converts value into ReturnType.
+    //!
+    //! The conversions are the same as by json::reader::value().
+    //!
+    //! @throws json::error if requested type is incompatible with the value.
+    template <typename ReturnType> ReturnType value() const;
+
+    //! @brief Returns string as view into the input buffer.
+    //!
+    //! @returns View of string without the surrounding quotes.
+    //! @throws json::error with json::incompatible_type if value is not a string.
+    //! @throws json::error with json::invalid_value if string contains escaped
+    //!         characters, in which case value<std::string>() must be used.
+    view_type string_view() const;
+
+    //! @brief Decodes value into dynamic variable.
+    //!
+    //! @returns Dynamic variable containing the decoded JSON data.
+    template <typename Allocator = std::allocator<char>, typename MapPolicy = dynamic::ordered_map_policy>
+    auto materialize() const -> dynamic::basic_variable<Allocator, MapPolicy>;
+
+#ifndef BOOST_DOXYGEN_INVOKED
+private:
+    struct children;
+
+    lazy_value() noexcept;
+    lazy_value(token::code::value, const view_type&) noexcept;
+
+    bool has_escapes() const noexcept;
+    const std::shared_ptr<const children>& scan() const;
+
+private:
+    token::code::value current;
+    view_type view;
+    mutable std::shared_ptr<const children> cache;
+#endif
+};
+
+//! @brief Forward iterator over elements of array or members of object.
+
+class lazy_value::iterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = lazy_value;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const lazy_value *;
+    using reference = const lazy_value&;
+
+    //! @brief Construct end iterator.
+    iterator() = default;
+
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept;
+
+    iterator& operator++();
+    iterator operator++(int);
+
+    bool operator==(const iterator&) const noexcept;
+    bool operator!=(const iterator&) const noexcept;
+
+    //! @brief Returns key of current member.
+    //!
+    //! The key is a lazy value with the token::code::key code. It can be
+    //! accessed with string_view() or value<std::string>().
+    //!
+    //! @throws json::error with json::incompatible_type if not iterating over an object.
+    lazy_value key() const;
+
+#ifndef BOOST_DOXYGEN_INVOKED
+private:
+    friend class lazy_value;
+
+    iterator(const std::shared_ptr<const children>&, size_type = 0) noexcept;
+
+    bool at_end() const noexcept;
+
+private:
+    std::shared_ptr<const children> container;
+    size_type index = 0;
+#endif
+};
+
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#include <trial/protocol/json/detail/lazy.ipp>
+
+#endif // TRIAL_PROTOCOL_JSON_LAZY_HPP
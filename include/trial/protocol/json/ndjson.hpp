@@ -0,0 +1,113 @@
+#ifndef TRIAL_PROTOCOL_JSON_NDJSON_HPP
+#define TRIAL_PROTOCOL_JSON_NDJSON_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <trial/dynamic/variable.hpp>
+#include <trial/protocol/json/parse.hpp>
+#include <trial/protocol/json/detail/concurrency.hpp>
+#include <trial/protocol/json/detail/ndjson.ipp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+
+//! @brief Newline-delimited JSON.
+//!
+//! Newline-delimited JSON (also known as JSON Lines) is a sequence of JSON
+//! values separated by newline characters. JSON does not permit unescaped
+//! newlines inside values, so the input can be split into records without
+//! parsing it.
+//!
+//! The input is divided into batches of records that are parsed in parallel.
+//! Records are delivered in input order, and blank lines are skipped.
+
+namespace ndjson
+{
+
+//! @returns The default number of parser threads.
+
+inline std::size_t default_concurrency() noexcept
+{
+    return detail::default_concurrency();
+}
+
+//! @brief Default size in bytes of the batches parsed by each thread.
+
+constexpr std::size_t default_batch_size = 64 * 1024;
+
+//! @brief Decode newline-delimited JSON into dynamic variables passed to visitor.
+//!
+//! The visitor is invoked as @c visitor(variable&&) for each record, in input
+//! order and on the calling thread, while subsequent batches are parsed by
+//! worker threads.
+//!
+//! Parsing stops at the first malformed record, and json::error is thrown
+//! after all preceding records have been delivered. An exception thrown by
+//! the visitor also stops parsing and is propagated to the caller.
+//!
+//! @param input The newline-delimited JSON input buffer.
+//! @param visitor Function object receiving the decoded records.
+//! @param concurrency Number of parser threads. The input is parsed on the
+//!        calling thread if 1 or less.
+//! @param batch_size Approximate number of bytes per batch. Batches are
+//!        extended to the next record boundary.
+
+template <typename Allocator = std::allocator<char>,
+          typename MapPolicy = dynamic::ordered_map_policy,
+          typename Visitor>
+void visit(const json::reader::view_type& input,
+           Visitor&& visitor,
+           std::size_t concurrency = default_concurrency(),
+           std::size_t batch_size = default_batch_size)
+{
+    detail::ndjson_parser<Allocator, MapPolicy> parser(input, batch_size);
+    parser.visit(visitor, concurrency);
+}
+
+//! @brief Decode newline-delimited JSON into dynamic variables.
+//!
+//! @param input The newline-delimited JSON input buffer.
+//! @param concurrency Number of parser threads.
+//! @param batch_size Approximate number of bytes per batch.
+//! @returns Decoded records in input order.
+//! @throws json::error if a record is malformed.
+
+template <typename Allocator = std::allocator<char>,
+          typename MapPolicy = dynamic::ordered_map_policy>
+auto parse(const json::reader::view_type& input,
+           std::size_t concurrency = default_concurrency(),
+           std::size_t batch_size = default_batch_size) -> std::vector<dynamic::basic_variable<Allocator, MapPolicy>>
+{
+    std::vector<dynamic::basic_variable<Allocator, MapPolicy>> result;
+    ndjson::visit<Allocator, MapPolicy>(
+        input,
+        [&result] (dynamic::basic_variable<Allocator, MapPolicy>&& value)
+        {
+            result.push_back(std::move(value));
+        },
+        concurrency,
+        batch_size);
+    return result;
+}
+
+} // namespace ndjson
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_NDJSON_HPP
@@ -0,0 +1,58 @@
+#ifndef TRIAL_PROTOCOL_JSON_NESTING_HPP
+#define TRIAL_PROTOCOL_JSON_NESTING_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <trial/protocol/json/detail/nesting_stack.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+
+//! @brief Nesting of containers stored inline with spill onto the heap.
+//!
+//! The reader keeps track of up to Depth nested containers without allocating
+//! memory. Deeper nesting is stored on the heap.
+//!
+//! This is the default nesting policy of the reader.
+
+template <std::size_t Depth = 16>
+struct small_nesting
+{
+    static constexpr std::size_t depth = Depth;
+
+    template <typename T>
+    using stack_type = detail::nesting_stack<T, Depth + 1, true>;
+};
+
+//! @brief Nesting of containers stored inline with a fixed maximum depth.
+//!
+//! The reader keeps track of up to Depth nested containers without allocating
+//! memory. Deeper nesting results in the json::max_depth error.
+
+template <std::size_t Depth>
+struct fixed_nesting
+{
+    static constexpr std::size_t depth = Depth;
+
+    template <typename T>
+    using stack_type = detail::nesting_stack<T, Depth + 1, false>;
+};
+
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_NESTING_HPP
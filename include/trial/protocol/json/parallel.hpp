@@ -0,0 +1,67 @@
+#ifndef TRIAL_PROTOCOL_JSON_PARALLEL_HPP
+#define TRIAL_PROTOCOL_JSON_PARALLEL_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <memory>
+#include <trial/dynamic/variable.hpp>
+#include <trial/protocol/json/parse.hpp>
+#include <trial/protocol/json/detail/concurrency.hpp>
+#include <trial/protocol/json/detail/parallel.ipp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+namespace parallel
+{
+
+//! @brief Default size in bytes of the array fragments parsed by each thread.
+
+constexpr std::size_t default_fragment_size = 256 * 1024;
+
+//! @brief Decode JSON formatted data into dynamic variable using multiple threads.
+//!
+//! If the input is a top-level array, then the array is split into fragments
+//! of elements that are decoded in parallel. Other input, and arrays smaller
+//! than a fragment, are decoded sequentially as by json::parse.
+//!
+//! The Allocator must be safe to use concurrently from multiple threads, so
+//! dynamic::arena_allocator cannot be used.
+//!
+//! @param input The JSON formatted input buffer.
+//! @param concurrency Number of parser threads. Defaults to the number of
+//!        hardware threads.
+//! @param fragment_size Approximate number of bytes per fragment. Fragments
+//!        are extended to the next element boundary.
+//! @returns Dynamic variable containing the decoded JSON data.
+//! @throws json::error with the same error as json::parse if the input is
+//!         malformed.
+
+template <typename Allocator = std::allocator<char>,
+          typename MapPolicy = dynamic::ordered_map_policy>
+auto parse(const json::reader::view_type& input,
+           std::size_t concurrency = detail::default_concurrency(),
+           std::size_t fragment_size = default_fragment_size) -> dynamic::basic_variable<Allocator, MapPolicy>
+{
+    detail::parallel_parser<Allocator, MapPolicy> parser(input, fragment_size);
+    return parser.parse(concurrency);
+}
+
+} // namespace parallel
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_PARALLEL_HPP
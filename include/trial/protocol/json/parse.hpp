@@ -11,6 +11,7 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <trial/dynamic/arena.hpp>
 #include <trial/dynamic/variable.hpp>
 #include <trial/protocol/json/reader.hpp>
 #include <trial/protocol/json/detail/parse.ipp>
@@ -34,13 +35,29 @@ namespace partial
 //! @param reader Reader pointing to an arbitrary position within a buffer.
 //! @returns Dynamic variable containing the decoded JSON data.
 
-template <typename Allocator = std::allocator<char>>
-auto parse(json::reader& reader) -> dynamic::basic_variable<Allocator>
+template <typename Allocator = std::allocator<char>, typename MapPolicy = dynamic::ordered_map_policy>
+auto parse(json::reader& reader) -> dynamic::basic_variable<Allocator, MapPolicy>
 {
-    detail::basic_parser<char, Allocator> parser(reader);
+    detail::basic_parser<char, Allocator, MapPolicy> parser(reader);
     return parser.parse();
 }
 
+//! @brief Decode JSON formatted data into dynamic variable allocated from arena.
+//!
+//! Strings, arrays, and maps of the returned variable are allocated from
+//! @c arena, which must outlive the variable.
+//!
+//! @param reader Reader pointing to an arbitrary position within a buffer.
+//! @param arena Memory region for the decoded data.
+//! @returns Dynamic variable containing the decoded JSON data.
+
+inline auto parse(json::reader& reader,
+                  dynamic::arena& arena) -> dynamic::basic_variable<dynamic::arena_allocator<char>>
+{
+    dynamic::arena::scope scope(arena);
+    return partial::parse<dynamic::arena_allocator<char>>(reader);
+}
+
 } // namespace partial
 
 //! @brief Decode JSON formatted data into dynamic variable.
@@ -48,16 +65,34 @@ auto parse(json::reader& reader) -> dynamic::basic_variable<Allocator>
 //! @param input The JSON formatted input buffer.
 //! @returns Dynamic variable containing the decoded JSON data.
 
-template <typename U, typename Allocator = std::allocator<char>>
-auto parse(const U& input) -> dynamic::basic_variable<Allocator>
+template <typename U, typename Allocator = std::allocator<char>, typename MapPolicy = dynamic::ordered_map_policy>
+auto parse(const U& input) -> dynamic::basic_variable<Allocator, MapPolicy>
 {
     json::reader reader(input);
-    auto result = partial::parse(reader);
+    auto result = partial::parse<Allocator, MapPolicy>(reader);
     if (reader.symbol() != json::token::symbol::end)
         throw json::error(json::unexpected_token);
     return result;
 }
 
+//! @brief Decode JSON formatted data into dynamic variable allocated from arena.
+//!
+//! All strings, arrays, and maps of the returned variable are allocated from
+//! @c arena. They are returned in bulk when the arena is released, which must
+//! happen after the variable has been destroyed.
+//!
+//! @param input The JSON formatted input buffer.
+//! @param arena Memory region for the decoded data.
+//! @returns Dynamic variable containing the decoded JSON data.
+
+template <typename U>
+auto parse(const U& input,
+           dynamic::arena& arena) -> dynamic::basic_variable<dynamic::arena_allocator<char>>
+{
+    dynamic::arena::scope scope(arena);
+    return parse<U, dynamic::arena_allocator<char>>(input);
+}
+
 } // namespace json
 } // namespace protocol
 } // namespace trial
@@ -12,6 +12,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <trial/protocol/json/reader.hpp>
+#include <trial/protocol/json/indexed_reader.hpp>
 
 namespace trial
 {
@@ -21,12 +22,15 @@ namespace json
 {
 namespace partial
 {
+namespace detail
+{
 
-template<class CharT>
-typename basic_reader<CharT>::view_type
-skip(basic_reader<CharT> &reader, std::error_code &ec)
+template<class Reader>
+typename Reader::view_type
+skip(Reader &reader, std::error_code &ec)
 {
-    using view_type = typename basic_reader<CharT>::view_type;
+    using CharT = typename Reader::value_type;
+    using view_type = typename Reader::view_type;
     using size_type = typename view_type::size_type;
 
     switch (reader.symbol()) {
@@ -92,9 +96,72 @@ skip(basic_reader<CharT> &reader, std::error_code &ec)
     return {};
 }
 
+} // namespace detail
+
+template<class CharT, class Nesting>
+typename basic_reader<CharT, Nesting>::view_type
+skip(basic_reader<CharT, Nesting> &reader, std::error_code &ec)
+{
+    return detail::skip(reader, ec);
+}
+
+template<class CharT, class Nesting>
+typename basic_reader<CharT, Nesting>::view_type
+skip(basic_reader<CharT, Nesting> &reader)
+{
+    std::error_code ec;
+    auto ret = skip(reader, ec);
+    if (ec)
+        throw json::error(ec);
+    return ret;
+}
+
+//! @brief Skip over the current value with the structural index.
+//!
+//! Arrays and objects are skipped by jumping to their matching end bracket
+//! without tokenizing their content. Malformed content inside the skipped
+//! value, such as missing or superfluous separators or invalid strings, is
+//! therefore not detected. Only the balance of brackets is checked.
+template<class CharT>
+typename basic_indexed_reader<CharT>::view_type
+skip(basic_indexed_reader<CharT> &reader, std::error_code &ec)
+{
+    using view_type = typename basic_indexed_reader<CharT>::view_type;
+
+    switch (reader.symbol()) {
+    case token::symbol::begin_array:
+    case token::symbol::begin_object:
+        {
+            // Jump over container content with the structural index
+            const CharT * const head = reader.literal().data();
+            if (reader.skip_to_end())
+            {
+                const CharT * const tail = reader.literal().end();
+                if (!reader.next()) // Skip over end_array or end_object
+                    ec = reader.error();
+                return view_type(head, std::distance(head, tail));
+            }
+            if (reader.symbol() == token::symbol::error)
+            {
+                ec = reader.error();
+                return view_type(head, std::distance(head, reader.literal().begin()));
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    return detail::skip(reader, ec);
+}
+
+//! @brief Skip over the current value with the structural index.
+//!
+//! Malformed content inside the skipped value is not detected.
+//!
+//! @throws json::error if the brackets are unbalanced.
 template<class CharT>
-typename basic_reader<CharT>::view_type
-skip(basic_reader<CharT> &reader)
+typename basic_indexed_reader<CharT>::view_type
+skip(basic_indexed_reader<CharT> &reader)
 {
     std::error_code ec;
     auto ret = skip(reader, ec);
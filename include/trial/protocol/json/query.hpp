@@ -0,0 +1,127 @@
+#ifndef TRIAL_PROTOCOL_JSON_QUERY_HPP
+#define TRIAL_PROTOCOL_JSON_QUERY_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include <trial/dynamic/variable.hpp>
+#include <trial/protocol/json/error.hpp>
+#include <trial/protocol/json/lazy.hpp>
+#include <trial/protocol/json/reader.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+
+//! @brief Set of paths evaluated in a single pass over JSON input.
+//!
+//! Paths are JSON Pointers (RFC 6901), such as "/items/0/price", where the
+//! segment "*" matches all members of an object or all elements of an array,
+//! such as "/items/*/price". The empty path matches the entire input.
+//!
+//! All paths are evaluated together in one pass with json::reader without
+//! decoding the input into a dynamic variable. Subtrees that cannot match any
+//! path are skipped with partial::skip.
+//!
+//! Matched values are passed to a visitor as json::lazy_value in input order.
+//! If a matched value contains matches of other paths, then the enclosing
+//! value is passed before the values within it.
+//!
+//! @code
+//! json::query query;
+//! const auto price = query.add("/items/*/price");
+//! query.visit(input,
+//!             [&] (std::size_t path, const json::lazy_value& value)
+//!             {
+//!                 if (path == price)
+//!                     total += value.value<double>();
+//!             });
+//! @endcode
+
+class query
+{
+public:
+    using value_type = json::reader::value_type;
+    using size_type = std::size_t;
+    using view_type = json::reader::view_type;
+
+    //! @brief Adds path to query.
+    //!
+    //! @param[in] path JSON Pointer with optional "*" wildcard segments.
+    //! @returns Index of path, which is passed to visitors.
+    //! @throws json::error with json::invalid_key if the path is malformed.
+    size_type add(const view_type& path);
+
+    //! @returns Number of paths.
+    size_type size() const noexcept;
+
+    //! @brief Evaluates paths over JSON formatted buffer.
+    //!
+    //! The visitor is invoked as @c visitor(size_type path, const json::lazy_value& value)
+    //! for each match.
+    //!
+    //! @param[in] input The JSON formatted input buffer.
+    //! @param[in] visitor Function object receiving the matched values.
+    //! @throws json::error if the input is malformed.
+    template <typename Visitor>
+    void visit(const view_type& input, Visitor&& visitor) const;
+
+    //! @brief Evaluates paths over the current value of reader.
+    //!
+    //! Paths are relative to the current value. The reader is advanced past
+    //! the value.
+    //!
+    //! @param[in] reader Reader pointing to a value.
+    //! @param[in] visitor Function object receiving the matched values.
+    //! @throws json::error if the value is malformed.
+    template <typename Visitor>
+    void visit(json::reader& reader, Visitor&& visitor) const;
+
+    //! @brief Decodes matched values into dynamic variables.
+    //!
+    //! @param[in] input The JSON formatted input buffer.
+    //! @returns Matched values in input order for each path, indexed by path.
+    //! @throws json::error if the input is malformed.
+    template <typename Allocator = std::allocator<char>, typename MapPolicy = dynamic::ordered_map_policy>
+    auto select(const view_type& input) const -> std::vector<std::vector<dynamic::basic_variable<Allocator, MapPolicy>>>;
+
+#ifndef BOOST_DOXYGEN_INVOKED
+private:
+    struct segment
+    {
+        static constexpr size_type npos = size_type(-1);
+
+        bool wildcard = false;
+        std::string key;
+        size_type index = npos;
+    };
+    using path_type = std::vector<segment>;
+
+    template <typename Visitor> class evaluator;
+
+private:
+    std::vector<path_type> paths;
+#endif
+};
+
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#include <trial/protocol/json/detail/query.ipp>
+
+#endif // TRIAL_PROTOCOL_JSON_QUERY_HPP
@@ -12,10 +12,11 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <string>
-#include <stack>
-#include <vector>
+#include <trial/protocol/core/mapped_file.hpp>
 #include <trial/protocol/json/error.hpp>
+#include <trial/protocol/json/nesting.hpp>
 #include <trial/protocol/json/token.hpp>
+#include <trial/protocol/json/validation.hpp>
 #include <trial/protocol/json/detail/decoder.hpp>
 
 namespace trial
@@ -31,7 +32,14 @@ namespace json
 //! the reader only parses enough of the input to identify the next token.
 //! The entire input has to be parsed by repeating parsing the next token until
 //! the end of the input.
-template <typename CharT>
+//!
+//! The nesting of containers is tracked according to the Nesting policy. By
+//! default, the first 16 nesting levels are stored inside the reader, so
+//! shallow documents are parsed without memory allocation.
+//!
+//! @tparam CharT Character type of input buffer.
+//! @tparam Nesting Nesting policy, either json::small_nesting or json::fixed_nesting.
+template <typename CharT, typename Nesting = json::small_nesting<>>
 class basic_reader
 {
 public:
@@ -50,6 +58,22 @@ public:
     //! @param[in] view A string view of a JSON formatted buffer.
     basic_reader(const view_type& view);
 
+    //! @brief Construct an incremental JSON reader with string validation.
+    //!
+    //! With json::validation::strict, strings that are not well-formed UTF-8
+    //! result in the json::invalid_encoding error.
+    //!
+    //! @param[in] view A string view of a JSON formatted buffer.
+    //! @param[in] validation The validation mode of strings.
+    basic_reader(const view_type& view, json::validation validation);
+
+    //! @brief Construct an incremental JSON reader over a mapped file.
+    //!
+    //! The reader does not assume ownership of the mapped file.
+    //!
+    //! @param[in] file A memory-mapped JSON formatted file.
+    basic_reader(const core::mapped_file& file);
+
     //! @brief Copy-construct an incremental JSON reader.
     //!
     //! Copies the internal parsing state from the input reader, and continues
@@ -139,6 +163,20 @@ public:
     //! @returns json::errc if requested type is incompatible with the current token.
     template <typename Collector> json::errc string(Collector& collector) const noexcept;
 
+    //! @brief Converts consecutive numbers into contiguous storage.
+    //!
+    //! Converts the current number and the numbers following it in the same
+    //! array, advancing the reader past each converted number. Stops before
+    //! the first token that is not a number or that cannot be converted into T,
+    //! so the caller can process that token.
+    //!
+    //! This is faster than calling value() and next() for each number.
+    //!
+    //! @param[out] output Contiguous storage where the converted numbers are placed.
+    //! @param[in] output_length Number of items in storage.
+    //! @returns The number of converted numbers.
+    template <typename T> size_type array(T *output, size_type output_length);
+
     //! @returns A view of the current value before it is converted into its type.
     view_type literal() const noexcept;
 
@@ -147,32 +185,49 @@ public:
 
 #ifndef BOOST_DOXYGEN_INVOKED
 protected:
+    using decoder_type = detail::basic_decoder<value_type>;
+
+    basic_reader(decoder_type&& decoder);
+
     template <typename ReturnType, typename Enable = void>
     struct overloader;
 
     bool next_frame();
 
 protected:
-    using decoder_type = detail::basic_decoder<value_type>;
     decoder_type decoder;
 
     struct frame
     {
+        frame() noexcept = default;
         frame(token::null) noexcept;
         frame(token::begin_array) noexcept;
         frame(token::begin_object) noexcept;
 
-        token::code::value (frame::*next)(decoder_type&) noexcept;
+        token::code::value next(decoder_type&) noexcept;
+        bool next_number(decoder_type&) noexcept;
 
     private:
+        enum state_type : unsigned char
+        {
+            outer,
+            array,
+            array_value,
+            object,
+            object_key,
+            object_value
+        };
+
         token::code::value next_outer(decoder_type&) noexcept;
         token::code::value next_array(decoder_type&) noexcept;
         token::code::value next_array_value(decoder_type&) noexcept;
         token::code::value next_object(decoder_type&) noexcept;
         token::code::value next_object_key(decoder_type&) noexcept;
         token::code::value next_object_value(decoder_type&) noexcept;
+
+        state_type state;
     };
-    std::stack<frame, std::vector<frame>> stack;
+    typename Nesting::template stack_type<frame> stack;
 #endif
 };
 
@@ -13,6 +13,7 @@
 
 #include <trial/protocol/json/serialization/serialization.hpp>
 #include <trial/protocol/json/serialization/array.hpp>
+#include <trial/protocol/json/serialization/fields.hpp>
 #include <trial/protocol/json/serialization/std/pair.hpp>
 #include <trial/protocol/json/serialization/std/map.hpp>
 #include <trial/protocol/json/serialization/std/set.hpp>
@@ -11,6 +11,9 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef>
+#include <type_traits>
+#include <trial/protocol/core/detail/type_traits.hpp>
 #include <trial/protocol/json/serialization/serialization.hpp>
 #include <trial/protocol/core/serialization/array.hpp>
 
@@ -74,6 +77,19 @@ struct save_overloader< json::basic_oarchive<CharT>,
     static void save(json::basic_oarchive<CharT>& ar,
                      const T (&data)[N],
                      const unsigned int protocol_version)
+    {
+        save(ar, data, protocol_version, is_number{});
+    }
+
+private:
+    using is_number = std::integral_constant<bool,
+                                             std::is_arithmetic<T>::value &&
+                                             !core::detail::is_bool<T>::value>;
+
+    static void save(json::basic_oarchive<CharT>& ar,
+                     const T (&data)[N],
+                     const unsigned int protocol_version,
+                     std::false_type)
     {
         ar.template save<json::token::begin_array>();
         for (std::size_t i = 0; i < N; ++i)
@@ -82,6 +98,14 @@ struct save_overloader< json::basic_oarchive<CharT>,
         }
         ar.template save<json::token::end_array>();
     }
+
+    static void save(json::basic_oarchive<CharT>& ar,
+                     const T (&data)[N],
+                     const unsigned int,
+                     std::true_type)
+    {
+        ar.save_array(data, N);
+    }
 };
 
 } // namespace serialization
@@ -11,6 +11,7 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <trial/protocol/json/partial/skip.hpp>
 #include <trial/protocol/json/serialization/detail/array_load.hpp>
 
 namespace trial
@@ -32,6 +33,12 @@ basic_iarchive<CharT>::basic_iarchive(const json::reader::view_type& view)
 {
 }
 
+template <typename CharT>
+basic_iarchive<CharT>::basic_iarchive(const core::mapped_file& file)
+    : member{ file }
+{
+}
+
 template <typename CharT>
 template <typename Iterator>
 basic_iarchive<CharT>::basic_iarchive(Iterator begin, Iterator end)
@@ -77,6 +84,24 @@ bool basic_iarchive<CharT>::at() const
     return (member.reader.code() == Tag::code);
 }
 
+template <typename CharT>
+template <typename T>
+std::size_t basic_iarchive<CharT>::load_array(T *output, std::size_t length)
+{
+    const auto result = member.reader.array(output, length);
+    if (member.reader.symbol() == token::symbol::error)
+    {
+        throw json::error(member.reader.error());
+    }
+    return result;
+}
+
+template <typename CharT>
+void basic_iarchive<CharT>::skip()
+{
+    partial::skip(member.reader);
+}
+
 template <typename CharT>
 token::code::value basic_iarchive<CharT>::code() const
 {
@@ -41,6 +41,13 @@ void basic_oarchive<CharT>::save(const T& data)
     writer.value(data);
 }
 
+template <typename CharT>
+template <typename T>
+void basic_oarchive<CharT>::save_array(const T *data, std::size_t size)
+{
+    writer.array(data, size);
+}
+
 template <typename CharT>
 template<typename T>
 void basic_oarchive<CharT>::save_override(const T& data)
@@ -0,0 +1,241 @@
+#ifndef TRIAL_PROTOCOL_JSON_SERIALIZATION_FIELDS_HPP
+#define TRIAL_PROTOCOL_JSON_SERIALIZATION_FIELDS_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <trial/protocol/json/error.hpp>
+#include <trial/protocol/json/detail/traits.hpp>
+#include <trial/protocol/json/serialization/serialization.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+
+//! @brief Named data member of a struct.
+//!
+//! The length of the name is part of the type, so matching a key against the
+//! name compares the lengths as constants before comparing characters.
+//!
+//! Created with json::field().
+
+template <typename T, typename M, std::size_t N>
+struct basic_field
+{
+    using class_type = T;
+    using member_type = M;
+    static constexpr std::size_t size = N;
+
+    const char *name;
+    M T::*member;
+};
+
+//! @brief Create named data member.
+//!
+//! @param name String literal with the JSON key of the member.
+//! @param member Pointer to data member.
+
+template <std::size_t N, typename T, typename M>
+constexpr basic_field<T, M, N - 1> field(const char (&name)[N], M T::*member) noexcept
+{
+    return { name, member };
+}
+
+//! @brief Table of named data members for serialization of structs as JSON objects.
+//!
+//! Object keys are matched directly against the input of json::iarchive
+//! without allocating memory, except for keys that contain escaped characters.
+//! Keys can appear in any order, and unknown keys are skipped. Members without
+//! a key in the input are left unchanged.
+//!
+//! The table is typically used by the overloaders of a struct:
+//! @code
+//! struct person
+//! {
+//!     std::string name;
+//!     int age;
+//! };
+//!
+//! namespace trial { namespace protocol { namespace serialization {
+//!
+//! template <typename CharT>
+//! struct load_overloader<json::basic_iarchive<CharT>, person>
+//! {
+//!     static void load(json::basic_iarchive<CharT>& archive,
+//!                      person& data,
+//!                      const unsigned int version)
+//!     {
+//!         static const auto table = json::make_field_table(json::field("name", &person::name),
+//!                                                          json::field("age", &person::age));
+//!         table.load(archive, data, version);
+//!     }
+//! };
+//!
+//! }}}
+//! @endcode
+
+template <typename... Fields>
+class field_table
+{
+    static_assert(sizeof...(Fields) > 0, "field_table must have fields");
+
+    using first_type = typename std::tuple_element<0, std::tuple<Fields...>>::type;
+
+public:
+    using class_type = typename first_type::class_type;
+
+    field_table(Fields... fields)
+        : fields(fields...)
+    {
+    }
+
+    //! @brief Load JSON object into struct.
+    //!
+    //! @throws json::error if the input is not a JSON object.
+    template <typename CharT>
+    void load(json::basic_iarchive<CharT>& archive,
+              class_type& data,
+              const unsigned int protocol_version) const;
+
+    //! @brief Save struct as JSON object.
+    //!
+    //! Members are saved in table order.
+    template <typename CharT>
+    void save(json::basic_oarchive<CharT>& archive,
+              const class_type& data,
+              const unsigned int protocol_version) const;
+
+#ifndef BOOST_DOXYGEN_INVOKED
+private:
+    template <std::size_t I, typename CharT>
+    typename std::enable_if<(I == sizeof...(Fields)), bool>::type
+    load_member(json::basic_iarchive<CharT>&, class_type&, const char *, std::size_t, const unsigned int) const
+    {
+        return false;
+    }
+
+    template <std::size_t I, typename CharT>
+    typename std::enable_if<(I < sizeof...(Fields)), bool>::type
+    load_member(json::basic_iarchive<CharT>& archive,
+                class_type& data,
+                const char *key,
+                std::size_t size,
+                const unsigned int protocol_version) const
+    {
+        const auto& current = std::get<I>(fields);
+        using field_type = typename std::decay<decltype(current)>::type;
+        if ((size == field_type::size) && (std::memcmp(key, current.name, field_type::size) == 0))
+        {
+            archive.load_override(data.*current.member, protocol_version);
+            return true;
+        }
+        return load_member<I + 1>(archive, data, key, size, protocol_version);
+    }
+
+    template <std::size_t I, typename CharT>
+    typename std::enable_if<(I == sizeof...(Fields))>::type
+    save_member(json::basic_oarchive<CharT>&, const class_type&, const unsigned int) const
+    {
+    }
+
+    template <std::size_t I, typename CharT>
+    typename std::enable_if<(I < sizeof...(Fields))>::type
+    save_member(json::basic_oarchive<CharT>& archive,
+                const class_type& data,
+                const unsigned int protocol_version) const
+    {
+        const auto& current = std::get<I>(fields);
+        archive.save_override(current.name);
+        archive.save_override(data.*current.member, protocol_version);
+        save_member<I + 1>(archive, data, protocol_version);
+    }
+
+private:
+    std::tuple<Fields...> fields;
+#endif
+};
+
+//! @brief Create table of named data members.
+
+template <typename... Fields>
+field_table<Fields...> make_field_table(Fields... fields)
+{
+    return field_table<Fields...>(fields...);
+}
+
+//-----------------------------------------------------------------------------
+
+#ifndef BOOST_DOXYGEN_INVOKED
+
+template <typename T, typename M, std::size_t N>
+constexpr std::size_t basic_field<T, M, N>::size;
+
+template <typename... Fields>
+template <typename CharT>
+void field_table<Fields...>::load(json::basic_iarchive<CharT>& archive,
+                                  class_type& data,
+                                  const unsigned int protocol_version) const
+{
+    archive.template load<token::begin_object>();
+    while (!archive.template at<token::end_object>())
+    {
+        if (archive.symbol() != token::symbol::key)
+            throw json::error(make_error_code(json::invalid_key));
+
+        // Match key without the surrounding quotes
+        const auto literal = archive.reader().literal();
+        const char *key = literal.data() + 1;
+        const std::size_t size = literal.size() - 2;
+        bool found;
+        if (std::memchr(key, detail::traits::alphabet<char>::reverse_solidus, size) == nullptr)
+        {
+            archive.template load<token::key>();
+            found = load_member<0>(archive, data, key, size, protocol_version);
+        }
+        else
+        {
+            const auto unescaped = archive.reader().template value<std::string>();
+            archive.template load<token::key>();
+            found = load_member<0>(archive, data, unescaped.data(), unescaped.size(), protocol_version);
+        }
+        if (!found)
+        {
+            archive.skip();
+        }
+    }
+    archive.template load<token::end_object>();
+}
+
+template <typename... Fields>
+template <typename CharT>
+void field_table<Fields...>::save(json::basic_oarchive<CharT>& archive,
+                                  const class_type& data,
+                                  const unsigned int protocol_version) const
+{
+    archive.template save<token::begin_object>();
+    save_member<0>(archive, data, protocol_version);
+    archive.template save<token::end_object>();
+}
+
+#endif
+
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_SERIALIZATION_FIELDS_HPP
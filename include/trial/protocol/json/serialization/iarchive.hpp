@@ -11,6 +11,7 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef>
 #include <string>
 #include <boost/archive/detail/common_iarchive.hpp>
 #include <boost/archive/detail/register_archive.hpp>
@@ -34,6 +35,10 @@ public:
 
     basic_iarchive(const json::reader&);
     basic_iarchive(const json::reader::view_type&);
+    //! @brief Construct archive over a mapped file.
+    //!
+    //! The archive does not assume ownership of the mapped file.
+    basic_iarchive(const core::mapped_file&);
     template <typename Iterator>
     basic_iarchive(Iterator begin, Iterator end);
 
@@ -52,6 +57,24 @@ public:
     template <typename Tag>
     bool at() const;
 
+    //! @brief Load consecutive numbers of the current array.
+    //!
+    //! Stops before the first value that is not a number convertible into T.
+    //!
+    //! @param[out] output Contiguous storage where the numbers are placed.
+    //! @param[in] length Number of items in storage.
+    //! @returns The number of loaded numbers.
+    //! @throws json::error if the input is malformed.
+    template <typename T>
+    std::size_t load_array(T *output, std::size_t length);
+
+    //! @brief Skip the current value.
+    //!
+    //! Skips a single value or an entire container.
+    //!
+    //! @throws json::error if the value is malformed.
+    void skip();
+
     token::code::value code() const;
     token::symbol::value symbol() const;
     token::category::value category() const;
@@ -11,6 +11,7 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <cstddef>
 #include <string>
 #include <boost/archive/detail/common_oarchive.hpp>
 #include <boost/archive/detail/register_archive.hpp>
@@ -41,6 +42,13 @@ public:
     template <typename T>
     void save(const T& data);
 
+    //! @brief Save array of numbers.
+    //!
+    //! @param[in] data Contiguous storage with numbers.
+    //! @param[in] size Number of items in storage.
+    template <typename T>
+    void save_array(const T *data, std::size_t size);
+
     template<typename T>
     void save_override(const T& data);
 
@@ -54,7 +54,7 @@ struct load_overloader< json::basic_iarchive<CharT>,
             // We cannot use std::map<Key, T>::value_type because it has a const key
             std::pair<Key, T> value;
             archive.load_override(value, protocol_version);
-            data.insert(value);
+            data.insert(std::move(value));
         }
         archive.template load<json::token::end_array>();
     }
@@ -97,7 +97,7 @@ struct load_overloader< json::basic_iarchive<CharT>,
             value.first.reserve(archive.reader().literal().size());
             archive.load_override(value.first, protocol_version);
             archive.load_override(value.second, protocol_version);
-            data.insert(value);
+            data.insert(std::move(value));
         }
         archive.template load<json::token::end_object>();
     }
@@ -11,6 +11,12 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include <trial/protocol/core/detail/type_traits.hpp>
+#include <trial/protocol/json/detail/scan.hpp>
 #include <trial/protocol/json/serialization/serialization.hpp>
 #include <trial/protocol/core/serialization/std/vector.hpp>
 
@@ -28,6 +34,19 @@ struct save_overloader< json::basic_oarchive<CharT>,
     static void save(json::basic_oarchive<CharT>& archive,
                      const std::vector<T, Allocator>& data,
                      const unsigned int protocol_version)
+    {
+        save(archive, data, protocol_version, is_number{});
+    }
+
+private:
+    using is_number = std::integral_constant<bool,
+                                             std::is_arithmetic<T>::value &&
+                                             !core::detail::is_bool<T>::value>;
+
+    static void save(json::basic_oarchive<CharT>& archive,
+                     const std::vector<T, Allocator>& data,
+                     const unsigned int protocol_version,
+                     std::false_type)
     {
         archive.template save<json::token::begin_array>();
         for (typename std::vector<T, Allocator>::const_iterator it = data.begin();
@@ -38,6 +57,14 @@ struct save_overloader< json::basic_oarchive<CharT>,
         }
         archive.template save<json::token::end_array>();
     }
+
+    static void save(json::basic_oarchive<CharT>& archive,
+                     const std::vector<T, Allocator>& data,
+                     const unsigned int,
+                     std::true_type)
+    {
+        archive.save_array(data.data(), data.size());
+    }
 };
 
 template <typename CharT, typename T, typename Allocator>
@@ -49,6 +76,7 @@ struct load_overloader< json::basic_iarchive<CharT>,
                      const unsigned int protocol_version)
     {
         archive.template load<json::token::begin_array>();
+        load_numbers(archive, data, is_number{});
         while (!archive.template at<json::token::end_array>())
         {
             T value;
@@ -57,6 +85,67 @@ struct load_overloader< json::basic_iarchive<CharT>,
         }
         archive.template load<json::token::end_array>();
     }
+
+private:
+    using is_number = std::integral_constant<bool,
+                                             std::is_arithmetic<T>::value &&
+                                             !core::detail::is_bool<T>::value>;
+
+    static void load_numbers(json::basic_iarchive<CharT>&,
+                             std::vector<T, Allocator>&,
+                             std::false_type)
+    {
+    }
+
+    // Numbers are converted directly into the vector. The remaining elements,
+    // if any, are loaded one by one.
+    //
+    // The vector grows in chunks that are limited by the number of elements
+    // converted so far, so malformed input cannot cause a large allocation
+    // before the elements have been checked.
+    static void load_numbers(json::basic_iarchive<CharT>& archive,
+                             std::vector<T, Allocator>& data,
+                             std::true_type)
+    {
+        if (archive.symbol() != json::token::symbol::integer &&
+            archive.symbol() != json::token::symbol::real)
+            return;
+
+        const std::size_t initial_chunk = 64;
+        const auto offset = data.size();
+        auto remaining = count_numbers(archive.reader().tail());
+        auto chunk = std::min<std::size_t>(remaining, initial_chunk);
+        try
+        {
+            do
+            {
+                const auto size = data.size();
+                data.resize(size + chunk);
+                const auto loaded = archive.load_array(data.data() + size, chunk);
+                data.resize(size + loaded);
+                if (loaded < chunk)
+                    break;
+                remaining = (remaining > loaded) ? remaining - loaded : 1;
+                chunk = std::min<std::size_t>(remaining, data.size() - offset);
+            } while (archive.symbol() == json::token::symbol::integer ||
+                     archive.symbol() == json::token::symbol::real);
+        }
+        catch (...)
+        {
+            data.resize(offset);
+            throw;
+        }
+    }
+
+    // The number of numbers is estimated from the number of value separators
+    // before the first end array bracket. The estimate is too large if the
+    // array contains other values, such as strings with commas, nested arrays
+    // or objects, or if the input is malformed. It is therefore only used to
+    // limit the size of the chunks.
+    static std::size_t count_numbers(const typename json::basic_reader<CharT>::view_type& tail) noexcept
+    {
+        return 1 + json::detail::count_separators(tail.data(), tail.data() + tail.size());
+    }
 };
 
 // Specialization for std::vector<bool>
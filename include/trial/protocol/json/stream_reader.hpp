@@ -0,0 +1,148 @@
+#ifndef TRIAL_PROTOCOL_JSON_STREAM_READER_HPP
+#define TRIAL_PROTOCOL_JSON_STREAM_READER_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <functional>
+#include <istream>
+#include <vector>
+#include <trial/protocol/json/reader.hpp>
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+
+//! @brief Incremental JSON reader of streamed input.
+//!
+//! Reads JSON formatted input that is pulled from a source in chunks. The
+//! reader owns the input buffer and refills it when the next token is not
+//! entirely available. Only the unfinished token, and the current token, are
+//! moved to the beginning of the buffer before refilling, and the buffer only
+//! grows if a single token exceeds its capacity.
+//!
+//! The input may contain a sequence of JSON values, such as newline-delimited
+//! JSON. The nesting level returns to 0 after each value.
+//!
+//! The view returned by literal() is valid until the next call to next().
+template <typename CharT>
+class basic_stream_reader
+    : protected basic_reader<CharT>
+{
+    using super = basic_reader<CharT>;
+    using typename super::decoder_type;
+
+public:
+    using typename super::value_type;
+    using typename super::size_type;
+    using typename super::view_type;
+
+    //! @brief Source of input.
+    //!
+    //! Copies up to @c size characters into @c data and returns the number
+    //! of copied characters. Returns 0 at the end of input.
+    //!
+    //! For example, a file descriptor source:
+    //! @code
+    //! [fd](char *data, std::size_t size) -> std::size_t
+    //! {
+    //!     auto result = ::read(fd, data, size);
+    //!     return (result > 0) ? result : 0;
+    //! }
+    //! @endcode
+    using source_type = std::function<size_type (value_type *data, size_type size)>;
+
+    //! @brief Construct a reader of input pulled from a source.
+    //!
+    //! The first token is automatically parsed.
+    //!
+    //! @param[in] source The source of input.
+    //! @param[in] capacity The initial size of the input buffer.
+    //! @param[in] validation The validation mode of strings.
+    basic_stream_reader(source_type source,
+                        size_type capacity = 4096,
+                        json::validation validation = json::validation::lenient);
+
+    //! @brief Construct a reader of input from an input stream.
+    //!
+    //! Reads whatever the stream has buffered, and blocks only if nothing is
+    //! available.
+    //!
+    //! The reader does not assume ownership of the stream.
+    //!
+    //! @param[in] input The input stream.
+    //! @param[in] capacity The initial size of the input buffer.
+    //! @param[in] validation The validation mode of strings.
+    basic_stream_reader(std::basic_istream<value_type>& input,
+                        size_type capacity = 4096,
+                        json::validation validation = json::validation::lenient);
+
+    basic_stream_reader(const basic_stream_reader&) = delete;
+    basic_stream_reader(basic_stream_reader&&) = default;
+    basic_stream_reader& operator=(const basic_stream_reader&) = delete;
+    basic_stream_reader& operator=(basic_stream_reader&&) = default;
+
+    //! @brief Parse the next token.
+    //!
+    //! Pulls more input from the source if needed.
+    //!
+    //! @returns false if an error occurred or end-of-input was reached, true otherwise.
+    bool next();
+
+    //! @brief Parse the next token if current token has a given value.
+    //!
+    //! @param[in] expect Expected value of current token.
+    //! @returns false if current token does not have the expected value.
+    bool next(token::code::value expect);
+
+    //! @returns The size of the input buffer.
+    size_type capacity() const noexcept;
+
+    using super::level;
+    using super::code;
+    using super::symbol;
+    using super::category;
+    using super::error;
+    using super::value;
+    using super::string;
+    using super::literal;
+
+#ifndef BOOST_DOXYGEN_INVOKED
+private:
+    using const_pointer = const value_type *;
+    using checkpoint_type = typename decoder_type::checkpoint_type;
+
+    void initialize();
+    void next_root();
+    bool tentative() const noexcept;
+    void refill(const checkpoint_type&);
+    void fill(size_type offset);
+
+private:
+    source_type source;
+    std::vector<value_type> buffer;
+    size_type length;
+    bool exhausted;
+    json::validation mode;
+#endif
+};
+
+using stream_reader = basic_stream_reader<char>;
+
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#include <trial/protocol/json/detail/stream_reader.ipp>
+
+#endif // TRIAL_PROTOCOL_JSON_STREAM_READER_HPP
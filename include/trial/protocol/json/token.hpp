@@ -56,7 +56,9 @@ struct code
         error_unbalanced_end_array = -5,
         error_unbalanced_end_object = -6,
         error_expected_end_array = -7,
-        error_expected_end_object = -8
+        error_expected_end_object = -8,
+        error_invalid_encoding = -9,
+        error_max_depth = -10
     };
 };
 
@@ -106,6 +108,11 @@ struct null
     static const token::code::value code = token::code::null;
 };
 
+struct key
+{
+    static const token::code::value code = token::code::key;
+};
+
 struct begin_array
 {
     static const token::code::value code = token::code::begin_array;
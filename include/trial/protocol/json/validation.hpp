@@ -0,0 +1,38 @@
+#ifndef TRIAL_PROTOCOL_JSON_VALIDATION_HPP
+#define TRIAL_PROTOCOL_JSON_VALIDATION_HPP
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace trial
+{
+namespace protocol
+{
+namespace json
+{
+
+//! @brief Validation of string tokens.
+enum class validation
+{
+    //! Multi-byte characters must have the number of continuation bytes
+    //! announced by their first byte.
+    lenient,
+
+    //! Strings must be well-formed UTF-8. Overlong encodings, surrogates,
+    //! and code points beyond U+10FFFF are rejected with
+    //! json::invalid_encoding.
+    strict
+};
+
+} // namespace json
+} // namespace protocol
+} // namespace trial
+
+#endif // TRIAL_PROTOCOL_JSON_VALIDATION_HPP
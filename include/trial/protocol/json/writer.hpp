@@ -28,17 +28,28 @@ namespace json
 //! @brief Incremental JSON writer.
 //!
 //! Generate JSON output incrementally by appending C++ data.
-template <typename CharT, std::size_t N = 2 * sizeof(void *)>
+//!
+//! By default the output buffer is accessed through the virtual buffer::base
+//! interface, so the writer accepts any buffer type for which a buffer
+//! wrapper exists. The buffer wrapper is stored in N bytes.
+//!
+//! If Buffer is a buffer wrapper derived from buffer::static_base, then the
+//! writer only accepts the buffer type of that wrapper, but the output is
+//! written without virtual function calls. See static_writer.
+template <typename CharT,
+          std::size_t N = 2 * sizeof(void *),
+          typename Buffer = buffer::base<CharT>>
 class basic_writer
 {
 public:
     using value_type = CharT;
     using size_type = std::size_t;
-    using view_type = typename detail::basic_encoder<value_type, N>::view_type;
+    using view_type = typename detail::basic_encoder<value_type, N, Buffer>::view_type;
 
     //! @brief Construct an incremental JSON writer.
     //!
-    //! The buffer type can be any for which a buffer wrapper exists.
+    //! The buffer type can be any for which a buffer wrapper exists, or the
+    //! buffer type of Buffer if Buffer is not buffer::base.
     //!
     //! @param[in] buffer A buffer where the JSON formatted output is stored.
     template <typename T> basic_writer(T& buffer);
@@ -54,9 +65,25 @@ public:
     template <typename T>
     size_type value(T&& value);
 
+    //! @brief Write array of numbers.
+    //!
+    //! Writes the numbers as a JSON array in one pass. This is faster than
+    //! writing begin_array, each number, and end_array separately.
+    //!
+    //! @param[in] data Contiguous storage with numbers. T can be an integral
+    //!            type (except bool) or a floating-point type.
+    //! @param[in] size Number of items in storage.
+    template <typename T>
+    size_type array(const T *data, size_type size);
+
     //! @brief Write raw output.
     size_type literal(const view_type&) BOOST_NOEXCEPT;
 
+    //! @brief Reserve capacity for an estimated amount of output.
+    //!
+    //! @returns false if the buffer cannot hold the estimated output.
+    bool reserve(size_type);
+
 #ifndef BOOST_DOXYGEN_INVOKED
 private:
     void validate_scope();
@@ -72,7 +99,7 @@ private:
     size_type end_object_value();
 
 private:
-    using encoder_type = detail::basic_encoder<value_type, N>;
+    using encoder_type = detail::basic_encoder<value_type, N, Buffer>;
     encoder_type encoder;
     mutable enum json::errc last_error;
 
@@ -92,6 +119,12 @@ private:
 
 using writer = basic_writer<char>;
 
+//! @brief Incremental JSON writer with statically dispatched buffer.
+//!
+//! Example: static_writer<buffer::basic_string<char, buffer::static_base<char>>>
+template <typename Buffer>
+using static_writer = basic_writer<typename Buffer::value_type, sizeof(Buffer), Buffer>;
+
 } // namespace json
 } // namespace protocol
 } // namespace trial
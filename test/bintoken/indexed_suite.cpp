@@ -0,0 +1,538 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <trial/protocol/buffer/vector.hpp>
+#include <trial/protocol/bintoken/indexed_reader.hpp>
+#include <trial/protocol/bintoken/indexed_writer.hpp>
+#include <trial/protocol/core/detail/lightweight_test.hpp>
+
+namespace format = trial::protocol::bintoken;
+namespace token = format::token;
+using value_type = std::uint8_t;
+
+//-----------------------------------------------------------------------------
+// Output with limited capacity
+//-----------------------------------------------------------------------------
+
+struct limited_output
+{
+    std::vector<value_type> data;
+    std::size_t capacity;
+};
+
+class limited_buffer : public trial::protocol::buffer::base<value_type>
+{
+public:
+    limited_buffer(limited_output& output)
+        : output(output)
+    {
+    }
+
+    bool grow(size_type delta)
+    {
+        return output.data.size() + delta <= output.capacity;
+    }
+
+    void write(value_type value)
+    {
+        output.data.push_back(value);
+    }
+
+    void write(const view_type& view)
+    {
+        output.data.insert(output.data.end(), view.begin(), view.end());
+    }
+
+private:
+    limited_output& output;
+};
+
+namespace trial
+{
+namespace protocol
+{
+namespace buffer
+{
+
+template <>
+struct traits<limited_output>
+{
+    using buffer_type = limited_buffer;
+};
+
+} // namespace buffer
+} // namespace protocol
+} // namespace trial
+
+//-----------------------------------------------------------------------------
+// Writer
+//-----------------------------------------------------------------------------
+
+namespace writer_suite
+{
+
+void test_empty_array()
+{
+    std::vector<value_type> result;
+    format::indexed_writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::begin_array>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::end_array>(), 1 + 10 + 10);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.size(), 0);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.tell(), result.size());
+    std::vector<value_type> expected = {
+        token::code::begin_array,
+        token::code::end_array,
+        // Index
+        token::code::array8_int64, 8,
+        0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        // Footer
+        token::code::array8_int64, 8,
+        0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expected.begin(), expected.end());
+}
+
+void test_array()
+{
+    std::vector<value_type> result;
+    format::indexed_writer writer(result);
+    writer.value<token::begin_array>();
+    writer.value(1);
+    writer.value<token::begin_record>();
+    writer.value(2);
+    writer.value<token::end_record>();
+    writer.value(3);
+    writer.value<token::end_array>();
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.size(), 3);
+    std::vector<value_type> expected = {
+        token::code::begin_array,
+        0x01,
+        token::code::begin_record, 0x02, token::code::end_record,
+        0x03,
+        token::code::end_array,
+        // Index
+        token::code::array8_int64, 4 * 8,
+        0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        // Footer
+        token::code::array8_int64, 8,
+        0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expected.begin(), expected.end());
+}
+
+void test_assoc_array()
+{
+    std::vector<value_type> result;
+    format::indexed_writer writer(result);
+    writer.value<token::begin_assoc_array>();
+    writer.value("a");
+    writer.value(1);
+    writer.value("b");
+    const std::int16_t data[] = { 2, 3 };
+    writer.array(data, 2);
+    writer.value<token::end_assoc_array>();
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.size(), 2);
+    std::vector<value_type> expected = {
+        token::code::begin_assoc_array,
+        token::code::string8, 0x01, 'a', 0x01,
+        token::code::string8, 0x01, 'b', token::code::array8_int16, 0x04, 0x02, 0x00, 0x03, 0x00,
+        token::code::end_assoc_array,
+        // Index
+        token::code::array8_int64, 3 * 8,
+        0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        // Keys
+        token::code::array8_int64, 2 * 8,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        // Footer
+        token::code::array8_int64, 8,
+        0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expected.begin(), expected.end());
+}
+
+void fail_not_container()
+{
+    std::vector<value_type> result;
+    format::indexed_writer writer(result);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(writer.value(1),
+                                    format::error,
+                                    "unexpected token");
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(writer.value<token::begin_record>(),
+                                    format::error,
+                                    "unexpected token");
+}
+
+void fail_after_close()
+{
+    std::vector<value_type> result;
+    format::indexed_writer writer(result);
+    writer.value<token::begin_array>();
+    writer.value<token::end_array>();
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(writer.value<token::begin_array>(),
+                                    format::error,
+                                    "unexpected token");
+}
+
+void fail_overflow()
+{
+    limited_output result{ {}, 4 };
+    format::indexed_writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::begin_array>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(1), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(1000), 0);
+    // Subsequent tokens are discarded even if they fit
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(2), 0);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::end_array>(), 0);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.size(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.tell(), 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.data.size(), 2);
+}
+
+void fail_overflow_trailer()
+{
+    limited_output result{ {}, 8 };
+    format::indexed_writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::begin_array>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::end_array>(), 0);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.size(), 0);
+}
+
+void run()
+{
+    test_empty_array();
+    test_array();
+    test_assoc_array();
+    fail_not_container();
+    fail_after_close();
+    fail_overflow();
+    fail_overflow_trailer();
+}
+
+} // namespace writer_suite
+
+//-----------------------------------------------------------------------------
+// Reader
+//-----------------------------------------------------------------------------
+
+namespace reader_suite
+{
+
+std::vector<value_type> make_array(int count)
+{
+    std::vector<value_type> result;
+    format::indexed_writer writer(result);
+    writer.value<token::begin_array>();
+    for (int i = 0; i < count; ++i)
+    {
+        writer.value<token::begin_record>();
+        writer.value(i);
+        writer.value(std::to_string(i));
+        writer.value<token::end_record>();
+    }
+    writer.value<token::end_array>();
+    return result;
+}
+
+void test_empty()
+{
+    auto input = make_array(0);
+    format::indexed_reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.size(), 0);
+    TRIAL_PROTOCOL_TEST(reader.empty());
+}
+
+void test_at()
+{
+    auto input = make_array(1000);
+    format::indexed_reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.size(), 1000);
+    auto record = reader.at(765);
+    TRIAL_PROTOCOL_TEST_EQUAL(record.code(), token::code::begin_record);
+    TRIAL_PROTOCOL_TEST(record.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(record.value<int>(), 765);
+    TRIAL_PROTOCOL_TEST(record.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(record.value<std::string>(), "765");
+    TRIAL_PROTOCOL_TEST(record.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(record.code(), token::code::end_record);
+    TRIAL_PROTOCOL_TEST(!record.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(record.code(), token::code::end);
+}
+
+void test_range()
+{
+    auto input = make_array(100);
+    format::indexed_reader reader(input);
+    // Scan disjoint ranges independently
+    int total = 0;
+    for (std::size_t first = 0; first < reader.size(); first += 30)
+    {
+        const std::size_t last = std::min<std::size_t>(first + 30, reader.size());
+        auto range = reader.range(first, last);
+        std::size_t records = 0;
+        do
+        {
+            if (range.code() == token::code::begin_record)
+            {
+                ++records;
+                range.next();
+                total += range.value<int>();
+            }
+        } while (range.next());
+        TRIAL_PROTOCOL_TEST_EQUAL(range.code(), token::code::end);
+        TRIAL_PROTOCOL_TEST_EQUAL(records, last - first);
+    }
+    TRIAL_PROTOCOL_TEST_EQUAL(total, 99 * 100 / 2);
+}
+
+void test_range_empty()
+{
+    auto input = make_array(3);
+    format::indexed_reader reader(input);
+    auto range = reader.range(2, 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(range.code(), token::code::end);
+}
+
+void test_sequential()
+{
+    // Indexed container remains readable with a sequential reader
+    auto input = make_array(2);
+    format::reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array);
+    while ((reader.code() != token::code::end_array) || (reader.level() != 1))
+    {
+        if (!reader.next())
+            break;
+    }
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::array8_int64);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::array8_int64);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+}
+
+void test_find()
+{
+    std::vector<value_type> input;
+    {
+        format::indexed_writer writer(input);
+        writer.value<token::begin_assoc_array>();
+        writer.value("alpha");
+        writer.value(1);
+        writer.value("bravo");
+        writer.value<token::begin_array>();
+        writer.value("alpha");
+        writer.value<token::end_array>();
+        writer.value("charlie");
+        writer.value(3);
+        writer.value<token::end_assoc_array>();
+    }
+    format::indexed_reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_assoc_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.size(), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.find("alpha"), 0);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.find("bravo"), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.find("charlie"), 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.find("delta"), reader.size());
+    auto record = reader.at(reader.find("charlie"));
+    TRIAL_PROTOCOL_TEST_EQUAL(record.value<std::string>(), "charlie");
+    TRIAL_PROTOCOL_TEST(record.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(record.value<int>(), 3);
+    TRIAL_PROTOCOL_TEST(!record.next());
+}
+
+void test_find_unsorted()
+{
+    std::vector<value_type> input;
+    {
+        format::indexed_writer writer(input);
+        writer.value<token::begin_assoc_array>();
+        writer.value(std::string("delta"));
+        writer.value(0);
+        writer.value(42);
+        writer.value(1);
+        writer.value("bravo");
+        writer.value(2);
+        writer.value(format::writer::string_view_type("alpha"));
+        writer.value(3);
+        writer.value("bravo");
+        writer.value(4);
+        writer.value("");
+        writer.value(5);
+        writer.value<token::end_assoc_array>();
+    }
+    format::indexed_reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.size(), 6);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.find("alpha"), 3);
+    // First record with duplicate key
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.find("bravo"), 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.find("delta"), 0);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.find(""), 5);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.find("42"), reader.size());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.find("bravo2"), reader.size());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.find("echo"), reader.size());
+}
+
+void test_find_many()
+{
+    std::vector<value_type> input;
+    {
+        format::indexed_writer writer(input);
+        writer.value<token::begin_assoc_array>();
+        for (int i = 999; i >= 0; --i)
+        {
+            writer.value(std::to_string(i));
+            writer.value(i);
+        }
+        writer.value<token::end_assoc_array>();
+    }
+    format::indexed_reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.size(), 1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        const auto index = reader.find(std::to_string(i));
+        TRIAL_PROTOCOL_TEST_EQUAL(index, 999 - i);
+    }
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.find("1000"), reader.size());
+}
+
+void test_find_array()
+{
+    std::vector<value_type> input;
+    {
+        format::indexed_writer writer(input);
+        writer.value<token::begin_array>();
+        writer.value("alpha");
+        writer.value<token::end_array>();
+    }
+    format::indexed_reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.find("alpha"), reader.size());
+}
+
+void fail_at()
+{
+    auto input = make_array(3);
+    format::indexed_reader reader(input);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(reader.at(3),
+                                    format::error,
+                                    "overflow");
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(reader.range(2, 1),
+                                    format::error,
+                                    "overflow");
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(reader.range(0, 4),
+                                    format::error,
+                                    "overflow");
+}
+
+void fail_missing_index()
+{
+    std::vector<value_type> input = {
+        token::code::begin_array, 0x01, 0x02, 0x03, 0x04, 0x05,
+        0x06, 0x07, 0x08, 0x09, 0x0A, token::code::end_array };
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(format::indexed_reader{input},
+                                    format::error,
+                                    "invalid value");
+}
+
+void fail_truncated()
+{
+    auto input = make_array(3);
+    input.pop_back();
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(format::indexed_reader{input},
+                                    format::error,
+                                    "invalid value");
+}
+
+void fail_corrupted_offset()
+{
+    auto input = make_array(3);
+    // First offset in index
+    const std::size_t index = input[input.size() - 8];
+    input[index + 2] = 0xFF;
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(format::indexed_reader{input},
+                                    format::error,
+                                    "invalid value");
+}
+
+void fail_corrupted_key()
+{
+    std::vector<value_type> input;
+    {
+        format::indexed_writer writer(input);
+        writer.value<token::begin_assoc_array>();
+        writer.value("alpha");
+        writer.value(1);
+        writer.value<token::end_assoc_array>();
+    }
+    // Only entry in keys table
+    input[input.size() - 10 - 8] = 0x01;
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(format::indexed_reader{input},
+                                    format::error,
+                                    "invalid value");
+}
+
+void fail_missing_keys()
+{
+    std::vector<value_type> input;
+    {
+        format::indexed_writer writer(input);
+        writer.value<token::begin_assoc_array>();
+        writer.value<token::end_assoc_array>();
+    }
+    // Remove empty keys table
+    input.erase(input.end() - 10 - 2, input.end() - 10);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(format::indexed_reader{input},
+                                    format::error,
+                                    "invalid value");
+}
+
+void run()
+{
+    test_empty();
+    test_at();
+    test_range();
+    test_range_empty();
+    test_sequential();
+    test_find();
+    test_find_unsorted();
+    test_find_many();
+    test_find_array();
+    fail_at();
+    fail_missing_index();
+    fail_truncated();
+    fail_corrupted_offset();
+    fail_corrupted_key();
+    fail_missing_keys();
+}
+
+} // namespace reader_suite
+
+//-----------------------------------------------------------------------------
+// main
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    writer_suite::run();
+    reader_suite::run();
+
+    return boost::report_errors();
+}
@@ -10,7 +10,9 @@
 
 #include <functional>
 #include <limits>
+#include <vector>
 #include <trial/protocol/buffer/array.hpp>
+#include <trial/protocol/buffer/vector.hpp>
 #include <trial/protocol/bintoken/reader.hpp>
 #include <trial/protocol/core/detail/lightweight_test.hpp>
 
@@ -1179,6 +1181,50 @@ void fail_float64_overflow()
                                     format::error, "overflow");
 }
 
+void test_int32_large()
+{
+    // Crosses the array8 length limit
+    const std::size_t count = 300;
+    std::vector<value_type> input = {
+        token::code::array16_int32,
+        (count * token::int32::size) & 0xFF, (count * token::int32::size) >> 8 };
+    std::vector<std::int32_t> expected;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const value_type bytes[] = { value_type(i), value_type(i >> 8), 0x03, 0x84 };
+        input.insert(input.end(), bytes, bytes + sizeof(bytes));
+        expected.push_back(std::int32_t(UINT32_C(0x84030000) | std::uint32_t(i)));
+    }
+    format::reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::array16_int32);
+    TRIAL_PROTOCOL_TEST(reader.length() == count);
+    std::vector<std::int32_t> buffer(count);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.array<std::int32_t>(buffer.data(), buffer.size()), count);
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(buffer.begin(), buffer.end(),
+                                  expected.begin(), expected.end());
+}
+
+void test_float64_large()
+{
+    const std::size_t count = 100;
+    std::vector<value_type> input = {
+        token::code::array16_float64,
+        (count * token::float64::size) & 0xFF, (count * token::float64::size) >> 8 };
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // 1.5
+        const value_type bytes[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x3F };
+        input.insert(input.end(), bytes, bytes + sizeof(bytes));
+    }
+    format::reader reader(input);
+    TRIAL_PROTOCOL_TEST(reader.length() == count);
+    std::vector<token::float64::type> buffer(count);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.array<token::float64::type>(buffer.data(), buffer.size()), count);
+    std::vector<token::float64::type> expected(count, 1.5);
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(buffer.begin(), buffer.end(),
+                                  expected.begin(), expected.end());
+}
+
 void run()
 {
     test_int8();
@@ -1193,10 +1239,116 @@ void run()
     fail_float32_overflow();
     test_float64();
     fail_float64_overflow();
+    test_int32_large();
+    test_float64_large();
 }
 
 } // namespace compact_suite
 
+//-----------------------------------------------------------------------------
+// Array views
+//-----------------------------------------------------------------------------
+
+namespace view_suite
+{
+
+void test_int32_aligned()
+{
+    // Array data starts at an 8-byte boundary
+    alignas(8) const value_type storage[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        token::code::array8_int32, 2 * token::int32::size,
+        0x01, 0x00, 0x00, 0x00,
+        0x02, 0x00, 0x00, 0x80 };
+    format::reader reader(format::reader::view_type(storage + 6, sizeof(storage) - 6));
+    auto view = reader.array_view<std::int32_t>();
+    TRIAL_PROTOCOL_TEST_EQUAL(view.size(), 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(view[0], 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(view[1], std::numeric_limits<std::int32_t>::min() + 2);
+    TRIAL_PROTOCOL_TEST(!view.is_copy());
+    TRIAL_PROTOCOL_TEST(static_cast<const void *>(view.data()) == static_cast<const void *>(storage + 8));
+    // View survives advancing the reader
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(view[0], 1);
+}
+
+void test_int32_unsigned()
+{
+    alignas(8) const value_type storage[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        token::code::array8_int32, 1 * token::int32::size,
+        0xFF, 0xFF, 0xFF, 0xFF };
+    format::reader reader(format::reader::view_type(storage + 6, sizeof(storage) - 6));
+    auto view = reader.array_view<std::uint32_t>();
+    TRIAL_PROTOCOL_TEST_EQUAL(view.size(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(view[0], std::numeric_limits<std::uint32_t>::max());
+    TRIAL_PROTOCOL_TEST(!view.is_copy());
+}
+
+void test_float64_misaligned()
+{
+    // Array data starts one byte after an 8-byte boundary
+    alignas(8) const value_type storage[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        token::code::array8_float64, 2 * token::float64::size,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x3F,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x3F };
+    format::reader reader(format::reader::view_type(storage + 7, sizeof(storage) - 7));
+    auto view = reader.array_view<token::float64::type>();
+    TRIAL_PROTOCOL_TEST(view.is_copy());
+    std::vector<token::float64::type> expected = { 1.0, 1.5 };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(view.begin(), view.end(),
+                                  expected.begin(), expected.end());
+    // Copies remain valid after the original is gone
+    auto copy = view;
+    view = {};
+    TRIAL_PROTOCOL_TEST(view.empty());
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(copy.begin(), copy.end(),
+                                  expected.begin(), expected.end());
+}
+
+void test_int8_scalar()
+{
+    const value_type input[] = { 0x2A };
+    format::reader reader(input);
+    auto view = reader.array_view<std::int8_t>();
+    TRIAL_PROTOCOL_TEST(view.is_copy());
+    TRIAL_PROTOCOL_TEST_EQUAL(view.size(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(view[0], 0x2A);
+}
+
+void test_empty()
+{
+    const value_type input[] = { token::code::array8_int16, 0x00 };
+    format::reader reader(input);
+    auto view = reader.array_view<std::int16_t>();
+    TRIAL_PROTOCOL_TEST(view.empty());
+}
+
+void fail_mismatch()
+{
+    // Integer array viewed as floating-point numbers
+    alignas(8) const value_type storage[] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        token::code::array8_int32, 1 * token::int32::size,
+        0x01, 0x00, 0x00, 0x00 };
+    format::reader reader(format::reader::view_type(storage + 6, sizeof(storage) - 6));
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(reader.array_view<token::float32::type>(),
+                                    format::error, "invalid value");
+}
+
+void run()
+{
+    test_int32_aligned();
+    test_int32_unsigned();
+    test_float64_misaligned();
+    test_int8_scalar();
+    test_empty();
+    fail_mismatch();
+}
+
+} // namespace view_suite
+
 //-----------------------------------------------------------------------------
 // Containers
 //-----------------------------------------------------------------------------
@@ -1286,6 +1438,7 @@ int main()
     number_suite::run();
     string_suite::run();
     compact_suite::run();
+    view_suite::run();
     container_suite::run();
 
     return boost::report_errors();
@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <trial/protocol/buffer/array.hpp>
+#include <trial/protocol/bintoken/partial/skip.hpp>
+#include <trial/protocol/core/detail/lightweight_test.hpp>
+
+namespace format = trial::protocol::bintoken;
+namespace token = format::token;
+using value_type = std::uint8_t;
+
+//-----------------------------------------------------------------------------
+// Values
+//-----------------------------------------------------------------------------
+
+namespace value_suite
+{
+
+void test_small_integer()
+{
+    const value_type input[] = { 0x2A, 0x01 };
+    format::reader reader(input);
+    auto skipped = format::partial::skip(reader);
+    TRIAL_PROTOCOL_TEST(skipped.data() == input);
+    TRIAL_PROTOCOL_TEST_EQUAL(skipped.size(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 1);
+}
+
+void test_int16()
+{
+    const value_type input[] = { token::code::int16, 0x00, 0x01, 0x01 };
+    format::reader reader(input);
+    auto skipped = format::partial::skip(reader);
+    TRIAL_PROTOCOL_TEST(skipped.data() == input);
+    TRIAL_PROTOCOL_TEST_EQUAL(skipped.size(), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 1);
+}
+
+void test_string()
+{
+    const value_type input[] = { token::code::string8, 0x03, 'a', 'b', 'c', token::code::null };
+    format::reader reader(input);
+    auto skipped = format::partial::skip(reader);
+    TRIAL_PROTOCOL_TEST(skipped.data() == input);
+    TRIAL_PROTOCOL_TEST_EQUAL(skipped.size(), 5);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::null);
+}
+
+void test_compact_array()
+{
+    const value_type input[] = {
+        token::code::array16_int32, 0x08, 0x00,
+        0x01, 0x00, 0x00, 0x00,
+        0x02, 0x00, 0x00, 0x00 };
+    format::reader reader(input);
+    auto skipped = format::partial::skip(reader);
+    TRIAL_PROTOCOL_TEST(skipped.data() == input);
+    TRIAL_PROTOCOL_TEST_EQUAL(skipped.size(), sizeof(input));
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+}
+
+void fail_end()
+{
+    const value_type input[] = { token::code::end_array };
+    format::reader reader(input);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(format::partial::skip(reader),
+                                    format::error,
+                                    "unexpected token");
+}
+
+void run()
+{
+    test_small_integer();
+    test_int16();
+    test_string();
+    test_compact_array();
+    fail_end();
+}
+
+} // namespace value_suite
+
+//-----------------------------------------------------------------------------
+// Groups
+//-----------------------------------------------------------------------------
+
+namespace group_suite
+{
+
+void test_array()
+{
+    const value_type input[] = {
+        token::code::begin_array,
+        0x01,
+        token::code::begin_record, token::code::string8, 0x01, 'a', token::code::end_record,
+        token::code::begin_assoc_array, 0x02, 0x03, token::code::end_assoc_array,
+        token::code::end_array,
+        0x04 };
+    format::reader reader(input);
+    auto skipped = format::partial::skip(reader);
+    TRIAL_PROTOCOL_TEST(skipped.data() == input);
+    TRIAL_PROTOCOL_TEST_EQUAL(skipped.size(), sizeof(input) - 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 0);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 4);
+}
+
+void test_nested()
+{
+    // Skip inner group and continue with outer group
+    const value_type input[] = {
+        token::code::begin_array,
+        token::code::begin_array, 0x01, token::code::begin_array, token::code::end_array, token::code::end_array,
+        0x02,
+        token::code::end_array };
+    format::reader reader(input);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 1);
+    auto skipped = format::partial::skip(reader);
+    TRIAL_PROTOCOL_TEST(skipped.data() == input + 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(skipped.size(), 5);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 2);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+}
+
+void test_skip_to_end()
+{
+    const value_type input[] = {
+        token::code::begin_record, 0x01, token::code::string8, 0x01, 'a', token::code::end_record };
+    format::reader reader(input);
+    TRIAL_PROTOCOL_TEST(reader.skip_to_end());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_record);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 1);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 0);
+}
+
+void test_skip_to_end_value()
+{
+    const value_type input[] = { 0x01 };
+    format::reader reader(input);
+    TRIAL_PROTOCOL_TEST(!reader.skip_to_end());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 1);
+}
+
+void fail_missing_end()
+{
+    const value_type input[] = {
+        token::code::begin_array, 0x01, token::code::begin_record, token::code::end_record };
+    format::reader reader(input);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(format::partial::skip(reader),
+                                    format::error,
+                                    "expected end array bracket");
+}
+
+void fail_mismatched_end()
+{
+    const value_type input[] = {
+        token::code::begin_array, 0x01, token::code::end_record };
+    format::reader reader(input);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(format::partial::skip(reader),
+                                    format::error,
+                                    "expected end array bracket");
+}
+
+void fail_truncated_string()
+{
+    const value_type input[] = {
+        token::code::begin_array, token::code::string8, 0x05, 'a', token::code::end_array };
+    format::reader reader(input);
+    std::error_code error;
+    format::partial::skip(reader, error);
+    TRIAL_PROTOCOL_TEST(error);
+}
+
+void run()
+{
+    test_array();
+    test_nested();
+    test_skip_to_end();
+    test_skip_to_end_value();
+    fail_missing_end();
+    fail_mismatched_end();
+    fail_truncated_string();
+}
+
+} // namespace group_suite
+
+//-----------------------------------------------------------------------------
+// main
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    value_suite::run();
+    group_suite::run();
+
+    return boost::report_errors();
+}
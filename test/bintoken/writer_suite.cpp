@@ -456,6 +456,42 @@ void test_float64()
                                  std::equal_to<output_type>());
 }
 
+void test_int16_large()
+{
+    // Crosses the array8 length limit
+    std::vector<output_type> result;
+    format::writer writer(result);
+    std::vector<std::int16_t> data;
+    std::vector<output_type> expected = { token::code::array16_int16, 0x58, 0x02 };
+    for (int i = 0; i < 300; ++i)
+    {
+        data.push_back(std::int16_t(0x8100 + i));
+        expected.push_back(output_type(i));
+        expected.push_back(output_type(0x81 + (i >> 8)));
+    }
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.array(data.data(), data.size()), 603);
+    TRIAL_PROTOCOL_TEST_ALL_WITH(result.begin(), result.end(),
+                                 expected.begin(), expected.end(),
+                                 std::equal_to<output_type>());
+}
+
+void test_float64_large()
+{
+    std::vector<output_type> result;
+    format::writer writer(result);
+    std::vector<token::float64::type> data(100, 1.5);
+    std::vector<output_type> expected = { token::code::array16_float64, 0x20, 0x03 };
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        const output_type bytes[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x3F };
+        expected.insert(expected.end(), bytes, bytes + sizeof(bytes));
+    }
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.array(data.data(), data.size()), 803);
+    TRIAL_PROTOCOL_TEST_ALL_WITH(result.begin(), result.end(),
+                                 expected.begin(), expected.end(),
+                                 std::equal_to<output_type>());
+}
+
 void run()
 {
     test_int8_empty();
@@ -465,6 +501,8 @@ void run()
     test_int64();
     test_float32();
     test_float64();
+    test_int16_large();
+    test_float64_large();
 }
 
 } // namespace compact_suite
@@ -637,6 +675,58 @@ void run()
 
 } // namespace assoc_array_suite
 
+//-----------------------------------------------------------------------------
+// Static buffer
+//-----------------------------------------------------------------------------
+
+namespace static_suite
+{
+
+using vector_writer = format::static_writer<trial::protocol::buffer::vector<output_type, std::allocator<output_type>, trial::protocol::buffer::static_base<output_type>>>;
+
+void test_vector()
+{
+    std::vector<output_type> result;
+    vector_writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::begin_array>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(std::int16_t(0x1234)), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value("AB"), 4);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::end_array>(), 1);
+    output_type expected[] = { token::code::begin_array,
+                               token::code::int16, 0x34, 0x12,
+                               token::code::string8, 0x02, 'A', 'B',
+                               token::code::end_array };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expected, expected + sizeof(expected));
+}
+
+void test_reserve()
+{
+    std::vector<output_type> result;
+    vector_writer writer(result);
+    TRIAL_PROTOCOL_TEST(writer.reserve(100));
+    TRIAL_PROTOCOL_TEST(result.capacity() >= 100);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 0);
+}
+
+void fail_mismatched_end()
+{
+    std::vector<output_type> result;
+    vector_writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::begin_array>(), 1);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(writer.value<token::end_record>(),
+                                    format::error, "unexpected token");
+}
+
+void run()
+{
+    test_vector();
+    test_reserve();
+    fail_mismatched_end();
+}
+
+} // namespace static_suite
+
 //-----------------------------------------------------------------------------
 // main
 //-----------------------------------------------------------------------------
@@ -650,6 +740,7 @@ int main()
     record_suite::run();
     array_suite::run();
     assoc_array_suite::run();
+    static_suite::run();
 
     return boost::report_errors();
 }
@@ -8,7 +8,9 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <functional>
+#include <string>
 #include <vector>
 #include <array>
 #include <trial/protocol/buffer/vector.hpp>
@@ -44,6 +46,11 @@ public:
     {
         return Super::write(view);
     }
+
+    virtual value_type *claim(size_type size) override
+    {
+        return Super::claim(size);
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -89,11 +96,64 @@ void test_view()
                                   input.begin(), input.end());
 }
 
+void test_claim()
+{
+    std::vector<char> output;
+    vector_buffer<char> container(output);
+    TRIAL_PROTOCOL_TEST_EQUAL(container.grow(2), true);
+    TRIAL_PROTOCOL_TEST_NO_THROW(container.write('a'));
+    TRIAL_PROTOCOL_TEST_EQUAL(container.grow(4), true);
+    char *span = container.claim(4);
+    TRIAL_PROTOCOL_TEST(span != nullptr);
+    std::copy_n("lpha", 4, span);
+    std::string expected = "alpha";
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(output.begin(), output.end(),
+                                  expected.begin(), expected.end());
+}
+
+std::size_t count_reallocations(std::vector<char>& output, std::function<bool(std::size_t)> grow)
+{
+    std::size_t result = 0;
+    auto capacity = output.capacity();
+    for (int i = 0; i < 10000; ++i)
+    {
+        grow(1);
+        output.push_back('A');
+        if (output.capacity() != capacity)
+        {
+            capacity = output.capacity();
+            ++result;
+        }
+    }
+    return result;
+}
+
+void test_geometric_growth()
+{
+    std::vector<char> output;
+    vector_buffer<char> container(output);
+    auto reallocations = count_reallocations(output, [&container] (std::size_t size) { return container.grow(size); });
+    TRIAL_PROTOCOL_TEST(reallocations < 20);
+}
+
+void test_exact_growth()
+{
+    std::vector<char> output;
+    vector_buffer<char, buffer::vector<char, std::allocator<char>, buffer::base<char>, buffer::exact_growth>> container(output);
+    TRIAL_PROTOCOL_TEST_EQUAL(container.grow(100), true);
+    TRIAL_PROTOCOL_TEST(output.capacity() >= 100);
+    auto reallocations = count_reallocations(output, [&container] (std::size_t size) { return container.grow(size); });
+    TRIAL_PROTOCOL_TEST(reallocations > 1000);
+}
+
 void test()
 {
     test_empty();
     test_single();
     test_view();
+    test_claim();
+    test_geometric_growth();
+    test_exact_growth();
 }
 
 } // namespace vector_suite
@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <trial/protocol/core/mapped_file.hpp>
+#include <trial/protocol/json/reader.hpp>
+#include <trial/protocol/json/serialization.hpp>
+#include <trial/protocol/bintoken/reader.hpp>
+#include <trial/protocol/bintoken/serialization.hpp>
+#include <trial/protocol/core/detail/lightweight_test.hpp>
+
+using namespace trial::protocol;
+
+// Temporary file that is removed on destruction
+class scoped_file
+{
+public:
+    scoped_file(const std::string& content)
+        : path("mapped_file_suite.tmp")
+    {
+        std::ofstream output(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        output.write(content.data(), content.size());
+    }
+
+    ~scoped_file()
+    {
+        std::remove(path.c_str());
+    }
+
+    const std::string path;
+};
+
+//-----------------------------------------------------------------------------
+
+namespace file_suite
+{
+
+void test_content()
+{
+    scoped_file input("alpha");
+    core::mapped_file file(input.path);
+    TRIAL_PROTOCOL_TEST_EQUAL(file.size(), 5);
+    TRIAL_PROTOCOL_TEST(!file.empty());
+    TRIAL_PROTOCOL_TEST_EQUAL(std::string(file.data(), file.size()), "alpha");
+}
+
+void test_empty()
+{
+    scoped_file input("");
+    core::mapped_file file(input.path);
+    TRIAL_PROTOCOL_TEST_EQUAL(file.size(), 0);
+    TRIAL_PROTOCOL_TEST(file.empty());
+}
+
+void test_move()
+{
+    scoped_file input("alpha");
+    core::mapped_file file(input.path, core::mapped_file::access::random);
+    const char *data = file.data();
+    core::mapped_file other(std::move(file));
+    TRIAL_PROTOCOL_TEST(file.empty());
+    TRIAL_PROTOCOL_TEST(other.data() == data);
+    TRIAL_PROTOCOL_TEST_EQUAL(std::string(other.data(), other.size()), "alpha");
+    other.advise(core::mapped_file::access::normal);
+    TRIAL_PROTOCOL_TEST_EQUAL(std::string(other.data(), other.size()), "alpha");
+}
+
+void fail_missing()
+{
+    TRIAL_PROTOCOL_TEST_THROWS(core::mapped_file("mapped_file_suite.missing"),
+                               std::system_error);
+}
+
+void run()
+{
+    test_content();
+    test_empty();
+    test_move();
+    fail_missing();
+}
+
+} // namespace file_suite
+
+//-----------------------------------------------------------------------------
+
+namespace json_suite
+{
+
+void test_reader()
+{
+    scoped_file input("[true,42]");
+    core::mapped_file file(input.path);
+    json::reader reader(file);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.symbol(), json::token::symbol::begin_array);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<bool>(), true);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 42);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.symbol(), json::token::symbol::end_array);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.symbol(), json::token::symbol::end);
+}
+
+void test_iarchive()
+{
+    scoped_file input("[1,2,3]");
+    core::mapped_file file(input.path);
+    json::iarchive in(file);
+    std::vector<int> value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    std::vector<int> expect = { 1, 2, 3 };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(value.begin(), value.end(),
+                                  expect.begin(), expect.end());
+}
+
+void run()
+{
+    test_reader();
+    test_iarchive();
+}
+
+} // namespace json_suite
+
+//-----------------------------------------------------------------------------
+
+namespace bintoken_suite
+{
+
+void test_reader()
+{
+    const char content[] = { char(bintoken::token::code::begin_array), 0x01, 0x02, char(bintoken::token::code::end_array) };
+    scoped_file input(std::string(content, sizeof(content)));
+    core::mapped_file file(input.path);
+    bintoken::reader reader(file);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), bintoken::token::code::begin_array);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 1);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 2);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), bintoken::token::code::end_array);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+}
+
+void test_iarchive()
+{
+    const char content[] = { char(bintoken::token::code::array8_int16), 4, 0x01, 0x00, 0x02, 0x00 };
+    scoped_file input(std::string(content, sizeof(content)));
+    core::mapped_file file(input.path);
+    bintoken::iarchive in(file);
+    std::vector<std::int16_t> value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    std::vector<std::int16_t> expect = { 1, 2 };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(value.begin(), value.end(),
+                                  expect.begin(), expect.end());
+}
+
+void run()
+{
+    test_reader();
+    test_iarchive();
+}
+
+} // namespace bintoken_suite
+
+//-----------------------------------------------------------------------------
+// main
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    file_suite::run();
+    json_suite::run();
+    bintoken_suite::run();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,204 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <vector>
+#include <trial/protocol/core/detail/lightweight_test.hpp>
+#include <trial/dynamic/arena.hpp>
+#include <trial/dynamic/variable.hpp>
+
+using namespace trial::dynamic;
+
+//-----------------------------------------------------------------------------
+// Arena
+//-----------------------------------------------------------------------------
+
+namespace arena_suite
+{
+
+void test_empty()
+{
+    arena region;
+    TRIAL_PROTOCOL_TEST_EQUAL(region.capacity(), 0);
+}
+
+void test_allocate()
+{
+    arena region(256);
+    auto first = static_cast<char *>(region.allocate(8, 1));
+    auto second = static_cast<char *>(region.allocate(8, 1));
+    TRIAL_PROTOCOL_TEST_EQUAL(second - first, 8);
+    TRIAL_PROTOCOL_TEST_EQUAL(region.capacity(), 256);
+}
+
+void test_alignment()
+{
+    arena region(256);
+    region.allocate(1, 1);
+    auto pointer = region.allocate(8, 64);
+    TRIAL_PROTOCOL_TEST_EQUAL(reinterpret_cast<std::uintptr_t>(pointer) % 64, 0);
+}
+
+void test_grow()
+{
+    arena region(256);
+    region.allocate(200, 1);
+    region.allocate(200, 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(region.capacity(), 256 + 512);
+}
+
+void test_large()
+{
+    arena region(256);
+    region.allocate(10000, 1);
+    TRIAL_PROTOCOL_TEST(region.capacity() >= 10000);
+}
+
+void test_release()
+{
+    arena region(256);
+    region.allocate(200, 1);
+    region.allocate(200, 1);
+    region.release();
+    TRIAL_PROTOCOL_TEST_EQUAL(region.capacity(), 0);
+    region.allocate(200, 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(region.capacity(), 256);
+}
+
+void test_scope()
+{
+    TRIAL_PROTOCOL_TEST(arena::current() == nullptr);
+    arena outer;
+    {
+        arena::scope outer_scope(outer);
+        TRIAL_PROTOCOL_TEST(arena::current() == &outer);
+        arena inner;
+        {
+            arena::scope inner_scope(inner);
+            TRIAL_PROTOCOL_TEST(arena::current() == &inner);
+        }
+        TRIAL_PROTOCOL_TEST(arena::current() == &outer);
+    }
+    TRIAL_PROTOCOL_TEST(arena::current() == nullptr);
+}
+
+void run()
+{
+    test_empty();
+    test_allocate();
+    test_alignment();
+    test_grow();
+    test_large();
+    test_release();
+    test_scope();
+}
+
+} // namespace arena_suite
+
+//-----------------------------------------------------------------------------
+// Allocator
+//-----------------------------------------------------------------------------
+
+namespace allocator_suite
+{
+
+void test_heap()
+{
+    arena_allocator<int> allocator;
+    TRIAL_PROTOCOL_TEST(allocator.resource() == nullptr);
+    std::vector<int, arena_allocator<int>> data(allocator);
+    data.assign(100, 42);
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 100);
+}
+
+void test_explicit()
+{
+    arena region;
+    arena_allocator<int> allocator(region);
+    TRIAL_PROTOCOL_TEST(allocator.resource() == &region);
+    std::vector<int, arena_allocator<int>> data(allocator);
+    data.assign(100, 42);
+    TRIAL_PROTOCOL_TEST(region.capacity() >= 100 * sizeof(int));
+}
+
+void test_scoped()
+{
+    arena region;
+    arena::scope scope(region);
+    arena_allocator<int> allocator;
+    TRIAL_PROTOCOL_TEST(allocator.resource() == &region);
+}
+
+void test_rebind()
+{
+    arena region;
+    arena_allocator<int> allocator(region);
+    arena_allocator<char> other(allocator);
+    TRIAL_PROTOCOL_TEST(other.resource() == &region);
+    TRIAL_PROTOCOL_TEST(other == allocator);
+    TRIAL_PROTOCOL_TEST(other != arena_allocator<char>());
+}
+
+void test_variable()
+{
+    using variable_type = basic_variable<arena_allocator<char>>;
+    arena region;
+    {
+        arena::scope scope(region);
+        variable_type data = { 1, "a string that is longer than small string buffers", variable_type::map_type() };
+        data[2]["key"] = basic_array<arena_allocator<char>>::make({ 1, 2, 3 });
+        TRIAL_PROTOCOL_TEST(region.capacity() > 0);
+        TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 3);
+        TRIAL_PROTOCOL_TEST_EQUAL(data[2]["key"].size(), 3);
+    }
+}
+
+void test_variable_after_scope()
+{
+    // Containers keep their arena after the scope ends
+    using variable_type = basic_variable<arena_allocator<char>>;
+    arena region;
+    variable_type data;
+    {
+        arena::scope scope(region);
+        data = basic_array<arena_allocator<char>>::make({ 1, 2, 3 });
+    }
+    const auto capacity = region.capacity();
+    for (int i = 0; i < 1000; ++i)
+    {
+        data.insert(i);
+    }
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 1003);
+    TRIAL_PROTOCOL_TEST(region.capacity() > capacity);
+}
+
+void run()
+{
+    test_heap();
+    test_explicit();
+    test_scoped();
+    test_rebind();
+    test_variable();
+    test_variable_after_scope();
+}
+
+} // namespace allocator_suite
+
+//-----------------------------------------------------------------------------
+// main
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    arena_suite::run();
+    allocator_suite::run();
+
+    return boost::report_errors();
+}
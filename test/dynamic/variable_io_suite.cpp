@@ -51,7 +51,7 @@ void test_real()
     std::ostringstream stream;
     variable data(3.0);
     stream << data;
-    TRIAL_PROTOCOL_TEST_EQUAL(stream.str(), "3.00000000000000");
+    TRIAL_PROTOCOL_TEST_EQUAL(stream.str(), "3.0");
 }
 
 void test_string()
@@ -93,7 +93,7 @@ void test_array()
     std::ostringstream stream;
     variable data = array::make({ true, 2, 3.0, "alpha" });
     stream << data;
-    TRIAL_PROTOCOL_TEST_EQUAL(stream.str(), "[true,2,3.00000000000000,\"alpha\"]");
+    TRIAL_PROTOCOL_TEST_EQUAL(stream.str(), "[true,2,3.0,\"alpha\"]");
 }
 
 void test_map()
@@ -107,7 +107,7 @@ void test_map()
             { "delta", "hydrogen" }
         });
     stream << data;
-    TRIAL_PROTOCOL_TEST_EQUAL(stream.str(), "{\"alpha\":true,\"bravo\":2,\"charlie\":3.00000000000000,\"delta\":\"hydrogen\"}");
+    TRIAL_PROTOCOL_TEST_EQUAL(stream.str(), "{\"alpha\":true,\"bravo\":2,\"charlie\":3.0,\"delta\":\"hydrogen\"}");
 }
 
 void run()
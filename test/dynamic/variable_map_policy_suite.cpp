@@ -0,0 +1,453 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include <trial/protocol/core/detail/lightweight_test.hpp>
+#include <trial/dynamic/variable.hpp>
+#include <trial/dynamic/algorithm/find.hpp>
+
+using namespace trial::dynamic;
+
+template <typename MapPolicy>
+using variable_type = basic_variable<std::allocator<char>, MapPolicy>;
+
+template <typename MapPolicy>
+using map_type = basic_map<std::allocator<char>, MapPolicy>;
+
+// Keys in iteration order
+template <typename MapPolicy>
+std::vector<std::string> keys_of(const variable_type<MapPolicy>& data)
+{
+    std::vector<std::string> result;
+    for (auto it = data.key_begin(); it != data.key_end(); ++it)
+    {
+        result.push_back((*it).template value<std::string>());
+    }
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+// Common behavior
+//-----------------------------------------------------------------------------
+
+namespace common_suite
+{
+
+template <typename MapPolicy>
+void make_empty()
+{
+    auto data = map_type<MapPolicy>::make();
+    TRIAL_PROTOCOL_TEST(data.template is<map>());
+    TRIAL_PROTOCOL_TEST(data.empty());
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 0);
+}
+
+template <typename MapPolicy>
+void make_duplicate()
+{
+    // First occurrence wins as with std::map
+    auto data = map_type<MapPolicy>::make({ { "alpha", 1 }, { "bravo", 2 }, { "alpha", 3 } });
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 2);
+    TRIAL_PROTOCOL_TEST(data["alpha"] == 1);
+    TRIAL_PROTOCOL_TEST(data["bravo"] == 2);
+}
+
+template <typename MapPolicy>
+void subscript()
+{
+    variable_type<MapPolicy> data;
+    data["alpha"] = 1;
+    data["bravo"] = 2;
+    data["alpha"] = 3;
+    TRIAL_PROTOCOL_TEST(data.template is<map>());
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 2);
+    TRIAL_PROTOCOL_TEST(data["alpha"] == 3);
+    TRIAL_PROTOCOL_TEST(data["bravo"] == 2);
+}
+
+template <typename MapPolicy>
+void subscript_const()
+{
+    const auto data = map_type<MapPolicy>::make({ { "alpha", 1 }, { "bravo", 2 } });
+    TRIAL_PROTOCOL_TEST(data["bravo"] == 2);
+    TRIAL_PROTOCOL_TEST_THROWS(data["charlie"],
+                               std::out_of_range);
+}
+
+template <typename MapPolicy>
+void subscript_numeric_key()
+{
+    // Numbers with the same value are the same key
+    variable_type<MapPolicy> data = map_type<MapPolicy>::make();
+    data[variable_type<MapPolicy>(1)] = "alpha";
+    data[variable_type<MapPolicy>(1.0)] = "bravo";
+    data[variable_type<MapPolicy>(true)] = "charlie";
+    data[variable_type<MapPolicy>(2U)] = "delta";
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 2);
+    TRIAL_PROTOCOL_TEST(data[variable_type<MapPolicy>(1)] == "charlie");
+    TRIAL_PROTOCOL_TEST(data[variable_type<MapPolicy>(2.0)] == "delta");
+}
+
+template <typename MapPolicy>
+void insert_pair()
+{
+    variable_type<MapPolicy> data = map_type<MapPolicy>::make();
+    auto where = data.insert({ "alpha", 1 });
+    TRIAL_PROTOCOL_TEST(where.key() == "alpha");
+    TRIAL_PROTOCOL_TEST(*where == 1);
+    data.insert({ "bravo", 2 });
+    data.insert({ "alpha", 3 });
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 2);
+    TRIAL_PROTOCOL_TEST(data["alpha"] == 1);
+}
+
+template <typename MapPolicy>
+void insert_range()
+{
+    variable_type<MapPolicy> data = map_type<MapPolicy>::make({ { "alpha", 1 } });
+    std::map<std::string, int> input = { { "alpha", 2 }, { "bravo", 3 }, { "charlie", 4 } };
+    data.insert(input.begin(), input.end());
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 3);
+    TRIAL_PROTOCOL_TEST(data["alpha"] == 1);
+    TRIAL_PROTOCOL_TEST(data["charlie"] == 4);
+}
+
+template <typename MapPolicy>
+void erase_iterator()
+{
+    auto data = map_type<MapPolicy>::make({ { "alpha", 1 }, { "bravo", 2 }, { "charlie", 3 } });
+    auto where = data.begin();
+    while (where.key() != "bravo")
+    {
+        ++where;
+    }
+    auto next = data.erase(where);
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 2);
+    TRIAL_PROTOCOL_TEST(next == data.end() || next.key() != "bravo");
+    TRIAL_PROTOCOL_TEST(key::find(data, "bravo") == data.key_end());
+    TRIAL_PROTOCOL_TEST(data["alpha"] == 1);
+    TRIAL_PROTOCOL_TEST(data["charlie"] == 3);
+}
+
+template <typename MapPolicy>
+void erase_all()
+{
+    auto data = map_type<MapPolicy>::make({ { "alpha", 1 }, { "bravo", 2 }, { "charlie", 3 } });
+    auto where = data.begin();
+    while (where != data.end())
+    {
+        where = data.erase(where);
+    }
+    TRIAL_PROTOCOL_TEST(data.empty());
+    data["delta"] = 4;
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 1);
+}
+
+template <typename MapPolicy>
+void erase_many()
+{
+    variable_type<MapPolicy> data = map_type<MapPolicy>::make();
+    for (int i = 0; i < 1000; ++i)
+    {
+        data[variable_type<MapPolicy>(i)] = i * 2;
+    }
+    for (auto where = data.begin(); where != data.end();)
+    {
+        if (where.key().template value<int>() % 3 == 0)
+            where = data.erase(where);
+        else
+            ++where;
+    }
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 666);
+    const auto& view = data;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const bool expected = (i % 3 != 0);
+        const bool found = (key::find(view, i) != view.key_end());
+        TRIAL_PROTOCOL_TEST_EQUAL(found, expected);
+        if (found)
+        {
+            TRIAL_PROTOCOL_TEST(view[variable_type<MapPolicy>(i)] == i * 2);
+        }
+    }
+}
+
+template <typename MapPolicy>
+void erase_range()
+{
+    variable_type<MapPolicy> data = map_type<MapPolicy>::make();
+    for (int i = 0; i < 1000; ++i)
+    {
+        data[variable_type<MapPolicy>(i)] = i * 2;
+    }
+    std::vector<int> before;
+    for (auto where = data.key_begin(); where != data.key_end(); ++where)
+    {
+        before.push_back((*where).template value<int>());
+    }
+    auto first = std::next(data.begin(), 100);
+    auto last = std::next(data.begin(), 900);
+    auto next = data.erase(first, last);
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 200);
+    TRIAL_PROTOCOL_TEST(next.key() == before[900]);
+    const auto& view = data;
+    for (std::size_t i = 0; i < before.size(); ++i)
+    {
+        const bool expected = (i < 100) || (i >= 900);
+        const bool found = (key::find(view, before[i]) != view.key_end());
+        TRIAL_PROTOCOL_TEST_EQUAL(found, expected);
+        if (found)
+        {
+            TRIAL_PROTOCOL_TEST(view[variable_type<MapPolicy>(before[i])] == before[i] * 2);
+        }
+    }
+    data[variable_type<MapPolicy>(1000)] = 2000;
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 201);
+}
+
+template <typename MapPolicy>
+void iterate_values()
+{
+    auto data = map_type<MapPolicy>::make({ { "alpha", 1 }, { "bravo", 2 }, { "charlie", 3 } });
+    int sum = 0;
+    for (const auto& value : data)
+    {
+        sum += value.template value<int>();
+    }
+    TRIAL_PROTOCOL_TEST_EQUAL(sum, 6);
+}
+
+template <typename MapPolicy>
+void iterate_reverse()
+{
+    auto data = map_type<MapPolicy>::make({ { "alpha", 1 }, { "bravo", 2 }, { "charlie", 3 } });
+    std::vector<std::string> forward;
+    for (auto it = data.begin(); it != data.end(); ++it)
+    {
+        forward.push_back(it.key().template value<std::string>());
+    }
+    std::vector<std::string> backward;
+    for (auto it = data.end(); it != data.begin();)
+    {
+        --it;
+        backward.push_back(it.key().template value<std::string>());
+    }
+    std::reverse(backward.begin(), backward.end());
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(forward.begin(), forward.end(),
+                                  backward.begin(), backward.end());
+}
+
+template <typename MapPolicy>
+void compare_equal()
+{
+    auto first = map_type<MapPolicy>::make({ { "alpha", 1 }, { "bravo", 2 } });
+    auto second = first;
+    TRIAL_PROTOCOL_TEST(first == second);
+    second["bravo"] = 3;
+    TRIAL_PROTOCOL_TEST(first != second);
+    second["bravo"] = 2;
+    second["charlie"] = 3;
+    TRIAL_PROTOCOL_TEST(first != second);
+}
+
+template <typename MapPolicy>
+void nested()
+{
+    variable_type<MapPolicy> data;
+    data["alpha"]["bravo"] = 1;
+    data["alpha"]["charlie"] = basic_array<std::allocator<char>, MapPolicy>::make({ 1, 2, 3 });
+    TRIAL_PROTOCOL_TEST_EQUAL(data.size(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(data["alpha"].size(), 2);
+    TRIAL_PROTOCOL_TEST(data["alpha"]["bravo"] == 1);
+}
+
+template <typename MapPolicy>
+void run_policy()
+{
+    make_empty<MapPolicy>();
+    make_duplicate<MapPolicy>();
+    subscript<MapPolicy>();
+    subscript_const<MapPolicy>();
+    subscript_numeric_key<MapPolicy>();
+    insert_pair<MapPolicy>();
+    insert_range<MapPolicy>();
+    erase_iterator<MapPolicy>();
+    erase_all<MapPolicy>();
+    erase_many<MapPolicy>();
+    erase_range<MapPolicy>();
+    iterate_values<MapPolicy>();
+    iterate_reverse<MapPolicy>();
+    compare_equal<MapPolicy>();
+    nested<MapPolicy>();
+}
+
+void run()
+{
+    run_policy<ordered_map_policy>();
+    run_policy<flat_map_policy>();
+    run_policy<hash_map_policy>();
+}
+
+} // namespace common_suite
+
+//-----------------------------------------------------------------------------
+// Policy specific behavior
+//-----------------------------------------------------------------------------
+
+namespace order_suite
+{
+
+void flat_sorted()
+{
+    auto data = map_type<flat_map_policy>::make({ { "charlie", 3 }, { "alpha", 1 }, { "bravo", 2 } });
+    data["delta"] = 4;
+    data["aardvark"] = 0;
+    std::vector<std::string> expect = { "aardvark", "alpha", "bravo", "charlie", "delta" };
+    auto result = keys_of(data);
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void hash_insertion_order()
+{
+    auto data = map_type<hash_map_policy>::make({ { "charlie", 3 }, { "alpha", 1 }, { "bravo", 2 } });
+    data["delta"] = 4;
+    data["aardvark"] = 0;
+    std::vector<std::string> expect = { "charlie", "alpha", "bravo", "delta", "aardvark" };
+    auto result = keys_of(data);
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void hash_erase_order()
+{
+    auto data = map_type<hash_map_policy>::make({ { "charlie", 3 }, { "alpha", 1 }, { "bravo", 2 } });
+    data.erase(std::next(data.begin()));
+    std::vector<std::string> expect = { "charlie", "bravo" };
+    auto result = keys_of(data);
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void hash_erase_ends()
+{
+    auto data = map_type<hash_map_policy>::make({ { "alpha", 1 }, { "bravo", 2 }, { "charlie", 3 }, { "delta", 4 } });
+    data.erase(data.begin());
+    data.erase(std::prev(data.end()));
+    data["echo"] = 5;
+    std::vector<std::string> expect = { "bravo", "charlie", "echo" };
+    auto result = keys_of(data);
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+    const auto& view = data;
+    TRIAL_PROTOCOL_TEST(key::find(view, "alpha") == view.key_end());
+    TRIAL_PROTOCOL_TEST(key::find(view, "delta") == view.key_end());
+    TRIAL_PROTOCOL_TEST(view["bravo"] == 2);
+    TRIAL_PROTOCOL_TEST(view["charlie"] == 3);
+    TRIAL_PROTOCOL_TEST(view["echo"] == 5);
+}
+
+void hash_equal_unordered()
+{
+    auto first = map_type<hash_map_policy>::make({ { "alpha", 1 }, { "bravo", 2 } });
+    auto second = map_type<hash_map_policy>::make({ { "bravo", 2 }, { "alpha", 1 } });
+    TRIAL_PROTOCOL_TEST(first == second);
+}
+
+void hash_less_unordered()
+{
+    using hash_type = variable_type<hash_map_policy>::map_type;
+    hash_type first = { { "alpha", 1 }, { "bravo", 2 } };
+    hash_type second = { { "bravo", 2 }, { "alpha", 1 } };
+    TRIAL_PROTOCOL_TEST(first == second);
+    TRIAL_PROTOCOL_TEST(!(first < second));
+    TRIAL_PROTOCOL_TEST(!(second < first));
+
+    hash_type third = { { "bravo", 3 }, { "alpha", 1 } };
+    TRIAL_PROTOCOL_TEST(first < third);
+    TRIAL_PROTOCOL_TEST(!(third < first));
+    hash_type fourth = { { "charlie", 0 }, { "alpha", 1 } };
+    TRIAL_PROTOCOL_TEST(third < fourth);
+    TRIAL_PROTOCOL_TEST(!(fourth < third));
+}
+
+void run()
+{
+    flat_sorted();
+    hash_insertion_order();
+    hash_erase_order();
+    hash_erase_ends();
+    hash_equal_unordered();
+    hash_less_unordered();
+}
+
+} // namespace order_suite
+
+//-----------------------------------------------------------------------------
+// Hash
+//-----------------------------------------------------------------------------
+
+namespace hash_suite
+{
+
+void hash_numbers()
+{
+    hash<variable> hasher;
+    TRIAL_PROTOCOL_TEST_EQUAL(hasher(variable(1)), hasher(variable(1.0)));
+    TRIAL_PROTOCOL_TEST_EQUAL(hasher(variable(1)), hasher(variable(true)));
+    TRIAL_PROTOCOL_TEST_EQUAL(hasher(variable(1)), hasher(variable(1ULL)));
+    TRIAL_PROTOCOL_TEST_EQUAL(hasher(variable(-1)), hasher(variable(-1.0f)));
+    TRIAL_PROTOCOL_TEST_EQUAL(hasher(variable(0.5)), hasher(variable(0.5f)));
+    TRIAL_PROTOCOL_TEST(hasher(variable(1)) != hasher(variable(2)));
+}
+
+void hash_strings()
+{
+    hash<variable> hasher;
+    TRIAL_PROTOCOL_TEST_EQUAL(hasher(variable("alpha")), hasher(variable(std::string("alpha"))));
+    TRIAL_PROTOCOL_TEST(hasher(variable("alpha")) != hasher(variable("bravo")));
+}
+
+void hash_containers()
+{
+    hash<variable> hasher;
+    TRIAL_PROTOCOL_TEST_EQUAL(hasher(array::make({ 1, 2 })), hasher(array::make({ 1.0, 2.0 })));
+    TRIAL_PROTOCOL_TEST(hasher(array::make({ 1, 2 })) != hasher(array::make({ 2, 1 })));
+
+    hash<variable_type<hash_map_policy>> map_hasher;
+    auto first = map_type<hash_map_policy>::make({ { "alpha", 1 }, { "bravo", 2 } });
+    auto second = map_type<hash_map_policy>::make({ { "bravo", 2 }, { "alpha", 1 } });
+    TRIAL_PROTOCOL_TEST_EQUAL(map_hasher(first), map_hasher(second));
+}
+
+void run()
+{
+    hash_numbers();
+    hash_strings();
+    hash_containers();
+}
+
+} // namespace hash_suite
+
+//-----------------------------------------------------------------------------
+// main
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    common_suite::run();
+    order_suite::run();
+    hash_suite::run();
+
+    return boost::report_errors();
+}
@@ -224,11 +224,87 @@ void run()
 
 //-----------------------------------------------------------------------------
 
+namespace rollback_suite
+{
+
+void rollback_string()
+{
+    json::chunk_reader reader;
+    TRIAL_PROTOCOL_TEST(reader.next("[\"alpha\\nbravo\",\"char"));
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::string);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    // Retains old state including escaped string
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::string);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.literal(), "\"alpha\\nbravo\"");
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), "alpha\nbravo");
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.tail(), ",\"char");
+    TRIAL_PROTOCOL_TEST(reader.next(",\"charlie\"]"));
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), "charlie");
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+}
+
+void rollback_key()
+{
+    json::chunk_reader reader;
+    TRIAL_PROTOCOL_TEST(reader.next("{\"alpha\":tr"));
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_object);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::key);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::key); // Retains old state
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), "alpha");
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 1);
+    TRIAL_PROTOCOL_TEST(reader.next(":true}"));
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::true_value);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_object);
+}
+
+void rollback_number()
+{
+    json::chunk_reader reader;
+    TRIAL_PROTOCOL_TEST(reader.next("[1.5,2"));
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::real);
+    TRIAL_PROTOCOL_TEST(!reader.next()); // Number could continue
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::real); // Retains old state
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<double>(), 1.5);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.tail(), ",2");
+}
+
+void rollback_begin()
+{
+    json::chunk_reader reader;
+    TRIAL_PROTOCOL_TEST(reader.next("[[\"al"));
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 2);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array); // Retains old state
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.tail(), "\"al");
+}
+
+void run()
+{
+    rollback_string();
+    rollback_key();
+    rollback_number();
+    rollback_begin();
+}
+
+} // namespace rollback_suite
+
+//-----------------------------------------------------------------------------
+
 int main()
 {
     string_suite::run();
     number_suite::run();
     whitespace_suite::run();
+    rollback_suite::run();
 
     return boost::report_errors();
 }
@@ -182,6 +182,13 @@ void test_newlines()
     TRIAL_PROTOCOL_TEST_EQUAL(decoder.code(), token::code::end);
 }
 
+void test_mixed_long()
+{
+    const char input[] = " \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n null";
+    decoder_type decoder(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(decoder.code(), token::code::null);
+}
+
 void test_junk()
 {
     const char input[] = "n true";
@@ -198,6 +205,7 @@ void run()
     test_tabs();
     test_carriage_returns();
     test_newlines();
+    test_mixed_long();
     test_junk();
 }
 
@@ -656,6 +664,16 @@ void fail_minus_alpha()
     TRIAL_PROTOCOL_TEST_EQUAL(decoder.literal(), "-");
 }
 
+void fail_slash_long()
+{
+    const char input[] = "1234/6789012345678901234567890123456789012345678901234567890123456789";
+    decoder_type decoder(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(decoder.code(), token::code::integer);
+    TRIAL_PROTOCOL_TEST_EQUAL(decoder.literal(), "1234");
+    decoder.next();
+    TRIAL_PROTOCOL_TEST_EQUAL(decoder.code(), token::code::error_unexpected_token);
+}
+
 void fail_too_large()
 {
     const char input[] = "10000000000000000000";
@@ -1209,6 +1227,7 @@ void run()
     fail_minus();
     fail_minus_white();
     fail_minus_alpha();
+    fail_slash_long();
     fail_too_large();
     fail_too_large2();
     fail_as_float();
@@ -1380,6 +1399,112 @@ void test_one_exp_minus_one()
     TRIAL_PROTOCOL_TEST_EQUAL(decoder.code(), token::code::end);
 }
 
+void test_nearest()
+{
+    {
+        const char input[] = "0.1";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), 0.1);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<float>(), 0.1f);
+    }
+    {
+        const char input[] = "-65.613616999999977";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), -65.613616999999977);
+    }
+    {
+        const char input[] = "43.420273000000009";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), 43.420273000000009);
+    }
+    {
+        const char input[] = "1.7976931348623157e308";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), std::numeric_limits<double>::max());
+    }
+    {
+        const char input[] = "2.2250738585072014e-308";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), std::numeric_limits<double>::min());
+    }
+    {
+        const char input[] = "3.4028234663852886e38";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<float>(), std::numeric_limits<float>::max());
+    }
+}
+
+void test_halfway()
+{
+    // Exactly halfway between 2^53 and 2^53 + 2 rounds to even
+    {
+        const char input[] = "9007199254740993.0";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), 9007199254740992.0);
+    }
+    // Slightly above halfway rounds up
+    {
+        const char input[] = "9007199254740993.0000000000000000000000000001";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), 9007199254740994.0);
+    }
+    {
+        const char input[] = "9007199254740995.0";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), 9007199254740996.0);
+    }
+}
+
+void test_subnormal()
+{
+    {
+        const char input[] = "4.9406564584124654e-324";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), std::numeric_limits<double>::denorm_min());
+    }
+    // Halfway between zero and smallest subnormal rounds to even
+    {
+        const char input[] = "2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989828234772285886546332835517796989819938739800539093906315035659515570226392290858392449105184435931802849936536152500319370457678249219365623669863658480757001585769269903706311928279558551332927834338409351978015531246597263579574622766465272827220056374006485499977096599470454020828166226237857393450736339007967761930577506740176324673600968951340535537458516661134223766678604162159680461914467291840300530057530849048765391711386591646239524912623653881879636239373280423891018672348497668235089863388587925628302755995657524455507255189313690836254779186948667994968324049705821028513185451396213837722826145437693412532098591327667236328125e-324";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), 0.0);
+    }
+    {
+        const char input[] = "2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989828234772285886546332835517796989819938739800539093906315035659515570226392290858392449105184435931802849936536152500319370457678249219365623669863658480757001585769269903706311928279558551332927834338409351978015531246597263579574622766465272827220056374006485499977096599470454020828166226237857393450736339007967761930577506740176324673600968951340535537458516661134223766678604162159680461914467291840300530057530849048765391711386591646239524912623653881879636239373280423891018672348497668235089863388587925628302755995657524455507255189313690836254779186948667994968324049705821028513185451396213837722826145437693412532098591327667236328125001e-324";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), std::numeric_limits<double>::denorm_min());
+    }
+}
+
+void test_overflow()
+{
+    {
+        const char input[] = "1.7976931348623159e308";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), std::numeric_limits<double>::infinity());
+    }
+    {
+        const char input[] = "-1e99999999999";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), -std::numeric_limits<double>::infinity());
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<float>(), -std::numeric_limits<float>::infinity());
+    }
+}
+
+void test_underflow()
+{
+    {
+        const char input[] = "1e-400";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), 0.0);
+    }
+    {
+        const char input[] = "1e-99999999999";
+        decoder_type decoder(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<double>(), 0.0);
+        TRIAL_PROTOCOL_TEST_EQUAL(decoder.real_value<float>(), 0.0f);
+    }
+}
+
 void fail_missing_fraction()
 {
     const char input[] = "0.";
@@ -1482,6 +1607,11 @@ void run()
     test_one_dot_exp_one();
     test_one_exp_plus_one();
     test_one_exp_minus_one();
+    test_nearest();
+    test_halfway();
+    test_subnormal();
+    test_overflow();
+    test_underflow();
     fail_missing_fraction();
     fail_missing_fraction_white();
     fail_missing_exponent();
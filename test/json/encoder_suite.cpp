@@ -8,6 +8,7 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <cstdlib>
 #include <sstream>
 #include <limits>
 #include <functional>
@@ -363,16 +364,16 @@ void test_float_zero()
 {
     std::ostringstream result;
     encoder_type encoder(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(0.0f), 7);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.00000");
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(0.0f), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.0");
 }
 
 void test_double_zero()
 {
     std::ostringstream result;
     encoder_type encoder(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(0.0), 16);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.00000000000000");
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(0.0), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.0");
 }
 
 void test_unsigned_double_zero()
@@ -380,8 +381,8 @@ void test_unsigned_double_zero()
 #if defined(TRIAL_PROTOCOL_JSON_WITH_UNSIGNED_CHAR)
     unsigned_ostringstream buffer;
     unsigned_encoder_type encoder(buffer);
-    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(0.0), 16);
-    unsigned char expect[] = { '0', '.', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0' };
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(0.0), 3);
+    unsigned char expect[] = { '0', '.', '0' };
     unsigned_string result = buffer.str();
     TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
                                   expect, expect + sizeof(expect));
@@ -392,80 +393,196 @@ void test_double_one()
 {
     std::ostringstream result;
     encoder_type encoder(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(1.0), 16);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.00000000000000");
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(1.0), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.0");
 }
 
 void test_double_minus_one()
 {
     std::ostringstream result;
     encoder_type encoder(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(-1.0), 17);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "-1.00000000000000");
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(-1.0), 4);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "-1.0");
 }
 
 void test_double_half()
 {
     std::ostringstream result;
     encoder_type encoder(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(0.5), 17);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.500000000000000");
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(0.5), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.5");
 }
 
 void test_double_minus_half()
 {
     std::ostringstream result;
     encoder_type encoder(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(-0.5), 18);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "-0.500000000000000");
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(-0.5), 4);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "-0.5");
 }
 
 void test_double_e_100()
 {
     std::ostringstream result;
     encoder_type encoder(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(1e100), 21);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.00000000000000e+100");
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(1e100), 6);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1e+100");
 }
 
 void test_double_e_minus_100()
 {
     std::ostringstream result;
     encoder_type encoder(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(1e-100), 21);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.00000000000000e-100");
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(1e-100), 6);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1e-100");
 }
 
 void test_float_max()
 {
     std::ostringstream result;
     encoder_type encoder(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(std::numeric_limits<float>::max()), 11);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "3.40282e+38");
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(std::numeric_limits<float>::max()), 13);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "3.4028235e+38");
 }
 
 void test_double_max()
 {
     std::ostringstream result;
     encoder_type encoder(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(std::numeric_limits<double>::max()), 21);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.79769313486232e+308");
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(std::numeric_limits<double>::max()), 23);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.7976931348623157e+308");
 }
 
 void test_float_min()
 {
     std::ostringstream result;
     encoder_type encoder(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(std::numeric_limits<float>::min()), 11);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.17549e-38");
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(std::numeric_limits<float>::min()), 13);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.1754944e-38");
 }
 
 void test_double_min()
 {
     std::ostringstream result;
     encoder_type encoder(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(std::numeric_limits<double>::min()), 21);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "2.22507385850720e-308");
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(std::numeric_limits<double>::min()), 23);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "2.2250738585072014e-308");
+}
+
+void test_double_minus_zero()
+{
+    std::ostringstream result;
+    encoder_type encoder(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(-0.0), 4);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "-0.0");
+}
+
+void test_float_tenth()
+{
+    std::ostringstream result;
+    encoder_type encoder(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(0.1f), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.1");
+}
+
+void test_double_tenth()
+{
+    std::ostringstream result;
+    encoder_type encoder(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(0.1), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.1");
+}
+
+void test_double_third()
+{
+    std::ostringstream result;
+    encoder_type encoder(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(1.0 / 3.0), 18);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.3333333333333333");
+}
+
+void test_double_fraction()
+{
+    std::ostringstream result;
+    encoder_type encoder(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(123.456), 7);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "123.456");
+}
+
+void test_double_small()
+{
+    {
+        std::ostringstream result;
+        encoder_type encoder(result);
+        TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(0.00012), 7);
+        TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.00012");
+    }
+    {
+        std::ostringstream result;
+        encoder_type encoder(result);
+        TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(0.000012), 6);
+        TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.2e-5");
+    }
+}
+
+void test_double_large()
+{
+    {
+        std::ostringstream result;
+        encoder_type encoder(result);
+        TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(1e16), 19);
+        TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "10000000000000000.0");
+    }
+    {
+        std::ostringstream result;
+        encoder_type encoder(result);
+        TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(1e17), 5);
+        TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1e+17");
+    }
+    {
+        std::ostringstream result;
+        encoder_type encoder(result);
+        TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(1.5e300), 8);
+        TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.5e+300");
+    }
+}
+
+void test_double_denorm_min()
+{
+    std::ostringstream result;
+    encoder_type encoder(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(std::numeric_limits<double>::denorm_min()), 6);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "5e-324");
+}
+
+void test_long_double_one()
+{
+    std::ostringstream result;
+    encoder_type encoder(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(1.0L), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.0");
+}
+
+void test_long_double_half()
+{
+    std::ostringstream result;
+    encoder_type encoder(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(0.5L), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.5");
+}
+
+void test_long_double_tenth()
+{
+    // Shortest digits of the double are not enough for extended precision
+    const long double value = static_cast<long double>(0.1);
+    std::ostringstream result;
+    encoder_type encoder(result);
+    encoder.value(value);
+    TRIAL_PROTOCOL_TEST_EQUAL(std::strtold(result.str().c_str(), nullptr), value);
+    if (std::numeric_limits<long double>::digits > std::numeric_limits<double>::digits)
+    {
+        TRIAL_PROTOCOL_TEST(result.str() != "0.1");
+    }
 }
 
 void test_float_infinity()
@@ -531,6 +648,17 @@ void run()
     test_double_max();
     test_float_min();
     test_double_min();
+    test_double_minus_zero();
+    test_float_tenth();
+    test_double_tenth();
+    test_double_third();
+    test_double_fraction();
+    test_double_small();
+    test_double_large();
+    test_double_denorm_min();
+    test_long_double_one();
+    test_long_double_half();
+    test_long_double_tenth();
     test_float_infinity();
     test_double_infinity();
     test_float_minus_infinity();
@@ -654,6 +782,67 @@ void test_escape_tab()
     TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "\"\\t\"");
 }
 
+void test_long()
+{
+    std::ostringstream result;
+    const std::string text(200, 'x');
+    encoder_type encoder(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(text), 202);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "\"" + text + "\"");
+}
+
+void test_long_escape()
+{
+    // Escape characters at different vector positions
+    std::string text(100, 'x');
+    std::string expect(100, 'x');
+    for (std::size_t position : { 99, 70, 63, 31, 15, 0 })
+    {
+        text.insert(position, "\"\n/");
+        expect.insert(position, "\\\"\\n\\/");
+    }
+    std::ostringstream result;
+    encoder_type encoder(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(text), 2 + 118 + 18);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "\"" + expect + "\"");
+}
+
+void test_long_utf8()
+{
+    // Multi-byte characters straddling vector boundaries
+    std::string text;
+    for (int i = 0; i < 40; ++i)
+    {
+        text += "\xC3\xA6\xE2\x82\xAC";
+    }
+    std::ostringstream result;
+    encoder_type encoder(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(text), 202);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "\"" + text + "\"");
+}
+
+void sanitize_long()
+{
+    // Invalid character after a long valid prefix
+    const std::string prefix = std::string(60, 'x') + "\xE2\x82\xAC/";
+    std::ostringstream result;
+    encoder_type encoder(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(prefix + "\xC3" + prefix), 2 + 64 + 1 + 64 + 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(),
+                              "\"" + std::string(60, 'x') + "\xE2\x82\xAC\\/?"
+                              + std::string(59, 'x') + "\xE2\x82\xAC\\/\"");
+}
+
+void sanitize_long_truncated()
+{
+    std::string text(64, 'x');
+    text += "\xE2\x82";
+    std::ostringstream result;
+    encoder_type encoder(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(encoder.value(text), 68);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "\"" + std::string(64, 'x') + "?\"");
+}
+
 void sanitize_01111111()
 {
     std::ostringstream result;
@@ -834,6 +1023,9 @@ void run()
     test_escape_newline();
     test_escape_carriage_return();
     test_escape_tab();
+    test_long();
+    test_long_escape();
+    test_long_utf8();
 
     sanitize_01111111();
     sanitize_10000000();
@@ -855,6 +1047,8 @@ void run()
     sanitize_11100000_10000000_10111111();
     sanitize_11100000_10000000_11000000();
     sanitize_11100000_10000000_11111111();
+    sanitize_long();
+    sanitize_long_truncated();
 }
 
 } // namespace string_suite
@@ -90,7 +90,7 @@ void format_real()
 {
     variable data(3.0);
     auto result = json::format<std::string>(data);
-    TRIAL_PROTOCOL_TEST_EQUAL(result, "3.00000000000000");
+    TRIAL_PROTOCOL_TEST_EQUAL(result, "3.0");
 }
 
 void format_string()
@@ -135,7 +135,7 @@ void format_array()
 {
     variable data = { null, true, 2, 3.0, "alpha" };
     auto result = json::format<std::string>(data);
-    TRIAL_PROTOCOL_TEST_EQUAL(result, "[null,true,2,3.00000000000000,\"alpha\"]");
+    TRIAL_PROTOCOL_TEST_EQUAL(result, "[null,true,2,3.0,\"alpha\"]");
 }
 
 void format_empty_map()
@@ -156,7 +156,7 @@ void format_map()
             { "echo", "hydrogen" }
         };
     auto result = json::format<std::string>(data);
-    TRIAL_PROTOCOL_TEST_EQUAL(result, "{\"alpha\":null,\"bravo\":true,\"charlie\":2,\"delta\":3.00000000000000,\"echo\":\"hydrogen\"}");
+    TRIAL_PROTOCOL_TEST_EQUAL(result, "{\"alpha\":null,\"bravo\":true,\"charlie\":2,\"delta\":3.0,\"echo\":\"hydrogen\"}");
 }
 
 void run()
@@ -223,7 +223,7 @@ void format_real()
     writer.value<json::token::begin_array>();
     json::partial::format(data, writer);
     writer.value<json::token::end_array>();
-    TRIAL_PROTOCOL_TEST_EQUAL(result, "[3.00000000000000]");
+    TRIAL_PROTOCOL_TEST_EQUAL(result, "[3.0]");
 }
 
 void format_string()
@@ -278,7 +278,7 @@ void format_array()
     writer.value<json::token::begin_array>();
     json::partial::format(data, writer);
     writer.value<json::token::end_array>();
-    TRIAL_PROTOCOL_TEST_EQUAL(result, "[[null,true,2,3.00000000000000,\"alpha\"]]");
+    TRIAL_PROTOCOL_TEST_EQUAL(result, "[[null,true,2,3.0,\"alpha\"]]");
 }
 
 void format_map()
@@ -296,7 +296,7 @@ void format_map()
     writer.value<json::token::begin_array>();
     json::partial::format(data, writer);
     writer.value<json::token::end_array>();
-    TRIAL_PROTOCOL_TEST_EQUAL(result, "[{\"alpha\":null,\"bravo\":true,\"charlie\":2,\"delta\":3.00000000000000,\"echo\":\"hydrogen\"}]");
+    TRIAL_PROTOCOL_TEST_EQUAL(result, "[{\"alpha\":null,\"bravo\":true,\"charlie\":2,\"delta\":3.0,\"echo\":\"hydrogen\"}]");
 }
 
 void run()
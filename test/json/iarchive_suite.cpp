@@ -9,6 +9,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <sstream>
+#include <string>
+#include <vector>
 #include <trial/protocol/json/serialization.hpp>
 #include <trial/protocol/core/detail/lightweight_test.hpp>
 
@@ -539,6 +541,110 @@ void fail_mismatching_end()
                                     json::error, "expected end array bracket");
 }
 
+void test_int_empty()
+{
+    const char input[] = "[]";
+    json::iarchive in(input);
+    std::vector<int> value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.size(), 0U);
+}
+
+void test_int_many()
+{
+    const char input[] = "[1, 2 ,3,-4]";
+    json::iarchive in(input);
+    std::vector<int> value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    std::vector<int> expect = { 1, 2, 3, -4 };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(value.begin(), value.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_double_many()
+{
+    const char input[] = "[1.5,-2,3e2,0.25]";
+    json::iarchive in(input);
+    std::vector<double> value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    std::vector<double> expect = { 1.5, -2.0, 300.0, 0.25 };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(value.begin(), value.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_float_large()
+{
+    std::string input = "[";
+    std::vector<float> expect;
+    for (int i = 0; i < 10000; ++i)
+    {
+        if (i > 0)
+            input += ",";
+        input += std::to_string(i) + ".5";
+        expect.push_back(i + 0.5f);
+    }
+    input += "]";
+    json::iarchive in(input);
+    std::vector<float> value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(value.begin(), value.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_int_nested()
+{
+    const char input[] = "[[1,2],[],[3]]";
+    json::iarchive in(input);
+    std::vector< std::vector<int> > value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.size(), 3U);
+    TRIAL_PROTOCOL_TEST_EQUAL(value[0].size(), 2U);
+    TRIAL_PROTOCOL_TEST_EQUAL(value[0][1], 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(value[1].size(), 0U);
+    TRIAL_PROTOCOL_TEST_EQUAL(value[2].size(), 1U);
+    TRIAL_PROTOCOL_TEST_EQUAL(value[2][0], 3);
+}
+
+void fail_int_mixed()
+{
+    const char input[] = "[1,2,\"alpha\"]";
+    json::iarchive in(input);
+    std::vector<int> value;
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(in >> value,
+                                    json::error, "invalid value");
+}
+
+void fail_int_trailing_separator()
+{
+    const char input[] = "[1,2,]";
+    json::iarchive in(input);
+    std::vector<int> value;
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(in >> value,
+                                    json::error, "unexpected token");
+    TRIAL_PROTOCOL_TEST_EQUAL(value.size(), 0U);
+}
+
+void fail_int_many_separators()
+{
+    // Capacity is not reserved for separators without elements
+    const std::string input = "[1" + std::string(100000, ',') + "]";
+    json::iarchive in(input);
+    std::vector<int> value;
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(in >> value,
+                                    json::error, "unexpected token");
+    TRIAL_PROTOCOL_TEST_EQUAL(value.size(), 0U);
+    TRIAL_PROTOCOL_TEST(value.capacity() <= 64U);
+}
+
+void fail_int_missing_end()
+{
+    const char input[] = "[1,2";
+    json::iarchive in(input);
+    std::vector<int> value;
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(in >> value,
+                                    json::error, "expected end array bracket");
+}
+
 void run()
 {
     test_bool_empty();
@@ -549,6 +655,15 @@ void run()
     fail_missing_end();
     fail_missing_begin();
     fail_mismatching_end();
+    test_int_empty();
+    test_int_many();
+    test_double_many();
+    test_float_large();
+    test_int_nested();
+    fail_int_mixed();
+    fail_int_trailing_separator();
+    fail_int_many_separators();
+    fail_int_missing_end();
 }
 
 } // namespace vector_suite
@@ -664,6 +779,202 @@ void run()
 
 } // namespace map_suite
 
+//-----------------------------------------------------------------------------
+// Fields
+//-----------------------------------------------------------------------------
+
+namespace field_suite
+{
+
+struct point
+{
+    int x = 0;
+    int y = 0;
+};
+
+struct person
+{
+    std::string name;
+    std::int16_t age = 0;
+    point position;
+    std::vector<std::string> tags;
+};
+
+} // namespace field_suite
+
+namespace trial
+{
+namespace protocol
+{
+namespace serialization
+{
+
+template <typename CharT>
+struct load_overloader<json::basic_iarchive<CharT>, field_suite::point>
+{
+    static void load(json::basic_iarchive<CharT>& archive,
+                     field_suite::point& data,
+                     const unsigned int version)
+    {
+        static const auto table = json::make_field_table(json::field("x", &field_suite::point::x),
+                                                         json::field("y", &field_suite::point::y));
+        table.load(archive, data, version);
+    }
+};
+
+template <typename CharT>
+struct load_overloader<json::basic_iarchive<CharT>, field_suite::person>
+{
+    static void load(json::basic_iarchive<CharT>& archive,
+                     field_suite::person& data,
+                     const unsigned int version)
+    {
+        static const auto table = json::make_field_table(json::field("name", &field_suite::person::name),
+                                                         json::field("age", &field_suite::person::age),
+                                                         json::field("position", &field_suite::person::position),
+                                                         json::field("tags", &field_suite::person::tags));
+        table.load(archive, data, version);
+    }
+};
+
+} // namespace serialization
+} // namespace protocol
+} // namespace trial
+
+namespace field_suite
+{
+
+void test_empty()
+{
+    const char input[] = "{}";
+    json::iarchive in(input);
+    point value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.x, 0);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.y, 0);
+    TRIAL_PROTOCOL_TEST_EQUAL(in.symbol(), json::token::symbol::end);
+}
+
+void test_ordered()
+{
+    const char input[] = "{\"x\":1,\"y\":2}";
+    json::iarchive in(input);
+    point value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.x, 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.y, 2);
+}
+
+void test_unordered()
+{
+    const char input[] = "{\"y\":2,\"x\":1}";
+    json::iarchive in(input);
+    point value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.x, 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.y, 2);
+}
+
+void test_missing()
+{
+    const char input[] = "{\"y\":2}";
+    json::iarchive in(input);
+    point value;
+    value.x = 42;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.x, 42);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.y, 2);
+}
+
+void test_unknown()
+{
+    const char input[] = "{\"z\":[1,{\"x\":3}],\"x\":1,\"xx\":{\"y\":4},\"y\":2,\"\":null}";
+    json::iarchive in(input);
+    point value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.x, 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.y, 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(in.symbol(), json::token::symbol::end);
+}
+
+void test_escaped()
+{
+    const char input[] = "{\"\\u0078\":1,\"\\\\y\":2}";
+    json::iarchive in(input);
+    point value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.x, 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.y, 0);
+}
+
+void test_nested()
+{
+    const char input[] = "{\"tags\":[\"alpha\",\"bravo\"],\"position\":{\"y\":2,\"x\":1},\"name\":\"Kant\",\"age\":127}";
+    json::iarchive in(input);
+    person value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.name, "Kant");
+    TRIAL_PROTOCOL_TEST_EQUAL(value.age, 127);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.position.x, 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.position.y, 2);
+    std::vector<std::string> expect = { "alpha", "bravo" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(value.tags.begin(), value.tags.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_vector()
+{
+    const char input[] = "[{\"x\":1},{\"y\":2},{}]";
+    json::iarchive in(input);
+    std::vector<point> value;
+    TRIAL_PROTOCOL_TEST_NO_THROW(in >> value);
+    TRIAL_PROTOCOL_TEST_EQUAL(value.size(), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(value[0].x, 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(value[1].y, 2);
+}
+
+void fail_array()
+{
+    const char input[] = "[1,2]";
+    json::iarchive in(input);
+    point value;
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(in >> value,
+                                    json::error, "unexpected token");
+}
+
+void fail_missing_end()
+{
+    const char input[] = "{\"x\":1";
+    json::iarchive in(input);
+    point value;
+    TRIAL_PROTOCOL_TEST_THROWS(in >> value, json::error);
+}
+
+void fail_unknown_malformed()
+{
+    const char input[] = "{\"z\":[1,}";
+    json::iarchive in(input);
+    point value;
+    TRIAL_PROTOCOL_TEST_THROWS(in >> value, json::error);
+}
+
+void run()
+{
+    test_empty();
+    test_ordered();
+    test_unordered();
+    test_missing();
+    test_unknown();
+    test_escaped();
+    test_nested();
+    test_vector();
+    fail_array();
+    fail_missing_end();
+    fail_unknown_malformed();
+}
+
+} // namespace field_suite
+
 //-----------------------------------------------------------------------------
 // dynamic::variable
 //-----------------------------------------------------------------------------
@@ -826,6 +1137,7 @@ int main()
     optional_suite::run();
     vector_suite::run();
     map_suite::run();
+    field_suite::run();
     dynamic_suite::run();
 
     return boost::report_errors();
@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include <trial/protocol/json/indexed_reader.hpp>
+#include <trial/protocol/json/partial/skip.hpp>
+#include <trial/protocol/core/detail/lightweight_test.hpp>
+
+using namespace trial::protocol;
+namespace token = json::token;
+
+//-----------------------------------------------------------------------------
+// Structural index
+//-----------------------------------------------------------------------------
+
+namespace index_suite
+{
+
+using index_type = json::detail::structural_index<char>;
+
+std::vector<index_type::position_type> make(const std::string& input)
+{
+    index_type index(input.data(), input.data() + input.size());
+    return { index.begin(), index.end() };
+}
+
+void test_empty()
+{
+    std::vector<index_type::position_type> expect = { 0 };
+    auto result = make("");
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_literals()
+{
+    std::vector<index_type::position_type> expect = { 0, 1, 5, 7, 12, 13, 17, 18 };
+    auto result = make("[null, false,true]");
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_numbers()
+{
+    std::vector<index_type::position_type> expect = { 0, 2, 5, 6, 12, 13 };
+    auto result = make("[ -1 ,2.5e1 ]");
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_strings()
+{
+    std::vector<index_type::position_type> expect = { 0, 1, 8, 9, 16, 17 };
+    auto result = make(R"({"a,[:}":"\"}\\"})");
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_long_string()
+{
+    const std::string input = "[\"" + std::string(100, ',') + "\\\\\",\"" + std::string(100, '\\') + "\"]";
+    std::vector<index_type::position_type> expect = { 0, 1, 105, 106, 208, 209 };
+    auto result = make(input);
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_partner()
+{
+    const std::string input = R"([{"a":[]},[1]])";
+    index_type index(input.data(), input.data() + input.size());
+    TRIAL_PROTOCOL_TEST_EQUAL(index.size(), 13);
+    TRIAL_PROTOCOL_TEST_EQUAL(index.partner(index.begin()), index.begin() + 11);
+    TRIAL_PROTOCOL_TEST_EQUAL(index.partner(index.begin() + 1), index.begin() + 6);
+    TRIAL_PROTOCOL_TEST_EQUAL(index.partner(index.begin() + 4), index.begin() + 5);
+    TRIAL_PROTOCOL_TEST_EQUAL(index.partner(index.begin() + 8), index.begin() + 10);
+    TRIAL_PROTOCOL_TEST(index.partner(index.begin() + 2) == nullptr);
+}
+
+void fail_partner_mismatch()
+{
+    const std::string input = R"([{]})";
+    index_type index(input.data(), input.data() + input.size());
+    TRIAL_PROTOCOL_TEST(index.partner(index.begin()) == nullptr);
+    TRIAL_PROTOCOL_TEST(index.partner(index.begin() + 1) == nullptr);
+}
+
+void run()
+{
+    test_empty();
+    test_literals();
+    test_numbers();
+    test_strings();
+    test_long_string();
+    test_partner();
+    fail_partner_mismatch();
+}
+
+} // namespace index_suite
+
+//-----------------------------------------------------------------------------
+// Compare with reader
+//-----------------------------------------------------------------------------
+
+namespace compare_suite
+{
+
+void compare(const std::string& input)
+{
+    json::reader expect(input);
+    json::indexed_reader reader(input);
+    do
+    {
+        TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), expect.code());
+        TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), expect.level());
+        TRIAL_PROTOCOL_TEST_EQUAL(reader.literal(), expect.literal());
+        reader.next();
+    } while (expect.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), expect.code());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), expect.level());
+}
+
+void test_scalar()
+{
+    compare("null");
+    compare("  true  ");
+    compare("-12.5e3");
+    compare("\"alpha\"");
+}
+
+void test_array()
+{
+    compare("[]");
+    compare("[null,true,false,1,2.0,\"alpha\"]");
+    compare(" [ null , true ,\n\tfalse\r\n, 1 , 2.0 , \"alpha\" ] ");
+    compare("[[[[[[]]]]],[[[]]]]");
+}
+
+void test_object()
+{
+    compare("{}");
+    compare("{\"key\":\"value\",\"array\":[1,2,3],\"object\":{\"null\":null}}");
+    compare("{ \"key\" : \"va\\\"lue\" ,\n  \"[\" : \"{\" }");
+}
+
+void test_long()
+{
+    std::string input = "[";
+    for (int i = 0; i < 100; ++i)
+    {
+        input += "{\"key\\\\\":\"" + std::string(i, 'x') + "\\\"\",\n    \"value\": ";
+        input += std::to_string(i * 12345);
+        input += "}, ";
+    }
+    input += "null]";
+    compare(input);
+}
+
+void fail_junk()
+{
+    compare("[1-2]");
+    compare("[1 2]");
+    compare("[truex]");
+    compare("[\"alpha\"beta]");
+    compare("{\"key\"1}");
+    compare("[1,]");
+    compare("[1}");
+    compare("\"unterminated");
+    compare("[\\\"]");
+}
+
+void fail_control()
+{
+    // Control characters are not whitespaces
+    compare("[1, \x01 2]");
+    compare("[1,\x01]");
+    compare("[1\x01]");
+    compare("{\"a\": \x02 true}");
+    compare("[ \x01]");
+    compare("{ \x01}");
+    compare("\x0B[]");
+    compare("[]\x0C");
+    compare(std::string("[\x00]", 3));
+}
+
+void run()
+{
+    test_scalar();
+    test_array();
+    test_object();
+    test_long();
+    fail_junk();
+    fail_control();
+}
+
+} // namespace compare_suite
+
+//-----------------------------------------------------------------------------
+// Skip
+//-----------------------------------------------------------------------------
+
+namespace skip_suite
+{
+
+void api_copy_ctor()
+{
+    const char input[] = "[[1], 2]";
+    json::indexed_reader reader(input);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    json::indexed_reader copy(reader);
+    TRIAL_PROTOCOL_TEST(copy.skip_to_end());
+    TRIAL_PROTOCOL_TEST_EQUAL(copy.code(), token::code::end_array);
+    TRIAL_PROTOCOL_TEST(copy.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(copy.code(), token::code::integer);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 2);
+}
+
+void test_skip_to_end()
+{
+    const char input[] = "[ [1, [2]], {\"a\": {}}, 3 ]";
+    json::indexed_reader reader(input);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 2);
+    TRIAL_PROTOCOL_TEST(reader.skip_to_end());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 1);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_object);
+    TRIAL_PROTOCOL_TEST(reader.skip_to_end());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_object);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 1);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::integer);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.skip_to_end(), false);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.next(), false);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+}
+
+void test_partial_skip()
+{
+    const char input[] = R"({
+        "skip": [ "]", { "}": "\"]" } ],
+        "keep": 42
+    })";
+    json::indexed_reader reader(input);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), "skip");
+    TRIAL_PROTOCOL_TEST(reader.next());
+    auto skipped = json::partial::skip(reader);
+    TRIAL_PROTOCOL_TEST_EQUAL(skipped, R"([ "]", { "}": "\"]" } ])");
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::key);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), "keep");
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 42);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_object);
+}
+
+void test_partial_skip_outer()
+{
+    json::indexed_reader reader(R"({"skip": "me"})");
+    auto skipped = json::partial::skip(reader);
+    TRIAL_PROTOCOL_TEST_EQUAL(skipped, R"({"skip": "me"})");
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+}
+
+void test_partial_skip_unvalidated()
+{
+    // Content of skipped containers is not validated
+    json::indexed_reader reader("[[1,,2],[1 2]]");
+    TRIAL_PROTOCOL_TEST(reader.next());
+    auto skipped = json::partial::skip(reader);
+    TRIAL_PROTOCOL_TEST_EQUAL(skipped, "[1,,2]");
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array);
+    skipped = json::partial::skip(reader);
+    TRIAL_PROTOCOL_TEST_EQUAL(skipped, "[1 2]");
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+}
+
+void fail_partial_skip_unbalanced()
+{
+    json::indexed_reader reader("[[1, 2]");
+    std::error_code error;
+    auto skipped = json::partial::skip(reader, error);
+    TRIAL_PROTOCOL_TEST_EQUAL(skipped, "[[1, 2");
+    TRIAL_PROTOCOL_TEST_EQUAL(error, json::insufficient_tokens);
+}
+
+void run()
+{
+    api_copy_ctor();
+    test_skip_to_end();
+    test_partial_skip();
+    test_partial_skip_outer();
+    test_partial_skip_unvalidated();
+    fail_partial_skip_unbalanced();
+}
+
+} // namespace skip_suite
+
+//-----------------------------------------------------------------------------
+// main
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    index_suite::run();
+    compare_suite::run();
+    skip_suite::run();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,426 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include <trial/protocol/core/detail/lightweight_test.hpp>
+#include <trial/protocol/json/lazy.hpp>
+
+using namespace trial::protocol;
+namespace dynamic = trial::dynamic;
+
+//-----------------------------------------------------------------------------
+
+namespace value_suite
+{
+
+void test_null()
+{
+    const std::string input = "null";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.symbol(), json::token::symbol::null);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.size(), 0);
+    TRIAL_PROTOCOL_TEST(document.empty());
+    TRIAL_PROTOCOL_TEST(document.begin() == document.end());
+}
+
+void test_boolean()
+{
+    const std::string input = "true";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.symbol(), json::token::symbol::boolean);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.size(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.value<bool>(), true);
+}
+
+void test_integer()
+{
+    const std::string input = "  42  ";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.symbol(), json::token::symbol::integer);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.literal(), "42");
+    TRIAL_PROTOCOL_TEST_EQUAL(document.value<int>(), 42);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.value<double>(), 42.0);
+}
+
+void test_real()
+{
+    const std::string input = "1.5";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.symbol(), json::token::symbol::real);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.value<double>(), 1.5);
+}
+
+void test_string()
+{
+    const std::string input = "\"alpha\"";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.symbol(), json::token::symbol::string);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.literal(), "\"alpha\"");
+    TRIAL_PROTOCOL_TEST_EQUAL(document.string_view(), "alpha");
+    TRIAL_PROTOCOL_TEST_EQUAL(document.value<std::string>(), "alpha");
+    // View into input buffer
+    TRIAL_PROTOCOL_TEST(document.string_view().data() == input.data() + 1);
+}
+
+void test_string_escaped()
+{
+    const std::string input = "\"al\\u0070ha\"";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.value<std::string>(), "alpha");
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(document.string_view(),
+                                    json::error,
+                                    "invalid value");
+}
+
+void fail_string_view()
+{
+    const std::string input = "42";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(document.string_view(),
+                                    json::error,
+                                    "incompatible type");
+}
+
+void fail_value()
+{
+    const std::string input = "\"alpha\"";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(document.value<int>(),
+                                    json::error,
+                                    "invalid value");
+}
+
+void run()
+{
+    test_null();
+    test_boolean();
+    test_integer();
+    test_real();
+    test_string();
+    test_string_escaped();
+    fail_string_view();
+    fail_value();
+}
+
+} // namespace value_suite
+
+//-----------------------------------------------------------------------------
+
+namespace array_suite
+{
+
+void test_empty()
+{
+    const std::string input = "[]";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.symbol(), json::token::symbol::begin_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.size(), 0);
+    TRIAL_PROTOCOL_TEST(document.empty());
+    TRIAL_PROTOCOL_TEST(document.begin() == document.end());
+}
+
+void test_index()
+{
+    const std::string input = "[1, \"alpha\", [2, 3], {\"key\": 4}, null]";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.size(), 5);
+    TRIAL_PROTOCOL_TEST(!document.empty());
+    TRIAL_PROTOCOL_TEST_EQUAL(document[0].value<int>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(document[1].string_view(), "alpha");
+    TRIAL_PROTOCOL_TEST_EQUAL(document[2].literal(), "[2, 3]");
+    TRIAL_PROTOCOL_TEST_EQUAL(document[2][1].value<int>(), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(document[3].literal(), "{\"key\": 4}");
+    TRIAL_PROTOCOL_TEST_EQUAL(document[3]["key"].value<int>(), 4);
+    TRIAL_PROTOCOL_TEST_EQUAL(document[4].symbol(), json::token::symbol::null);
+}
+
+void test_iterator()
+{
+    const std::string input = "[1,2,[3,4],5]";
+    json::lazy_value document(input);
+    std::vector<std::string> result;
+    for (const auto& element : document)
+    {
+        result.push_back(std::string(element.literal().data(), element.literal().size()));
+    }
+    std::vector<std::string> expect = { "1", "2", "[3,4]", "5" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_index_loop()
+{
+    std::string input = "[";
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (i > 0)
+            input += ",";
+        input += "[" + std::to_string(i) + "]";
+    }
+    input += "]";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.size(), 1000);
+    int sum = 0;
+    for (json::lazy_value::size_type i = 0; i < document.size(); ++i)
+    {
+        sum += document[i][0].value<int>();
+    }
+    TRIAL_PROTOCOL_TEST_EQUAL(sum, 999 * 1000 / 2);
+}
+
+void test_copy()
+{
+    const std::string input = "[1,2,3]";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.size(), 3);
+    json::lazy_value copy(document);
+    TRIAL_PROTOCOL_TEST_EQUAL(copy.size(), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(copy[2].value<int>(), 3);
+    auto it = document.begin();
+    ++it;
+    TRIAL_PROTOCOL_TEST_EQUAL(it->value<int>(), 2);
+    TRIAL_PROTOCOL_TEST(it != copy.begin());
+}
+
+void fail_index_range()
+{
+    const std::string input = "[1,2]";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(document[2],
+                                    json::error,
+                                    "invalid key");
+}
+
+void fail_index_type()
+{
+    const std::string input = "{\"key\":1}";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(document[0],
+                                    json::error,
+                                    "incompatible type");
+}
+
+void fail_key()
+{
+    const std::string input = "[1,2]";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(document.begin().key(),
+                                    json::error,
+                                    "incompatible type");
+}
+
+void run()
+{
+    test_empty();
+    test_index();
+    test_iterator();
+    test_index_loop();
+    test_copy();
+    fail_index_range();
+    fail_index_type();
+    fail_key();
+}
+
+} // namespace array_suite
+
+//-----------------------------------------------------------------------------
+
+namespace object_suite
+{
+
+void test_empty()
+{
+    const std::string input = "{}";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.symbol(), json::token::symbol::begin_object);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.size(), 0);
+    TRIAL_PROTOCOL_TEST(document.empty());
+    TRIAL_PROTOCOL_TEST(document.find("alpha") == document.end());
+}
+
+void test_key()
+{
+    const std::string input = "{\"alpha\":1,\"bravo\":{\"charlie\":[true,false]},\"delta\":\"echo\"}";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.size(), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(document["alpha"].value<int>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(document["bravo"]["charlie"][1].value<bool>(), false);
+    TRIAL_PROTOCOL_TEST_EQUAL(document["delta"].string_view(), "echo");
+    TRIAL_PROTOCOL_TEST(document.find("foxtrot") == document.end());
+}
+
+void test_key_escaped()
+{
+    const std::string input = "{\"al\\u0070ha\":1}";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(document["alpha"].value<int>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(document.begin().key().value<std::string>(), "alpha");
+}
+
+void test_iterator()
+{
+    const std::string input = "{\"alpha\":1,\"bravo\":[2],\"charlie\":3}";
+    json::lazy_value document(input);
+    std::vector<std::string> keys;
+    std::vector<std::string> values;
+    for (auto it = document.begin(); it != document.end(); ++it)
+    {
+        const auto key = it.key().string_view();
+        keys.push_back(std::string(key.data(), key.size()));
+        values.push_back(std::string(it->literal().data(), it->literal().size()));
+    }
+    std::vector<std::string> expect_keys = { "alpha", "bravo", "charlie" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(keys.begin(), keys.end(),
+                                  expect_keys.begin(), expect_keys.end());
+    std::vector<std::string> expect_values = { "1", "[2]", "3" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(values.begin(), values.end(),
+                                  expect_values.begin(), expect_values.end());
+}
+
+void test_find()
+{
+    const std::string input = "{\"alpha\":1,\"bravo\":2,\"charlie\":3}";
+    json::lazy_value document(input);
+    auto it = document.find("bravo");
+    TRIAL_PROTOCOL_TEST(it != document.end());
+    TRIAL_PROTOCOL_TEST_EQUAL(it.key().string_view(), "bravo");
+    TRIAL_PROTOCOL_TEST_EQUAL(it->value<int>(), 2);
+    ++it;
+    TRIAL_PROTOCOL_TEST_EQUAL(it.key().string_view(), "charlie");
+    ++it;
+    TRIAL_PROTOCOL_TEST(it == document.end());
+    TRIAL_PROTOCOL_TEST_EQUAL(document.size(), 3);
+}
+
+void fail_missing_key()
+{
+    const std::string input = "{\"alpha\":1}";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(document["bravo"],
+                                    json::error,
+                                    "invalid key");
+}
+
+void fail_key_type()
+{
+    const std::string input = "[1]";
+    json::lazy_value document(input);
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(document["alpha"],
+                                    json::error,
+                                    "incompatible type");
+}
+
+void run()
+{
+    test_empty();
+    test_key();
+    test_key_escaped();
+    test_iterator();
+    test_find();
+    fail_missing_key();
+    fail_key_type();
+}
+
+} // namespace object_suite
+
+//-----------------------------------------------------------------------------
+
+namespace materialize_suite
+{
+
+void test_scalar()
+{
+    const std::string input = "{\"alpha\":\"bravo\"}";
+    json::lazy_value document(input);
+    auto result = document["alpha"].materialize();
+    TRIAL_PROTOCOL_TEST(result == "bravo");
+}
+
+void test_subtree()
+{
+    const std::string input = "{\"alpha\":1,\"bravo\":{\"charlie\":[1,2,3]}}";
+    json::lazy_value document(input);
+    auto result = document["bravo"].materialize();
+    TRIAL_PROTOCOL_TEST(result.is<dynamic::map>());
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(result["charlie"].size(), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(result["charlie"][2].value<int>(), 3);
+}
+
+void test_map_policy()
+{
+    const std::string input = "[{\"b\":1,\"a\":2}]";
+    json::lazy_value document(input);
+    auto result = document[0].materialize<std::allocator<char>, dynamic::flat_map_policy>();
+    TRIAL_PROTOCOL_TEST_EQUAL(result["a"].value<int>(), 2);
+}
+
+void run()
+{
+    test_scalar();
+    test_subtree();
+    test_map_policy();
+}
+
+} // namespace materialize_suite
+
+//-----------------------------------------------------------------------------
+
+namespace failure_suite
+{
+
+void fail_empty()
+{
+    const std::string input = "";
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(json::lazy_value{input},
+                                    json::error,
+                                    "algorithm used requires more tokens than available");
+}
+
+void fail_malformed()
+{
+    const std::string input = "{\"alpha\":[1,2}";
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(json::lazy_value{input},
+                                    json::error,
+                                    "expected end array bracket");
+}
+
+void fail_trailing_value()
+{
+    const std::string input = "[1] 2";
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(json::lazy_value{input},
+                                    json::error,
+                                    "unexpected token");
+}
+
+void run()
+{
+    fail_empty();
+    fail_malformed();
+    fail_trailing_value();
+}
+
+} // namespace failure_suite
+
+//-----------------------------------------------------------------------------
+// main
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    value_suite::run();
+    array_suite::run();
+    object_suite::run();
+    materialize_suite::run();
+    failure_suite::run();
+
+    return boost::report_errors();
+}
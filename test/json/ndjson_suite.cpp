@@ -0,0 +1,237 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <trial/protocol/core/detail/lightweight_test.hpp>
+#include <trial/protocol/json/ndjson.hpp>
+
+using namespace trial::protocol;
+namespace dynamic = trial::dynamic;
+
+// Records {"id":0} to {"id":count-1}
+std::string make_records(int count)
+{
+    std::string result;
+    for (int i = 0; i < count; ++i)
+    {
+        result += "{\"id\":" + std::to_string(i) + ",\"name\":\"record\"}\n";
+    }
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+namespace basic_suite
+{
+
+void parse_empty()
+{
+    std::string input = "";
+    auto result = json::ndjson::parse(input);
+    TRIAL_PROTOCOL_TEST(result.empty());
+}
+
+void parse_one()
+{
+    std::string input = "[1,2,3]";
+    auto result = json::ndjson::parse(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(result[0].size(), 3);
+    TRIAL_PROTOCOL_TEST(result[0][2] == 3);
+}
+
+void parse_values()
+{
+    std::string input = "null\ntrue\n42\n\"alpha\"\n[]\n{}\n";
+    auto result = json::ndjson::parse(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 6);
+    TRIAL_PROTOCOL_TEST(result[0].is<dynamic::nullable>());
+    TRIAL_PROTOCOL_TEST(result[1] == true);
+    TRIAL_PROTOCOL_TEST(result[2] == 42);
+    TRIAL_PROTOCOL_TEST(result[3] == "alpha");
+    TRIAL_PROTOCOL_TEST(result[4].is<dynamic::array>());
+    TRIAL_PROTOCOL_TEST(result[5].is<dynamic::map>());
+}
+
+void parse_blank_lines()
+{
+    std::string input = "\n1\n\n  \r\n2\r\n\n";
+    auto result = json::ndjson::parse(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 2);
+    TRIAL_PROTOCOL_TEST(result[0] == 1);
+    TRIAL_PROTOCOL_TEST(result[1] == 2);
+}
+
+void parse_without_final_newline()
+{
+    std::string input = "1\n2";
+    auto result = json::ndjson::parse(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 2);
+    TRIAL_PROTOCOL_TEST(result[1] == 2);
+}
+
+void parse_map_policy()
+{
+    std::string input = "{\"b\":1,\"a\":2}\n";
+    auto result = json::ndjson::parse<std::allocator<char>, dynamic::flat_map_policy>(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 1);
+    TRIAL_PROTOCOL_TEST(result[0]["a"] == 2);
+}
+
+void run()
+{
+    parse_empty();
+    parse_one();
+    parse_values();
+    parse_blank_lines();
+    parse_without_final_newline();
+    parse_map_policy();
+}
+
+} // namespace basic_suite
+
+//-----------------------------------------------------------------------------
+
+namespace order_suite
+{
+
+void parse_sequential()
+{
+    const int count = 1000;
+    auto result = json::ndjson::parse(make_records(count), 1, 64);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), count);
+    for (int i = 0; i < count; ++i)
+    {
+        TRIAL_PROTOCOL_TEST(result[i]["id"].value<int>() == i);
+    }
+}
+
+void parse_concurrent()
+{
+    const int count = 1000;
+    for (std::size_t concurrency : { 2, 3, 8 })
+    {
+        for (std::size_t batch_size : { 1, 64, 1000 })
+        {
+            auto result = json::ndjson::parse(make_records(count), concurrency, batch_size);
+            TRIAL_PROTOCOL_TEST_EQUAL(result.size(), count);
+            for (int i = 0; i < count; ++i)
+            {
+                TRIAL_PROTOCOL_TEST(result[i]["id"].value<int>() == i);
+            }
+        }
+    }
+}
+
+void visit_concurrent()
+{
+    const int count = 1000;
+    int expected = 0;
+    json::ndjson::visit(make_records(count),
+                        [&expected] (dynamic::variable&& record)
+                        {
+                            TRIAL_PROTOCOL_TEST(record["id"].value<int>() == expected);
+                            ++expected;
+                        },
+                        4,
+                        100);
+    TRIAL_PROTOCOL_TEST_EQUAL(expected, count);
+}
+
+void run()
+{
+    parse_sequential();
+    parse_concurrent();
+    visit_concurrent();
+}
+
+} // namespace order_suite
+
+//-----------------------------------------------------------------------------
+
+namespace failure_suite
+{
+
+void fail_malformed_record()
+{
+    std::string input = "1\n[2,\n3\n";
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(json::ndjson::parse(input),
+                                    json::error,
+                                    "expected end array bracket");
+}
+
+void fail_trailing_value()
+{
+    std::string input = "1\n2 3\n";
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(json::ndjson::parse(input),
+                                    json::error,
+                                    "unexpected token");
+}
+
+void fail_delivers_preceding()
+{
+    // Malformed record in the middle of many batches
+    std::string input = make_records(500) + "{\"id\":}\n" + make_records(500);
+    for (std::size_t concurrency : { 1, 4 })
+    {
+        int delivered = 0;
+        TRIAL_PROTOCOL_TEST_THROW_EQUAL(json::ndjson::visit(input,
+                                                            [&delivered] (dynamic::variable&& record)
+                                                            {
+                                                                TRIAL_PROTOCOL_TEST(record["id"].value<int>() == delivered);
+                                                                ++delivered;
+                                                            },
+                                                            concurrency,
+                                                            64),
+                                        json::error,
+                                        "invalid value");
+        TRIAL_PROTOCOL_TEST_EQUAL(delivered, 500);
+    }
+}
+
+void fail_visitor()
+{
+    int delivered = 0;
+    TRIAL_PROTOCOL_TEST_THROWS(json::ndjson::visit(make_records(1000),
+                                                   [&delivered] (dynamic::variable&&)
+                                                   {
+                                                       if (++delivered == 10)
+                                                           throw std::runtime_error("stop");
+                                                   },
+                                                   4,
+                                                   64),
+                               std::runtime_error);
+    TRIAL_PROTOCOL_TEST_EQUAL(delivered, 10);
+}
+
+void run()
+{
+    fail_malformed_record();
+    fail_trailing_value();
+    fail_delivers_preceding();
+    fail_visitor();
+}
+
+} // namespace failure_suite
+
+//-----------------------------------------------------------------------------
+// main
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    basic_suite::run();
+    order_suite::run();
+    failure_suite::run();
+
+    return boost::report_errors();
+}
@@ -143,7 +143,7 @@ void test_one()
     json::oarchive ar(result);
     double value = 1.0;
     ar << value;
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.00000000000000");
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.0");
 }
 
 void test_const_one()
@@ -152,7 +152,7 @@ void test_const_one()
     json::oarchive ar(result);
     const double value = 1.0;
     ar << value;
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.00000000000000");
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.0");
 }
 
 void test_half()
@@ -161,7 +161,7 @@ void test_half()
     json::oarchive ar(result);
     double value = 0.5;
     ar << value;
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.500000000000000");
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.5");
 }
 
 void test_max()
@@ -170,7 +170,7 @@ void test_max()
     json::oarchive ar(result);
     double value = std::numeric_limits<double>::max();
     ar << value;
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.79769313486232e+308");
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "1.7976931348623157e+308");
 }
 
 void test_min()
@@ -179,7 +179,7 @@ void test_min()
     json::oarchive ar(result);
     double value = std::numeric_limits<double>::min();
     ar << value;
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "2.22507385850720e-308");
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "2.2250738585072014e-308");
 }
 
 void test_infinity()
@@ -297,7 +297,7 @@ void test_double_four()
     json::oarchive ar(result);
     double array[] = { 1.5, 2.5, 3.5, 4.5 };
     ar << array;
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "[1.50000000000000,2.50000000000000,3.50000000000000,4.50000000000000]");
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "[1.5,2.5,3.5,4.5]");
 }
 
 void run()
@@ -462,6 +462,26 @@ void test_int_two()
     TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "[1,2]");
 }
 
+void test_double_two()
+{
+    std::ostringstream result;
+    json::oarchive ar(result);
+    std::vector<double> value;
+    value.push_back(-1.5);
+    value.push_back(1e100);
+    ar << value;
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "[-1.5,1e+100]");
+}
+
+void test_nested_int()
+{
+    std::ostringstream result;
+    json::oarchive ar(result);
+    std::vector< std::vector<int> > value = { { 1, 2 }, {}, { -3 } };
+    ar << value;
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "[[1,2],[],[-3]]");
+}
+
 void run()
 {
     test_bool_empty();
@@ -470,6 +490,8 @@ void run()
     test_int_empty();
     test_int_one();
     test_int_two();
+    test_double_two();
+    test_nested_int();
 }
 
 } // namespace vector_suite
@@ -619,6 +641,74 @@ void run()
 
 } // namespace record_suite
 
+//-----------------------------------------------------------------------------
+// Fields
+//-----------------------------------------------------------------------------
+
+namespace field_suite
+{
+
+struct point
+{
+    int x;
+    int y;
+};
+
+} // namespace field_suite
+
+namespace trial
+{
+namespace protocol
+{
+namespace serialization
+{
+
+template <typename CharT>
+struct save_overloader<json::basic_oarchive<CharT>, field_suite::point>
+{
+    static void save(json::basic_oarchive<CharT>& archive,
+                     const field_suite::point& data,
+                     const unsigned int version)
+    {
+        static const auto table = json::make_field_table(json::field("x", &field_suite::point::x),
+                                                         json::field("y", &field_suite::point::y));
+        table.save(archive, data, version);
+    }
+};
+
+} // namespace serialization
+} // namespace protocol
+} // namespace trial
+
+namespace field_suite
+{
+
+void test_struct()
+{
+    std::ostringstream result;
+    json::oarchive ar(result);
+    point value = { 1, 2 };
+    ar << value;
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "{\"x\":1,\"y\":2}");
+}
+
+void test_vector()
+{
+    std::ostringstream result;
+    json::oarchive ar(result);
+    std::vector<point> value = { { 1, 2 }, { 3, 4 } };
+    ar << value;
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "[{\"x\":1,\"y\":2},{\"x\":3,\"y\":4}]");
+}
+
+void run()
+{
+    test_struct();
+    test_vector();
+}
+
+} // namespace field_suite
+
 //-----------------------------------------------------------------------------
 // dynamic::variable
 //-----------------------------------------------------------------------------
@@ -661,7 +751,7 @@ void test_number()
     json::oarchive ar(result);
     variable value(3.0);
     ar << value;
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "3.00000000000000");
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "3.0");
 }
 
 void test_string()
@@ -679,7 +769,7 @@ void test_array()
     json::oarchive ar(result);
     variable value = array::make({ true, 2, 3.0, "alpha" });;
     ar << value;
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "[true,2,3.00000000000000,\"alpha\"]");
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "[true,2,3.0,\"alpha\"]");
 }
 
 void test_map()
@@ -721,6 +811,7 @@ int main()
     map_suite::run();
     set_suite::run();
     record_suite::run();
+    field_suite::run();
     dynamic_suite::run();
 
     return boost::report_errors();
@@ -0,0 +1,189 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <trial/protocol/core/detail/lightweight_test.hpp>
+#include <trial/protocol/json/parallel.hpp>
+
+using namespace trial::protocol;
+namespace dynamic = trial::dynamic;
+
+// Returns the error message, or an empty string if successful
+template <typename Function>
+std::string failure(Function function)
+{
+    try
+    {
+        function();
+        return {};
+    }
+    catch (const json::error& ex)
+    {
+        return ex.what();
+    }
+}
+
+// Parses in parallel with tiny fragments and compares with json::parse
+void verify(const std::string& input)
+{
+    for (std::size_t fragment_size : { 1, 2, 8 })
+    {
+        dynamic::variable expected;
+        dynamic::variable result;
+        const auto expected_failure = failure([&] { expected = json::parse(input); });
+        const auto result_failure = failure([&] { result = json::parallel::parse(input, 4, fragment_size); });
+        TRIAL_PROTOCOL_TEST_EQUAL(result_failure, expected_failure);
+        TRIAL_PROTOCOL_TEST(result == expected);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+namespace array_suite
+{
+
+void parse_empty()
+{
+    verify("[]");
+    verify(" [ ] ");
+}
+
+void parse_numbers()
+{
+    verify("[1,2,3,4,5,6,7,8,9,10]");
+    verify("[ 1 , 2 , 3 ]\n");
+    verify("[1.5,-2,3e3,true,false,null]");
+}
+
+void parse_strings()
+{
+    verify("[\"alpha\",\"bravo\",\"charlie\"]");
+    verify("[\",\",\"]\",\"[\",\"}\"]");
+    verify("[\"\\\"\",\"\\\\\",\"\\\\\\\"]\"]");
+}
+
+void parse_containers()
+{
+    verify("[[1,2],[3,[4,5]],{\"a\":[6,7]},{\"b\":{\"c\":8}}]");
+    verify("[{\"id\":1,\"tags\":[\"x\",\"y\"]},{\"id\":2,\"tags\":[]}]");
+}
+
+void parse_many()
+{
+    std::string input = "[";
+    for (int i = 0; i < 10000; ++i)
+    {
+        if (i > 0)
+            input += ",";
+        input += "{\"id\":" + std::to_string(i) + ",\"values\":[" + std::to_string(i) + ",\"x\"]}";
+    }
+    input += "]";
+    auto result = json::parallel::parse(input, 4, 100);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 10000);
+    TRIAL_PROTOCOL_TEST_EQUAL(result[9999]["id"].value<int>(), 9999);
+    TRIAL_PROTOCOL_TEST(result == json::parse(input));
+}
+
+void parse_map_policy()
+{
+    std::string input = "[{\"b\":1},{\"a\":2},{\"c\":3}]";
+    auto result = json::parallel::parse<std::allocator<char>, dynamic::hash_map_policy>(input, 2, 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(result[1]["a"].value<int>(), 2);
+}
+
+void run()
+{
+    parse_empty();
+    parse_numbers();
+    parse_strings();
+    parse_containers();
+    parse_many();
+    parse_map_policy();
+}
+
+} // namespace array_suite
+
+//-----------------------------------------------------------------------------
+
+namespace sequential_suite
+{
+
+void parse_non_array()
+{
+    verify("");
+    verify("null");
+    verify("42");
+    verify("\"alpha\"");
+    verify("{\"a\":[1,2,3]}");
+}
+
+void parse_single_thread()
+{
+    std::string input = "[1,2,3]";
+    auto result = json::parallel::parse(input, 1, 1);
+    TRIAL_PROTOCOL_TEST(result == json::parse(input));
+}
+
+void run()
+{
+    parse_non_array();
+    parse_single_thread();
+}
+
+} // namespace sequential_suite
+
+//-----------------------------------------------------------------------------
+
+namespace failure_suite
+{
+
+void fail_elements()
+{
+    verify("[1,]");
+    verify("[,1]");
+    verify("[1,,2]");
+    verify("[1 2,3]");
+    verify("[1,2 3]");
+    verify("[1,nul,3]");
+    verify("[1,{\"a\":},3]");
+}
+
+void fail_brackets()
+{
+    verify("[1,2");
+    verify("[1,2}");
+    verify("[1,[2,3],4");
+    verify("[1,{2,3],4]");
+    verify("[1,2]]");
+    verify("[1,2] 3");
+    verify("[1,\"2]");
+}
+
+void run()
+{
+    fail_elements();
+    fail_brackets();
+}
+
+} // namespace failure_suite
+
+//-----------------------------------------------------------------------------
+// main
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    array_suite::run();
+    sequential_suite::run();
+    failure_suite::run();
+
+    return boost::report_errors();
+}
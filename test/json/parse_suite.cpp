@@ -13,6 +13,7 @@
 #include <iomanip>
 #include <trial/protocol/buffer/string.hpp>
 #include <trial/protocol/json/parse.hpp>
+#include <trial/protocol/json/format.hpp>
 #include <trial/protocol/core/detail/lightweight_test.hpp>
 
 using namespace trial::dynamic;
@@ -863,6 +864,151 @@ void run()
 
 } // namespace residue_suite
 
+//-----------------------------------------------------------------------------
+// Arena
+//-----------------------------------------------------------------------------
+
+namespace arena_suite
+{
+
+using variable_type = basic_variable<arena_allocator<char>>;
+
+void parse_null()
+{
+    arena region;
+    std::string input = "null";
+    auto result = json::parse(input, region);
+    TRIAL_PROTOCOL_TEST(result.same<nullable>());
+    TRIAL_PROTOCOL_TEST_EQUAL(region.capacity(), 0);
+}
+
+void parse_string()
+{
+    arena region;
+    std::string input = "\"a string that is longer than small string buffers\"";
+    auto result = json::parse(input, region);
+    TRIAL_PROTOCOL_TEST(result.is<string>());
+    TRIAL_PROTOCOL_TEST_EQUAL(result.value<variable_type::string_type>(),
+                              "a string that is longer than small string buffers");
+    TRIAL_PROTOCOL_TEST(result.assume_value<variable_type::string_type>().get_allocator().resource() == &region);
+}
+
+void parse_array()
+{
+    arena region;
+    std::string input = "[null,true,2,3.0,\"alpha\"]";
+    auto result = json::parse(input, region);
+    TRIAL_PROTOCOL_TEST(result.is<array>());
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 5);
+    TRIAL_PROTOCOL_TEST(result[0].is<nullable>());
+    TRIAL_PROTOCOL_TEST(result[1] == true);
+    TRIAL_PROTOCOL_TEST(result[2] == 2);
+    TRIAL_PROTOCOL_TEST(result[3] == 3.0);
+    TRIAL_PROTOCOL_TEST_EQUAL(result[4].value<variable_type::string_type>(), "alpha");
+    TRIAL_PROTOCOL_TEST(region.capacity() > 0);
+    TRIAL_PROTOCOL_TEST(result.assume_value<variable_type::array_type>().get_allocator().resource() == &region);
+}
+
+void parse_object()
+{
+    arena region;
+    std::string input = "{\"alpha\":[{\"bravo\":1},{\"charlie\":2}]}";
+    auto result = json::parse(input, region);
+    TRIAL_PROTOCOL_TEST(result.is<map>());
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(result["alpha"].size(), 2);
+    TRIAL_PROTOCOL_TEST(result["alpha"][0]["bravo"] == 1);
+    TRIAL_PROTOCOL_TEST(result["alpha"][1]["charlie"] == 2);
+    TRIAL_PROTOCOL_TEST(result.assume_value<variable_type::map_type>().get_allocator().resource() == &region);
+}
+
+void parse_no_scope()
+{
+    // The arena is only current during parsing
+    arena region;
+    std::string input = "[1,2,3]";
+    auto result = json::parse(input, region);
+    TRIAL_PROTOCOL_TEST(arena::current() == nullptr);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 3);
+}
+
+void parse_failure()
+{
+    arena region;
+    std::string input = "[1,2";
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(json::parse(input, region),
+                                    json::error,
+                                    "expected end array bracket");
+    TRIAL_PROTOCOL_TEST(arena::current() == nullptr);
+}
+
+void partial_array()
+{
+    arena region;
+    std::string input = "[[1,2],[3,4]]";
+    json::reader reader(input);
+    TRIAL_PROTOCOL_TEST(reader.next(json::token::code::begin_array));
+    auto first = json::partial::parse(reader, region);
+    TRIAL_PROTOCOL_TEST_EQUAL(first.size(), 2);
+    auto second = json::partial::parse(reader, region);
+    TRIAL_PROTOCOL_TEST_EQUAL(second.size(), 2);
+    TRIAL_PROTOCOL_TEST(second[1] == 4);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), json::token::code::end_array);
+}
+
+void run()
+{
+    parse_null();
+    parse_string();
+    parse_array();
+    parse_object();
+    parse_no_scope();
+    parse_failure();
+    partial_array();
+}
+
+} // namespace arena_suite
+
+//-----------------------------------------------------------------------------
+// Map policy
+//-----------------------------------------------------------------------------
+
+namespace map_policy_suite
+{
+
+void parse_flat_object()
+{
+    std::string input = "{\"charlie\":3,\"alpha\":{\"delta\":4,\"bravo\":2},\"alpha\":1}";
+    auto result = json::parse<std::string, std::allocator<char>, flat_map_policy>(input);
+    TRIAL_PROTOCOL_TEST(result.is<map>());
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 2);
+    TRIAL_PROTOCOL_TEST(result["alpha"]["bravo"] == 2);
+    TRIAL_PROTOCOL_TEST(result["charlie"] == 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(json::format<std::string>(result),
+                              "{\"alpha\":{\"bravo\":2,\"delta\":4},\"charlie\":3}");
+}
+
+void parse_hash_object()
+{
+    std::string input = "{\"charlie\":3,\"alpha\":{\"delta\":4,\"bravo\":2},\"alpha\":1}";
+    auto result = json::parse<std::string, std::allocator<char>, hash_map_policy>(input);
+    TRIAL_PROTOCOL_TEST(result.is<map>());
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 2);
+    TRIAL_PROTOCOL_TEST(result["alpha"]["bravo"] == 2);
+    TRIAL_PROTOCOL_TEST(result["charlie"] == 3);
+    // Insertion order is preserved
+    TRIAL_PROTOCOL_TEST_EQUAL(json::format<std::string>(result),
+                              "{\"charlie\":3,\"alpha\":{\"delta\":4,\"bravo\":2}}");
+}
+
+void run()
+{
+    parse_flat_object();
+    parse_hash_object();
+}
+
+} // namespace map_policy_suite
+
 //-----------------------------------------------------------------------------
 // main
 //-----------------------------------------------------------------------------
@@ -873,6 +1019,8 @@ int main()
     partial_suite::run();
     failure_suite::run();
     residue_suite::run();
+    arena_suite::run();
+    map_policy_suite::run();
 
     return boost::report_errors();
 }
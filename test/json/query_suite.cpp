@@ -0,0 +1,368 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <trial/protocol/core/detail/lightweight_test.hpp>
+#include <trial/protocol/json/query.hpp>
+
+using namespace trial::protocol;
+namespace dynamic = trial::dynamic;
+
+// Collects matches as "path:literal"
+std::vector<std::string> collect(const json::query& query, const std::string& input)
+{
+    std::vector<std::string> result;
+    query.visit(input,
+                [&result] (std::size_t path, const json::lazy_value& value)
+                {
+                    const auto literal = value.literal();
+                    result.push_back(std::to_string(path) + ":" + std::string(literal.data(), literal.size()));
+                });
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+namespace pointer_suite
+{
+
+void test_root()
+{
+    json::query query;
+    TRIAL_PROTOCOL_TEST_EQUAL(query.add(""), 0);
+    TRIAL_PROTOCOL_TEST_EQUAL(query.size(), 1);
+    auto result = collect(query, " [1,2] ");
+    std::vector<std::string> expect = { "0:[1,2]" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_key()
+{
+    json::query query;
+    query.add("/bravo");
+    auto result = collect(query, "{\"alpha\":1,\"bravo\":[2,3],\"charlie\":4}");
+    std::vector<std::string> expect = { "0:[2,3]" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_key_nested()
+{
+    json::query query;
+    query.add("/alpha/bravo/charlie");
+    auto result = collect(query, "{\"alpha\":{\"bravo\":{\"charlie\":true},\"charlie\":false}}");
+    std::vector<std::string> expect = { "0:true" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_key_missing()
+{
+    json::query query;
+    query.add("/delta");
+    auto result = collect(query, "{\"alpha\":1,\"bravo\":[2,3]}");
+    TRIAL_PROTOCOL_TEST(result.empty());
+}
+
+void test_key_empty()
+{
+    json::query query;
+    query.add("/");
+    auto result = collect(query, "{\"alpha\":1,\"\":2}");
+    std::vector<std::string> expect = { "0:2" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_key_pointer_escaped()
+{
+    json::query query;
+    query.add("/a~1b");
+    query.add("/m~0n");
+    auto result = collect(query, "{\"a/b\":1,\"m~n\":2}");
+    std::vector<std::string> expect = { "0:1", "1:2" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_key_input_escaped()
+{
+    json::query query;
+    query.add("/alpha");
+    auto result = collect(query, "{\"al\\u0070ha\":1}");
+    std::vector<std::string> expect = { "0:1" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_index()
+{
+    json::query query;
+    query.add("/1");
+    query.add("/2/0");
+    auto result = collect(query, "[10,11,[12,13]]");
+    std::vector<std::string> expect = { "0:11", "1:12" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_index_key()
+{
+    // Index segments also match object keys
+    json::query query;
+    query.add("/0");
+    auto result = collect(query, "{\"0\":true}");
+    std::vector<std::string> expect = { "0:true" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_index_leading_zero()
+{
+    json::query query;
+    query.add("/01");
+    auto result = collect(query, "[10,11]");
+    TRIAL_PROTOCOL_TEST(result.empty());
+}
+
+void fail_path()
+{
+    json::query query;
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(query.add("alpha"),
+                                    json::error,
+                                    "invalid key");
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(query.add("/alpha~"),
+                                    json::error,
+                                    "invalid key");
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(query.add("/alpha~2"),
+                                    json::error,
+                                    "invalid key");
+    TRIAL_PROTOCOL_TEST_EQUAL(query.size(), 0);
+}
+
+void run()
+{
+    test_root();
+    test_key();
+    test_key_nested();
+    test_key_missing();
+    test_key_empty();
+    test_key_pointer_escaped();
+    test_key_input_escaped();
+    test_index();
+    test_index_key();
+    test_index_leading_zero();
+    fail_path();
+}
+
+} // namespace pointer_suite
+
+//-----------------------------------------------------------------------------
+
+namespace wildcard_suite
+{
+
+void test_array()
+{
+    json::query query;
+    query.add("/items/*/price");
+    auto result = collect(query, "{\"items\":[{\"price\":1,\"name\":\"a\"},{\"name\":\"b\"},{\"price\":2.5}]}");
+    std::vector<std::string> expect = { "0:1", "0:2.5" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_object()
+{
+    json::query query;
+    query.add("/*/x");
+    auto result = collect(query, "{\"alpha\":{\"x\":1},\"bravo\":{\"y\":2},\"charlie\":{\"x\":3}}");
+    std::vector<std::string> expect = { "0:1", "0:3" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_scalar()
+{
+    // Wildcard does not match inside scalars
+    json::query query;
+    query.add("/*/*");
+    auto result = collect(query, "[1,\"alpha\",[2]]");
+    std::vector<std::string> expect = { "0:2" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void run()
+{
+    test_array();
+    test_object();
+    test_scalar();
+}
+
+} // namespace wildcard_suite
+
+//-----------------------------------------------------------------------------
+
+namespace multiple_suite
+{
+
+void test_order()
+{
+    json::query query;
+    query.add("/charlie");
+    query.add("/alpha");
+    auto result = collect(query, "{\"alpha\":1,\"bravo\":2,\"charlie\":3}");
+    std::vector<std::string> expect = { "1:1", "0:3" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_same()
+{
+    json::query query;
+    query.add("/alpha");
+    query.add("/*");
+    auto result = collect(query, "{\"alpha\":1,\"bravo\":2}");
+    std::vector<std::string> expect = { "0:1", "1:1", "1:2" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_nested()
+{
+    // Enclosing match is reported before matches within it
+    json::query query;
+    query.add("/alpha/bravo");
+    query.add("/alpha");
+    auto result = collect(query, "{\"alpha\":{\"bravo\":[1]},\"charlie\":2}");
+    std::vector<std::string> expect = { "1:{\"bravo\":[1]}", "0:[1]" };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void test_select()
+{
+    json::query query;
+    query.add("/items/*/price");
+    query.add("/items/1");
+    query.add("/total");
+    auto result = query.select("{\"items\":[{\"price\":1},{\"price\":2}],\"count\":2}");
+    TRIAL_PROTOCOL_TEST_EQUAL(result.size(), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(result[0].size(), 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(result[0][0].value<int>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(result[0][1].value<int>(), 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(result[1].size(), 1);
+    TRIAL_PROTOCOL_TEST(result[1][0].is<dynamic::map>());
+    TRIAL_PROTOCOL_TEST_EQUAL(result[1][0]["price"].value<int>(), 2);
+    TRIAL_PROTOCOL_TEST(result[2].empty());
+}
+
+void test_reader()
+{
+    // Paths relative to current value of reader
+    const std::string input = "[{\"alpha\":1},{\"alpha\":2}]";
+    json::reader reader(input);
+    reader.next();
+    json::query query;
+    query.add("/alpha");
+    std::vector<int> result;
+    auto visitor = [&result] (std::size_t, const json::lazy_value& value)
+        {
+            result.push_back(value.value<int>());
+        };
+    query.visit(reader, visitor);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.symbol(), json::token::symbol::begin_object);
+    query.visit(reader, visitor);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.symbol(), json::token::symbol::end_array);
+    std::vector<int> expect = { 1, 2 };
+    TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                  expect.begin(), expect.end());
+}
+
+void run()
+{
+    test_order();
+    test_same();
+    test_nested();
+    test_select();
+    test_reader();
+}
+
+} // namespace multiple_suite
+
+//-----------------------------------------------------------------------------
+
+namespace failure_suite
+{
+
+void fail_empty()
+{
+    json::query query;
+    query.add("/alpha");
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(collect(query, ""),
+                                    json::error,
+                                    "algorithm used requires more tokens than available");
+}
+
+void fail_skipped()
+{
+    // Malformed subtree that is skipped
+    json::query query;
+    query.add("/alpha");
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(collect(query, "{\"bravo\":[1,]}"),
+                                    json::error,
+                                    "unexpected token");
+}
+
+void fail_descended()
+{
+    json::query query;
+    query.add("/alpha/*");
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(collect(query, "{\"alpha\":[1,2}"),
+                                    json::error,
+                                    "expected end array bracket");
+}
+
+void fail_trailing_value()
+{
+    json::query query;
+    query.add("/alpha");
+    TRIAL_PROTOCOL_TEST_THROW_EQUAL(collect(query, "{\"alpha\":1} 2"),
+                                    json::error,
+                                    "unexpected token");
+}
+
+void run()
+{
+    fail_empty();
+    fail_skipped();
+    fail_descended();
+    fail_trailing_value();
+}
+
+} // namespace failure_suite
+
+//-----------------------------------------------------------------------------
+// main
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    pointer_suite::run();
+    wildcard_suite::run();
+    multiple_suite::run();
+    failure_suite::run();
+
+    return boost::report_errors();
+}
@@ -8,7 +8,9 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>
 #include <scoped_allocator>
+#include <string>
 #include <trial/protocol/json/reader.hpp>
 #include <trial/protocol/core/detail/lightweight_test.hpp>
 
@@ -612,6 +614,85 @@ void fail_nested_concatenated_arrays()
     TRIAL_PROTOCOL_TEST_EQUAL(reader.tail(), "]]");
 }
 
+void test_numbers()
+{
+    const char input[] = "[1, 2.5,-3 ,4]";
+    json::reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.next(), true);
+    double output[8] = {};
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.array(output, 8), 4);
+    TRIAL_PROTOCOL_TEST_EQUAL(output[0], 1.0);
+    TRIAL_PROTOCOL_TEST_EQUAL(output[1], 2.5);
+    TRIAL_PROTOCOL_TEST_EQUAL(output[2], -3.0);
+    TRIAL_PROTOCOL_TEST_EQUAL(output[3], 4.0);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 0);
+}
+
+void test_numbers_length()
+{
+    const char input[] = "[1,2,3]";
+    json::reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.next(), true);
+    int output[2] = {};
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.array(output, 2), 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(output[0], 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(output[1], 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::integer);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 3);
+}
+
+void test_numbers_mixed()
+{
+    const char input[] = "[1,2,[3],true]";
+    json::reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.next(), true);
+    int output[8] = {};
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.array(output, 8), 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.next(), true);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.array(output, 8), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(output[0], 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.next(), true);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.array(output, 8), 0);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::true_value);
+}
+
+void test_numbers_object()
+{
+    const char input[] = "{\"alpha\":1,\"bravo\":2}";
+    json::reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.next(), true);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.next(), true);
+    int output[8] = {};
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.array(output, 8), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(output[0], 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::key);
+}
+
+void fail_numbers_trailing_separator()
+{
+    const char input[] = "[1,2,]";
+    json::reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.next(), true);
+    int output[8] = {};
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.array(output, 8), 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::error_unexpected_token);
+}
+
+void fail_numbers_missing_separator()
+{
+    const char input[] = "[1 2]";
+    json::reader reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.next(), true);
+    int output[8] = {};
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.array(output, 8), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::error_expected_end_array);
+}
+
 void run()
 {
     test_empty();
@@ -630,6 +711,12 @@ void run()
     fail_missing_end();
     fail_concatenated_arrays();
     fail_nested_concatenated_arrays();
+    test_numbers();
+    test_numbers_length();
+    test_numbers_mixed();
+    test_numbers_object();
+    fail_numbers_trailing_separator();
+    fail_numbers_missing_separator();
 }
 
 } // namespace array_suite
@@ -1053,6 +1140,312 @@ void run()
 
 } // namespace object_suite
 
+//-----------------------------------------------------------------------------
+// Validation
+//-----------------------------------------------------------------------------
+
+namespace validation_suite
+{
+
+void test_lenient_overlong()
+{
+    const char input[] = "\"\xC0\x80\"";
+    json::reader reader(input, json::validation::lenient);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::string);
+}
+
+void test_strict_ascii()
+{
+    const char input[] = "[\"alpha\",{\"bravo\\n\":\"/\"}]";
+    json::reader reader(input, json::validation::strict);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), "alpha");
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), "bravo\n");
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), "/");
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+}
+
+void test_strict_multibyte()
+{
+    // Two, three, and four byte characters mixed with escapes
+    const char input[] = "\"\xC3\xA6\\\"\xE2\x82\xAC/\xF0\x9F\x98\x80\\n\xF4\x8F\xBF\xBF\"";
+    json::reader reader(input, json::validation::strict);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::string);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(),
+                              "\xC3\xA6\"\xE2\x82\xAC/\xF0\x9F\x98\x80\n\xF4\x8F\xBF\xBF");
+}
+
+void test_strict_long()
+{
+    std::string text;
+    for (int i = 0; i < 100; ++i)
+    {
+        text += "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E ";
+    }
+    const std::string input = "{\"" + text + "\":\"" + text + "\"}";
+    json::reader reader(input, json::validation::strict);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::key);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), text);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::string);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), text);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_object);
+}
+
+void test_straddle_probe()
+{
+    // Multibyte characters across the boundary of any scan vector
+    const char *characters[] = { "\xC3\xA6", "\xE2\x82\xAC", "\xF0\x9F\x98\x80" };
+    for (const auto character : characters)
+    {
+        for (int offset = 0; offset < 70; ++offset)
+        {
+            const std::string text = std::string(offset, 'a') + character + std::string(100, 'b');
+            const std::string input = "\"" + text + "\"";
+            json::reader strict(input, json::validation::strict);
+            TRIAL_PROTOCOL_TEST_EQUAL(strict.code(), token::code::string);
+            TRIAL_PROTOCOL_TEST_EQUAL(strict.value<std::string>(), text);
+            if (std::strlen(character) < 4)
+            {
+                json::reader lenient(input, json::validation::lenient);
+                TRIAL_PROTOCOL_TEST_EQUAL(lenient.code(), token::code::string);
+                TRIAL_PROTOCOL_TEST_EQUAL(lenient.value<std::string>(), text);
+            }
+        }
+    }
+}
+
+void fail_strict_overlong()
+{
+    const char input[] = "\"\xC0\x80\"";
+    json::reader reader(input, json::validation::strict);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::error_invalid_encoding);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::invalid_encoding);
+}
+
+void fail_strict_overlong_3()
+{
+    const char input[] = "\"\xE0\x80\xAF\"";
+    json::reader reader(input, json::validation::strict);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::invalid_encoding);
+}
+
+void fail_strict_surrogate()
+{
+    const char input[] = "\"\xED\xA0\x80\"";
+    json::reader reader(input, json::validation::strict);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::invalid_encoding);
+}
+
+void fail_strict_too_large()
+{
+    const char input[] = "\"\xF4\x90\x80\x80\"";
+    json::reader reader(input, json::validation::strict);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::invalid_encoding);
+}
+
+void fail_strict_continuation()
+{
+    const char input[] = "[\"alpha\x80\"]";
+    json::reader reader(input, json::validation::strict);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.next(), false);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::invalid_encoding);
+}
+
+void fail_strict_truncated()
+{
+    // Missing continuation byte before the terminating quote
+    const char input[] = "\"\xE2\x82\"";
+    json::reader reader(input, json::validation::strict);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::invalid_encoding);
+}
+
+void fail_strict_long()
+{
+    std::string text;
+    for (int i = 0; i < 100; ++i)
+    {
+        text += "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E ";
+    }
+    const std::string input = "\"" + text + "\xED\xBF\xBF" + text + "\"";
+    json::reader reader(input, json::validation::strict);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::invalid_encoding);
+}
+
+void fail_strict_unterminated()
+{
+    const char input[] = "\"\xC3\xA6";
+    json::reader reader(input, json::validation::strict);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::unexpected_token);
+}
+
+void run()
+{
+    test_lenient_overlong();
+    test_strict_ascii();
+    test_strict_multibyte();
+    test_strict_long();
+    test_straddle_probe();
+    fail_strict_overlong();
+    fail_strict_overlong_3();
+    fail_strict_surrogate();
+    fail_strict_too_large();
+    fail_strict_continuation();
+    fail_strict_truncated();
+    fail_strict_long();
+    fail_strict_unterminated();
+}
+
+} // namespace validation_suite
+
+//-----------------------------------------------------------------------------
+// Nesting
+//-----------------------------------------------------------------------------
+
+namespace nesting_suite
+{
+
+std::string nested_arrays(std::size_t depth)
+{
+    return std::string(depth, '[') + std::string(depth, ']');
+}
+
+void test_small_inline()
+{
+    using reader_type = json::basic_reader<char, json::small_nesting<4>>;
+    const char input[] = "[[{\"alpha\":[1]}]]";
+    reader_type reader(input);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 1);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_object);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::key);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 4);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 1);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_object);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 0);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+}
+
+void test_small_spill()
+{
+    // Nesting beyond inline capacity continues on the heap
+    using reader_type = json::basic_reader<char, json::small_nesting<4>>;
+    const std::size_t depth = 100;
+    const auto input = nested_arrays(depth);
+    reader_type reader(input);
+    for (std::size_t i = 1; i < depth; ++i)
+    {
+        TRIAL_PROTOCOL_TEST(reader.next());
+        TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array);
+    }
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), depth);
+    // Copies continue independently
+    reader_type copy(reader);
+    for (std::size_t i = 0; i < depth; ++i)
+    {
+        TRIAL_PROTOCOL_TEST(reader.next());
+        TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+    }
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 0);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+    TRIAL_PROTOCOL_TEST_EQUAL(copy.level(), depth);
+    TRIAL_PROTOCOL_TEST(copy.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(copy.level(), depth - 1);
+}
+
+void test_fixed_depth()
+{
+    using reader_type = json::basic_reader<char, json::fixed_nesting<3>>;
+    const auto input = nested_arrays(3);
+    reader_type reader(input);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 3);
+    for (int i = 0; i < 3; ++i)
+    {
+        TRIAL_PROTOCOL_TEST(reader.next());
+        TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+    }
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+}
+
+void fail_fixed_array()
+{
+    using reader_type = json::basic_reader<char, json::fixed_nesting<3>>;
+    const auto input = nested_arrays(4);
+    reader_type reader(input);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::error_max_depth);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.symbol(), token::symbol::error);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::max_depth);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 3);
+}
+
+void fail_fixed_object()
+{
+    using reader_type = json::basic_reader<char, json::fixed_nesting<1>>;
+    const char input[] = "{\"alpha\":{}}";
+    reader_type reader(input);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::key);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::max_depth);
+}
+
+void fail_fixed_outer()
+{
+    using reader_type = json::basic_reader<char, json::fixed_nesting<0>>;
+    {
+        const char input[] = "[]";
+        reader_type reader(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::error_max_depth);
+    }
+    {
+        const char input[] = "true";
+        reader_type reader(input);
+        TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::true_value);
+    }
+}
+
+void run()
+{
+    test_small_inline();
+    test_small_spill();
+    test_fixed_depth();
+    fail_fixed_array();
+    fail_fixed_object();
+    fail_fixed_outer();
+}
+
+} // namespace nesting_suite
+
 //-----------------------------------------------------------------------------
 // main
 //-----------------------------------------------------------------------------
@@ -1063,6 +1456,8 @@ int main()
     ubasic_suite::run();
     array_suite::run();
     object_suite::run();
+    validation_suite::run();
+    nesting_suite::run();
 
     return boost::report_errors();
 }
@@ -0,0 +1,372 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2020 Bjorn Reese <breese@users.sourceforge.net>
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <trial/protocol/core/detail/lightweight_test.hpp>
+#include <trial/protocol/json/stream_reader.hpp>
+
+using namespace trial::protocol;
+namespace token = json::token;
+
+// Source that delivers at most chunk_size characters per call
+struct chunk_source
+{
+    chunk_source(const std::string& input, std::size_t chunk_size)
+        : input(input),
+          chunk_size(chunk_size)
+    {}
+
+    std::size_t operator()(char *data, std::size_t size)
+    {
+        const auto count = std::min({ size, chunk_size, input.size() - position });
+        std::memcpy(data, input.data() + position, count);
+        position += count;
+        return count;
+    }
+
+    std::string input;
+    std::size_t chunk_size;
+    std::size_t position = 0;
+};
+
+// Token codes and literals
+template <typename Reader>
+std::vector<std::string> tokenize(Reader& reader)
+{
+    std::vector<std::string> result;
+    do
+    {
+        std::string entry = std::to_string(int(reader.code()));
+        entry += ':';
+        entry.append(reader.literal().data(), reader.literal().size());
+        switch (reader.code())
+        {
+        case token::code::string:
+        case token::code::key:
+            entry += '=';
+            entry += reader.template value<std::string>();
+            break;
+        default:
+            break;
+        }
+        result.push_back(entry);
+    } while (reader.next());
+    result.push_back(std::to_string(int(reader.code())));
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+namespace basic_suite
+{
+
+void stream_empty()
+{
+    json::stream_reader reader(chunk_source("", 4));
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+}
+
+void stream_whitespace()
+{
+    json::stream_reader reader(chunk_source("        \n\n        ", 4));
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+}
+
+void stream_keyword()
+{
+    json::stream_reader reader(chunk_source("  true", 3));
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::true_value);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+}
+
+void stream_integer()
+{
+    json::stream_reader reader(chunk_source("123456789", 2));
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::integer);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 123456789);
+}
+
+void stream_string()
+{
+    json::stream_reader reader(chunk_source("\"alpha\\nbravo\"", 1));
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::string);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), "alpha\nbravo");
+}
+
+void stream_array()
+{
+    json::stream_reader reader(chunk_source("[1, \"alpha\", [true, null], {\"bravo\": 2.5}]", 3));
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_array);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 1);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), "alpha");
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 2);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::true_value);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::null);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_object);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::key);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), "bravo");
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<double>(), 2.5);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_object);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.level(), 0);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+}
+
+void stream_istream()
+{
+    std::istringstream input("{\"alpha\":[1,2,3]}");
+    json::stream_reader reader(input, 4);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::begin_object);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), "alpha");
+    TRIAL_PROTOCOL_TEST(reader.next(token::code::key));
+    TRIAL_PROTOCOL_TEST(reader.next(token::code::begin_array));
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 1);
+}
+
+void run()
+{
+    stream_empty();
+    stream_whitespace();
+    stream_keyword();
+    stream_integer();
+    stream_string();
+    stream_array();
+    stream_istream();
+}
+
+} // namespace basic_suite
+
+//-----------------------------------------------------------------------------
+
+namespace buffer_suite
+{
+
+void grow_long_string()
+{
+    // Token larger than buffer
+    const std::string text(1000, 'a');
+    json::stream_reader reader(chunk_source("[\"" + text + "\"]", 7), 16);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), text);
+    TRIAL_PROTOCOL_TEST(reader.capacity() >= 1000);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_array);
+}
+
+void bounded_capacity()
+{
+    // Many small tokens do not grow buffer
+    std::string input = "[";
+    for (int i = 0; i < 10000; ++i)
+    {
+        input += std::to_string(i) + ",";
+    }
+    input += "0]";
+    json::stream_reader reader(chunk_source(input, 100), 64);
+    int sum = 0;
+    while (reader.next())
+    {
+        if (reader.code() == token::code::integer)
+            sum += reader.value<int>();
+    }
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+    TRIAL_PROTOCOL_TEST_EQUAL(sum, 49995000);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.capacity(), 64);
+}
+
+void compare_reader()
+{
+    const std::vector<std::string> inputs = {
+        "[1, 22, 333, \"alpha\\nbeta\", {\"key\\u0041\": [true, false, null]}, -4.5e3, \"\", {}, []]",
+        "{\"a\":{\"b\":{\"c\":[\"x\\\"y\", 1.25, 0]}}, \"d\": \"\\u00e6\\u00f8 esc\\t\"}",
+        "  [ \"long string with several \\\\ escapes \\/ and \\b more \\f \\r\" , 12345678901234 ]  "
+    };
+    for (const auto& input : inputs)
+    {
+        json::reader expected_reader(input);
+        const auto expected = tokenize(expected_reader);
+        for (std::size_t chunk_size = 1; chunk_size <= input.size(); ++chunk_size)
+        {
+            for (std::size_t capacity : { 1, 8, 64 })
+            {
+                json::stream_reader reader(chunk_source(input, chunk_size), capacity);
+                const auto result = tokenize(reader);
+                TRIAL_PROTOCOL_TEST_ALL_EQUAL(result.begin(), result.end(),
+                                              expected.begin(), expected.end());
+            }
+        }
+    }
+}
+
+void run()
+{
+    grow_long_string();
+    bounded_capacity();
+    compare_reader();
+}
+
+} // namespace buffer_suite
+
+//-----------------------------------------------------------------------------
+
+namespace sequence_suite
+{
+
+void sequence_scalars()
+{
+    json::stream_reader reader(chunk_source("1 true \"alpha\"\nnull", 3));
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 1);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::true_value);
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<std::string>(), "alpha");
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::null);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+}
+
+void sequence_lines()
+{
+    std::string input;
+    for (int i = 0; i < 1000; ++i)
+    {
+        input += "{\"id\":" + std::to_string(i) + ",\"tags\":[\"alpha\",\"bravo\"]}\n";
+    }
+    json::stream_reader reader(chunk_source(input, 37), 32);
+    int documents = 0;
+    int sum = 0;
+    do
+    {
+        if (reader.code() == token::code::key && reader.value<std::string>() == "id")
+        {
+            TRIAL_PROTOCOL_TEST(reader.next());
+            sum += reader.value<int>();
+        }
+        if (reader.code() == token::code::end_object && reader.level() == 0)
+            ++documents;
+    } while (reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end);
+    TRIAL_PROTOCOL_TEST_EQUAL(documents, 1000);
+    TRIAL_PROTOCOL_TEST_EQUAL(sum, 499500);
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.capacity(), 32);
+}
+
+void fail_sequence_separator()
+{
+    json::stream_reader reader(chunk_source("{} , {}", 2));
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.code(), token::code::end_object);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::unexpected_token);
+}
+
+void fail_sequence_end()
+{
+    json::stream_reader reader(chunk_source("[] ]", 2));
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::unbalanced_end_array);
+}
+
+void run()
+{
+    sequence_scalars();
+    sequence_lines();
+    fail_sequence_separator();
+    fail_sequence_end();
+}
+
+} // namespace sequence_suite
+
+//-----------------------------------------------------------------------------
+
+namespace failure_suite
+{
+
+void fail_unterminated_string()
+{
+    json::stream_reader reader(chunk_source("[\"alpha", 2));
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::unexpected_token);
+}
+
+void fail_truncated_keyword()
+{
+    json::stream_reader reader(chunk_source("[tru", 2));
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::unexpected_token);
+}
+
+void fail_missing_end()
+{
+    json::stream_reader reader(chunk_source("[1, 2", 2));
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.value<int>(), 2);
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::expected_end_array);
+}
+
+void fail_early()
+{
+    // Error is reported without reading remaining input
+    chunk_source source("[1, x, " + std::string(10000, ' ') + "]", 16);
+    const auto& position = source.position;
+    json::stream_reader reader(std::ref(source));
+    TRIAL_PROTOCOL_TEST(reader.next());
+    TRIAL_PROTOCOL_TEST(!reader.next());
+    TRIAL_PROTOCOL_TEST_EQUAL(reader.error(), json::unexpected_token);
+    TRIAL_PROTOCOL_TEST(position < 100);
+}
+
+void run()
+{
+    fail_unterminated_string();
+    fail_truncated_keyword();
+    fail_missing_end();
+    fail_early();
+}
+
+} // namespace failure_suite
+
+//-----------------------------------------------------------------------------
+// main
+//-----------------------------------------------------------------------------
+
+int main()
+{
+    basic_suite::run();
+    buffer_suite::run();
+    sequence_suite::run();
+    failure_suite::run();
+
+    return boost::report_errors();
+}
@@ -8,8 +8,15 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <sstream>
+#include <string>
+#include <vector>
+#include <trial/protocol/buffer/array.hpp>
 #include <trial/protocol/buffer/ostream.hpp>
+#include <trial/protocol/buffer/string.hpp>
 #include <trial/protocol/json/writer.hpp>
 #include <trial/protocol/core/detail/lightweight_test.hpp>
 
@@ -126,12 +133,45 @@ void test_literal_zero_one()
     TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0,1");
 }
 
+void test_digits()
+{
+    std::ostringstream result;
+    json::writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::begin_array>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(9), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(10), 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(-99), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(100), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(-1000), 5);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::end_array>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "[9,10,-99,100,-1000]");
+}
+
+void test_intmax_min()
+{
+    std::ostringstream result;
+    json::writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(std::numeric_limits<std::int64_t>::min()), 20);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "-9223372036854775808");
+}
+
+void test_uintmax_max()
+{
+    std::ostringstream result;
+    json::writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(std::numeric_limits<std::uint64_t>::max()), 20);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "18446744073709551615");
+}
+
 void run()
 {
     test_literal_zero();
     test_zero();
     test_intmax_zero();
     test_literal_zero_one();
+    test_digits();
+    test_intmax_min();
+    test_uintmax_max();
 }
 
 } // namespace integer_suite
@@ -147,16 +187,16 @@ void test_literal_zero()
 {
     std::ostringstream result;
     json::writer writer(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(0.0), 16);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.00000000000000");
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(0.0), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.0");
 }
 
 void test_zero()
 {
     std::ostringstream result;
     json::writer writer(result);
-    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(double(0.0)), 16);
-    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.00000000000000");
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(double(0.0)), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "0.0");
 }
 
 void run()
@@ -282,6 +322,84 @@ void fail_mismatched_end()
                                     json::error, "unexpected token");
 }
 
+void test_int_array_empty()
+{
+    std::ostringstream result;
+    json::writer writer(result);
+    const int input[] = { 0 };
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.array(input, 0), 2);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "[]");
+}
+
+void test_int_array()
+{
+    std::ostringstream result;
+    json::writer writer(result);
+    const int input[] = { 0, 1, -22, 333 };
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.array(input, 4), 13);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "[0,1,-22,333]");
+}
+
+void test_double_array()
+{
+    std::ostringstream result;
+    json::writer writer(result);
+    const double input[] = { 0.0, -1.5, 1e300, std::numeric_limits<double>::quiet_NaN() };
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.array(input, 4), 22);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "[0.0,-1.5,1e+300,null]");
+}
+
+void test_nested_int_array()
+{
+    std::ostringstream result;
+    json::writer writer(result);
+    const int input[] = { 1, 2 };
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::begin_array>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.array(input, 2), 5);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.array(input, 1), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::end_array>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "[[1,2],[1]]");
+}
+
+void test_large_array()
+{
+    // Exceeds the internal formatting block
+    std::vector<std::int64_t> input;
+    std::ostringstream expect;
+    {
+        json::writer writer(expect);
+        writer.value<token::begin_array>();
+        for (std::int64_t i = 0; i < 1000; ++i)
+        {
+            input.push_back(i * i * i * i * i * ((i % 2) ? -1 : 1));
+            writer.value(input.back());
+        }
+        writer.value<token::end_array>();
+    }
+    std::ostringstream result;
+    json::writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.array(input.data(), input.size()), expect.str().size());
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), expect.str());
+}
+
+void test_full_block_array()
+{
+    // Last number ends exactly at the end of the internal formatting block
+    std::vector<std::int64_t> input = { 0, 12345 };
+    std::string expect = "[0,12345";
+    for (int i = 0; i < 24; ++i)
+    {
+        input.push_back(std::numeric_limits<std::int64_t>::min());
+        expect += ",-9223372036854775808";
+    }
+    TRIAL_PROTOCOL_TEST_EQUAL(expect.size(), 512);
+    expect += "]";
+    std::ostringstream result;
+    json::writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.array(input.data(), input.size()), expect.size());
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), expect);
+}
+
 void run()
 {
     test_empty();
@@ -290,6 +408,12 @@ void run()
     test_nested_bool_one();
     fail_missing_begin();
     fail_mismatched_end();
+    test_int_array_empty();
+    test_int_array();
+    test_double_array();
+    test_nested_int_array();
+    test_large_array();
+    test_full_block_array();
 }
 
 } // namespace array_suite
@@ -377,6 +501,95 @@ void run()
 
 } // namespace object_suite
 
+//-----------------------------------------------------------------------------
+// Static buffer
+//-----------------------------------------------------------------------------
+
+namespace static_suite
+{
+
+using string_writer = json::static_writer<buffer::basic_string<char, buffer::static_base<char>>>;
+using ostream_writer = json::static_writer<buffer::basic_ostream<char, core::char_traits<char>, buffer::static_base<char>>>;
+using array_writer = json::static_writer<buffer::array<char, 8, buffer::static_base<char>>>;
+
+void test_string()
+{
+    std::string result;
+    string_writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::begin_array>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(true), 4);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(2), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(3.5), 3);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value("al\"pha"), 9);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::end_array>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(result, "[true,2,3.5,\"al\\\"pha\"]");
+}
+
+void test_ostream()
+{
+    std::ostringstream result;
+    ostream_writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::begin_object>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value("key"), 5);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::null>(), 4);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::end_object>(), 1);
+    TRIAL_PROTOCOL_TEST_EQUAL(result.str(), "{\"key\":null}");
+}
+
+void test_array()
+{
+    std::array<char, 8> result;
+    array_writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(false), 5);
+    TRIAL_PROTOCOL_TEST_EQUAL(std::string(result.data(), 5), "false");
+}
+
+void test_reserve()
+{
+    std::string result;
+    string_writer writer(result);
+    TRIAL_PROTOCOL_TEST(writer.reserve(100));
+    TRIAL_PROTOCOL_TEST(result.capacity() >= 100);
+    TRIAL_PROTOCOL_TEST_EQUAL(result, "");
+}
+
+void fail_reserve_array()
+{
+    std::array<char, 8> result;
+    array_writer writer(result);
+    TRIAL_PROTOCOL_TEST(writer.reserve(8));
+    TRIAL_PROTOCOL_TEST(!writer.reserve(9));
+}
+
+void fail_array_overflow()
+{
+    std::array<char, 8> result;
+    array_writer writer(result);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value(false), 5);
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.value<token::null>(), 0);
+}
+
+void fail_array_numbers_overflow()
+{
+    std::array<char, 8> result;
+    array_writer writer(result);
+    const int input[] = { 100, 200, 300 };
+    TRIAL_PROTOCOL_TEST_EQUAL(writer.array(input, 3), 0);
+}
+
+void run()
+{
+    test_string();
+    test_ostream();
+    test_array();
+    test_reserve();
+    fail_reserve_array();
+    fail_array_overflow();
+    fail_array_numbers_overflow();
+}
+
+} // namespace static_suite
+
 //-----------------------------------------------------------------------------
 // main
 //-----------------------------------------------------------------------------
@@ -390,6 +603,7 @@ int main()
     string_suite::run();
     array_suite::run();
     object_suite::run();
+    static_suite::run();
 
     return boost::report_errors();
 }